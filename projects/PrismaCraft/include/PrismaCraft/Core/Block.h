@@ -1,12 +1,15 @@
 #pragma once
 
 #include <PrismaCraft/PrismaCraft.h>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace PrismaCraft {
 
 class BlockState;
+class BlockProperty;
 
 /**
  * Base block class
@@ -21,11 +24,20 @@ public:
     virtual int getId() const = 0;
 
     // State handling
-    virtual const BlockState& defaultBlockState() const = 0;
+    virtual const BlockState& defaultBlockState() const;
+
+    // Properties spanning this block's states (StateDefinition); queried once when state IDs are assigned
+    virtual std::vector<const BlockProperty*> getStateProperties() const { return {}; }
+    virtual size_t getDefaultValueIndex(const BlockProperty& /*property*/) const { return 0; }
+
+    // Global state ID range, valid after BlockStateRegistry::build()
+    uint32_t getFirstStateId() const { return firstStateId; }
+    uint32_t getStateCount() const { return stateCount; }
 
     // Block behavior
     virtual float getDestroySpeed(const BlockState& state) const { return 1.0f; }
     virtual float getExplosionResistance() const { return 0.0f; }
+    virtual bool isRandomlyTicking(const BlockState& /*state*/) const { return false; }
 
     // Light
     virtual int getLightEmission(const BlockState& state) const { return 0; }
@@ -34,9 +46,21 @@ public:
     // Collision
     virtual bool isSolid(const BlockState& state) const { return true; }
     virtual bool isAir(const BlockState& state) const { return false; }
+    virtual bool canOcclude(const BlockState& state) const { return isSolid(state); }
+    virtual bool isCollisionShapeFullBlock(const BlockState& state) const { return isSolid(state); }
+
+    // Index into the game's collision shape table: 0 = empty, 1 = full cube
+    virtual uint16_t getCollisionShapeIndex(const BlockState& state) const { return isSolid(state) ? 1 : 0; }
 
 protected:
     Block() = default;
+
+private:
+    friend class BlockStateRegistry;
+
+    uint32_t firstStateId = 0;
+    uint32_t defaultStateId = 0;
+    uint32_t stateCount = 0;
 };
 
 } // namespace PrismaCraft
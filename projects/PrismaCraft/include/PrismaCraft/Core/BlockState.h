@@ -19,10 +19,14 @@ class BlockProperty;
  */
 class PRISMACRAFT_API BlockProperty {
 public:
+    static constexpr size_t INVALID_VALUE = static_cast<size_t>(-1);
+
     virtual ~BlockProperty() = default;
 
     virtual std::string getName() const = 0;
     virtual std::vector<std::string> getPossibleValues() const = 0;
+    virtual size_t getValueCount() const { return getPossibleValues().size(); }
+    // INVALID_VALUE when the string is not a value of this property
     virtual size_t getValueIndex(const std::string& value) const = 0;
     virtual std::string getValueName(size_t index) const = 0;
 
@@ -42,9 +46,10 @@ public:
     std::vector<std::string> getPossibleValues() const override {
         return {"true", "false"};
     }
+    size_t getValueCount() const override { return 2; }
 
     size_t getValueIndex(const std::string& value) const override {
-        return (value == "true") ? 0 : 1;
+        return (value == "true") ? 0 : (value == "false") ? 1 : INVALID_VALUE;
     }
 
     std::string getValueName(size_t index) const override {
@@ -66,6 +71,7 @@ public:
 
     std::string getName() const override { return name; }
     std::vector<std::string> getPossibleValues() const override;
+    size_t getValueCount() const override { return static_cast<size_t>(maxValue - minValue + 1); }
 
     size_t getValueIndex(const std::string& value) const override;
     std::string getValueName(size_t index) const override {
@@ -94,6 +100,7 @@ public:
 
     std::string getName() const override { return name; }
     std::vector<std::string> getPossibleValues() const override { return values; }
+    size_t getValueCount() const override { return values.size(); }
 
     size_t getValueIndex(const std::string& value) const override;
     std::string getValueName(size_t index) const override {
@@ -128,6 +135,9 @@ protected:
 /**
  * Block state with property values
  * Corresponds to: net.minecraft.world.level.block.state.BlockState
+ *
+ * States are created by BlockStateRegistry; the state ID is the dense global index into its
+ * flag and transition tables. Hot paths should query BlockStateRegistry by ID directly.
  */
 class PRISMACRAFT_API BlockState : public BlockStateBase {
 public:
@@ -149,6 +159,20 @@ public:
     int getInteger(const IntegerProperty& property) const;
     std::string getEnum(const EnumProperty& property) const;
 
+    // Value index of the property, BlockProperty::INVALID_VALUE when the block lacks it
+    size_t getValueIndex(const BlockProperty& property) const;
+
+    // State differing only in the given property; *this when the block lacks it
+    const BlockState& with(const BlockProperty& property, size_t valueIndex) const;
+    const BlockState& setValue(const BooleanProperty& property, bool value) const;
+    const BlockState& setValue(const IntegerProperty& property, int value) const;
+
+    // Cached classification (see BlockStateRegistry)
+    bool canOcclude() const;
+    bool isCollisionShapeFullBlock() const;
+    int getLightEmission() const;
+    int getLightBlock() const;
+
     // Generate state map key for serialization
     std::map<std::string, std::string> getValues() const;
 
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include "BlockState.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace PrismaCraft {
+
+/**
+ * Dense global block state IDs with flat per-state lookup tables
+ * Corresponds to: net.minecraft.world.level.block.Block.BLOCK_STATE_REGISTRY
+ *
+ * build() enumerates every state of every block in registry order, so each block owns a
+ * contiguous ID range. Classification (air, occlusion, light, collision shape) is queried
+ * from the blocks once and stored in flat arrays, and every with(property, value) result is
+ * precomputed: a state change is two table reads, with no virtual calls or strings.
+ */
+class PRISMACRAFT_API BlockStateRegistry {
+public:
+    using StateId = uint32_t;
+
+    static constexpr StateId INVALID_STATE = 0xFFFFFFFFu;
+    static constexpr size_t MAX_PROPERTY_VALUES = 256;
+
+    enum Flags : uint16_t {
+        AIR = 1 << 0,
+        SOLID = 1 << 1,
+        CAN_OCCLUDE = 1 << 2,
+        FULL_CUBE = 1 << 3,                 // Collision shape is a full block
+        EMITS_LIGHT = 1 << 4,
+        BLOCKS_LIGHT = 1 << 5,              // Light block value > 0
+        FULLY_BLOCKS_LIGHT = 1 << 6,        // Light block value == 15
+        RANDOM_TICKS = 1 << 7
+    };
+
+    static BlockStateRegistry& instance();
+
+    /**
+     * Assign state IDs and fill the lookup tables. Called by Registries::init() once the
+     * block registry is frozen; blocks must not change their state definition afterwards.
+     */
+    void build(const std::vector<Block*>& blocks);
+
+    bool isBuilt() const { return built; }
+    size_t size() const { return states.size(); }
+
+    const BlockState& byId(StateId id) const { return *states[id]; }
+    const Block& getBlock(StateId id) const { return *blocks[stateBlock[id]].block; }
+    StateId getDefaultState(const Block& block) const;
+
+    // ========== Classification ==========
+
+    uint16_t getFlags(StateId id) const { return flags[id]; }
+    bool hasFlags(StateId id, uint16_t mask) const { return (flags[id] & mask) == mask; }
+    bool isAir(StateId id) const { return (flags[id] & AIR) != 0; }
+    bool canOcclude(StateId id) const { return (flags[id] & CAN_OCCLUDE) != 0; }
+    bool isRandomlyTicking(StateId id) const { return (flags[id] & RANDOM_TICKS) != 0; }
+    bool isCollisionShapeFullBlock(StateId id) const { return (flags[id] & FULL_CUBE) != 0; }
+    int getLightEmission(StateId id) const { return lightEmission[id]; }
+    int getLightBlock(StateId id) const { return lightBlock[id]; }
+    uint16_t getCollisionShapeIndex(StateId id) const { return shapeIndex[id]; }
+
+    // Flat arrays indexed by state ID, for batch consumers (meshing, lighting)
+    const uint16_t* getFlagsTable() const { return flags.data(); }
+    const uint8_t* getLightEmissionTable() const { return lightEmission.data(); }
+    const uint8_t* getLightBlockTable() const { return lightBlock.data(); }
+    const uint16_t* getCollisionShapeTable() const { return shapeIndex.data(); }
+
+    // ========== Properties ==========
+
+    const std::vector<const BlockProperty*>& getProperties(StateId id) const {
+        return blocks[stateBlock[id]].properties;
+    }
+
+    // Position of the property in the block's definition, -1 when absent
+    int getPropertySlot(StateId id, const BlockProperty& property) const;
+
+    size_t getValueIndex(StateId id, int slot) const {
+        return valueIndices[valueOffsets[id] + slot];
+    }
+
+    StateId with(StateId id, int slot, size_t valueIndex) const {
+        const BlockInfo& info = blocks[stateBlock[id]];
+        return transitions[transitionOffsets[id] + info.valueOffsets[slot] + valueIndex];
+    }
+
+    // INVALID_STATE when the block lacks the property or the value is out of range
+    StateId with(StateId id, const BlockProperty& property, size_t valueIndex) const;
+
+private:
+    struct BlockInfo {
+        const Block* block = nullptr;
+        StateId firstState = 0;
+        uint32_t stateCount = 0;
+        std::vector<const BlockProperty*> properties;
+        std::vector<uint32_t> valueCounts;
+        std::vector<uint32_t> valueOffsets;     // Start of each property's values in a transition row
+        uint32_t rowSize = 0;                   // Sum of value counts
+    };
+
+    BlockStateRegistry() = default;
+
+    bool built = false;
+    std::vector<BlockInfo> blocks;
+    std::vector<std::unique_ptr<BlockState>> states;
+    std::vector<uint32_t> stateBlock;           // State -> index into blocks
+
+    std::vector<uint16_t> flags;
+    std::vector<uint8_t> lightEmission;
+    std::vector<uint8_t> lightBlock;
+    std::vector<uint16_t> shapeIndex;
+
+    std::vector<uint32_t> valueOffsets;         // State -> start of its value indices
+    std::vector<uint8_t> valueIndices;
+    std::vector<uint32_t> transitionOffsets;    // State -> start of its transition row
+    std::vector<StateId> transitions;
+};
+
+} // namespace PrismaCraft
@@ -8,6 +8,9 @@
 #include <memory>
 #include <stdexcept>
 #include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
 
 namespace PrismaCraft {
 
@@ -16,43 +19,52 @@ class Block;
 class ItemType;
 class EntityType;
 
+/**
+ * Interned string; equal texts share one Symbol for the lifetime of the process
+ */
+struct PRISMACRAFT_API Symbol {
+    std::string text;
+    size_t hash;
+};
+
+/**
+ * Global, thread-safe intern table backing ResourceLocation
+ */
+class PRISMACRAFT_API SymbolTable {
+public:
+    static const Symbol* intern(std::string_view text);
+
+    // Existing symbol or nullptr; never inserts
+    static const Symbol* find(std::string_view text);
+
+    static const Symbol* empty();
+    static size_t size();
+
+private:
+    SymbolTable() = default;
+};
+
 /**
  * Resource location (namespaced identifier)
  * Corresponds to: net.minecraft.resources.ResourceLocation
+ *
+ * Namespace and path are interned symbols, so copies are three words, equality is two
+ * pointer compares and the hash is computed once at construction.
  */
 class PRISMACRAFT_API ResourceLocation {
 public:
-    ResourceLocation() = default;
-
-    ResourceLocation(const std::string& namespace_, const std::string& path)
-        : namespace_(namespace_), path(path) {
-        if (namespace_.empty() || !isValidNamespace(namespace_)) {
-            throw std::invalid_argument("Invalid namespace: " + namespace_);
-        }
-        if (path.empty() || !isValidPath(path)) {
-            throw std::invalid_argument("Invalid path: " + path);
-        }
-    }
+    ResourceLocation() : namespace_(SymbolTable::empty()), path(SymbolTable::empty()), hash(combineHash(namespace_, path)) {}
 
-    explicit ResourceLocation(const std::string& combined) {
-        size_t colon = combined.find(':');
-        if (colon == std::string::npos) {
-            namespace_ = "minecraft";
-            path = combined;
-        } else {
-            namespace_ = combined.substr(0, colon);
-            path = combined.substr(colon + 1);
-        }
-        if (!isValidNamespace(namespace_) || !isValidPath(path)) {
-            throw std::invalid_argument("Invalid resource location: " + combined);
-        }
-    }
+    ResourceLocation(std::string_view namespace_, std::string_view path);
+    explicit ResourceLocation(std::string_view combined);
+    explicit ResourceLocation(const std::string& combined) : ResourceLocation(std::string_view(combined)) {}
+    explicit ResourceLocation(const char* combined) : ResourceLocation(std::string_view(combined)) {}
 
-    const std::string& getNamespace() const { return namespace_; }
-    const std::string& getPath() const { return path; }
+    const std::string& getNamespace() const { return namespace_->text; }
+    const std::string& getPath() const { return path->text; }
 
     std::string toString() const {
-        return namespace_ + ":" + path;
+        return namespace_->text + ":" + path->text;
     }
 
     bool operator==(const ResourceLocation& other) const {
@@ -64,7 +76,7 @@ public:
     }
 
     size_t hashCode() const {
-        return std::hash<std::string>{}(toString());
+        return hash;
     }
 
     struct Hash {
@@ -76,33 +88,25 @@ public:
     static const std::string DEFAULT_NAMESPACE;
 
 private:
-    std::string namespace_;
-    std::string path;
-
-    static bool isValidNamespace(const std::string& ns) {
-        if (ns.empty()) return false;
-        for (char c : ns) {
-            if (!std::isalnum(c) && c != '_' && c != '-' && c != '.') {
-                return false;
-            }
-        }
-        return true;
-    }
+    const Symbol* namespace_;
+    const Symbol* path;
+    size_t hash;
 
-    static bool isValidPath(const std::string& p) {
-        if (p.empty()) return false;
-        for (char c : p) {
-            if (!std::isalnum(c) && c != '_' && c != '-' && c != '.' && c != '/') {
-                return false;
-            }
-        }
-        return true;
+    static size_t combineHash(const Symbol* ns, const Symbol* p) {
+        return ns->hash ^ (p->hash + 0x9E3779B97F4A7C15ull + (ns->hash << 6) + (ns->hash >> 2));
     }
+
+    static bool isValidNamespace(std::string_view ns);
+    static bool isValidPath(std::string_view p);
 };
 
 /**
  * Generic registry for game objects
  * Corresponds to: net.minecraft.core.Registry
+ *
+ * IDs are dense indices into the object and key arrays. Once frozen, no more objects can be
+ * registered and key lookups go through a single-probe perfect hash (hash and displace)
+ * built over the keys' precomputed hashes.
  */
 template<typename T>
 class PRISMACRAFT_API Registry {
@@ -113,10 +117,15 @@ public:
 
     // Register an object and return its ID
     IdType registerObject(const ResourceLocation& key, std::unique_ptr<T> object) {
+        if (frozen_) {
+            throw std::logic_error("Registry is already frozen: " + name_);
+        }
+        if (keyToId_.count(key)) {
+            throw std::invalid_argument("Adding duplicate key '" + key.toString() + "' to registry " + name_);
+        }
         IdType id = static_cast<IdType>(objects_.size());
         objects_.push_back(object.get());
-        byId_[id] = object.get();
-        byKey_[key] = object.get();
+        keys_.push_back(key);
         keyToId_[key] = id;
         object.release(); // Registry owns the object
         return id;
@@ -124,30 +133,31 @@ public:
 
     // Get object by ID
     T* getById(IdType id) const {
-        auto it = byId_.find(id);
-        return it != byId_.end() ? it->second : nullptr;
+        return static_cast<size_t>(id) < objects_.size() ? objects_[id] : nullptr;
     }
 
     // Get object by resource location
     T* get(const ResourceLocation& key) const {
-        auto it = byKey_.find(key);
-        return it != byKey_.end() ? it->second : nullptr;
+        IdType id = getId(key);
+        return id >= 0 ? objects_[id] : nullptr;
     }
 
     // Get ID by resource location
     IdType getId(const ResourceLocation& key) const {
+        if (!slots_.empty()) {
+            const size_t hash = key.hashCode();
+            const IdType id = slots_[slotOf(hash, seeds_[hash & (seeds_.size() - 1)], slots_.size() - 1)];
+            return id >= 0 && keys_[id] == key ? id : -1;
+        }
         auto it = keyToId_.find(key);
         return it != keyToId_.end() ? it->second : -1;
     }
 
+    bool containsKey(const ResourceLocation& key) const { return getId(key) >= 0; }
+
     // Get resource location by ID
     ResourceLocation getKey(IdType id) const {
-        for (const auto& entry : keyToId_) {
-            if (entry.second == id) {
-                return entry.first;
-            }
-        }
-        return ResourceLocation();
+        return static_cast<size_t>(id) < keys_.size() ? keys_[id] : ResourceLocation();
     }
 
     // Iterate over all objects
@@ -155,15 +165,95 @@ public:
         return objects_;
     }
 
+    /**
+     * Stop accepting registrations and build the perfect hash for key lookups.
+     * If the keys cannot be placed (full 64-bit hash collision), lookups keep using the hash map.
+     */
+    void freeze() {
+        if (frozen_) return;
+        frozen_ = true;
+        buildPerfectHash();
+    }
+
+    bool isFrozen() const { return frozen_; }
+    bool hasPerfectHash() const { return !slots_.empty(); }
+
     size_t size() const { return objects_.size(); }
     const std::string& getName() const { return name_; }
 
 private:
+    static constexpr uint32_t MAX_SEED_ATTEMPTS = 1u << 16;
+
+    static size_t slotOf(size_t hash, uint32_t seed, size_t mask) {
+        uint64_t x = static_cast<uint64_t>(hash) ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        return static_cast<size_t>(x) & mask;
+    }
+
+    static size_t nextPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    void buildPerfectHash() {
+        if (keys_.empty()) return;
+
+        // ~4 keys per bucket, table at most half full
+        const size_t bucketCount = nextPowerOfTwo(std::max<size_t>(keys_.size() / 4, 1));
+        const size_t slotCount = nextPowerOfTwo(keys_.size() * 2);
+
+        std::vector<std::vector<IdType>> buckets(bucketCount);
+        for (IdType id = 0; id < static_cast<IdType>(keys_.size()); ++id) {
+            buckets[keys_[id].hashCode() & (bucketCount - 1)].push_back(id);
+        }
+        std::vector<size_t> order(bucketCount);
+        for (size_t i = 0; i < bucketCount; ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        std::vector<IdType> slots(slotCount, -1);
+        std::vector<uint32_t> seeds(bucketCount, 0);
+        std::vector<size_t> placed;
+        for (size_t bucket : order) {
+            const auto& ids = buckets[bucket];
+            if (ids.empty()) break;
+
+            bool found = false;
+            for (uint32_t seed = 0; seed < MAX_SEED_ATTEMPTS && !found; ++seed) {
+                placed.clear();
+                found = true;
+                for (IdType id : ids) {
+                    const size_t slot = slotOf(keys_[id].hashCode(), seed, slotCount - 1);
+                    if (slots[slot] >= 0 || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                        found = false;
+                        break;
+                    }
+                    placed.push_back(slot);
+                }
+                if (found) {
+                    seeds[bucket] = seed;
+                    for (size_t i = 0; i < ids.size(); ++i) slots[placed[i]] = ids[i];
+                }
+            }
+            if (!found) return;
+        }
+
+        slots_ = std::move(slots);
+        seeds_ = std::move(seeds);
+    }
+
     std::string name_;
     std::vector<T*> objects_;
-    std::unordered_map<IdType, T*> byId_;
-    std::unordered_map<ResourceLocation, T*, ResourceLocation::Hash> byKey_;
+    std::vector<ResourceLocation> keys_;
     std::unordered_map<ResourceLocation, IdType, ResourceLocation::Hash> keyToId_;
+
+    bool frozen_ = false;
+    std::vector<IdType> slots_;       // Perfect hash table: slot -> ID, -1 when empty
+    std::vector<uint32_t> seeds_;     // Per-bucket displacement seed
 };
 
 /**
@@ -176,7 +266,7 @@ public:
     static Registry<ItemType>& ITEM();
     static Registry<EntityType>& ENTITY_TYPE();
 
-    // Initialize all registries
+    // Freeze all registries once content registration is complete; later lookups use perfect hashing
     static void init();
 
 private:
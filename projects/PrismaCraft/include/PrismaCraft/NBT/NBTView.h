@@ -0,0 +1,513 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include "NBTTag.h"
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace PrismaCraft {
+namespace NBT {
+
+class NbtDocument;
+
+namespace detail {
+
+// NBT is big-endian on disk; decode without alignment requirements
+inline uint16_t loadU16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+inline uint32_t loadU32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+inline uint64_t loadU64(const uint8_t* p) {
+    return (static_cast<uint64_t>(loadU32(p)) << 32) | loadU32(p + 4);
+}
+
+template<typename T>
+T loadBigEndian(const uint8_t* p) {
+    if constexpr (sizeof(T) == 1) {
+        return static_cast<T>(p[0]);
+    } else if constexpr (sizeof(T) == 2) {
+        return static_cast<T>(loadU16(p));
+    } else if constexpr (std::is_same_v<T, float>) {
+        uint32_t bits = loadU32(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    } else if constexpr (std::is_same_v<T, double>) {
+        uint64_t bits = loadU64(p);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    } else if constexpr (sizeof(T) == 4) {
+        return static_cast<T>(loadU32(p));
+    } else {
+        return static_cast<T>(loadU64(p));
+    }
+}
+
+// Payload size of fixed-size tags, 0 for variable-size tags
+constexpr uint32_t fixedPayloadSize(TagType type) {
+    switch (type) {
+        case TagType::BYTE:   return 1;
+        case TagType::SHORT:  return 2;
+        case TagType::INT:    return 4;
+        case TagType::LONG:   return 8;
+        case TagType::FLOAT:  return 4;
+        case TagType::DOUBLE: return 8;
+        default:              return 0;
+    }
+}
+
+} // namespace detail
+
+/**
+ * Lazily decoded view of a BYTE_ARRAY / INT_ARRAY / LONG_ARRAY payload.
+ * Elements are converted from big-endian on access; nothing is copied up front.
+ */
+template<typename T>
+class NbtArrayView {
+public:
+    NbtArrayView() = default;
+    NbtArrayView(const uint8_t* data, uint32_t count) : data(data), count(count) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T operator[](size_t index) const {
+        return detail::loadBigEndian<T>(data + index * sizeof(T));
+    }
+
+    // Decode into caller-provided storage; copies min(size(), out.size()) elements
+    size_t copyTo(std::span<T> out) const {
+        const size_t n = out.size() < count ? out.size() : count;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = detail::loadBigEndian<T>(data + i * sizeof(T));
+        }
+        return n;
+    }
+
+    std::vector<T> toVector() const {
+        std::vector<T> result(count);
+        copyTo(result);
+        return result;
+    }
+
+private:
+    const uint8_t* data = nullptr;
+    uint32_t count = 0;
+};
+
+/**
+ * Read-only view of one tag inside an NbtDocument.
+ *
+ * Views are cheap value types (document pointer + tape position). Looking up a missing
+ * key, indexing past the end, or reading a value of the wrong type yields an invalid
+ * view / default value instead of throwing, mirroring CompoundTag::getInt returning 0
+ * for absent keys.
+ */
+class PRISMACRAFT_API NbtView {
+public:
+    NbtView() = default;
+
+    bool isValid() const { return document != nullptr; }
+    explicit operator bool() const { return isValid(); }
+
+    TagType getId() const { return type; }
+    bool is(TagType t) const { return isValid() && type == t; }
+
+    // Name of this tag within its parent compound; empty for list elements and unnamed roots
+    std::string_view getName() const;
+
+    // Compound access
+    NbtView get(std::string_view key) const;
+    NbtView operator[](std::string_view key) const { return get(key); }
+    NbtView operator[](const char* key) const { return get(key); }
+    bool contains(std::string_view key) const { return get(key).isValid(); }
+
+    // List access
+    NbtView get(size_t index) const;
+    NbtView operator[](size_t index) const { return get(index); }
+    NbtView operator[](int index) const { return get(static_cast<size_t>(index)); }
+    TagType getListType() const;
+
+    // Number of entries for compounds, lists and arrays; 0 otherwise
+    size_t size() const;
+
+    // Numeric values convert from any numeric tag type, like Tag::getAsNumber in Minecraft
+    int8_t getAsByte(int8_t fallback = 0) const { return numeric<int8_t>(fallback); }
+    int16_t getAsShort(int16_t fallback = 0) const { return numeric<int16_t>(fallback); }
+    int32_t getAsInt(int32_t fallback = 0) const { return numeric<int32_t>(fallback); }
+    int64_t getAsLong(int64_t fallback = 0) const { return numeric<int64_t>(fallback); }
+    float getAsFloat(float fallback = 0.0f) const { return numeric<float>(fallback); }
+    double getAsDouble(double fallback = 0.0) const { return numeric<double>(fallback); }
+    bool getAsBoolean() const { return getAsByte() != 0; }
+
+    // Raw (modified UTF-8) bytes of a STRING tag, pointing into the source buffer
+    std::string_view getAsString() const;
+
+    NbtArrayView<int8_t> getAsByteArray() const { return array<int8_t>(TagType::BYTE_ARRAY); }
+    NbtArrayView<int32_t> getAsIntArray() const { return array<int32_t>(TagType::INT_ARRAY); }
+    NbtArrayView<int64_t> getAsLongArray() const { return array<int64_t>(TagType::LONG_ARRAY); }
+
+    // Compound shorthands matching CompoundTag's getters
+    int8_t getByte(std::string_view key) const { return get(key).getAsByte(); }
+    int16_t getShort(std::string_view key) const { return get(key).getAsShort(); }
+    int32_t getInt(std::string_view key) const { return get(key).getAsInt(); }
+    int64_t getLong(std::string_view key) const { return get(key).getAsLong(); }
+    float getFloat(std::string_view key) const { return get(key).getAsFloat(); }
+    double getDouble(std::string_view key) const { return get(key).getAsDouble(); }
+    bool getBoolean(std::string_view key) const { return get(key).getAsBoolean(); }
+    std::string_view getString(std::string_view key) const { return get(key).getAsString(); }
+
+    // Visit children of a compound or list in file order: fn(NbtView child)
+    template<typename Fn>
+    void forEach(Fn&& fn) const;
+
+private:
+    friend class NbtDocument;
+
+    static constexpr uint32_t NO_TAPE = 0xFFFFFFFFu;
+
+    NbtView(const NbtDocument* document, uint32_t tape, uint32_t offset, TagType type)
+        : document(document), tape(tape), offset(offset), type(type) {}
+
+    template<typename T>
+    T numeric(T fallback) const;
+
+    template<typename T>
+    NbtArrayView<T> array(TagType expected) const;
+
+    const NbtDocument* document = nullptr;
+    uint32_t tape = NO_TAPE;     // Tape index; NO_TAPE for elements of primitive lists
+    uint32_t offset = 0;         // Payload offset in the source buffer
+    TagType type = TagType::END;
+};
+
+/**
+ * Zero-copy NBT document
+ * Alternative to NbtReader for read-mostly data such as region chunks.
+ *
+ * parse() walks the buffer once and records a flat tape with one 20-byte entry per tag
+ * (payload offset, name offset, subtree end). Primitive list elements and array contents
+ * get no entries at all; strings and arrays are decoded only when accessed. The tape and
+ * parse stack are reused across parse() calls, so parsing many chunks with one document
+ * performs no allocation once warmed up.
+ *
+ * The source buffer is not copied and must outlive the document and all its views.
+ *
+ * @code
+ * NbtDocument doc;
+ * if (doc.parse(bytes)) {
+ *     NbtView sections = doc.root()["Level"]["Sections"];
+ *     for (size_t i = 0; i < sections.size(); ++i) {
+ *         int8_t y = sections[i].getByte("Y");
+ *         NbtArrayView<int64_t> states = sections[i]["BlockStates"].getAsLongArray();
+ *     }
+ * }
+ * @endcode
+ */
+class PRISMACRAFT_API NbtDocument {
+public:
+    static constexpr int MAX_DEPTH = 512;
+
+    /**
+     * Parse a complete NBT payload
+     * @param namedRoot true for the file format (type byte + name + payload),
+     *                  false for the nameless root used by network NBT
+     * @return false on malformed or truncated input; see getError()
+     */
+    bool parse(std::span<const uint8_t> data, bool namedRoot = true);
+
+    NbtView root() const {
+        if (tape.empty()) return NbtView();
+        return NbtView(this, 0, tape[0].offset, tape[0].type);
+    }
+
+    const std::string& getError() const { return error; }
+    size_t getTapeSize() const { return tape.size(); }
+    std::span<const uint8_t> getBuffer() const { return buffer; }
+
+    void clear() {
+        buffer = {};
+        tape.clear();
+        error.clear();
+    }
+
+private:
+    friend class NbtView;
+
+    static constexpr uint32_t NO_NAME = 0xFFFFFFFFu;
+
+    struct TapeEntry {
+        uint32_t offset;        // Payload offset
+        uint32_t nameOffset;    // Offset of the u16 name length, NO_NAME if unnamed
+        uint32_t next;          // Tape index just past this subtree
+        uint32_t count;         // Children of compounds
+        TagType type;
+    };
+
+    struct Frame {
+        uint32_t tape;
+        TagType elementType;    // END for compounds
+        int32_t remaining;      // Elements left for lists
+    };
+
+    bool fail(const char* message, size_t at) {
+        error = std::string(message) + " at offset " + std::to_string(at);
+        tape.clear();
+        return false;
+    }
+
+    bool pushTag(TagType type, uint32_t nameOffset, size_t& pos);
+
+    std::span<const uint8_t> buffer;
+    std::vector<TapeEntry> tape;
+    std::vector<Frame> stack;
+    std::string error;
+};
+
+// ========== NbtDocument ==========
+
+inline bool NbtDocument::pushTag(TagType type, uint32_t nameOffset, size_t& pos) {
+    const size_t size = buffer.size();
+    const uint8_t* data = buffer.data();
+    const uint32_t index = static_cast<uint32_t>(tape.size());
+    tape.push_back({ static_cast<uint32_t>(pos), nameOffset, index + 1, 0, type });
+
+    switch (type) {
+        case TagType::BYTE:
+        case TagType::SHORT:
+        case TagType::INT:
+        case TagType::LONG:
+        case TagType::FLOAT:
+        case TagType::DOUBLE: {
+            const uint32_t bytes = detail::fixedPayloadSize(type);
+            if (size - pos < bytes) return fail("Truncated value", pos);
+            pos += bytes;
+            return true;
+        }
+        case TagType::STRING: {
+            if (size - pos < 2) return fail("Truncated string length", pos);
+            const size_t length = detail::loadU16(data + pos);
+            if (size - pos - 2 < length) return fail("Truncated string", pos);
+            pos += 2 + length;
+            return true;
+        }
+        case TagType::BYTE_ARRAY:
+        case TagType::INT_ARRAY:
+        case TagType::LONG_ARRAY: {
+            if (size - pos < 4) return fail("Truncated array length", pos);
+            const int32_t length = static_cast<int32_t>(detail::loadU32(data + pos));
+            const size_t element = type == TagType::BYTE_ARRAY ? 1 : type == TagType::INT_ARRAY ? 4 : 8;
+            if (length < 0 || (size - pos - 4) / element < static_cast<size_t>(length)) {
+                return fail("Truncated array", pos);
+            }
+            pos += 4 + static_cast<size_t>(length) * element;
+            return true;
+        }
+        case TagType::LIST: {
+            if (size - pos < 5) return fail("Truncated list header", pos);
+            const TagType elementType = static_cast<TagType>(data[pos]);
+            const int32_t length = static_cast<int32_t>(detail::loadU32(data + pos + 1));
+            if (elementType < TagType::END || elementType > TagType::LONG_ARRAY) return fail("Invalid list type", pos);
+            if (length < 0) return fail("Negative list length", pos);
+            pos += 5;
+            if (length == 0) return true;
+            if (elementType == TagType::END) return fail("Non-empty list of END", pos);
+            // Fixed-size elements are addressed arithmetically and get no tape entries
+            if (const uint32_t element = detail::fixedPayloadSize(elementType)) {
+                if ((size - pos) / element < static_cast<size_t>(length)) return fail("Truncated list", pos);
+                pos += static_cast<size_t>(length) * element;
+                return true;
+            }
+            if (stack.size() >= MAX_DEPTH) return fail("NBT nested too deeply", pos);
+            stack.push_back({ index, elementType, length });
+            return true;
+        }
+        case TagType::COMPOUND:
+            if (stack.size() >= MAX_DEPTH) return fail("NBT nested too deeply", pos);
+            stack.push_back({ index, TagType::END, 0 });
+            return true;
+        default:
+            return fail("Invalid tag type", pos);
+    }
+}
+
+inline bool NbtDocument::parse(std::span<const uint8_t> data, bool namedRoot) {
+    buffer = data;
+    tape.clear();
+    stack.clear();
+    error.clear();
+
+    const size_t size = data.size();
+    size_t pos = 0;
+    if (size < 1) return fail("Empty buffer", 0);
+
+    const TagType rootType = static_cast<TagType>(data[pos++]);
+    if (rootType == TagType::END) return true;
+
+    uint32_t rootName = NO_NAME;
+    if (namedRoot) {
+        if (size - pos < 2) return fail("Truncated root name", pos);
+        const size_t length = detail::loadU16(data.data() + pos);
+        if (size - pos - 2 < length) return fail("Truncated root name", pos);
+        rootName = static_cast<uint32_t>(pos);
+        pos += 2 + length;
+    }
+    if (!pushTag(rootType, rootName, pos)) return false;
+
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        if (frame.elementType == TagType::END) {
+            // Compound: (type, name, payload)* terminated by END
+            if (pos >= size) return fail("Unterminated compound", pos);
+            const TagType childType = static_cast<TagType>(data[pos++]);
+            if (childType == TagType::END) {
+                tape[frame.tape].next = static_cast<uint32_t>(tape.size());
+                stack.pop_back();
+                continue;
+            }
+            if (size - pos < 2) return fail("Truncated tag name", pos);
+            const size_t length = detail::loadU16(data.data() + pos);
+            if (size - pos - 2 < length) return fail("Truncated tag name", pos);
+            const uint32_t nameOffset = static_cast<uint32_t>(pos);
+            pos += 2 + length;
+            ++tape[frame.tape].count;
+            if (!pushTag(childType, nameOffset, pos)) return false;
+        } else {
+            if (frame.remaining == 0) {
+                tape[frame.tape].next = static_cast<uint32_t>(tape.size());
+                stack.pop_back();
+                continue;
+            }
+            --frame.remaining;
+            // pushTag may grow the stack and invalidate frame
+            if (!pushTag(frame.elementType, NO_NAME, pos)) return false;
+        }
+    }
+    return true;
+}
+
+// ========== NbtView ==========
+
+inline std::string_view NbtView::getName() const {
+    if (!isValid() || tape == NO_TAPE) return {};
+    const uint32_t nameOffset = document->tape[tape].nameOffset;
+    if (nameOffset == NbtDocument::NO_NAME) return {};
+    const uint8_t* p = document->buffer.data() + nameOffset;
+    return std::string_view(reinterpret_cast<const char*>(p + 2), detail::loadU16(p));
+}
+
+inline NbtView NbtView::get(std::string_view key) const {
+    if (!is(TagType::COMPOUND)) return NbtView();
+    const auto& entries = document->tape;
+    const uint8_t* data = document->buffer.data();
+    const uint32_t end = entries[tape].next;
+    for (uint32_t i = tape + 1; i < end; i = entries[i].next) {
+        const uint8_t* name = data + entries[i].nameOffset;
+        const uint16_t length = detail::loadU16(name);
+        if (length == key.size() && std::memcmp(name + 2, key.data(), length) == 0) {
+            return NbtView(document, i, entries[i].offset, entries[i].type);
+        }
+    }
+    return NbtView();
+}
+
+inline TagType NbtView::getListType() const {
+    if (!is(TagType::LIST)) return TagType::END;
+    return static_cast<TagType>(document->buffer[offset]);
+}
+
+inline NbtView NbtView::get(size_t index) const {
+    if (!is(TagType::LIST) || index >= size()) return NbtView();
+    const TagType elementType = getListType();
+    if (const uint32_t element = detail::fixedPayloadSize(elementType)) {
+        return NbtView(document, NO_TAPE, offset + 5 + static_cast<uint32_t>(index) * element, elementType);
+    }
+    const auto& entries = document->tape;
+    uint32_t i = tape + 1;
+    for (size_t n = 0; n < index; ++n) i = entries[i].next;
+    return NbtView(document, i, entries[i].offset, entries[i].type);
+}
+
+inline size_t NbtView::size() const {
+    if (!isValid()) return 0;
+    const uint8_t* data = document->buffer.data();
+    switch (type) {
+        case TagType::COMPOUND:
+            return document->tape[tape].count;
+        case TagType::LIST:
+            return detail::loadU32(data + offset + 1);
+        case TagType::BYTE_ARRAY:
+        case TagType::INT_ARRAY:
+        case TagType::LONG_ARRAY:
+            return detail::loadU32(data + offset);
+        default:
+            return 0;
+    }
+}
+
+inline std::string_view NbtView::getAsString() const {
+    if (!is(TagType::STRING)) return {};
+    const uint8_t* p = document->buffer.data() + offset;
+    return std::string_view(reinterpret_cast<const char*>(p + 2), detail::loadU16(p));
+}
+
+template<typename T>
+T NbtView::numeric(T fallback) const {
+    if (!isValid()) return fallback;
+    const uint8_t* p = document->buffer.data() + offset;
+    switch (type) {
+        case TagType::BYTE:   return static_cast<T>(detail::loadBigEndian<int8_t>(p));
+        case TagType::SHORT:  return static_cast<T>(detail::loadBigEndian<int16_t>(p));
+        case TagType::INT:    return static_cast<T>(detail::loadBigEndian<int32_t>(p));
+        case TagType::LONG:   return static_cast<T>(detail::loadBigEndian<int64_t>(p));
+        case TagType::FLOAT:  return static_cast<T>(detail::loadBigEndian<float>(p));
+        case TagType::DOUBLE: return static_cast<T>(detail::loadBigEndian<double>(p));
+        default:              return fallback;
+    }
+}
+
+template<typename T>
+NbtArrayView<T> NbtView::array(TagType expected) const {
+    if (!is(expected)) return NbtArrayView<T>();
+    const uint8_t* p = document->buffer.data() + offset;
+    return NbtArrayView<T>(p + 4, detail::loadU32(p));
+}
+
+template<typename Fn>
+void NbtView::forEach(Fn&& fn) const {
+    if (is(TagType::COMPOUND)) {
+        const auto& entries = document->tape;
+        const uint32_t end = entries[tape].next;
+        for (uint32_t i = tape + 1; i < end; i = entries[i].next) {
+            fn(NbtView(document, i, entries[i].offset, entries[i].type));
+        }
+    } else if (is(TagType::LIST)) {
+        const size_t count = size();
+        if (count == 0) return;
+        const TagType elementType = getListType();
+        if (const uint32_t element = detail::fixedPayloadSize(elementType)) {
+            for (size_t n = 0; n < count; ++n) {
+                fn(NbtView(document, NO_TAPE, offset + 5 + static_cast<uint32_t>(n) * element, elementType));
+            }
+        } else {
+            const auto& entries = document->tape;
+            for (uint32_t i = tape + 1, n = 0; n < count; i = entries[i].next, ++n) {
+                fn(NbtView(document, i, entries[i].offset, entries[i].type));
+            }
+        }
+    }
+}
+
+} // namespace NBT
+} // namespace PrismaCraft
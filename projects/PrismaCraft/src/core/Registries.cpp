@@ -0,0 +1,35 @@
+#include <PrismaCraft/Core/Registry.h>
+#include <PrismaCraft/Core/BlockStateRegistry.h>
+
+namespace PrismaCraft {
+
+bool Registries::initialized_ = false;
+
+Registry<Block>& Registries::BLOCK() {
+    static Registry<Block> registry("block");
+    return registry;
+}
+
+Registry<ItemType>& Registries::ITEM() {
+    static Registry<ItemType> registry("item");
+    return registry;
+}
+
+Registry<EntityType>& Registries::ENTITY_TYPE() {
+    static Registry<EntityType> registry("entity_type");
+    return registry;
+}
+
+void Registries::init() {
+    if (initialized_) return;
+    initialized_ = true;
+
+    // Content (Blocks::init() etc.) is registered by the bootstrap before this point
+    BLOCK().freeze();
+    ITEM().freeze();
+    ENTITY_TYPE().freeze();
+
+    BlockStateRegistry::instance().build(BLOCK().getObjects());
+}
+
+} // namespace PrismaCraft
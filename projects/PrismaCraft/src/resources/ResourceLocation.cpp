@@ -0,0 +1,112 @@
+#include <PrismaCraft/Core/Registry.h>
+#include <cctype>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+
+namespace PrismaCraft {
+
+namespace {
+
+struct SymbolStorage {
+    std::shared_mutex mutex;
+    // Keys view the text owned by the (address-stable) Symbol
+    std::unordered_map<std::string_view, std::unique_ptr<Symbol>> symbols;
+};
+
+SymbolStorage& getStorage() {
+    static SymbolStorage storage;
+    return storage;
+}
+
+} // namespace
+
+// ========== SymbolTable ==========
+
+const Symbol* SymbolTable::intern(std::string_view text) {
+    SymbolStorage& storage = getStorage();
+    {
+        std::shared_lock<std::shared_mutex> lock(storage.mutex);
+        auto it = storage.symbols.find(text);
+        if (it != storage.symbols.end()) return it->second.get();
+    }
+
+    std::unique_lock<std::shared_mutex> lock(storage.mutex);
+    auto it = storage.symbols.find(text);
+    if (it != storage.symbols.end()) return it->second.get();
+
+    auto symbol = std::make_unique<Symbol>(Symbol{ std::string(text), std::hash<std::string_view>{}(text) });
+    const Symbol* result = symbol.get();
+    storage.symbols.emplace(std::string_view(result->text), std::move(symbol));
+    return result;
+}
+
+const Symbol* SymbolTable::find(std::string_view text) {
+    SymbolStorage& storage = getStorage();
+    std::shared_lock<std::shared_mutex> lock(storage.mutex);
+    auto it = storage.symbols.find(text);
+    return it != storage.symbols.end() ? it->second.get() : nullptr;
+}
+
+const Symbol* SymbolTable::empty() {
+    static const Symbol* emptySymbol = intern("");
+    return emptySymbol;
+}
+
+size_t SymbolTable::size() {
+    SymbolStorage& storage = getStorage();
+    std::shared_lock<std::shared_mutex> lock(storage.mutex);
+    return storage.symbols.size();
+}
+
+// ========== ResourceLocation ==========
+
+const std::string ResourceLocation::DEFAULT_NAMESPACE = "minecraft";
+
+ResourceLocation::ResourceLocation(std::string_view namespace_, std::string_view path) {
+    if (!isValidNamespace(namespace_)) {
+        throw std::invalid_argument("Invalid namespace: " + std::string(namespace_));
+    }
+    if (!isValidPath(path)) {
+        throw std::invalid_argument("Invalid path: " + std::string(path));
+    }
+    this->namespace_ = SymbolTable::intern(namespace_);
+    this->path = SymbolTable::intern(path);
+    hash = combineHash(this->namespace_, this->path);
+}
+
+ResourceLocation::ResourceLocation(std::string_view combined) {
+    static const Symbol* defaultNamespace = SymbolTable::intern(DEFAULT_NAMESPACE);
+
+    const size_t colon = combined.find(':');
+    const std::string_view ns = colon == std::string_view::npos ? std::string_view() : combined.substr(0, colon);
+    const std::string_view p = colon == std::string_view::npos ? combined : combined.substr(colon + 1);
+    if ((colon != std::string_view::npos && !isValidNamespace(ns)) || !isValidPath(p)) {
+        throw std::invalid_argument("Invalid resource location: " + std::string(combined));
+    }
+    namespace_ = colon == std::string_view::npos ? defaultNamespace : SymbolTable::intern(ns);
+    path = SymbolTable::intern(p);
+    hash = combineHash(namespace_, path);
+}
+
+bool ResourceLocation::isValidNamespace(std::string_view ns) {
+    if (ns.empty()) return false;
+    for (char c : ns) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-' && c != '.') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResourceLocation::isValidPath(std::string_view p) {
+    if (p.empty()) return false;
+    for (char c : p) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-' && c != '.' && c != '/') {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace PrismaCraft
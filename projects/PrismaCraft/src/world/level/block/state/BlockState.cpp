@@ -0,0 +1,154 @@
+#include <PrismaCraft/Core/BlockStateRegistry.h>
+#include <algorithm>
+#include <charconv>
+
+namespace PrismaCraft {
+
+// ========== Properties ==========
+
+BooleanProperty* BooleanProperty::create(const std::string& name) {
+    return new BooleanProperty(name);
+}
+
+IntegerProperty* IntegerProperty::create(const std::string& name, int min, int max) {
+    if (min < 0 || max <= min) {
+        throw std::invalid_argument("Invalid range for property " + name);
+    }
+    return new IntegerProperty(name, min, max);
+}
+
+std::vector<std::string> IntegerProperty::getPossibleValues() const {
+    std::vector<std::string> values;
+    values.reserve(getValueCount());
+    for (int value = minValue; value <= maxValue; ++value) {
+        values.push_back(std::to_string(value));
+    }
+    return values;
+}
+
+size_t IntegerProperty::getValueIndex(const std::string& value) const {
+    int parsed = 0;
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+    if (error != std::errc() || end != value.data() + value.size() || parsed < minValue || parsed > maxValue) {
+        return INVALID_VALUE;
+    }
+    return static_cast<size_t>(parsed - minValue);
+}
+
+EnumProperty* EnumProperty::create(const std::string& name, const std::vector<std::string>& values) {
+    if (values.empty()) {
+        throw std::invalid_argument("Enum property " + name + " has no values");
+    }
+    return new EnumProperty(name, values);
+}
+
+size_t EnumProperty::getValueIndex(const std::string& value) const {
+    auto it = std::find(values.begin(), values.end(), value);
+    return it != values.end() ? static_cast<size_t>(it - values.begin()) : INVALID_VALUE;
+}
+
+// ========== Block ==========
+
+const BlockState& Block::defaultBlockState() const {
+    const BlockStateRegistry& registry = BlockStateRegistry::instance();
+    if (!registry.isBuilt()) {
+        throw std::logic_error("Block states requested before BlockStateRegistry::build(): " + getName());
+    }
+    return registry.byId(defaultStateId);
+}
+
+// ========== BlockState ==========
+
+namespace {
+
+BlockStateRegistry::StateId toId(size_t stateId) {
+    return static_cast<BlockStateRegistry::StateId>(stateId);
+}
+
+[[noreturn]] void throwMissingProperty(const BlockState& state, const BlockProperty& property) {
+    throw std::invalid_argument("Cannot get property " + property.getName() + " as it does not exist in " +
+                                state.getBlock().getName());
+}
+
+} // namespace
+
+size_t BlockState::getValueIndex(const BlockProperty& property) const {
+    const BlockStateRegistry& registry = BlockStateRegistry::instance();
+    const int slot = registry.getPropertySlot(toId(stateId), property);
+    return slot >= 0 ? registry.getValueIndex(toId(stateId), slot) : BlockProperty::INVALID_VALUE;
+}
+
+bool BlockState::hasProperty(const BlockProperty& property) const {
+    return BlockStateRegistry::instance().getPropertySlot(toId(stateId), property) >= 0;
+}
+
+std::string BlockState::getValue(const BlockProperty& property) const {
+    const size_t index = getValueIndex(property);
+    if (index == BlockProperty::INVALID_VALUE) throwMissingProperty(*this, property);
+    return property.getValueName(index);
+}
+
+bool BlockState::isAir() const {
+    return BlockStateRegistry::instance().isAir(toId(stateId));
+}
+
+bool BlockState::getBoolean(const BooleanProperty& property) const {
+    const size_t index = getValueIndex(property);
+    if (index == BlockProperty::INVALID_VALUE) throwMissingProperty(*this, property);
+    return index == 0;
+}
+
+int BlockState::getInteger(const IntegerProperty& property) const {
+    const size_t index = getValueIndex(property);
+    if (index == BlockProperty::INVALID_VALUE) throwMissingProperty(*this, property);
+    return property.getMin() + static_cast<int>(index);
+}
+
+std::string BlockState::getEnum(const EnumProperty& property) const {
+    return getValue(property);
+}
+
+std::map<std::string, std::string> BlockState::getValues() const {
+    const BlockStateRegistry& registry = BlockStateRegistry::instance();
+    const auto& properties = registry.getProperties(toId(stateId));
+
+    std::map<std::string, std::string> values;
+    for (size_t slot = 0; slot < properties.size(); ++slot) {
+        const size_t index = registry.getValueIndex(toId(stateId), static_cast<int>(slot));
+        values.emplace(properties[slot]->getName(), properties[slot]->getValueName(index));
+    }
+    return values;
+}
+
+const BlockState& BlockState::with(const BlockProperty& property, size_t valueIndex) const {
+    const BlockStateRegistry& registry = BlockStateRegistry::instance();
+    const BlockStateRegistry::StateId next = registry.with(toId(stateId), property, valueIndex);
+    return next != BlockStateRegistry::INVALID_STATE ? registry.byId(next) : *this;
+}
+
+const BlockState& BlockState::setValue(const BooleanProperty& property, bool value) const {
+    return with(property, value ? 0 : 1);
+}
+
+const BlockState& BlockState::setValue(const IntegerProperty& property, int value) const {
+    if (value < property.getMin() || value > property.getMax()) return *this;
+    return with(property, static_cast<size_t>(value - property.getMin()));
+}
+
+bool BlockState::canOcclude() const {
+    return BlockStateRegistry::instance().canOcclude(toId(stateId));
+}
+
+bool BlockState::isCollisionShapeFullBlock() const {
+    return BlockStateRegistry::instance().isCollisionShapeFullBlock(toId(stateId));
+}
+
+int BlockState::getLightEmission() const {
+    return BlockStateRegistry::instance().getLightEmission(toId(stateId));
+}
+
+int BlockState::getLightBlock() const {
+    return BlockStateRegistry::instance().getLightBlock(toId(stateId));
+}
+
+} // namespace PrismaCraft
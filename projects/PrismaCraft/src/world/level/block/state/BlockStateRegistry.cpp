@@ -0,0 +1,132 @@
+#include <PrismaCraft/Core/BlockStateRegistry.h>
+#include <algorithm>
+
+namespace PrismaCraft {
+
+BlockStateRegistry& BlockStateRegistry::instance() {
+    static BlockStateRegistry registry;
+    return registry;
+}
+
+void BlockStateRegistry::build(const std::vector<Block*>& blockList) {
+    *this = BlockStateRegistry();
+    blocks.reserve(blockList.size());
+
+    for (Block* block : blockList) {
+        if (!block) continue;
+
+        BlockInfo info;
+        info.block = block;
+        info.properties = block->getStateProperties();
+        info.firstState = static_cast<StateId>(states.size());
+
+        // Mixed-radix state numbering: the last property varies fastest
+        const size_t propertyCount = info.properties.size();
+        std::vector<uint32_t> strides(propertyCount);
+        uint64_t stateCount = 1;
+        for (size_t slot = propertyCount; slot-- > 0;) {
+            const size_t count = info.properties[slot]->getValueCount();
+            if (count == 0 || count > MAX_PROPERTY_VALUES) {
+                throw std::invalid_argument("Property " + info.properties[slot]->getName() + " of " +
+                                            block->getName() + " has an unsupported number of values");
+            }
+            strides[slot] = static_cast<uint32_t>(stateCount);
+            stateCount *= count;
+        }
+        if (info.firstState + stateCount >= INVALID_STATE) {
+            throw std::length_error("Too many block states");
+        }
+        info.stateCount = static_cast<uint32_t>(stateCount);
+
+        info.valueCounts.resize(propertyCount);
+        info.valueOffsets.resize(propertyCount);
+        for (size_t slot = 0; slot < propertyCount; ++slot) {
+            info.valueCounts[slot] = static_cast<uint32_t>(info.properties[slot]->getValueCount());
+            info.valueOffsets[slot] = info.rowSize;
+            info.rowSize += info.valueCounts[slot];
+        }
+
+        StateId defaultLocal = 0;
+        for (size_t slot = 0; slot < propertyCount; ++slot) {
+            const size_t value = block->getDefaultValueIndex(*info.properties[slot]);
+            defaultLocal += static_cast<StateId>(std::min<size_t>(value, info.valueCounts[slot] - 1)) * strides[slot];
+        }
+
+        const uint32_t blockIndex = static_cast<uint32_t>(blocks.size());
+        std::vector<uint32_t> digits(propertyCount);
+        for (StateId local = 0; local < info.stateCount; ++local) {
+            const StateId id = info.firstState + local;
+            states.push_back(std::make_unique<BlockState>(*block, id));
+            stateBlock.push_back(blockIndex);
+
+            valueOffsets.push_back(static_cast<uint32_t>(valueIndices.size()));
+            for (size_t slot = 0; slot < propertyCount; ++slot) {
+                digits[slot] = (local / strides[slot]) % info.valueCounts[slot];
+                valueIndices.push_back(static_cast<uint8_t>(digits[slot]));
+            }
+
+            transitionOffsets.push_back(static_cast<uint32_t>(transitions.size()));
+            for (size_t slot = 0; slot < propertyCount; ++slot) {
+                const StateId base = id - digits[slot] * strides[slot];
+                for (uint32_t value = 0; value < info.valueCounts[slot]; ++value) {
+                    transitions.push_back(base + value * strides[slot]);
+                }
+            }
+        }
+
+        block->firstStateId = info.firstState;
+        block->defaultStateId = info.firstState + defaultLocal;
+        block->stateCount = info.stateCount;
+        blocks.push_back(std::move(info));
+    }
+
+    // Value lookups work from here on, so blocks may inspect their state while being classified
+    built = true;
+
+    const size_t count = states.size();
+    flags.resize(count);
+    lightEmission.resize(count);
+    lightBlock.resize(count);
+    shapeIndex.resize(count);
+    for (size_t id = 0; id < count; ++id) {
+        const BlockState& state = *states[id];
+        const Block& block = state.getBlock();
+
+        const int emission = std::clamp(block.getLightEmission(state), 0, 15);
+        const int opacity = std::clamp(block.getLightBlock(state), 0, 15);
+        uint16_t stateFlags = 0;
+        if (block.isAir(state)) stateFlags |= AIR;
+        if (block.isSolid(state)) stateFlags |= SOLID;
+        if (block.canOcclude(state)) stateFlags |= CAN_OCCLUDE;
+        if (block.isCollisionShapeFullBlock(state)) stateFlags |= FULL_CUBE;
+        if (emission > 0) stateFlags |= EMITS_LIGHT;
+        if (opacity > 0) stateFlags |= BLOCKS_LIGHT;
+        if (opacity == 15) stateFlags |= FULLY_BLOCKS_LIGHT;
+        if (block.isRandomlyTicking(state)) stateFlags |= RANDOM_TICKS;
+
+        flags[id] = stateFlags;
+        lightEmission[id] = static_cast<uint8_t>(emission);
+        lightBlock[id] = static_cast<uint8_t>(opacity);
+        shapeIndex[id] = block.getCollisionShapeIndex(state);
+    }
+}
+
+BlockStateRegistry::StateId BlockStateRegistry::getDefaultState(const Block& block) const {
+    return block.defaultStateId;
+}
+
+int BlockStateRegistry::getPropertySlot(StateId id, const BlockProperty& property) const {
+    const auto& properties = blocks[stateBlock[id]].properties;
+    for (size_t slot = 0; slot < properties.size(); ++slot) {
+        if (properties[slot] == &property) return static_cast<int>(slot);
+    }
+    return -1;
+}
+
+BlockStateRegistry::StateId BlockStateRegistry::with(StateId id, const BlockProperty& property, size_t valueIndex) const {
+    const int slot = getPropertySlot(id, property);
+    if (slot < 0 || valueIndex >= blocks[stateBlock[id]].valueCounts[slot]) return INVALID_STATE;
+    return with(id, slot, valueIndex);
+}
+
+} // namespace PrismaCraft
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace PrismaCraft {
+
+/**
+ * 4-bit light values for a 16x16x16 section
+ * Corresponds to: net.minecraft.world.level.chunk.DataLayer
+ *
+ * Uniform layers (fully dark, or fully lit sky above the terrain) store a single value and
+ * allocate the 2048-byte nibble array only on the first write that differs from it.
+ */
+class PRISMACRAFT_API DataLayer {
+public:
+    static constexpr int SIZE = 2048;
+
+    explicit DataLayer(uint8_t fillValue = 0) : fill(fillValue & 0xF) {}
+
+    DataLayer(const DataLayer& other) : fill(other.fill) {
+        if (other.data) {
+            data = std::make_unique<uint8_t[]>(SIZE);
+            std::memcpy(data.get(), other.data.get(), SIZE);
+        }
+    }
+
+    static int getIndex(int x, int y, int z) {
+        return y << 8 | z << 4 | x;
+    }
+
+    int get(int x, int y, int z) const { return get(getIndex(x, y, z)); }
+    void set(int x, int y, int z, int value) { set(getIndex(x, y, z), value); }
+
+    int get(int index) const {
+        return data ? (data[index >> 1] >> ((index & 1) << 2)) & 0xF : fill;
+    }
+
+    void set(int index, int value) {
+        if (!data) {
+            if (value == fill) return;
+            data = std::make_unique<uint8_t[]>(SIZE);
+            std::memset(data.get(), fill | (fill << 4), SIZE);
+        }
+        const int shift = (index & 1) << 2;
+        uint8_t& byte = data[index >> 1];
+        byte = static_cast<uint8_t>((byte & ~(0xF << shift)) | ((value & 0xF) << shift));
+    }
+
+    // Drop any nibble array and make every value equal to value
+    void fillWith(int value) {
+        data.reset();
+        fill = static_cast<uint8_t>(value & 0xF);
+    }
+
+    bool isUniform() const { return !data; }
+    int getUniformValue() const { return fill; }
+
+    // Nibble array in vanilla layout (even index in the low nibble); nullptr while uniform
+    const uint8_t* getData() const { return data.get(); }
+
+    void copyTo(uint8_t* out) const {
+        if (data) {
+            std::memcpy(out, data.get(), SIZE);
+        } else {
+            std::memset(out, fill | (fill << 4), SIZE);
+        }
+    }
+
+private:
+    std::unique_ptr<uint8_t[]> data;
+    uint8_t fill;
+};
+
+} // namespace PrismaCraft
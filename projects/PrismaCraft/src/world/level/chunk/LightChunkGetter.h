@@ -0,0 +1,31 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include <cstdint>
+
+namespace PrismaCraft {
+
+/**
+ * Block data source for the light engine
+ * Corresponds to: net.minecraft.world.level.chunk.LightChunkGetter
+ */
+class PRISMACRAFT_API LightChunkGetter {
+public:
+    virtual ~LightChunkGetter() = default;
+
+    // Section Y range of the level, inclusive
+    virtual int getMinSection() const = 0;
+    virtual int getMaxSection() const = 0;
+
+    /**
+     * Global block state IDs (BlockStateRegistry) of a section, indexed y << 8 | z << 4 | x.
+     * nullptr when the section is entirely air. Must stay valid and unchanged while
+     * LevelLightEngine::runLightUpdates() is running.
+     */
+    virtual const uint32_t* getSectionStates(int sectionX, int sectionY, int sectionZ) const = 0;
+
+protected:
+    LightChunkGetter() = default;
+};
+
+} // namespace PrismaCraft
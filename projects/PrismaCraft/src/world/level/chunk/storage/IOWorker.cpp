@@ -0,0 +1,223 @@
+#include "IOWorker.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace PrismaCraft {
+
+IOWorker::IOWorker(const std::filesystem::path& folder, RegionCompression compression, size_t ioThreads, bool syncWrites) {
+    if (!ChunkCompression::isSupported(compression)) {
+        LOG_WARNING("ChunkIO", "区块压缩类型 {0} 不可用, 改用 LZ4", static_cast<int>(compression));
+        compression = RegionCompression::LZ4;
+    }
+
+    ioThreads = std::max<size_t>(ioThreads, 1);
+    workers.reserve(ioThreads);
+    for (size_t i = 0; i < ioThreads; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->storage = std::make_unique<RegionFileStorage>(folder, compression, syncWrites);
+        workers.push_back(std::move(worker));
+    }
+    for (auto& worker : workers) {
+        Worker* w = worker.get();
+        w->thread = std::thread([this, w] { run(*w); });
+    }
+}
+
+IOWorker::~IOWorker() {
+    close();
+}
+
+IOWorker::Worker& IOWorker::getWorker(const ChunkPos& pos) {
+    const uint64_t key = static_cast<uint64_t>(RegionFileStorage::getRegionKey(pos));
+    const uint64_t hash = (key * 0x9E3779B97F4A7C15ull) >> 32;
+    return *workers[hash % workers.size()];
+}
+
+std::future<IOWorker::LoadResult> IOWorker::loadAsync(const ChunkPos& pos) {
+    std::promise<LoadResult> promise;
+    std::future<LoadResult> future = promise.get_future();
+    if (closed) {
+        promise.set_value(std::nullopt);
+        return future;
+    }
+
+    ++loads;
+    Worker& worker = getWorker(pos);
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        auto it = worker.pendingStores.find(ChunkPos::asLong(pos.x, pos.z));
+        if (it != worker.pendingStores.end()) {
+            // Read-your-writes: the pending store is newer than anything on disk
+            ++loadsFromPending;
+            const auto& data = it->second.second;
+            promise.set_value(data.empty() ? LoadResult{} : LoadResult{ data });
+            return future;
+        }
+        worker.loads.push_back(LoadRequest{ pos, std::move(promise) });
+    }
+    worker.condition.notify_one();
+    return future;
+}
+
+void IOWorker::store(const ChunkPos& pos, std::vector<uint8_t> data) {
+    if (closed) {
+        LOG_WARNING("ChunkIO", "IOWorker 已关闭, 丢弃区块 {0} 的写入", pos.toString());
+        return;
+    }
+
+    ++stores;
+    Worker& worker = getWorker(pos);
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.pendingStores.empty()) {
+            worker.oldestPending = std::chrono::steady_clock::now();
+            wake = true;
+        }
+        auto [it, inserted] = worker.pendingStores.try_emplace(ChunkPos::asLong(pos.x, pos.z), pos, std::vector<uint8_t>{});
+        if (!inserted) ++coalescedStores;
+        it->second.second = std::move(data);
+        wake = wake || worker.pendingStores.size() >= BATCH_SIZE;
+    }
+    if (wake) worker.condition.notify_one();
+}
+
+void IOWorker::erase(const ChunkPos& pos) {
+    store(pos, {});
+}
+
+std::future<void> IOWorker::flush() {
+    auto state = std::make_shared<FlushState>();
+    std::future<void> future = state->promise.get_future();
+    if (closed) {
+        state->promise.set_value();
+        return future;
+    }
+
+    state->remaining = workers.size();
+    for (auto& worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->flushes.push_back(state);
+        }
+        worker->condition.notify_one();
+    }
+    return future;
+}
+
+void IOWorker::close() {
+    if (closed.exchange(true)) return;
+
+    for (auto& worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->stopping = true;
+        }
+        worker->condition.notify_one();
+    }
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+        worker->storage->close();
+    }
+}
+
+IOWorker::Stats IOWorker::getStats() const {
+    Stats stats;
+    stats.loads = loads;
+    stats.loadsFromPending = loadsFromPending;
+    stats.stores = stores;
+    stats.coalescedStores = coalescedStores;
+    stats.chunkWrites = chunkWrites;
+    stats.batches = batches;
+    stats.failedWrites = failedWrites;
+    return stats;
+}
+
+void IOWorker::completeFlush(const std::shared_ptr<FlushState>& flush) {
+    if (flush->remaining.fetch_sub(1) == 1) {
+        flush->promise.set_value();
+    }
+}
+
+void IOWorker::run(Worker& worker) {
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    while (true) {
+        auto urgent = [&] {
+            return worker.stopping || !worker.loads.empty() || !worker.flushes.empty() ||
+                   worker.pendingStores.size() >= BATCH_SIZE;
+        };
+        if (worker.pendingStores.empty()) {
+            worker.condition.wait(lock, [&] { return urgent() || !worker.pendingStores.empty(); });
+        } else {
+            worker.condition.wait_until(lock, worker.oldestPending + BATCH_DELAY, urgent);
+        }
+
+        // Loads first so that gameplay never waits behind a write batch
+        if (!worker.loads.empty()) {
+            LoadRequest request = std::move(worker.loads.front());
+            worker.loads.pop_front();
+            lock.unlock();
+            request.promise.set_value(worker.storage->read(request.pos));
+            lock.lock();
+            continue;
+        }
+
+        const bool due = worker.stopping || !worker.flushes.empty() || worker.pendingStores.size() >= BATCH_SIZE ||
+                         std::chrono::steady_clock::now() >= worker.oldestPending + BATCH_DELAY;
+        if (!worker.pendingStores.empty() && due) {
+            auto pending = std::move(worker.pendingStores);
+            worker.pendingStores.clear();
+            auto flushes = std::move(worker.flushes);
+            worker.flushes.clear();
+            lock.unlock();
+            writePending(worker, pending);
+            for (const auto& flush : flushes) completeFlush(flush);
+            lock.lock();
+            continue;
+        }
+
+        if (!worker.flushes.empty()) {
+            auto flushes = std::move(worker.flushes);
+            worker.flushes.clear();
+            lock.unlock();
+            for (const auto& flush : flushes) completeFlush(flush);
+            lock.lock();
+            continue;
+        }
+
+        if (worker.stopping && worker.pendingStores.empty()) break;
+    }
+}
+
+void IOWorker::writePending(Worker& worker,
+                            std::unordered_map<long long, std::pair<ChunkPos, std::vector<uint8_t>>>& pending) {
+    // Group by region so each region file gets a single batched write
+    std::vector<RegionFile::ChunkWrite> writes;
+    writes.reserve(pending.size());
+    for (const auto& [key, entry] : pending) {
+        writes.push_back(RegionFile::ChunkWrite{ entry.first, entry.second });
+    }
+    std::sort(writes.begin(), writes.end(), [](const RegionFile::ChunkWrite& a, const RegionFile::ChunkWrite& b) {
+        const long long regionA = RegionFileStorage::getRegionKey(a.pos);
+        const long long regionB = RegionFileStorage::getRegionKey(b.pos);
+        return regionA != regionB ? regionA < regionB : ChunkPos::asLong(a.pos.x, a.pos.z) < ChunkPos::asLong(b.pos.x, b.pos.z);
+    });
+
+    size_t begin = 0;
+    while (begin < writes.size()) {
+        const long long region = RegionFileStorage::getRegionKey(writes[begin].pos);
+        size_t end = begin + 1;
+        while (end < writes.size() && RegionFileStorage::getRegionKey(writes[end].pos) == region) ++end;
+
+        const std::span<const RegionFile::ChunkWrite> batch(writes.data() + begin, end - begin);
+        if (!worker.storage->writeBatch(batch)) {
+            failedWrites += batch.size();
+            LOG_ERROR("ChunkIO", "区域 {0} 的 {1} 个区块写入失败", region, batch.size());
+        }
+        chunkWrites += batch.size();
+        ++batches;
+        begin = end;
+    }
+}
+
+} // namespace PrismaCraft
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "RegionFileStorage.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <thread>
+
+namespace PrismaCraft {
+
+/**
+ * Asynchronous chunk I/O on top of RegionFileStorage
+ * Corresponds to: net.minecraft.world.level.chunk.storage.IOWorker
+ *
+ * Regions are assigned to I/O threads by hash, so every region file has exactly one owning
+ * thread and needs no locking. Stores are coalesced per chunk (only the latest data is
+ * written) and flushed in batches of up to BATCH_SIZE chunks once the oldest pending store
+ * is BATCH_DELAY old, amortizing the two syncs per batch. Loads take priority over batched
+ * writes and see pending stores immediately.
+ */
+class PRISMACRAFT_API IOWorker {
+public:
+    static constexpr size_t BATCH_SIZE = 64;
+    static constexpr std::chrono::milliseconds BATCH_DELAY{ 50 };
+
+    using LoadResult = std::optional<std::vector<uint8_t>>;
+
+    struct Stats {
+        uint64_t loads = 0;
+        uint64_t loadsFromPending = 0;  // Served from not-yet-written stores
+        uint64_t stores = 0;
+        uint64_t coalescedStores = 0;   // Stores that replaced a pending one
+        uint64_t chunkWrites = 0;
+        uint64_t batches = 0;
+        uint64_t failedWrites = 0;
+    };
+
+    IOWorker(const std::filesystem::path& folder, RegionCompression compression = RegionCompression::LZ4,
+             size_t ioThreads = 1, bool syncWrites = true);
+    ~IOWorker();
+
+    IOWorker(const IOWorker&) = delete;
+    IOWorker& operator=(const IOWorker&) = delete;
+
+    std::future<LoadResult> loadAsync(const ChunkPos& pos);
+
+    // Queue uncompressed chunk NBT; replaces any pending store for the same chunk
+    void store(const ChunkPos& pos, std::vector<uint8_t> data);
+
+    // Queue removal of a chunk
+    void erase(const ChunkPos& pos);
+
+    // Completes once every store queued before this call has been written
+    std::future<void> flush();
+
+    // Write all pending stores and stop the I/O threads
+    void close();
+
+    Stats getStats() const;
+
+private:
+    struct FlushState {
+        std::atomic<size_t> remaining{ 0 };
+        std::promise<void> promise;
+    };
+
+    struct LoadRequest {
+        ChunkPos pos;
+        std::promise<LoadResult> promise;
+    };
+
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::unique_ptr<RegionFileStorage> storage;
+
+        std::deque<LoadRequest> loads;
+        std::unordered_map<long long, std::pair<ChunkPos, std::vector<uint8_t>>> pendingStores;
+        std::chrono::steady_clock::time_point oldestPending;
+        std::vector<std::shared_ptr<FlushState>> flushes;
+        bool stopping = false;
+    };
+
+    Worker& getWorker(const ChunkPos& pos);
+    void run(Worker& worker);
+    void writePending(Worker& worker,
+                      std::unordered_map<long long, std::pair<ChunkPos, std::vector<uint8_t>>>& pending);
+    static void completeFlush(const std::shared_ptr<FlushState>& flush);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> closed{ false };
+
+    std::atomic<uint64_t> loads{ 0 };
+    std::atomic<uint64_t> loadsFromPending{ 0 };
+    std::atomic<uint64_t> stores{ 0 };
+    std::atomic<uint64_t> coalescedStores{ 0 };
+    std::atomic<uint64_t> chunkWrites{ 0 };
+    std::atomic<uint64_t> batches{ 0 };
+    std::atomic<uint64_t> failedWrites{ 0 };
+};
+
+} // namespace PrismaCraft
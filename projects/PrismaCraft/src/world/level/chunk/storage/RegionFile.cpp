@@ -0,0 +1,510 @@
+#include "RegionFile.h"
+#include "Logger.h"
+#include "Lz4.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+#if defined(PRISMACRAFT_HAS_ZLIB)
+    #include <zlib.h>
+#endif
+
+#if defined(PRISMA_USE_ZSTD)
+    #include <zstd.h>
+#endif
+
+namespace PrismaCraft {
+
+namespace {
+
+// Guards against corrupt size prefixes triggering huge allocations
+constexpr size_t MAX_CHUNK_BYTES = 256u * 1024u * 1024u;
+
+void storeU32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value >> 24);
+    p[1] = static_cast<uint8_t>(value >> 16);
+    p[2] = static_cast<uint8_t>(value >> 8);
+    p[3] = static_cast<uint8_t>(value);
+}
+
+uint32_t loadU32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint32_t currentTimestamp() {
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+}
+
+#if defined(PRISMACRAFT_HAS_ZLIB)
+bool deflateData(std::span<const uint8_t> input, std::vector<uint8_t>& output, bool gzip) {
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+    stream.next_in = const_cast<Bytef*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+    const int result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
+
+bool inflateData(std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+    z_stream stream{};
+    // 15 + 32: detect zlib or gzip header automatically
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) return false;
+    output.resize(std::max<size_t>(input.size() * 4, 1024));
+    stream.next_in = const_cast<Bytef*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+
+    int result = Z_OK;
+    while (result == Z_OK) {
+        if (stream.total_out == output.size()) {
+            if (output.size() >= MAX_CHUNK_BYTES) break;
+            output.resize(output.size() * 2);
+        }
+        stream.next_out = output.data() + stream.total_out;
+        stream.avail_out = static_cast<uInt>(output.size() - stream.total_out);
+        result = inflate(&stream, Z_NO_FLUSH);
+    }
+    output.resize(stream.total_out);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
+#endif
+
+bool seekTo(std::FILE* file, uint64_t offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+uint64_t fileSize(std::FILE* file) {
+#if defined(_WIN32)
+    _fseeki64(file, 0, SEEK_END);
+    return static_cast<uint64_t>(_ftelli64(file));
+#else
+    fseeko(file, 0, SEEK_END);
+    return static_cast<uint64_t>(ftello(file));
+#endif
+}
+
+// Flush stdio buffers and force the data to disk
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+} // namespace
+
+// ========== ChunkCompression ==========
+
+bool ChunkCompression::isSupported(RegionCompression type) {
+    switch (type) {
+        case RegionCompression::NONE:
+        case RegionCompression::LZ4:
+            return true;
+        case RegionCompression::GZIP:
+        case RegionCompression::ZLIB:
+#if defined(PRISMACRAFT_HAS_ZLIB)
+            return true;
+#else
+            return false;
+#endif
+        case RegionCompression::ZSTD:
+#if defined(PRISMA_USE_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+bool ChunkCompression::compress(RegionCompression type, std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+    switch (type) {
+        case RegionCompression::NONE:
+            output.assign(input.begin(), input.end());
+            return true;
+        case RegionCompression::LZ4: {
+            output.resize(4 + PrismaEngine::Core::Lz4::CompressBound(input.size()));
+            storeU32(output.data(), static_cast<uint32_t>(input.size()));
+            if (input.empty()) {
+                output.resize(4);
+                return true;
+            }
+            const size_t written = PrismaEngine::Core::Lz4::Compress(input.data(), input.size(),
+                                                                     output.data() + 4, output.size() - 4);
+            output.resize(4 + written);
+            return written != 0;
+        }
+#if defined(PRISMACRAFT_HAS_ZLIB)
+        case RegionCompression::GZIP:
+            return deflateData(input, output, true);
+        case RegionCompression::ZLIB:
+            return deflateData(input, output, false);
+#endif
+#if defined(PRISMA_USE_ZSTD)
+        case RegionCompression::ZSTD: {
+            output.resize(ZSTD_compressBound(input.size()));
+            const size_t written = ZSTD_compress(output.data(), output.size(), input.data(), input.size(), 3);
+            if (ZSTD_isError(written)) return false;
+            output.resize(written);
+            return true;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+bool ChunkCompression::decompress(RegionCompression type, std::span<const uint8_t> input, std::vector<uint8_t>& output) {
+    switch (type) {
+        case RegionCompression::NONE:
+            output.assign(input.begin(), input.end());
+            return true;
+        case RegionCompression::LZ4: {
+            if (input.size() < 4) return false;
+            const size_t rawSize = loadU32(input.data());
+            if (rawSize > MAX_CHUNK_BYTES) return false;
+            output.resize(rawSize);
+            if (rawSize == 0) return input.size() == 4;
+            return PrismaEngine::Core::Lz4::Decompress(input.data() + 4, input.size() - 4, output.data(), rawSize);
+        }
+#if defined(PRISMACRAFT_HAS_ZLIB)
+        case RegionCompression::GZIP:
+        case RegionCompression::ZLIB:
+            return inflateData(input, output);
+#endif
+#if defined(PRISMA_USE_ZSTD)
+        case RegionCompression::ZSTD: {
+            const unsigned long long rawSize = ZSTD_getFrameContentSize(input.data(), input.size());
+            if (rawSize == ZSTD_CONTENTSIZE_ERROR || rawSize == ZSTD_CONTENTSIZE_UNKNOWN || rawSize > MAX_CHUNK_BYTES) {
+                return false;
+            }
+            output.resize(static_cast<size_t>(rawSize));
+            const size_t read = ZSTD_decompress(output.data(), output.size(), input.data(), input.size());
+            return !ZSTD_isError(read) && read == rawSize;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+// ========== RegionFile ==========
+
+RegionFile::RegionFile(const std::filesystem::path& path, const std::filesystem::path& externalDir,
+                       RegionCompression compression, bool syncWrites)
+    : path(path), externalDir(externalDir), compression(compression), syncWrites(syncWrites) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    file = std::fopen(path.string().c_str(), "r+b");
+    if (!file) file = std::fopen(path.string().c_str(), "w+b");
+    if (!file) {
+        LOG_ERROR("Region", "无法打开区域文件 {0}", path.string());
+        return;
+    }
+    loadHeader();
+}
+
+RegionFile::~RegionFile() {
+    if (file) {
+        std::fflush(file);
+        std::fclose(file);
+    }
+}
+
+void RegionFile::loadHeader() {
+    uint64_t size = fileSize(file);
+    uint8_t header[SECTOR_BYTES * HEADER_SECTORS] = {};
+
+    if (size < sizeof(header)) {
+        // New or truncated file: start with an empty table
+        writeAt(0, header, sizeof(header));
+        sync();
+        size = sizeof(header);
+    } else if (!readAt(0, header, sizeof(header))) {
+        LOG_ERROR("Region", "读取区域文件头失败 {0}", path.string());
+    }
+
+    const size_t totalSectors = static_cast<size_t>((size + SECTOR_BYTES - 1) / SECTOR_BYTES);
+    usedSectors.assign(totalSectors, false);
+    markSectors(0, HEADER_SECTORS, true);
+
+    for (int i = 0; i < SECTOR_INTS; ++i) {
+        uint32_t location = loadU32(header + i * 4);
+        timestamps[i] = loadU32(header + SECTOR_BYTES + i * 4);
+
+        const uint32_t sector = sectorOf(location);
+        const uint32_t count = countOf(location);
+        if (location != 0) {
+            bool valid = sector >= HEADER_SECTORS && count > 0 && sector + count <= totalSectors;
+            for (uint32_t s = sector; valid && s < sector + count; ++s) {
+                valid = !usedSectors[s];
+            }
+            if (!valid) {
+                LOG_WARNING("Region", "区域文件 {0} 中区块 {1} 的位置无效, 已忽略", path.string(), i);
+                location = 0;
+            } else {
+                markSectors(sector, count, true);
+            }
+        }
+        locations[i] = location;
+    }
+}
+
+std::filesystem::path RegionFile::getExternalPath(const ChunkPos& pos) const {
+    return externalDir / ("c." + std::to_string(pos.x) + "." + std::to_string(pos.z) + ".mcc");
+}
+
+bool RegionFile::hasChunk(const ChunkPos& pos) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return locations[getOffsetIndex(pos)] != 0;
+}
+
+uint32_t RegionFile::getTimestamp(const ChunkPos& pos) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return timestamps[getOffsetIndex(pos)];
+}
+
+std::optional<std::vector<uint8_t>> RegionFile::read(const ChunkPos& pos) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) return std::nullopt;
+
+    const uint32_t location = locations[getOffsetIndex(pos)];
+    if (location == 0) return std::nullopt;
+
+    const uint64_t offset = static_cast<uint64_t>(sectorOf(location)) * SECTOR_BYTES;
+    uint8_t header[CHUNK_HEADER_SIZE];
+    if (!readAt(offset, header, sizeof(header))) return std::nullopt;
+
+    const uint32_t length = loadU32(header);
+    const uint8_t typeByte = header[4];
+    const bool external = (typeByte & EXTERNAL_STREAM_FLAG) != 0;
+    const auto type = static_cast<RegionCompression>(typeByte & ~EXTERNAL_STREAM_FLAG);
+    const size_t capacity = static_cast<size_t>(countOf(location)) * SECTOR_BYTES - 4;
+    if (length == 0 || length > capacity) {
+        LOG_WARNING("Region", "区块 {0} 长度 {1} 超出分配的扇区", pos.toString(), length);
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> compressed;
+    if (external) {
+        std::ifstream stream(getExternalPath(pos), std::ios::binary | std::ios::ate);
+        if (!stream) {
+            LOG_WARNING("Region", "区块 {0} 的外部文件缺失", pos.toString());
+            return std::nullopt;
+        }
+        compressed.resize(static_cast<size_t>(stream.tellg()));
+        stream.seekg(0);
+        stream.read(reinterpret_cast<char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+        if (!stream) return std::nullopt;
+    } else {
+        compressed.resize(length - 1);
+        if (!readAt(offset + CHUNK_HEADER_SIZE, compressed.data(), compressed.size())) return std::nullopt;
+    }
+
+    std::vector<uint8_t> data;
+    if (!ChunkCompression::decompress(type, compressed, data)) {
+        LOG_WARNING("Region", "区块 {0} 解压失败 (压缩类型 {1})", pos.toString(), static_cast<int>(type));
+        return std::nullopt;
+    }
+    return data;
+}
+
+RegionFile::Prepared RegionFile::prepare(const ChunkPos& pos, std::span<const uint8_t> data) {
+    Prepared prepared;
+    prepared.pos = pos;
+    prepared.index = getOffsetIndex(pos);
+    prepared.oldLocation = locations[prepared.index];
+    if (data.empty()) {
+        prepared.ok = true;
+        return prepared;
+    }
+
+    std::vector<uint8_t> compressed;
+    if (!ChunkCompression::compress(compression, data, compressed)) {
+        LOG_ERROR("Region", "区块 {0} 压缩失败 (压缩类型 {1})", pos.toString(), static_cast<int>(compression));
+        return prepared;
+    }
+
+    uint8_t typeByte = static_cast<uint8_t>(compression);
+    size_t payloadSize = compressed.size();
+    uint32_t sectors = static_cast<uint32_t>((CHUNK_HEADER_SIZE + payloadSize + SECTOR_BYTES - 1) / SECTOR_BYTES);
+    if (sectors > MAX_SECTORS_PER_CHUNK) {
+        // Oversized chunk: payload goes to c.<x>.<z>.mcc, replaced atomically via rename
+        const std::filesystem::path externalPath = getExternalPath(pos);
+        std::filesystem::path tempPath = externalPath;
+        tempPath += ".tmp";
+        {
+            // The contents must be durable before the rename, or a crash can leave the header
+            // pointing at an empty or torn .mcc
+            std::FILE* stream = std::fopen(tempPath.string().c_str(), "wb");
+            bool written = stream && std::fwrite(compressed.data(), 1, compressed.size(), stream) == compressed.size();
+            if (stream) {
+                if (written && syncWrites) written = syncFile(stream);
+                if (std::fclose(stream) != 0) written = false;
+            }
+            if (!written) {
+                LOG_ERROR("Region", "写入外部区块文件失败 {0}", tempPath.string());
+                return prepared;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tempPath, externalPath, ec);
+        if (ec) {
+            LOG_ERROR("Region", "替换外部区块文件失败 {0}: {1}", externalPath.string(), ec.message());
+            return prepared;
+        }
+        typeByte |= EXTERNAL_STREAM_FLAG;
+        payloadSize = 0;
+        sectors = 1;
+        prepared.external = true;
+    }
+
+    scratch.assign(static_cast<size_t>(sectors) * SECTOR_BYTES, 0);
+    storeU32(scratch.data(), static_cast<uint32_t>(payloadSize + 1));
+    scratch[4] = typeByte;
+    if (payloadSize) std::memcpy(scratch.data() + CHUNK_HEADER_SIZE, compressed.data(), payloadSize);
+
+    const uint32_t start = allocate(sectors);
+    if (!writeAt(static_cast<uint64_t>(start) * SECTOR_BYTES, scratch.data(), scratch.size())) {
+        markSectors(start, sectors, false);
+        LOG_ERROR("Region", "写入区块 {0} 失败", pos.toString());
+        return prepared;
+    }
+
+    prepared.location = packLocation(start, sectors);
+    prepared.ok = true;
+    return prepared;
+}
+
+bool RegionFile::publish(const Prepared& prepared, uint32_t timestamp) {
+    // Timestamp first: a stale timestamp next to the old location is harmless, a failed
+    // location write after it leaves the chunk untouched
+    uint8_t entry[4];
+    storeU32(entry, prepared.location ? timestamp : 0);
+    if (!writeAt(SECTOR_BYTES + static_cast<uint64_t>(prepared.index) * 4, entry, 4)) return false;
+    storeU32(entry, prepared.location);
+    if (!writeAt(static_cast<uint64_t>(prepared.index) * 4, entry, 4)) return false;
+
+    locations[prepared.index] = prepared.location;
+    timestamps[prepared.index] = prepared.location ? timestamp : 0;
+
+    // Old sectors become reusable only once nothing points at them
+    if (prepared.oldLocation != 0) {
+        markSectors(sectorOf(prepared.oldLocation), countOf(prepared.oldLocation), false);
+    }
+    if (!prepared.external) {
+        std::error_code ec;
+        std::filesystem::remove(getExternalPath(prepared.pos), ec);
+    }
+    return true;
+}
+
+bool RegionFile::write(const ChunkPos& pos, std::span<const uint8_t> data) {
+    const ChunkWrite single{ pos, data };
+    return writeBatch(std::span<const ChunkWrite>(&single, 1));
+}
+
+bool RegionFile::writeBatch(std::span<const ChunkWrite> writes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file || writes.empty()) return file != nullptr;
+
+    std::vector<Prepared> prepared;
+    prepared.reserve(writes.size());
+    for (const ChunkWrite& write : writes) {
+        prepared.push_back(prepare(write.pos, write.data));
+    }
+
+    // Payloads must be durable before any header entry points at them; if they are not,
+    // publish nothing and give the new sectors back
+    if (syncWrites && !sync()) {
+        LOG_ERROR("Region", "同步区块数据失败 {0}", path.string());
+        for (const Prepared& entry : prepared) {
+            if (entry.ok && entry.location != 0) markSectors(sectorOf(entry.location), countOf(entry.location), false);
+        }
+        return false;
+    }
+
+    bool ok = true;
+    const uint32_t timestamp = currentTimestamp();
+    for (const Prepared& entry : prepared) {
+        if (!entry.ok) {
+            ok = false;
+        } else if (!publish(entry, timestamp)) {
+            if (entry.location != 0) markSectors(sectorOf(entry.location), countOf(entry.location), false);
+            LOG_ERROR("Region", "写入区块头 {0} 失败", entry.pos.toString());
+            ok = false;
+        }
+    }
+    if (syncWrites && !sync()) ok = false;
+    return ok;
+}
+
+bool RegionFile::clear(const ChunkPos& pos) {
+    return write(pos, {});
+}
+
+void RegionFile::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file) sync();
+}
+
+uint32_t RegionFile::allocate(uint32_t count) {
+    // First fit; the file grows when no free run is large enough
+    uint32_t runStart = HEADER_SECTORS;
+    uint32_t runLength = 0;
+    for (uint32_t s = HEADER_SECTORS; s < usedSectors.size(); ++s) {
+        if (usedSectors[s]) {
+            runStart = s + 1;
+            runLength = 0;
+        } else if (++runLength == count) {
+            markSectors(runStart, count, true);
+            return runStart;
+        }
+    }
+    if (runLength == 0) runStart = static_cast<uint32_t>(usedSectors.size());
+    markSectors(runStart, count, true);
+    return runStart;
+}
+
+void RegionFile::markSectors(uint32_t start, uint32_t count, bool used) {
+    if (start + count > usedSectors.size()) usedSectors.resize(start + count, false);
+    std::fill(usedSectors.begin() + start, usedSectors.begin() + start + count, used);
+}
+
+bool RegionFile::readAt(uint64_t offset, void* buffer, size_t size) {
+    return seekTo(file, offset) && std::fread(buffer, 1, size, file) == size;
+}
+
+bool RegionFile::writeAt(uint64_t offset, const void* buffer, size_t size) {
+    return seekTo(file, offset) && std::fwrite(buffer, 1, size, file) == size;
+}
+
+bool RegionFile::sync() {
+    return syncFile(file);
+}
+
+} // namespace PrismaCraft
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include <PrismaCraft/Core/ChunkPos.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace PrismaCraft {
+
+/**
+ * Per-chunk compression scheme, stored in each chunk's header byte
+ * Corresponds to: net.minecraft.world.level.chunk.storage.RegionFileVersion
+ *
+ * GZIP/ZLIB/NONE use the vanilla ids. LZ4 stores a 4-byte big-endian raw size followed by
+ * an LZ4 block (the engine's block codec, not vanilla's lz4-java stream); ZSTD is an
+ * engine extension. Unavailable codecs fail to compress/decompress instead of crashing.
+ */
+enum class RegionCompression : uint8_t {
+    GZIP = 1,
+    ZLIB = 2,
+    NONE = 3,
+    LZ4 = 4,
+    ZSTD = 5
+};
+
+class PRISMACRAFT_API ChunkCompression {
+public:
+    static bool isSupported(RegionCompression type);
+
+    static bool compress(RegionCompression type, std::span<const uint8_t> input, std::vector<uint8_t>& output);
+    static bool decompress(RegionCompression type, std::span<const uint8_t> input, std::vector<uint8_t>& output);
+};
+
+/**
+ * Anvil region file holding up to 32x32 chunks
+ * Corresponds to: net.minecraft.world.level.chunk.storage.RegionFile
+ *
+ * Layout: an 8 KiB header (1024 sector locations, then 1024 timestamps) followed by 4 KiB
+ * sectors. Each chunk occupies a run of sectors starting with a 4-byte big-endian length and
+ * a compression byte. Chunks needing more than 255 sectors are stored in an external
+ * c.<x>.<z>.mcc file and flagged with EXTERNAL_STREAM_FLAG.
+ *
+ * Writes never overwrite the sectors a chunk currently points at: the new payload goes to
+ * freshly allocated sectors and is synced before the 4-byte header entry is switched over,
+ * so after a crash each chunk holds either its old or its new contents.
+ *
+ * Not designed for concurrent use from several threads; IOWorker gives each region file a
+ * single owning I/O thread. The internal mutex only guards against accidental misuse.
+ */
+class PRISMACRAFT_API RegionFile {
+public:
+    static constexpr int SECTOR_BYTES = 4096;
+    static constexpr int SECTOR_INTS = SECTOR_BYTES / 4;
+    static constexpr int CHUNK_HEADER_SIZE = 5;
+    static constexpr int HEADER_SECTORS = 2;
+    static constexpr int MAX_SECTORS_PER_CHUNK = 255;
+    static constexpr uint8_t EXTERNAL_STREAM_FLAG = 128;
+
+    struct ChunkWrite {
+        ChunkPos pos;
+        std::span<const uint8_t> data;   // Uncompressed NBT; empty clears the chunk
+    };
+
+    /**
+     * @param syncWrites flush payloads to stable storage before publishing their header entry
+     */
+    RegionFile(const std::filesystem::path& path, const std::filesystem::path& externalDir,
+               RegionCompression compression, bool syncWrites = true);
+    ~RegionFile();
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+    const std::filesystem::path& getPath() const { return path; }
+
+    bool hasChunk(const ChunkPos& pos) const;
+    uint32_t getTimestamp(const ChunkPos& pos) const;
+
+    // Decompressed chunk data; nullopt when absent or unreadable
+    std::optional<std::vector<uint8_t>> read(const ChunkPos& pos);
+
+    bool write(const ChunkPos& pos, std::span<const uint8_t> data);
+
+    /**
+     * Write several chunks with one sync for all payloads and one for all header entries.
+     * Each chunk is individually crash-consistent; returns false if any chunk failed.
+     */
+    bool writeBatch(std::span<const ChunkWrite> writes);
+
+    bool clear(const ChunkPos& pos);
+
+    void flush();
+
+    // Sectors in the file, including the header
+    size_t getSectorCount() const { return usedSectors.size(); }
+
+private:
+    struct Prepared {
+        ChunkPos pos;
+        int index = 0;
+        uint32_t location = 0;      // New packed location, 0 for cleared chunks
+        uint32_t oldLocation = 0;
+        bool external = false;      // Payload lives in the .mcc file
+        bool ok = false;
+    };
+
+    static int getOffsetIndex(const ChunkPos& pos) { return (pos.x & 31) + (pos.z & 31) * 32; }
+    static uint32_t packLocation(uint32_t sector, uint32_t count) { return (sector << 8) | count; }
+    static uint32_t sectorOf(uint32_t location) { return location >> 8; }
+    static uint32_t countOf(uint32_t location) { return location & 0xFF; }
+
+    void loadHeader();
+    std::filesystem::path getExternalPath(const ChunkPos& pos) const;
+
+    // Compress and write the payload to new sectors; header is untouched
+    Prepared prepare(const ChunkPos& pos, std::span<const uint8_t> data);
+    bool publish(const Prepared& prepared, uint32_t timestamp);
+
+    uint32_t allocate(uint32_t count);
+    void markSectors(uint32_t start, uint32_t count, bool used);
+
+    bool readAt(uint64_t offset, void* buffer, size_t size);
+    bool writeAt(uint64_t offset, const void* buffer, size_t size);
+    bool sync();
+
+    std::filesystem::path path;
+    std::filesystem::path externalDir;
+    RegionCompression compression;
+    bool syncWrites;
+
+    std::FILE* file = nullptr;
+    uint32_t locations[SECTOR_INTS] = {};
+    uint32_t timestamps[SECTOR_INTS] = {};
+    std::vector<bool> usedSectors;
+    std::vector<uint8_t> scratch;       // Reused compression / sector buffer
+    mutable std::mutex mutex;
+};
+
+} // namespace PrismaCraft
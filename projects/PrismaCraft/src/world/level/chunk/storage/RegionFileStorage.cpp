@@ -0,0 +1,78 @@
+#include "RegionFileStorage.h"
+#include <string>
+
+namespace PrismaCraft {
+
+RegionFileStorage::RegionFileStorage(const std::filesystem::path& folder, RegionCompression compression, bool syncWrites)
+    : folder(folder), compression(compression), syncWrites(syncWrites) {
+}
+
+RegionFileStorage::~RegionFileStorage() {
+    close();
+}
+
+RegionFile* RegionFileStorage::getRegionFile(const ChunkPos& pos, bool create) {
+    const long long key = getRegionKey(pos);
+    auto it = regionCache.find(key);
+    if (it != regionCache.end()) {
+        recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, it->second.lruPosition);
+        return it->second.file.get();
+    }
+
+    const std::filesystem::path path =
+        folder / ("r." + std::to_string(pos.x >> 5) + "." + std::to_string(pos.z >> 5) + ".mca");
+    if (!create && !std::filesystem::exists(path)) {
+        return nullptr;
+    }
+
+    if (regionCache.size() >= MAX_CACHE_SIZE) {
+        regionCache.erase(recentlyUsed.back());
+        recentlyUsed.pop_back();
+    }
+
+    auto file = std::make_unique<RegionFile>(path, folder, compression, syncWrites);
+    if (!file->isOpen()) {
+        return nullptr;
+    }
+    recentlyUsed.push_front(key);
+    RegionFile* result = file.get();
+    regionCache.emplace(key, CacheEntry{ std::move(file), recentlyUsed.begin() });
+    return result;
+}
+
+std::optional<std::vector<uint8_t>> RegionFileStorage::read(const ChunkPos& pos) {
+    RegionFile* file = getRegionFile(pos, false);
+    return file ? file->read(pos) : std::nullopt;
+}
+
+bool RegionFileStorage::write(const ChunkPos& pos, std::span<const uint8_t> data) {
+    const RegionFile::ChunkWrite single{ pos, data };
+    return writeBatch(std::span<const RegionFile::ChunkWrite>(&single, 1));
+}
+
+bool RegionFileStorage::writeBatch(std::span<const RegionFile::ChunkWrite> writes) {
+    if (writes.empty()) return true;
+
+    // Clearing chunks in a region that was never written needs no file
+    bool onlyClears = true;
+    for (const auto& write : writes) {
+        onlyClears = onlyClears && write.data.empty();
+    }
+
+    RegionFile* file = getRegionFile(writes.front().pos, !onlyClears);
+    if (!file) return onlyClears;
+    return file->writeBatch(writes);
+}
+
+void RegionFileStorage::flush() {
+    for (auto& [key, entry] : regionCache) {
+        entry.file->flush();
+    }
+}
+
+void RegionFileStorage::close() {
+    regionCache.clear();
+    recentlyUsed.clear();
+}
+
+} // namespace PrismaCraft
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "RegionFile.h"
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace PrismaCraft {
+
+/**
+ * Region file cache for one dimension folder
+ * Corresponds to: net.minecraft.world.level.chunk.storage.RegionFileStorage
+ *
+ * Keeps up to MAX_CACHE_SIZE region files open, evicting the least recently used.
+ * Not thread-safe: each instance is owned by a single I/O thread.
+ */
+class PRISMACRAFT_API RegionFileStorage {
+public:
+    static constexpr size_t MAX_CACHE_SIZE = 256;
+
+    RegionFileStorage(const std::filesystem::path& folder, RegionCompression compression, bool syncWrites = true);
+    ~RegionFileStorage();
+
+    RegionFileStorage(const RegionFileStorage&) = delete;
+    RegionFileStorage& operator=(const RegionFileStorage&) = delete;
+
+    static long long getRegionKey(const ChunkPos& pos) { return ChunkPos::asLong(pos.x >> 5, pos.z >> 5); }
+
+    std::optional<std::vector<uint8_t>> read(const ChunkPos& pos);
+    bool write(const ChunkPos& pos, std::span<const uint8_t> data);
+
+    // All writes must belong to the same region
+    bool writeBatch(std::span<const RegionFile::ChunkWrite> writes);
+
+    void flush();
+    void close();
+
+    const std::filesystem::path& getFolder() const { return folder; }
+
+private:
+    // Returns nullptr when the file does not exist and create is false
+    RegionFile* getRegionFile(const ChunkPos& pos, bool create);
+
+    std::filesystem::path folder;
+    RegionCompression compression;
+    bool syncWrites;
+
+    std::list<long long> recentlyUsed;  // Front = most recent
+    struct CacheEntry {
+        std::unique_ptr<RegionFile> file;
+        std::list<long long>::iterator lruPosition;
+    };
+    std::unordered_map<long long, CacheEntry> regionCache;
+};
+
+} // namespace PrismaCraft
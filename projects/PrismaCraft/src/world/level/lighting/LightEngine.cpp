@@ -0,0 +1,387 @@
+#include "LightEngine.h"
+#include <PrismaCraft/Core/BlockStateRegistry.h>
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+
+namespace PrismaCraft {
+
+namespace {
+
+constexpr int DIRECTION_COUNT = 6;
+constexpr int DOWN = 0;
+constexpr int OFFSETS[DIRECTION_COUNT][3] = {
+    { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }, { -1, 0, 0 }, { 1, 0, 0 }
+};
+
+} // namespace
+
+// ========== LightEngine ==========
+
+LightEngine::LightEngine(LightLayer layer, const LightChunkGetter& chunks)
+    : layer(layer), chunks(chunks), minSection(chunks.getMinSection()), maxSection(chunks.getMaxSection()),
+      topY((chunks.getMaxSection() + 1) << 4) {
+}
+
+int LightEngine::getLightValue(const BlockPos& pos) const {
+    if (layer == LightLayer::SKY && pos.y >= topY) return LevelLightEngine::MAX_LEVEL;
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = sections.find(SectionPos::asLong(pos.x >> 4, pos.y >> 4, pos.z >> 4));
+    return it != sections.end() ? it->second->get(pos.x & 15, pos.y & 15, pos.z & 15) : 0;
+}
+
+bool LightEngine::copySection(const SectionPos& pos, uint8_t* out) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = sections.find(pos.asLong());
+    if (it == sections.end()) return false;
+    it->second->copyTo(out);
+    return true;
+}
+
+bool LightEngine::hasChunk(const ChunkPos& pos) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return litChunks.count(ChunkPos::asLong(pos.x, pos.z)) != 0;
+}
+
+void LightEngine::invalidateCache() {
+    for (CacheEntry& entry : cache) entry.valid = false;
+}
+
+void LightEngine::bindTables() {
+    const BlockStateRegistry& registry = BlockStateRegistry::instance();
+    opacityTable = registry.isBuilt() ? registry.getLightBlockTable() : nullptr;
+    emissionTable = registry.isBuilt() ? registry.getLightEmissionTable() : nullptr;
+}
+
+bool LightEngine::resolve(int x, int y, int z, Cell& cell) {
+    if (y < (minSection << 4) || y >= topY) return false;
+
+    const int sx = x >> 4;
+    const int sy = y >> 4;
+    const int sz = z >> 4;
+    const long long key = SectionPos::asLong(sx, sy, sz);
+    CacheEntry& entry = cache[(sx ^ (sz << 2) ^ (sy * 5)) & (CACHE_SIZE - 1)];
+    if (!entry.valid || entry.key != key) {
+        auto it = sections.find(key);
+        entry.key = key;
+        entry.valid = true;
+        entry.light = it != sections.end() ? it->second.get() : nullptr;
+        entry.states = entry.light ? chunks.getSectionStates(sx, sy, sz) : nullptr;
+    }
+    if (!entry.light) return false;
+
+    cell.light = entry.light;
+    cell.states = entry.states;
+    cell.index = DataLayer::getIndex(x & 15, y & 15, z & 15);
+    return true;
+}
+
+int LightEngine::getLevel(int x, int y, int z) {
+    if (layer == LightLayer::SKY && y >= topY) return LevelLightEngine::MAX_LEVEL;
+    Cell cell;
+    return resolve(x, y, z, cell) ? cell.light->get(cell.index) : 0;
+}
+
+int LightEngine::getOpacity(const Cell& cell) const {
+    return cell.states && opacityTable ? opacityTable[cell.states[cell.index]] : 0;
+}
+
+int LightEngine::getEmission(const Cell& cell) const {
+    return cell.states && emissionTable ? emissionTable[cell.states[cell.index]] : 0;
+}
+
+void LightEngine::addChunk(const ChunkPos& pos) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    bindTables();
+
+    const uint8_t fill = layer == LightLayer::SKY ? LevelLightEngine::MAX_LEVEL : 0;
+    for (int sy = minSection; sy <= maxSection; ++sy) {
+        sections[SectionPos::asLong(pos.x, sy, pos.z)] = std::make_unique<DataLayer>(fill);
+    }
+    litChunks.insert(ChunkPos::asLong(pos.x, pos.z));
+    invalidateCache();
+
+    if (layer == LightLayer::SKY) {
+        seedSkyColumns(pos);
+    } else {
+        seedEmitters(pos);
+    }
+    seedBorder(pos, -1, 0);
+    seedBorder(pos, 1, 0);
+    seedBorder(pos, 0, -1);
+    seedBorder(pos, 0, 1);
+}
+
+void LightEngine::removeChunk(const ChunkPos& pos) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    for (int sy = minSection; sy <= maxSection; ++sy) {
+        sections.erase(SectionPos::asLong(pos.x, sy, pos.z));
+    }
+    litChunks.erase(ChunkPos::asLong(pos.x, pos.z));
+    invalidateCache();
+}
+
+void LightEngine::checkBlock(const BlockPos& pos) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    bindTables();
+    invalidateCache();
+
+    Cell cell;
+    if (!resolve(pos.x, pos.y, pos.z, cell)) return;
+
+    // Clear the old value and everything derived from it, then re-flood
+    const int oldLevel = cell.light->get(cell.index);
+    const int emission = layer == LightLayer::BLOCK ? getEmission(cell) : 0;
+    cell.light->set(cell.index, emission);
+    decreaseQueue.push_back({ pos.x, pos.y, pos.z, oldLevel });
+    if (emission > 0) increaseQueue.push_back({ pos.x, pos.y, pos.z, emission });
+}
+
+void LightEngine::seedSkyColumns(const ChunkPos& pos) {
+    // Straight-down pass per column; exact for vertical propagation
+    int levels[256];
+    std::fill(std::begin(levels), std::end(levels), LevelLightEngine::MAX_LEVEL);
+    bool allOpen = true;
+
+    for (int sy = maxSection; sy >= minSection; --sy) {
+        const uint32_t* states = chunks.getSectionStates(pos.x, sy, pos.z);
+        if (!states && allOpen) continue;   // Uniform level 15 section
+
+        DataLayer& light = *sections[SectionPos::asLong(pos.x, sy, pos.z)];
+        if (std::all_of(std::begin(levels), std::end(levels), [](int level) { return level == 0; })) {
+            // Every column is already dark: keep the section uniform instead of writing 4096 zeros
+            light.fillWith(0);
+            continue;
+        }
+        for (int y = 15; y >= 0; --y) {
+            allOpen = true;
+            for (int column = 0; column < 256; ++column) {
+                const int index = y << 8 | column;
+                const int opacity = states && opacityTable ? opacityTable[states[index]] : 0;
+                int& level = levels[column];
+                if (level != LevelLightEngine::MAX_LEVEL || opacity != 0) {
+                    level = std::max(0, level - std::max(1, opacity));
+                    allOpen = false;
+                }
+                light.set(index, level);
+            }
+        }
+
+        // Horizontal spread starts where a cell is brighter than a neighbor can be lit by it
+        if (light.isUniform()) continue;
+        for (int index = 0; index < 4096; ++index) {
+            const int level = light.get(index);
+            if (level <= 1) continue;
+            const int x = index & 15;
+            const int z = (index >> 4) & 15;
+            const bool darkerNeighbor = (x > 0 && light.get(index - 1) < level - 1) ||
+                                        (x < 15 && light.get(index + 1) < level - 1) ||
+                                        (z > 0 && light.get(index - 16) < level - 1) ||
+                                        (z < 15 && light.get(index + 16) < level - 1);
+            if (darkerNeighbor) {
+                increaseQueue.push_back({ (pos.x << 4) + x, (sy << 4) + (index >> 8), (pos.z << 4) + z, level });
+            }
+        }
+    }
+}
+
+void LightEngine::seedEmitters(const ChunkPos& pos) {
+    if (!emissionTable) return;
+    for (int sy = minSection; sy <= maxSection; ++sy) {
+        const uint32_t* states = chunks.getSectionStates(pos.x, sy, pos.z);
+        if (!states) continue;
+
+        DataLayer& light = *sections[SectionPos::asLong(pos.x, sy, pos.z)];
+        for (int index = 0; index < 4096; ++index) {
+            const int emission = emissionTable[states[index]];
+            if (emission == 0) continue;
+            light.set(index, emission);
+            increaseQueue.push_back({ (pos.x << 4) + (index & 15), (sy << 4) + (index >> 8),
+                                      (pos.z << 4) + ((index >> 4) & 15), emission });
+        }
+    }
+}
+
+void LightEngine::seedBorder(const ChunkPos& pos, int dx, int dz) {
+    if (!litChunks.count(ChunkPos::asLong(pos.x + dx, pos.z + dz))) return;
+
+    // Border cells of this chunk and the matching cells of the neighbor
+    const int baseX = pos.x << 4;
+    const int baseZ = pos.z << 4;
+    for (int y = minSection << 4; y < topY; ++y) {
+        for (int t = 0; t < 16; ++t) {
+            const int ox = dx == 0 ? baseX + t : (dx < 0 ? baseX : baseX + 15);
+            const int oz = dz == 0 ? baseZ + t : (dz < 0 ? baseZ : baseZ + 15);
+            const int ours = getLevel(ox, y, oz);
+            const int theirs = getLevel(ox + dx, y, oz + dz);
+            if (theirs > ours + 1) {
+                increaseQueue.push_back({ ox + dx, y, oz + dz, theirs });
+            } else if (ours > theirs + 1) {
+                increaseQueue.push_back({ ox, y, oz, ours });
+            }
+        }
+    }
+}
+
+size_t LightEngine::propagate() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    bindTables();
+    invalidateCache();
+
+    runDecrease();
+    runIncrease();
+
+    const size_t result = changed;
+    changed = 0;
+    return result;
+}
+
+void LightEngine::runDecrease() {
+    const bool sky = layer == LightLayer::SKY;
+    for (size_t head = 0; head < decreaseQueue.size(); ++head) {
+        const QueueEntry entry = decreaseQueue[head];
+        for (int direction = 0; direction < DIRECTION_COUNT; ++direction) {
+            const int x = entry.x + OFFSETS[direction][0];
+            const int y = entry.y + OFFSETS[direction][1];
+            const int z = entry.z + OFFSETS[direction][2];
+            if (sky && y >= topY) {
+                // Open sky above the level relights the column
+                increaseQueue.push_back({ x, y, z, LevelLightEngine::MAX_LEVEL });
+                continue;
+            }
+
+            Cell cell;
+            if (!resolve(x, y, z, cell)) continue;
+            const int level = cell.light->get(cell.index);
+            if (level == 0) continue;
+
+            const bool derived = level < entry.level ||
+                                 (sky && direction == DOWN && entry.level == LevelLightEngine::MAX_LEVEL &&
+                                  level == LevelLightEngine::MAX_LEVEL);
+            if (derived) {
+                const int emission = sky ? 0 : getEmission(cell);
+                cell.light->set(cell.index, emission);
+                ++changed;
+                decreaseQueue.push_back({ x, y, z, level });
+                if (emission > 0) increaseQueue.push_back({ x, y, z, emission });
+            } else {
+                // Lit from elsewhere: flood back into the cleared area
+                increaseQueue.push_back({ x, y, z, level });
+            }
+        }
+    }
+    decreaseQueue.clear();
+}
+
+void LightEngine::runIncrease() {
+    const bool sky = layer == LightLayer::SKY;
+    for (size_t head = 0; head < increaseQueue.size(); ++head) {
+        const QueueEntry entry = increaseQueue[head];
+        if (getLevel(entry.x, entry.y, entry.z) != entry.level) continue;   // Stale
+
+        for (int direction = 0; direction < DIRECTION_COUNT; ++direction) {
+            const int x = entry.x + OFFSETS[direction][0];
+            const int y = entry.y + OFFSETS[direction][1];
+            const int z = entry.z + OFFSETS[direction][2];
+
+            Cell cell;
+            if (!resolve(x, y, z, cell)) continue;
+            const int opacity = getOpacity(cell);
+            const int level = sky && direction == DOWN && entry.level == LevelLightEngine::MAX_LEVEL && opacity == 0
+                                  ? LevelLightEngine::MAX_LEVEL
+                                  : entry.level - std::max(1, opacity);
+            if (level <= cell.light->get(cell.index)) continue;
+
+            cell.light->set(cell.index, level);
+            ++changed;
+            if (level > 1) increaseQueue.push_back({ x, y, z, level });
+        }
+    }
+    increaseQueue.clear();
+}
+
+// ========== LevelLightEngine ==========
+
+LevelLightEngine::LevelLightEngine(const LightChunkGetter& chunks, bool hasSkyLight)
+    : blockEngine(LightLayer::BLOCK, chunks) {
+    if (hasSkyLight) {
+        skyEngine = std::make_unique<LightEngine>(LightLayer::SKY, chunks);
+    }
+}
+
+void LevelLightEngine::lightChunk(const ChunkPos& pos) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingUpdates.push_back({ PendingUpdate::Type::LIGHT_CHUNK, BlockPos(pos.x, 0, pos.z) });
+}
+
+void LevelLightEngine::removeChunk(const ChunkPos& pos) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingUpdates.push_back({ PendingUpdate::Type::REMOVE_CHUNK, BlockPos(pos.x, 0, pos.z) });
+}
+
+void LevelLightEngine::checkBlock(const BlockPos& pos) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingUpdates.push_back({ PendingUpdate::Type::CHECK_BLOCK, pos });
+}
+
+bool LevelLightEngine::hasPendingUpdates() const {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    return !pendingUpdates.empty();
+}
+
+size_t LevelLightEngine::runLightUpdates() {
+    std::lock_guard<std::mutex> updateLock(updateMutex);
+
+    std::vector<PendingUpdate> updates;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        updates.swap(pendingUpdates);
+    }
+    if (updates.empty()) return 0;
+
+    LightEngine* engines[2] = { &blockEngine, skyEngine.get() };
+    const size_t engineCount = skyEngine ? 2 : 1;
+    std::atomic<size_t> changed{ 0 };
+
+    // Block and sky light are independent, so each layer runs as its own job
+    PrismaEngine::JobSystem::GetInstance().ParallelFor(engineCount, [&](size_t i) {
+        LightEngine& engine = *engines[i];
+        for (const PendingUpdate& update : updates) {
+            switch (update.type) {
+                case PendingUpdate::Type::LIGHT_CHUNK:
+                    engine.addChunk(ChunkPos(update.pos.x, update.pos.z));
+                    break;
+                case PendingUpdate::Type::REMOVE_CHUNK:
+                    engine.removeChunk(ChunkPos(update.pos.x, update.pos.z));
+                    break;
+                case PendingUpdate::Type::CHECK_BLOCK:
+                    engine.checkBlock(update.pos);
+                    break;
+            }
+        }
+        changed += engine.propagate();
+    });
+    return changed;
+}
+
+int LevelLightEngine::getLightValue(LightLayer layer, const BlockPos& pos) const {
+    if (layer == LightLayer::SKY) {
+        return skyEngine ? skyEngine->getLightValue(pos) : 0;
+    }
+    return blockEngine.getLightValue(pos);
+}
+
+int LevelLightEngine::getRawBrightness(const BlockPos& pos, int skyDarken) const {
+    const int sky = getLightValue(LightLayer::SKY, pos) - skyDarken;
+    return std::max(sky, blockEngine.getLightValue(pos));
+}
+
+bool LevelLightEngine::copySection(LightLayer layer, const SectionPos& pos, uint8_t* out) const {
+    if (layer == LightLayer::SKY) {
+        return skyEngine && skyEngine->copySection(pos, out);
+    }
+    return blockEngine.copySection(pos, out);
+}
+
+} // namespace PrismaCraft
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include <PrismaCraft/Core/ChunkPos.h>
+#include "../chunk/DataLayer.h"
+#include "../chunk/LightChunkGetter.h"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace PrismaCraft {
+
+/**
+ * Corresponds to: net.minecraft.world.level.LightLayer
+ */
+enum class LightLayer : uint8_t {
+    SKY,
+    BLOCK
+};
+
+/**
+ * Breadth-first light propagation for one light layer
+ * Corresponds to: net.minecraft.world.level.lighting.LightEngine (BlockLightEngine / SkyLightEngine)
+ *
+ * Light is stored per section in DataLayers keyed by SectionPos, and the increase/decrease
+ * queues work in world coordinates, so propagation crosses chunk borders freely. A block
+ * change clears only the light that was derived from that block (decrease pass) and then
+ * re-floods from the surrounding boundary (increase pass), so the work is bounded by the
+ * affected area (light radius 15), not by the chunk.
+ *
+ * Sky light enters from above the top section at level 15 and keeps that level travelling
+ * straight down through blocks with no light block value.
+ */
+class PRISMACRAFT_API LightEngine {
+public:
+    LightEngine(LightLayer layer, const LightChunkGetter& chunks);
+
+    LightEngine(const LightEngine&) = delete;
+    LightEngine& operator=(const LightEngine&) = delete;
+
+    LightLayer getLayer() const { return layer; }
+
+    // Thread-safe reads; outside lit chunks sky light reads 15 above the level, else 0
+    int getLightValue(const BlockPos& pos) const;
+    bool copySection(const SectionPos& pos, uint8_t* out) const;
+    bool hasChunk(const ChunkPos& pos) const;
+
+    // Mutations; LevelLightEngine serializes these per layer
+    void addChunk(const ChunkPos& pos);
+    void removeChunk(const ChunkPos& pos);
+    void checkBlock(const BlockPos& pos);
+
+    // Run queued increases/decreases to completion; returns the number of light values changed
+    size_t propagate();
+
+private:
+    struct QueueEntry {
+        int x;
+        int y;
+        int z;
+        int level;
+    };
+
+    // Resolved storage for one block position
+    struct Cell {
+        DataLayer* light = nullptr;
+        const uint32_t* states = nullptr;
+        int index = 0;
+    };
+
+    struct CacheEntry {
+        long long key = 0;
+        DataLayer* light = nullptr;
+        const uint32_t* states = nullptr;
+        bool valid = false;
+    };
+
+    static constexpr int CACHE_SIZE = 16;
+
+    bool resolve(int x, int y, int z, Cell& cell);
+    int getLevel(int x, int y, int z);
+    int getOpacity(const Cell& cell) const;
+    int getEmission(const Cell& cell) const;
+    void invalidateCache();
+    void bindTables();
+
+    void seedSkyColumns(const ChunkPos& pos);
+    void seedEmitters(const ChunkPos& pos);
+    void seedBorder(const ChunkPos& pos, int dx, int dz);
+
+    void runDecrease();
+    void runIncrease();
+
+    LightLayer layer;
+    const LightChunkGetter& chunks;
+    int minSection;
+    int maxSection;
+    int topY;                               // First block Y above the level
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<long long, std::unique_ptr<DataLayer>> sections;
+    std::unordered_set<long long> litChunks;
+
+    CacheEntry cache[CACHE_SIZE];
+    const uint8_t* opacityTable = nullptr;
+    const uint8_t* emissionTable = nullptr;
+
+    // Reused between runs
+    std::vector<QueueEntry> increaseQueue;
+    std::vector<QueueEntry> decreaseQueue;
+    size_t changed = 0;
+};
+
+/**
+ * Block and sky light for a level
+ * Corresponds to: net.minecraft.world.level.lighting.LevelLightEngine
+ *
+ * Chunk loads and block changes are queued from any thread and applied by
+ * runLightUpdates(), which is meant to run on a worker thread; the two layers propagate in
+ * parallel on the job system. Light reads are safe at any time.
+ */
+class PRISMACRAFT_API LevelLightEngine {
+public:
+    static constexpr int MAX_LEVEL = 15;
+
+    LevelLightEngine(const LightChunkGetter& chunks, bool hasSkyLight = true);
+
+    // Queue initial lighting for a chunk whose block data is available
+    void lightChunk(const ChunkPos& pos);
+    void removeChunk(const ChunkPos& pos);
+
+    // Queue a relight after the block at pos changed
+    void checkBlock(const BlockPos& pos);
+
+    bool hasPendingUpdates() const;
+
+    /**
+     * Apply all queued work; block data must not change during the call.
+     * Returns the number of light values changed.
+     */
+    size_t runLightUpdates();
+
+    int getLightValue(LightLayer layer, const BlockPos& pos) const;
+    int getRawBrightness(const BlockPos& pos, int skyDarken) const;
+
+    // Copy a section's nibble array (DataLayer::SIZE bytes) for meshing; false if not lit
+    bool copySection(LightLayer layer, const SectionPos& pos, uint8_t* out) const;
+
+    LightEngine* getBlockEngine() { return &blockEngine; }
+    LightEngine* getSkyEngine() { return skyEngine.get(); }
+
+private:
+    // Queued work, applied in submission order
+    struct PendingUpdate {
+        enum class Type : uint8_t { LIGHT_CHUNK, REMOVE_CHUNK, CHECK_BLOCK };
+        Type type;
+        BlockPos pos;                       // Chunk coordinates in x/z for chunk updates
+    };
+
+    LightEngine blockEngine;
+    std::unique_ptr<LightEngine> skyEngine;
+
+    mutable std::mutex pendingMutex;
+    std::vector<PendingUpdate> pendingUpdates;
+
+    std::mutex updateMutex;
+};
+
+} // namespace PrismaCraft
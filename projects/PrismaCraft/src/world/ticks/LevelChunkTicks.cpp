@@ -0,0 +1,50 @@
+#include "LevelChunkTicks.h"
+#include <algorithm>
+
+namespace PrismaCraft {
+
+namespace {
+
+// std heap functions build a max-heap, so invert the ordering
+bool heapLess(const ScheduledTick& a, const ScheduledTick& b) {
+    return ScheduledTick::runsBefore(b, a);
+}
+
+} // namespace
+
+bool LevelChunkTicks::schedule(const ScheduledTick& tick) {
+    if (!pending.insert(Key{ tick.pos.asLong(), tick.type }).second) {
+        return false;
+    }
+    ticks.push_back(tick);
+    std::push_heap(ticks.begin(), ticks.end(), heapLess);
+    return true;
+}
+
+bool LevelChunkTicks::hasScheduledTick(const BlockPos& pos, uint32_t type) const {
+    return pending.count(Key{ pos.asLong(), type }) != 0;
+}
+
+ScheduledTick LevelChunkTicks::poll() {
+    std::pop_heap(ticks.begin(), ticks.end(), heapLess);
+    ScheduledTick tick = ticks.back();
+    ticks.pop_back();
+    pending.erase(Key{ tick.pos.asLong(), tick.type });
+    return tick;
+}
+
+size_t LevelChunkTicks::drainDue(int64_t gameTime, size_t maxCount, std::vector<ScheduledTick>& out) {
+    size_t drained = 0;
+    while (drained < maxCount && !ticks.empty() && ticks.front().triggerTick <= gameTime) {
+        out.push_back(poll());
+        ++drained;
+    }
+    return drained;
+}
+
+void LevelChunkTicks::clear() {
+    ticks.clear();
+    pending.clear();
+}
+
+} // namespace PrismaCraft
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ScheduledTick.h"
+#include <unordered_set>
+#include <vector>
+
+namespace PrismaCraft {
+
+/**
+ * Scheduled ticks of one chunk
+ * Corresponds to: net.minecraft.world.ticks.LevelChunkTicks
+ *
+ * A binary min-heap ordered by ScheduledTick::runsBefore, plus a (position, type) set so the
+ * same update is not queued twice. Not thread-safe; the owning region's tick thread is the
+ * only writer while ticking.
+ */
+class PRISMACRAFT_API LevelChunkTicks {
+public:
+    // False when an identical (position, type) tick is already pending
+    bool schedule(const ScheduledTick& tick);
+    bool hasScheduledTick(const BlockPos& pos, uint32_t type) const;
+
+    const ScheduledTick* peek() const { return ticks.empty() ? nullptr : &ticks.front(); }
+    ScheduledTick poll();
+
+    // Move every tick due at or before gameTime into out (unsorted), up to maxCount
+    size_t drainDue(int64_t gameTime, size_t maxCount, std::vector<ScheduledTick>& out);
+
+    size_t count() const { return ticks.size(); }
+    bool empty() const { return ticks.empty(); }
+    void clear();
+
+private:
+    struct Key {
+        long long pos;
+        uint32_t type;
+        bool operator==(const Key& other) const { return pos == other.pos && type == other.type; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            // Unsigned arithmetic: packed positions use the full 64 bits and may wrap
+            return std::hash<uint64_t>{}(static_cast<uint64_t>(key.pos) * 31u + key.type);
+        }
+    };
+
+    std::vector<ScheduledTick> ticks;           // Heap; front is the next tick to run
+    std::unordered_set<Key, KeyHash> pending;
+};
+
+} // namespace PrismaCraft
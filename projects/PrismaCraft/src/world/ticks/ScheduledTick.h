@@ -0,0 +1,44 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include <PrismaCraft/Core/BlockPos.h>
+#include <cstdint>
+
+namespace PrismaCraft {
+
+/**
+ * Corresponds to: net.minecraft.world.ticks.TickPriority
+ */
+enum class TickPriority : int8_t {
+    EXTREMELY_HIGH = -3,
+    VERY_HIGH = -2,
+    HIGH = -1,
+    NORMAL = 0,
+    LOW = 1,
+    VERY_LOW = 2,
+    EXTREMELY_LOW = 3
+};
+
+/**
+ * A block or fluid update due at a given game time
+ * Corresponds to: net.minecraft.world.ticks.ScheduledTick
+ *
+ * type is caller-defined (block or fluid ID); ticks run ordered by trigger time, then
+ * priority, then scheduling order.
+ */
+struct PRISMACRAFT_API ScheduledTick {
+    uint32_t type;
+    BlockPos pos;
+    int64_t triggerTick;
+    TickPriority priority;
+    uint64_t subTickOrder;
+
+    // Strict weak ordering: true when a runs before b
+    static bool runsBefore(const ScheduledTick& a, const ScheduledTick& b) {
+        if (a.triggerTick != b.triggerTick) return a.triggerTick < b.triggerTick;
+        if (a.priority != b.priority) return a.priority < b.priority;
+        return a.subTickOrder < b.subTickOrder;
+    }
+};
+
+} // namespace PrismaCraft
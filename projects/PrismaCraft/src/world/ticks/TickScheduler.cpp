@@ -0,0 +1,244 @@
+#include "TickScheduler.h"
+#include <PrismaCraft/Core/BlockStateRegistry.h>
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace PrismaCraft {
+
+namespace {
+
+// SplitMix64 finalizer; a counter fed through it gives independent, order-free samples
+uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+int floorDiv(int value, int divisor) {
+    const int quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+} // namespace
+
+TickScheduler::TickScheduler(ChunkTickHandler& handler, uint64_t seed, int regionSize)
+    : handler(handler), seed(seed), regionSize(std::max(regionSize, 2)),
+      minSection(handler.getMinSection()), maxSection(handler.getMaxSection()) {
+}
+
+long long TickScheduler::getRegionKey(int chunkX, int chunkZ) const {
+    return ChunkPos::asLong(floorDiv(chunkX, regionSize), floorDiv(chunkZ, regionSize));
+}
+
+TickScheduler::ChunkTicks* TickScheduler::getChunk(int chunkX, int chunkZ) const {
+    auto it = chunks.find(ChunkPos::asLong(chunkX, chunkZ));
+    return it != chunks.end() ? it->second.get() : nullptr;
+}
+
+void TickScheduler::addChunk(const ChunkPos& pos) {
+    const long long key = ChunkPos::asLong(pos.x, pos.z);
+    if (chunks.count(key)) return;
+
+    auto chunk = std::make_unique<ChunkTicks>();
+    chunk->pos = pos;
+    chunk->randomTickingBlocks.assign(maxSection - minSection + 1, 0);
+
+    const BlockStateRegistry& registry = BlockStateRegistry::instance();
+    if (registry.isBuilt()) {
+        const uint16_t* flags = registry.getFlagsTable();
+        for (int sy = minSection; sy <= maxSection; ++sy) {
+            const uint32_t* states = handler.getSectionStates(pos.x, sy, pos.z);
+            if (!states) continue;
+            uint16_t count = 0;
+            for (int index = 0; index < 4096; ++index) {
+                count += (flags[states[index]] & BlockStateRegistry::RANDOM_TICKS) != 0;
+            }
+            chunk->randomTickingBlocks[sy - minSection] = count;
+        }
+    }
+
+    regions[getRegionKey(pos.x, pos.z)].chunks.push_back(chunk.get());
+    chunks.emplace(key, std::move(chunk));
+    phasesDirty = true;
+}
+
+void TickScheduler::removeChunk(const ChunkPos& pos) {
+    auto it = chunks.find(ChunkPos::asLong(pos.x, pos.z));
+    if (it == chunks.end()) return;
+
+    auto regionIt = regions.find(getRegionKey(pos.x, pos.z));
+    auto& regionChunks = regionIt->second.chunks;
+    auto chunkIt = std::find(regionChunks.begin(), regionChunks.end(), it->second.get());
+    *chunkIt = regionChunks.back();
+    regionChunks.pop_back();
+    if (regionChunks.empty()) regions.erase(regionIt);
+
+    chunks.erase(it);
+    phasesDirty = true;
+}
+
+bool TickScheduler::hasChunk(const ChunkPos& pos) const {
+    return getChunk(pos.x, pos.z) != nullptr;
+}
+
+bool TickScheduler::schedule(bool fluid, const BlockPos& pos, uint32_t type, int delay, TickPriority priority) {
+    ChunkTicks* chunk = getChunk(pos.x >> 4, pos.z >> 4);
+    if (!chunk) return false;
+
+    const ScheduledTick tick{ type, pos, gameTime + delay, priority, nextSubTickOrder++ };
+    return fluid ? chunk->fluidTicks.schedule(tick) : chunk->blockTicks.schedule(tick);
+}
+
+bool TickScheduler::scheduleBlockTick(const BlockPos& pos, uint32_t type, int delay, TickPriority priority) {
+    return schedule(false, pos, type, delay, priority);
+}
+
+bool TickScheduler::scheduleFluidTick(const BlockPos& pos, uint32_t type, int delay, TickPriority priority) {
+    return schedule(true, pos, type, delay, priority);
+}
+
+bool TickScheduler::hasScheduledBlockTick(const BlockPos& pos, uint32_t type) const {
+    const ChunkTicks* chunk = getChunk(pos.x >> 4, pos.z >> 4);
+    return chunk && chunk->blockTicks.hasScheduledTick(pos, type);
+}
+
+bool TickScheduler::hasScheduledFluidTick(const BlockPos& pos, uint32_t type) const {
+    const ChunkTicks* chunk = getChunk(pos.x >> 4, pos.z >> 4);
+    return chunk && chunk->fluidTicks.hasScheduledTick(pos, type);
+}
+
+void TickScheduler::onBlockChanged(const BlockPos& pos, uint32_t oldState, uint32_t newState) {
+    ChunkTicks* chunk = getChunk(pos.x >> 4, pos.z >> 4);
+    const int section = (pos.y >> 4) - minSection;
+    if (!chunk || section < 0 || section >= static_cast<int>(chunk->randomTickingBlocks.size())) return;
+
+    const BlockStateRegistry& registry = BlockStateRegistry::instance();
+    const bool wasTicking = registry.isRandomlyTicking(oldState);
+    const bool isTicking = registry.isRandomlyTicking(newState);
+    uint16_t& count = chunk->randomTickingBlocks[section];
+    // A change reported out of step must not wrap the count, or the section is never skipped again
+    if (wasTicking && !isTicking) {
+        if (count > 0) --count;
+    } else if (isTicking && !wasTicking) {
+        if (count < 4096) ++count;
+    }
+}
+
+void TickScheduler::rebuildPhases() {
+    for (auto& phase : phases) phase.clear();
+    for (auto& [key, region] : regions) {
+        const ChunkPos regionPos = ChunkPos::fromLong(key);
+        phases[(regionPos.x & 1) | ((regionPos.z & 1) << 1)].push_back(&region);
+    }
+    phasesDirty = false;
+}
+
+void TickScheduler::tick(int64_t time, int randomTickSpeed) {
+    gameTime = time;
+    if (phasesDirty) rebuildPhases();
+
+    Stats stats;
+    stats.chunks = chunks.size();
+    stats.regions = regions.size();
+
+    std::vector<RegionStats> regionStats;
+    for (auto& phase : phases) {
+        if (phase.empty()) continue;
+
+        regionStats.assign(phase.size(), RegionStats{});
+        PrismaEngine::JobSystem::GetInstance().ParallelFor(phase.size(), [&](size_t i) {
+            tickRegion(*phase[i], randomTickSpeed, regionStats[i]);
+        });
+
+        for (const RegionStats& region : regionStats) {
+            stats.scheduledTicks += region.scheduledTicks;
+            stats.randomTicks += region.randomTicks;
+            stats.sectionsSampled += region.sectionsSampled;
+            stats.sectionsSkipped += region.sectionsSkipped;
+        }
+    }
+    lastStats = stats;
+}
+
+void TickScheduler::tickRegion(Region& region, int randomTickSpeed, RegionStats& stats) {
+    runScheduledTicks(region, false, stats);
+    runScheduledTicks(region, true, stats);
+
+    for (ChunkTicks* chunk : region.chunks) {
+        if (randomTickSpeed > 0) tickRandomly(*chunk, randomTickSpeed, stats);
+        handler.tickChunk(chunk->pos);
+    }
+}
+
+void TickScheduler::runScheduledTicks(Region& region, bool fluid, RegionStats& stats) {
+    // Ticks scheduled while running land in the heaps and run on a later game tick
+    thread_local std::vector<ScheduledTick> due;
+    due.clear();
+
+    const int64_t time = gameTime;
+    size_t budget = MAX_TICKS_PER_REGION;
+    for (ChunkTicks* chunk : region.chunks) {
+        LevelChunkTicks& ticks = fluid ? chunk->fluidTicks : chunk->blockTicks;
+        budget -= ticks.drainDue(time, budget, due);
+        if (budget == 0) break;
+    }
+    std::sort(due.begin(), due.end(), ScheduledTick::runsBefore);
+
+    for (const ScheduledTick& tick : due) {
+        if (fluid) {
+            handler.tickFluid(tick.pos, tick.type);
+        } else {
+            handler.tickBlock(tick.pos, tick.type);
+        }
+    }
+    stats.scheduledTicks += due.size();
+}
+
+void TickScheduler::tickRandomly(ChunkTicks& chunk, int randomTickSpeed, RegionStats& stats) {
+    const int sectionCount = static_cast<int>(chunk.randomTickingBlocks.size());
+    thread_local std::vector<int> active;
+    active.clear();
+    for (int section = 0; section < sectionCount; ++section) {
+        if (chunk.randomTickingBlocks[section] != 0) active.push_back(section);
+    }
+    const int activeCount = static_cast<int>(active.size());
+    stats.sectionsSkipped += sectionCount - activeCount;
+    if (activeCount == 0) return;
+
+    // Counter-based sampling: every index is an independent hash, so the loop vectorizes
+    thread_local std::vector<uint16_t> indices;
+    const size_t sampleCount = static_cast<size_t>(activeCount) * randomTickSpeed;
+    indices.resize(sampleCount);
+    const uint64_t base = mix64(seed ^ mix64(static_cast<uint64_t>(ChunkPos::asLong(chunk.pos.x, chunk.pos.z)) +
+                                             static_cast<uint64_t>(gameTime.load()) * 0x9E3779B97F4A7C15ull));
+    for (size_t k = 0; k < sampleCount; ++k) {
+        indices[k] = static_cast<uint16_t>(mix64(base + k) >> 52);
+    }
+
+    const uint16_t* flags = BlockStateRegistry::instance().getFlagsTable();
+    const uint16_t* sample = indices.data();
+    for (int i = 0; i < activeCount; ++i, sample += randomTickSpeed) {
+        const int sectionY = active[i] + minSection;
+        const uint32_t* states = handler.getSectionStates(chunk.pos.x, sectionY, chunk.pos.z);
+        if (!states) continue;
+        ++stats.sectionsSampled;
+
+        for (int j = 0; j < randomTickSpeed; ++j) {
+            const int index = sample[j];
+            const uint32_t state = states[index];
+            if (!(flags[state] & BlockStateRegistry::RANDOM_TICKS)) continue;
+
+            handler.randomTick(BlockPos((chunk.pos.x << 4) + (index & 15), (sectionY << 4) + (index >> 8),
+                                        (chunk.pos.z << 4) + ((index >> 4) & 15)), state);
+            ++stats.randomTicks;
+            // The tick may have replaced the section's storage
+            states = handler.getSectionStates(chunk.pos.x, sectionY, chunk.pos.z);
+            if (!states) break;
+        }
+    }
+}
+
+} // namespace PrismaCraft
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <PrismaCraft/PrismaCraft.h>
+#include <PrismaCraft/Core/ChunkPos.h>
+#include "LevelChunkTicks.h"
+#include "../level/chunk/LightChunkGetter.h"
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+namespace PrismaCraft {
+
+/**
+ * Level callbacks driven by TickScheduler
+ *
+ * Called concurrently from worker threads for different regions (see TickScheduler).
+ * Section states come from LightChunkGetter::getSectionStates.
+ */
+class PRISMACRAFT_API ChunkTickHandler : public LightChunkGetter {
+public:
+    virtual void tickBlock(const BlockPos& pos, uint32_t type) = 0;
+    virtual void tickFluid(const BlockPos& /*pos*/, uint32_t /*type*/) {}
+    virtual void randomTick(const BlockPos& pos, uint32_t stateId) = 0;
+
+    // Per-chunk work after block ticks (entities, block entities, weather)
+    virtual void tickChunk(const ChunkPos& /*pos*/) {}
+};
+
+/**
+ * Chunk tick loop: scheduled block/fluid ticks, random ticks and per-chunk work
+ * Corresponds to: net.minecraft.world.ticks.LevelTicks and ServerChunkCache#tickChunks
+ *
+ * Loaded chunks are partitioned into square regions of regionSize chunks. Regions are
+ * coloured by (regionX & 1, regionZ & 1) and ticked in four phases; regions of one colour
+ * are never adjacent, so each phase runs its regions in parallel on the job system. A tick
+ * may read and write blocks, and schedule ticks, in chunks up to regionSize / 2 chunks
+ * outside its own region.
+ *
+ * Random ticks draw randomTickSpeed positions per section from a counter-based generator
+ * keyed by (seed, game time, chunk), so results do not depend on thread scheduling and the
+ * sampling loop has no serial dependency. Sections holding no random-ticking states (tracked
+ * per section through onBlockChanged) are skipped without touching block data.
+ */
+class PRISMACRAFT_API TickScheduler {
+public:
+    static constexpr int DEFAULT_REGION_SIZE = 8;
+    static constexpr size_t MAX_TICKS_PER_REGION = 65536;
+
+    struct Stats {
+        uint64_t scheduledTicks = 0;
+        uint64_t randomTicks = 0;
+        uint64_t sectionsSampled = 0;
+        uint64_t sectionsSkipped = 0;
+        uint64_t chunks = 0;
+        uint64_t regions = 0;
+    };
+
+    TickScheduler(ChunkTickHandler& handler, uint64_t seed = 0, int regionSize = DEFAULT_REGION_SIZE);
+
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    // Main thread, outside tick(); block data of the chunk must be available
+    void addChunk(const ChunkPos& pos);
+    void removeChunk(const ChunkPos& pos);
+    bool hasChunk(const ChunkPos& pos) const;
+
+    // False when the chunk is not loaded or the same tick is already pending
+    bool scheduleBlockTick(const BlockPos& pos, uint32_t type, int delay, TickPriority priority = TickPriority::NORMAL);
+    bool scheduleFluidTick(const BlockPos& pos, uint32_t type, int delay, TickPriority priority = TickPriority::NORMAL);
+    bool hasScheduledBlockTick(const BlockPos& pos, uint32_t type) const;
+    bool hasScheduledFluidTick(const BlockPos& pos, uint32_t type) const;
+
+    // Must be called for every block change so empty sections keep being skipped
+    void onBlockChanged(const BlockPos& pos, uint32_t oldState, uint32_t newState);
+
+    /**
+     * Run one game tick. randomTickSpeed is the randomTickSpeed game rule (positions
+     * sampled per section); 0 disables random ticks.
+     */
+    void tick(int64_t gameTime, int randomTickSpeed);
+
+    int64_t getGameTime() const { return gameTime; }
+    const Stats& getLastTickStats() const { return lastStats; }
+
+private:
+    struct ChunkTicks {
+        ChunkPos pos;
+        LevelChunkTicks blockTicks;
+        LevelChunkTicks fluidTicks;
+        std::vector<uint16_t> randomTickingBlocks;     // Per section
+    };
+
+    struct Region {
+        std::vector<ChunkTicks*> chunks;
+    };
+
+    struct RegionStats {
+        uint64_t scheduledTicks = 0;
+        uint64_t randomTicks = 0;
+        uint64_t sectionsSampled = 0;
+        uint64_t sectionsSkipped = 0;
+    };
+
+    ChunkTicks* getChunk(int chunkX, int chunkZ) const;
+    long long getRegionKey(int chunkX, int chunkZ) const;
+    bool schedule(bool fluid, const BlockPos& pos, uint32_t type, int delay, TickPriority priority);
+    void rebuildPhases();
+
+    void tickRegion(Region& region, int randomTickSpeed, RegionStats& stats);
+    void runScheduledTicks(Region& region, bool fluid, RegionStats& stats);
+    void tickRandomly(ChunkTicks& chunk, int randomTickSpeed, RegionStats& stats);
+
+    ChunkTickHandler& handler;
+    uint64_t seed;
+    int regionSize;
+    int minSection;
+    int maxSection;
+
+    std::unordered_map<long long, std::unique_ptr<ChunkTicks>> chunks;
+    std::unordered_map<long long, Region> regions;
+    std::vector<Region*> phases[4];
+    bool phasesDirty = false;
+
+    std::atomic<int64_t> gameTime{ 0 };
+    std::atomic<uint64_t> nextSubTickOrder{ 0 };
+    Stats lastStats;
+};
+
+} // namespace PrismaCraft
@@ -3,12 +3,29 @@
 #if PRISMA_ENABLE_IMGUI_DEBUG && defined(_DEBUG)
 
 #include "Logger.h"
+#include "core/MemoryTracker.h"
 #include "imgui.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
 
 namespace PrismaEngine {
 
+namespace {
+
+// 将字节数格式化为带单位的短字符串
+void FormatBytes(char* buffer, size_t size, double bytes) {
+    const char* units[] = { "B", "KB", "MB", "GB" };
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 3) {
+        bytes /= 1024.0;
+        ++unit;
+    }
+    std::snprintf(buffer, size, unit == 0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+}
+
+} // namespace
+
 DebugOverlay& DebugOverlay::GetInstance() {
     static DebugOverlay instance;
     return instance;
@@ -199,6 +216,27 @@ void DebugOverlay::Render() {
             ImGui::Separator();
         }
 
+        // ========== 内存统计 ==========
+        if (m_showMemory) {
+            ImGui::Text("Memory (live / pool / allocs/s):");
+            char live[32];
+            char reserved[32];
+            for (size_t i = 0; i < Core::MemoryTracker::TagCount; ++i) {
+                auto tag = static_cast<Core::MemoryTag>(i);
+                Core::MemoryTagStats stats = Core::MemoryTracker::GetStats(tag);
+                if (stats.totalAllocations == 0 && stats.reservedBytes == 0) {
+                    continue;
+                }
+                FormatBytes(live, sizeof(live), static_cast<double>(stats.liveBytes));
+                FormatBytes(reserved, sizeof(reserved), static_cast<double>(stats.reservedBytes));
+                ImGui::Text("  %-10s %10s (%lld) %10s %8.0f",
+                            Core::MemoryTracker::GetTagName(tag), live,
+                            static_cast<long long>(stats.liveCount), reserved,
+                            stats.allocationsPerSecond);
+            }
+            ImGui::Separator();
+        }
+
         // ========== 消息输出 ==========
         if (m_showMessages && !m_messages.empty()) {
             ImGui::Text("Messages:");
@@ -219,6 +257,7 @@ void DebugOverlay::Render() {
             ImGui::Checkbox("Show Messages", &m_showMessages);
             ImGui::Checkbox("Show Stats", &m_showStats);
             ImGui::Checkbox("Show Watched Vars", &m_showWatchVars);
+            ImGui::Checkbox("Show Memory", &m_showMemory);
             ImGui::Separator();
             if (ImGui::MenuItem("Clear Messages")) {
                 m_messages.clear();
@@ -101,6 +101,9 @@ public:
     // 设置是否显示变量监视
     void SetShowWatchVars(bool show) { m_showWatchVars = show; }
 
+    // 设置是否显示按标签统计的内存面板
+    void SetShowMemory(bool show) { m_showMemory = show; }
+
     // ========== 渲染 ==========
 
     // 每帧更新（更新消息时间）
@@ -129,6 +132,7 @@ private:
     bool m_showMessages = true;
     bool m_showStats = true;
     bool m_showWatchVars = true;
+    bool m_showMemory = true;
 
     std::vector<DebugMessage> m_messages;
     int m_maxMessages = 20;  // 最多显示的消息数
@@ -1,9 +1,12 @@
 #include "Engine.h"
 #include "core/AssetManager.h"
+#include "core/FrameAllocator.h"
+#include "core/MemoryTracker.h"
 #include "Logger.h"
 #include "PhysicsSystem.h"
 #include "Platform.h"
 #include "graphic/RenderSystem.h"
+#include "JobSystem.h"
 #include "SceneManager.h"
 #include "ThreadManager.h"
 #include "DebugOverlay.h"
@@ -30,12 +33,25 @@ namespace PrismaEngine {
         }
         m_systems.push_back(ThreadManager::GetInstance().get());
 
+        if (JobSystem::GetInstance().Initialize() != 0) {
+            LOG_ERROR("Engine", "任务系统初始化失败");
+            return -1;
+        }
+        m_systems.push_back(&JobSystem::GetInstance());
+
         if (PhysicsSystem::GetInstance()->Initialize() != 0) {
             LOG_ERROR("Engine", "物理系统初始化失败");
             return -1;
         }
         m_systems.push_back(PhysicsSystem::GetInstance().get());
 
+        // 已由编辑器按项目根目录初始化时直接返回成功; 注册后 Update 负责热重载轮询与提交
+        if (AssetManager::GetInstance()->Initialize() != 0) {
+            LOG_ERROR("Engine", "资源管理器初始化失败");
+            return -1;
+        }
+        m_systems.push_back(AssetManager::GetInstance().get());
+
         // 注意：RenderSystem 的初始化由编辑器手动调用带参数版本，这里只注册不初始化
         m_systems.push_back(::PrismaEngine::Graphic::RenderSystem::GetInstance().get());
 
@@ -82,6 +98,11 @@ namespace PrismaEngine {
         for (ISubSystem* system : m_systems) {
             system->Update(deltaTime);
         }
+
+        Core::MemoryTracker::Update(deltaTime);
+
+        // 本帧的帧 arena 分配在此之后失效
+        Core::FrameMemory::EndFrame();
     }
 
 } // namespace PrismaEngine
@@ -7,14 +7,14 @@ namespace PrismaEngine{
         if (transform) {
             this->transform = std::move(transform);
         } else {
-            this->transform = std::make_unique<Transform>();
+            this->transform = Core::ObjectPool<Transform, Core::MemoryTag::Component>::MakeShared();
             this->transform->SetOwner(this);
             this->transform->Initialize();
         }
     }
 
     GameObject::GameObject() {
-        this->transform = std::make_unique<Transform>();
+        this->transform = Core::ObjectPool<Transform, Core::MemoryTag::Component>::MakeShared();
         this->transform->SetOwner(this);
         this->transform->Initialize();
     }
@@ -1,7 +1,10 @@
 #pragma once
 #include "Transform.h"
+#include "core/ObjectPool.h"
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
 #include <vector>
 namespace PrismaEngine {
 
@@ -12,13 +15,19 @@ public:
     std::string name;
     GameObject(std::string name, std::unique_ptr<Transform> transform = nullptr);
     GameObject();
+
+    /// @brief 从对象池创建游戏对象
+    template<typename... Args>
+    static std::shared_ptr<GameObject> Create(Args&&... args) {
+        return Core::ObjectPool<GameObject, Core::MemoryTag::Scene>::MakeShared(std::forward<Args>(args)...);
+    }
     //get属性
     [[nodiscard]] std::shared_ptr<Transform> GetTransform() { return transform; }
     
 	/// @brief 添加组件
     template<typename T>
     std::shared_ptr<T> AddComponent() {
-        auto component = std::make_shared<T>();
+        auto component = Core::ObjectPool<T, Core::MemoryTag::Component>::MakeShared();
         components.push_back(static_cast<std::shared_ptr<T>>(component));
         component->Owner(this);
         component->Initialize();
@@ -39,6 +48,14 @@ public:
 
     template <typename T>
     std::shared_ptr<T> GetComponent() {
+        // 先按精确类型匹配, 避免逐个 dynamic_cast; 查找基类或接口时再回退到 dynamic_pointer_cast
+        if constexpr (std::is_base_of_v<Component, T>) {
+            for (auto& comp : components) {
+                if (comp && typeid(*comp) == typeid(T)) {
+                    return std::static_pointer_cast<T>(comp);
+                }
+            }
+        }
         for (auto& comp : components) {
             if (auto casted = std::dynamic_pointer_cast<T>(comp)) {
                 return casted;
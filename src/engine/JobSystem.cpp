@@ -1,31 +1,227 @@
 #include "JobSystem.h"
 #include "Logger.h"
+#include <algorithm>
+#include <exception>
 
 namespace PrismaEngine {
 
+namespace {
+// 标记作业线程, 用于避免在作业内部阻塞等待
+thread_local bool t_isWorkerThread = false;
+}
+
+JobSystem& JobSystem::GetInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
 int JobSystem::Initialize() {
-    LOG_INFO("JobSystem", "任务系统初始化（基础实现）");
+    EnsureStarted();
+    LOG_INFO("JobSystem", "任务系统初始化完成，工作线程数: {0}", GetWorkerCount());
     return 0;
 }
 
+void JobSystem::EnsureStarted() {
+    if (m_started.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_startMutex);
+    if (m_started.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // 保留一个核心给主线程
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    size_t workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+    auto pool = std::make_unique<ThreadPool>();
+    pool->running = true;
+    pool->threads.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        pool->threads.emplace_back(&ThreadPool::WorkerThread, pool.get());
+    }
+    m_threadPools.push_back(std::move(pool));
+
+    m_started.store(true, std::memory_order_release);
+}
+
 void JobSystem::Shutdown() {
+    std::lock_guard<std::mutex> lock(m_startMutex);
+    if (!m_started.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    for (auto& pool : m_threadPools) {
+        {
+            std::lock_guard<std::mutex> queueLock(pool->queueMutex);
+            pool->running = false;
+        }
+        pool->condition.notify_all();
+        for (auto& thread : pool->threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+    m_threadPools.clear();
+    m_started.store(false, std::memory_order_release);
     LOG_INFO("JobSystem", "任务系统关闭");
 }
 
+size_t JobSystem::GetWorkerCount(uint32_t threadPoolIndex) const {
+    if (threadPoolIndex >= m_threadPools.size()) {
+        return 0;
+    }
+    return m_threadPools[threadPoolIndex]->threads.size();
+}
+
+bool JobSystem::IsWorkerThread() {
+    return t_isWorkerThread;
+}
+
 void JobSystem::SubmitJob(Job job, uint32_t threadPoolIndex) {
-    // 基础实现：由于目前没有真正的线程池，直接同步执行
-    LOG_DEBUG("JobSystem", "在线程池 {0} 提交任务", threadPoolIndex);
-    if (job) {
-        job();
+    if (!job) {
+        return;
     }
+
+    EnsureStarted();
+
+    if (threadPoolIndex >= m_threadPools.size()) {
+        LOG_WARNING("JobSystem", "线程池索引 {0} 无效，改用默认线程池", threadPoolIndex);
+        threadPoolIndex = 0;
+    }
+
+    ThreadPool& pool = *m_threadPools[threadPoolIndex];
+    {
+        std::lock_guard<std::mutex> lock(pool.queueMutex);
+        pool.jobQueue.push(std::move(job));
+    }
+    m_jobCounter.fetch_add(1, std::memory_order_relaxed);
+    pool.condition.notify_one();
 }
 
 void JobSystem::WaitForAllJobs() {
-    // 同步执行不需要等待
+    if (t_isWorkerThread) {
+        // 作业线程等待自身所在的队列会死锁
+        LOG_WARNING("JobSystem", "不能在作业线程中调用 WaitForAllJobs");
+        return;
+    }
+
+    for (auto& pool : m_threadPools) {
+        std::unique_lock<std::mutex> lock(pool->queueMutex);
+        pool->idleCondition.wait(lock, [&pool] {
+            return pool->jobQueue.empty() && pool->activeJobs == 0;
+        });
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, const std::function<void(size_t)>& func, uint32_t threadPoolIndex) {
+    if (count == 0) {
+        return;
+    }
+
+    EnsureStarted();
+
+    size_t workerCount = GetWorkerCount(threadPoolIndex < m_threadPools.size() ? threadPoolIndex : 0);
+    if (count == 1 || workerCount == 0) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    // 共享状态由辅助作业持有, 调用线程返回后尚未开始的作业仍可安全访问
+    struct ForState {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count = 0;
+        const std::function<void(size_t)>* func = nullptr;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;  // 第一个抛出的异常, 由 mutex 保护
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        void Run() {
+            size_t completed = 0;
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                // 出错后剩余索引只计数不执行, 保证 done 总能到达 count
+                if (!failed.load(std::memory_order_relaxed)) {
+                    try {
+                        (*func)(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+                ++completed;
+            }
+            if (completed > 0 && done.fetch_add(completed) + completed == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    };
+
+    auto state = std::make_shared<ForState>();
+    state->count = count;
+    state->func = &func;
+
+    size_t helperCount = std::min(workerCount, count - 1);
+    for (size_t i = 0; i < helperCount; ++i) {
+        SubmitJob([state] { state->Run(); }, threadPoolIndex);
+    }
+
+    state->Run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state] { return state->done.load() == state->count; });
+    // 所有辅助作业均已退出 func, 在调用线程上重新抛出
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
 }
 
 void JobSystem::ThreadPool::WorkerThread() {
-    // 待实现真正的线程池逻辑
+    t_isWorkerThread = true;
+
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            condition.wait(lock, [this] { return !running || !jobQueue.empty(); });
+            if (!running && jobQueue.empty()) {
+                return;
+            }
+            job = std::move(jobQueue.front());
+            jobQueue.pop();
+            ++activeJobs;
+        }
+
+        // 异常不能逃出工作线程, 否则 activeJobs 无法归零且进程终止
+        try {
+            job();
+        } catch (const std::exception& e) {
+            LOG_ERROR("JobSystem", "作业执行异常: {0}", e.what());
+        } catch (...) {
+            LOG_ERROR("JobSystem", "作业执行抛出未知异常");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            --activeJobs;
+            if (jobQueue.empty() && activeJobs == 0) {
+                idleCondition.notify_all();
+            }
+        }
+    }
 }
 
 }  // namespace PrismaEngine
\ No newline at end of file
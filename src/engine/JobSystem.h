@@ -1,7 +1,10 @@
 #pragma once
+#include "Export.h"
 #include "ISubSystem.h"
 #include "Singleton.h"
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -10,32 +13,56 @@
 #include <vector>
 namespace PrismaEngine {
 
-class JobSystem : public ISubSystem {
+class ENGINE_API JobSystem : public ISubSystem, public Singleton<JobSystem> {
     friend class Singleton<JobSystem>;
 
 public:
+    // 在 Engine 内定义, 遮蔽 Singleton 的内联实现, 保证跨模块 (PrismaCraft 等) 共享同一实例
+    static JobSystem& GetInstance();
+
     int Initialize() override;
     void Shutdown() override;
     using Job = std::function<void()>;
 
-    // 提交作业到指定线程池
+    // 提交作业到指定线程池 (线程池未启动时按硬件线程数自动启动)
     void SubmitJob(Job job, uint32_t threadPoolIndex = 0);
     // 等待所有作业完成
     void WaitForAllJobs();
 
+    // 并行执行 func(0..count-1) 并等待全部完成
+    // 调用线程同样参与执行, 因此可在作业内部嵌套调用而不会死锁
+    // func 抛出异常时不再执行剩余索引, 等待已开始的调用结束后在调用线程重新抛出第一个异常
+    void ParallelFor(size_t count, const std::function<void(size_t)>& func, uint32_t threadPoolIndex = 0);
+
     // 获取线程池数量
     size_t GetThreadPoolCount() const { return m_threadPools.size(); }
+    // 获取指定线程池的工作线程数量
+    size_t GetWorkerCount(uint32_t threadPoolIndex = 0) const;
+    // 当前线程是否为作业线程
+    static bool IsWorkerThread();
+
     struct ThreadPool {
         std::vector<std::thread> threads;
         std::queue<Job> jobQueue;
         std::mutex queueMutex;
         std::condition_variable condition;
+        std::condition_variable idleCondition;
         std::atomic<bool> running{false};
+        size_t activeJobs = 0;  // 受 queueMutex 保护
 
         void WorkerThread();
     };
+
+private:
+    JobSystem() = default;
+    ~JobSystem() override;
+
+    void EnsureStarted();
+
     std::vector<std::unique_ptr<ThreadPool>> m_threadPools;
     std::atomic<uint32_t> m_jobCounter{0};
+    std::mutex m_startMutex;
+    std::atomic<bool> m_started{false};
 };
 
 // 宏定义简化作业提交
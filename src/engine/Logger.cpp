@@ -155,11 +155,11 @@ Logger::~Logger() {
     Shutdown();
 }
 
-void Logger::LogInternal(LogLevel level, const std::string& category, const std::string& message, SourceLocation loc) {
+void Logger::LogInternal(LogLevel level, std::string_view category, std::string message, SourceLocation loc) {
     if (level < config_.minLevel)
         return;
 
-    LogEntry entry(level, message, category, loc);
+    LogEntry entry(level, std::move(message), std::string(category), loc);
 
     // 只有启用调用堆栈时才捕获
     if (config_.enableCallStack) {
@@ -11,6 +11,7 @@
 #include <source_location>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -58,7 +59,8 @@ public:
     void Shutdown();
 
     void SetPlatformLogger(PrismaEngine::IPlatformLogger* platformLogger);
-    void LogInternal(LogLevel level, const std::string& category, const std::string& message, SourceLocation loc);
+    // message 按值传入, 格式化结果直接移动进日志条目, 不再复制
+    void LogInternal(LogLevel level, std::string_view category, std::string message, SourceLocation loc);
 
     void SetMinLevel(LogLevel level);
     void SetTarget(LogTarget target);
@@ -78,21 +80,21 @@ public:
              std::source_location loc = std::source_location::current()) {
         if (level < GetMinLevel())
             return;
-        std::string message = std::format(fmt, std::forward<Args>(args)...);
-        LogInternal(
-            level, std::string(category), message, SourceLocation(loc.file_name(), loc.line(), loc.function_name()));
+        LogInternal(level,
+                    category,
+                    std::format(fmt, std::forward<Args>(args)...),
+                    SourceLocation(loc.file_name(), loc.line(), loc.function_name()));
     }
 
     template <typename... Args>
     inline void LogFormat(LogLevel level,
-                          const std::string& category,
+                          std::string_view category,
                           SourceLocation loc,
                           std::format_string<Args...> fmt,
                           Args&&... args) {
         if (level < GetMinLevel())
             return;
-        std::string message = std::format(fmt, std::forward<Args>(args)...);
-        LogInternal(level, category, message, loc);
+        LogInternal(level, category, std::format(fmt, std::forward<Args>(args)...), loc);
     }
 
     void Flush();
@@ -10,16 +10,20 @@ std::shared_ptr<PhysicsSystem> PhysicsSystem::GetInstance() {
 
 int PhysicsSystem::Initialize() {
     LOG_INFO("Physics", "物理系统初始化开始");
+    const auto& settings = m_world.getSettings();
+    LOG_INFO("Physics", "固定步长 {0} 秒, 求解迭代 {1} 次", settings.fixedTimeStep, settings.solverIterations);
     LOG_INFO("Physics", "物理系统初始化完成");
     return 0;
 }
 
 void PhysicsSystem::Shutdown() {
     LOG_INFO("Physics", "物理系统开始关闭");
+    m_world.clear();
 }
 
 void PhysicsSystem::Update(float deltaTime) {
     if (deltaTime <= 0.0f) return;
+    m_world.step(deltaTime);
 }
 
 }  // namespace PrismaEngine
@@ -1,7 +1,7 @@
 #pragma once
 #include "ISubSystem.h"
 #include "ManagerBase.h"
-#include "WorkerThread.h"
+#include "physics/PhysicsWorld.h"
 #include <memory>
 #include <string>
 
@@ -18,7 +18,13 @@ public:
     PhysicsSystem()           = default;
     ~PhysicsSystem() override = default;
 
+    Physics::PhysicsWorld& GetWorld() { return m_world; }
+    const Physics::PhysicsWorld& GetWorld() const { return m_world; }
+
+    // 渲染插值系数, 在上一固定步与当前固定步之间
+    double GetInterpolationAlpha() const { return m_world.getInterpolationAlpha(); }
+
 private:
-    WorkerThread m_workerThread;
+    Physics::PhysicsWorld m_world;
 };
 }  // namespace PrismaEngine
@@ -6,12 +6,26 @@
 #include "graphic/interfaces/IPipeline.h"
 #include "graphic/interfaces/ISampler.h"
 #include "graphic/interfaces/IResourceFactory.h"
+#include "core/VirtualFileSystem.h"
+#include "graphic/Ktx2.h"
+#include "stb_image.h"
 #include <chrono>
+#include <climits>
 #include <fstream>
 #include <algorithm>
 
 namespace PrismaEngine::Graphic {
 
+namespace {
+
+// 流式加载的解码结果
+struct DecodedImage {
+    std::vector<uint8_t> pixels;
+    TextureDesc desc;
+};
+
+} // namespace
+
 std::shared_ptr<ResourceManager> ResourceManager::GetInstance() {
     static std::shared_ptr<ResourceManager> instance = std::make_shared<ResourceManager>();
     return instance;
@@ -21,7 +35,6 @@ ResourceManager::ResourceManager()
     : m_device(nullptr)
     , m_initialized(false)
     , m_nextId(1)
-    , m_shouldStopLoading(false)
     , m_hotReloadEnabled(false)
     , m_hotReloadTimer(0.0f)
     , m_statsDirty(true)
@@ -41,8 +54,13 @@ int ResourceManager::Initialize(IRenderDevice* device) {
     if (!device) return 1;
     m_device = device;
     
-    // 启动异步加载线程
-    m_loadingThread = std::thread(&ResourceManager::LoadingThreadFunction, this);
+    // 启动流式加载器 (I/O 线程 + JobSystem 解码 + Update 中上传)
+    if (!m_streamingLoader) {
+        m_streamingLoader = std::make_unique<Core::StreamingLoader>();
+    }
+    if (!m_textureStreamer) {
+        m_textureStreamer = std::make_unique<TextureStreamer>(device, *m_streamingLoader);
+    }
     
     m_initialized = true;
     LOG_INFO("ResourceManager", "Resource manager initialized.");
@@ -63,6 +81,13 @@ void ResourceManager::RegisterResource(std::shared_ptr<IResource> resource, cons
 void ResourceManager::Update(float deltaTime) {
     if (!m_initialized) return;
 
+    if (m_streamingLoader) {
+        m_streamingLoader->Update();
+    }
+    if (m_textureStreamer) {
+        m_textureStreamer->Update();
+    }
+
     if (m_hotReloadEnabled) {
         m_hotReloadTimer += deltaTime;
         if (m_hotReloadTimer >= HOT_RELOAD_INTERVAL) {
@@ -77,10 +102,15 @@ void ResourceManager::Update(float deltaTime) {
 }
 
 void ResourceManager::Shutdown() {
-    m_shouldStopLoading = true;
-    m_loadQueueCV.notify_all();
-    if (m_loadingThread.joinable()) {
-        m_loadingThread.join();
+    // 流式纹理的请求引用加载器, 先于加载器销毁
+    m_textureStreamer.reset();
+    if (m_streamingLoader) {
+        m_streamingLoader->Shutdown();
+        m_streamingLoader.reset();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        m_asyncRequests.clear();
     }
 
     ReleaseAllResources();
@@ -94,7 +124,8 @@ std::shared_ptr<ITexture> ResourceManager::LoadTexture(const std::string& filena
     res = LoadTextureSync(filename, generateMips);
     if (res) {
         RegisterResource(res, filename);
-        if (std::filesystem::exists(filename)) {
+        // 归档中的资源不参与热重载, 也无需访问文件系统
+        if (!Core::VirtualFileSystem::GetInstance().Exists(filename) && std::filesystem::exists(filename)) {
             m_fileTimestamps[filename] = std::filesystem::last_write_time(filename);
         }
     }
@@ -152,7 +183,8 @@ std::shared_ptr<IShader> ResourceManager::LoadShader(const std::string& filename
     res = LoadShaderSync(filename, entryPoint, target, defines);
     if (res) {
         RegisterResource(res, filename);
-        if (std::filesystem::exists(filename)) {
+        // 归档中的资源不参与热重载, 也无需访问文件系统
+        if (!Core::VirtualFileSystem::GetInstance().Exists(filename) && std::filesystem::exists(filename)) {
             m_fileTimestamps[filename] = std::filesystem::last_write_time(filename);
         }
     }
@@ -240,38 +272,147 @@ void ResourceManager::GarbageCollect() {
 }
 
 ResourceId ResourceManager::LoadTextureAsync(const std::string& filename) {
+    return LoadTextureAsync(filename, 0.0f);
+}
+
+ResourceId ResourceManager::LoadTextureAsync(const std::string& filename, float priority, TextureCallback callback) {
     ResourceId id = GenerateId();
-    ResourceLoadTask task;
-    task.type = ResourceLoadTask::LoadTexture;
-    task.path = filename;
-    task.id = id;
-    
-    {
-        std::lock_guard<std::mutex> lock(m_loadQueueMutex);
-        m_loadQueue.push(task);
-    }
-    m_loadQueueCV.notify_one();
-    return id;
+
+    Core::StreamRequest request;
+    request.path     = filename;
+    request.priority = priority;
+
+    // 工作线程: 解码图像 (KTX2 无需解码, 保留源数据在上传时直接使用)
+    request.decode = [](Core::StreamPayload& payload) {
+        if (Ktx2::IsKtx2(payload.Data(), payload.Size())) {
+            payload.uploadBytes = payload.Size();
+            return true;
+        }
+
+        auto image = std::make_shared<DecodedImage>();
+        if (!DecodeImage(payload.Data(), payload.Size(), image->pixels, image->desc)) {
+            return false;
+        }
+        image->desc.filename = payload.path;
+        image->desc.mipLevels = 0;
+        payload.uploadBytes   = image->pixels.size();
+        payload.decoded       = image;
+        return true;
+    };
+
+    // 主线程: 创建纹理
+    request.upload = [this, id, filename, callback](Core::StreamPayload& payload) {
+        auto image = std::static_pointer_cast<DecodedImage>(payload.decoded);
+        std::shared_ptr<ITexture> texture;
+        if (!image) {
+            texture = CreateTextureFromKtx2(payload.Data(), payload.Size(), filename);
+        } else if (m_device && m_device->GetResourceFactory()) {
+            texture = m_device->GetResourceFactory()->CreateTextureFromMemory(
+                image->pixels.data(), image->pixels.size(), image->desc);
+        }
+
+        CompleteAsyncLoad(id, filename, texture);
+        if (callback) callback(id, texture);
+        return texture != nullptr;
+    };
+
+    request.onFailed = [this, id, filename, callback](Core::StreamRequestId) {
+        CompleteAsyncLoad(id, filename, nullptr);
+        if (callback) callback(id, nullptr);
+    };
+
+    return SubmitAsyncLoad(id, std::move(request));
 }
 
 ResourceId ResourceManager::LoadShaderAsync(const std::string& filename) {
     ResourceId id = GenerateId();
-    ResourceLoadTask task;
-    task.type = ResourceLoadTask::LoadShader;
-    task.path = filename;
-    task.id = id;
 
-    {
-        std::lock_guard<std::mutex> lock(m_loadQueueMutex);
-        m_loadQueue.push(task);
+    Core::StreamRequest request;
+    request.path   = filename;
+    request.upload = [this, id, filename](Core::StreamPayload& payload) {
+        std::string source(reinterpret_cast<const char*>(payload.Data()), payload.Size());
+        std::shared_ptr<IShader> shader = BuildShader(source, "main", "ps_6_0", {});
+        CompleteAsyncLoad(id, filename, shader);
+        return shader != nullptr;
+    };
+    request.onFailed = [this, id, filename](Core::StreamRequestId) {
+        CompleteAsyncLoad(id, filename, nullptr);
+    };
+
+    return SubmitAsyncLoad(id, std::move(request));
+}
+
+ResourceId ResourceManager::SubmitAsyncLoad(ResourceId id, Core::StreamRequest request) {
+    if (!m_streamingLoader) {
+        LOG_ERROR("ResourceManager", "资源管理器未初始化, 无法异步加载: {0}", request.path);
+        return 0;
     }
-    m_loadQueueCV.notify_one();
+
+    // 先登记再提交, 保证回调中能找到对应请求
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    Core::StreamRequestId requestId = m_streamingLoader->Submit(std::move(request));
+    if (requestId == Core::InvalidStreamRequest) {
+        return 0;
+    }
+    m_asyncRequests[id] = requestId;
     return id;
 }
 
+void ResourceManager::CompleteAsyncLoad(ResourceId id, const std::string& filename, std::shared_ptr<IResource> resource) {
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        m_asyncRequests.erase(id);
+    }
+    if (!resource) return;
+
+    {
+        std::unique_lock<std::shared_mutex> lock(m_resourceMutex);
+        m_resources[id]       = resource;
+        m_nameToId[filename]  = id;
+        m_statsDirty          = true;
+    }
+
+    if (!Core::VirtualFileSystem::GetInstance().Exists(filename) && std::filesystem::exists(filename)) {
+        m_fileTimestamps[filename] = std::filesystem::last_write_time(filename);
+    }
+}
+
+std::shared_ptr<StreamedTexture> ResourceManager::LoadStreamedTexture(const std::string& filename, float priority) {
+    if (!m_textureStreamer) {
+        LOG_WARNING("ResourceManager", "资源管理器未初始化, 无法流式加载纹理: {0}", filename);
+        return nullptr;
+    }
+    return m_textureStreamer->Load(filename, priority);
+}
+
+bool ResourceManager::SetAsyncLoadPriority(ResourceId id, float priority) {
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    auto it = m_asyncRequests.find(id);
+    return it != m_asyncRequests.end() && m_streamingLoader->SetPriority(it->second, priority);
+}
+
+bool ResourceManager::CancelAsyncLoad(ResourceId id) {
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    auto it = m_asyncRequests.find(id);
+    if (it == m_asyncRequests.end() || !m_streamingLoader->Cancel(it->second)) {
+        return false;
+    }
+    m_asyncRequests.erase(it);
+    return true;
+}
+
+void ResourceManager::SetUploadBudget(uint64_t bytesPerFrame) {
+    if (m_streamingLoader) m_streamingLoader->SetUploadBudget(bytesPerFrame);
+}
+
+Core::StreamingLoader::Stats ResourceManager::GetStreamingStats() const {
+    return m_streamingLoader ? m_streamingLoader->GetStats() : Core::StreamingLoader::Stats{};
+}
+
 bool ResourceManager::IsAsyncLoadingComplete(ResourceId id) {
-    std::shared_lock<std::shared_mutex> lock(m_resourceMutex);
-    return m_resources.find(id) != m_resources.end();
+    // 失败或取消的请求同样视为结束
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    return m_asyncRequests.find(id) == m_asyncRequests.end();
 }
 
 ResourceStats ResourceManager::GetResourceStats() const {
@@ -296,54 +437,76 @@ ResourceId ResourceManager::GenerateId() {
     return m_nextId++;
 }
 
-void ResourceManager::LoadingThreadFunction() {
-    while (!m_shouldStopLoading) {
-        ResourceLoadTask task;
-        {
-            std::unique_lock<std::mutex> lock(m_loadQueueMutex);
-            m_loadQueueCV.wait(lock, [this]{ return !m_loadQueue.empty() || m_shouldStopLoading; });
-            if (m_shouldStopLoading) break;
-            task = m_loadQueue.front();
-            m_loadQueue.pop();
-        }
-        ProcessLoadTask(task);
-    }
-}
-
-void ResourceManager::ProcessLoadTask(const ResourceLoadTask& task) {
-    std::shared_ptr<IResource> resource = nullptr;
-    if (task.type == ResourceLoadTask::LoadTexture) {
-        resource = LoadTextureSync(task.path, true);
-    } else if (task.type == ResourceLoadTask::LoadShader) {
-        resource = LoadShaderSync(task.path, "main", "ps_6_0", {});
-    }
-
-    if (resource) {
-        std::unique_lock<std::shared_mutex> lock(m_resourceMutex);
-        m_resources[task.id] = resource;
-        if (!task.name.empty()) m_nameToId[task.name] = task.id;
-        m_statsDirty = true;
-    }
-}
-
 std::shared_ptr<ITexture> ResourceManager::LoadTextureSync(const std::string& filename, bool generateMips) {
     if (!m_device || !m_device->GetResourceFactory()) return nullptr;
+    Core::VfsFile archived;
+    std::vector<uint8_t> fileData;
+    if (!ReadFileData(filename, archived, fileData)) return nullptr;
+
+    const uint8_t* bytes = archived ? archived.Data() : fileData.data();
+    const size_t size    = archived ? archived.Size() : fileData.size();
+    if (Ktx2::IsKtx2(bytes, size)) {
+        return CreateTextureFromKtx2(bytes, size, filename);
+    }
+
     TextureDesc desc;
     std::vector<uint8_t> data;
-    if (LoadImageFromFile(filename, data, desc)) {
+    if (DecodeImage(bytes, size, data, desc)) {
+        desc.filename  = filename;
         desc.mipLevels = generateMips ? 0 : 1;
         auto texture = m_device->GetResourceFactory()->CreateTextureFromMemory(data.data(), data.size(), desc);
         return std::shared_ptr<ITexture>(std::move(texture));
     }
+    LOG_WARNING("ResourceManager", "图像解码失败: {0}", filename);
     return nullptr;
 }
 
+std::shared_ptr<ITexture> ResourceManager::CreateTextureFromKtx2(const uint8_t* data, size_t size, const std::string& filename) {
+    if (!m_device || !m_device->GetResourceFactory()) return nullptr;
+
+    Ktx2::Image image;
+    std::string error;
+    if (!Ktx2::Parse(data, size, image, &error)) {
+        LOG_WARNING("ResourceManager", "KTX2 解析失败: {0} ({1})", filename, error);
+        return nullptr;
+    }
+
+    // 预生成的 MIP 逐级上传, 压缩格式无法在 GPU 上重新生成
+    TextureDesc desc;
+    desc.type      = TextureType::Texture2D;
+    desc.format    = image.format;
+    desc.width     = image.width;
+    desc.height    = image.height;
+    desc.mipLevels = static_cast<uint32_t>(image.levels.size());
+    desc.filename  = filename;
+
+    std::shared_ptr<ITexture> texture = m_device->GetResourceFactory()->CreateTextureImpl(desc);
+    if (!texture) return nullptr;
+
+    for (uint32_t mip = 0; mip < image.levels.size(); ++mip) {
+        const Ktx2::Level& level = image.levels[mip];
+        texture->UpdateData(level.data, level.size, mip, 0, 0, 0, 0, level.width, level.height, 1);
+    }
+    return texture;
+}
+
 std::shared_ptr<IShader> ResourceManager::LoadShaderSync(const std::string& filename, const std::string& entryPoint, const std::string& target, const std::vector<std::string>& defines) {
     if (!m_device || !m_device->GetResourceFactory()) return nullptr;
-    std::ifstream file(filename);
-    if (!file.is_open()) return nullptr;
-    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    
+    std::string source;
+    if (Core::VfsFile archived = Core::VirtualFileSystem::GetInstance().Open(filename)) {
+        source.assign(archived.Text());
+    } else {
+        std::ifstream file(filename);
+        if (!file.is_open()) return nullptr;
+        source.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+    return BuildShader(source, entryPoint, target, defines);
+}
+
+std::shared_ptr<IShader> ResourceManager::BuildShader(const std::string& source, const std::string& entryPoint, const std::string& target, const std::vector<std::string>& defines) {
+    if (!m_device || !m_device->GetResourceFactory()) return nullptr;
+    (void)source;
+
     ShaderDesc desc;
     desc.entryPoint = entryPoint;
     desc.target = target;
@@ -386,9 +549,46 @@ void ResourceManager::SaveToCache(const std::string& filename, const void* data,
     (void)filename; (void)data; (void)size;
 }
 
+bool ResourceManager::ReadFileData(const std::string& filename, Core::VfsFile& archived, std::vector<uint8_t>& fileData) {
+    archived = Core::VirtualFileSystem::GetInstance().Open(filename);
+    if (archived) return true;
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+    fileData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
 bool ResourceManager::LoadImageFromFile(const std::string& filename, std::vector<uint8_t>& data, TextureDesc& desc) {
-    (void)filename; (void)data; (void)desc;
-    return false;
+    Core::VfsFile archived;
+    std::vector<uint8_t> fileData;
+    if (!ReadFileData(filename, archived, fileData)) return false;
+
+    const uint8_t* bytes = archived ? archived.Data() : fileData.data();
+    const size_t size    = archived ? archived.Size() : fileData.size();
+    if (!DecodeImage(bytes, size, data, desc)) {
+        LOG_WARNING("ResourceManager", "图像解码失败: {0}", filename);
+        return false;
+    }
+    desc.filename = filename;
+    return true;
+}
+
+bool ResourceManager::DecodeImage(const uint8_t* fileData, size_t fileSize, std::vector<uint8_t>& pixels, TextureDesc& desc) {
+    if (!fileData || fileSize == 0 || fileSize > static_cast<size_t>(INT_MAX)) return false;
+
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* image = stbi_load_from_memory(fileData, static_cast<int>(fileSize), &width, &height, &channels, STBI_rgb_alpha);
+    if (!image) return false;
+
+    pixels.assign(image, image + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    stbi_image_free(image);
+
+    desc.type   = TextureType::Texture2D;
+    desc.format = TextureFormat::RGBA8_UNorm;
+    desc.width  = static_cast<uint64_t>(width);
+    desc.height = static_cast<uint64_t>(height);
+    return true;
 }
 
 } // namespace PrismaEngine::Graphic
\ No newline at end of file
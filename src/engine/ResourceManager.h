@@ -5,14 +5,15 @@
 #include "graphic/interfaces/IRenderDevice.h"
 #include "graphic/interfaces/IResourceManager.h"
 #include "graphic/RenderDesc.h"
+#include "graphic/TextureStreamer.h"
+#include "core/StreamingLoader.h"
+#include "core/VirtualFileSystem.h"
 #include <atomic>
-#include <condition_variable>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <shared_mutex>
-#include <thread>
 #include <unordered_map>
 
 namespace PrismaEngine::Graphic {
@@ -23,14 +24,6 @@ class IBuffer;
 class IPipeline;
 class ISampler;
 
-struct ResourceLoadTask {
-    enum Type { LoadTexture, LoadShader, LoadMesh } type;
-    std::string path;
-    std::string name;
-    ResourceId id;
-    std::function<void(ResourceId, std::shared_ptr<IResource>)> callback;
-};
-
 class ENGINE_API ResourceManager : public IResourceManager, public ManagerBase<ResourceManager> {
 public:
     static std::shared_ptr<ResourceManager> GetInstance();
@@ -76,6 +69,28 @@ public:
     ResourceId LoadShaderAsync(const std::string& filename) override;
     bool IsAsyncLoadingComplete(ResourceId id) override;
 
+    // === 流式加载 ===
+    // 读取和解码在后台进行, 纹理创建在 Update 中按优先级执行并受每帧上传预算限制
+    using TextureCallback = std::function<void(ResourceId, std::shared_ptr<ITexture>)>;
+
+    /**
+     * @brief 按优先级异步加载纹理
+     * @param priority 数值越小越优先 (例如到相机的距离)
+     * @param callback 在 Update 中调用, 失败时纹理为空 (取消的请求不会回调)
+     */
+    ResourceId LoadTextureAsync(const std::string& filename, float priority, TextureCallback callback = nullptr);
+    bool SetAsyncLoadPriority(ResourceId id, float priority);
+    bool CancelAsyncLoad(ResourceId id);
+    void SetUploadBudget(uint64_t bytesPerFrame);
+    Core::StreamingLoader::Stats GetStreamingStats() const;
+
+    /**
+     * @brief 按 MIP 级别流式加载纹理
+     * 先加载尾部级别, 更高精度的级别根据渲染器上报的屏幕尺寸加载, 并受纹理显存预算限制
+     */
+    std::shared_ptr<StreamedTexture> LoadStreamedTexture(const std::string& filename, float priority = 0.0f);
+    TextureStreamer* GetTextureStreamer() const { return m_textureStreamer.get(); }
+
     // === 统计与调试 ===
     ResourceStats GetResourceStats() const override;
     void EnableHotReload(bool enable) override;
@@ -100,13 +115,20 @@ public:
     
     void RegisterResource(std::shared_ptr<IResource> resource, const std::string& name = "");
 
+    /**
+     * @brief 将内存中的图像文件解码为 RGBA8 像素, 可在任意线程调用
+     */
+    static bool DecodeImage(const uint8_t* fileData, size_t fileSize, std::vector<uint8_t>& pixels, TextureDesc& desc);
+
 private:
     ResourceId GenerateId();
-    void LoadingThreadFunction();
-    void ProcessLoadTask(const ResourceLoadTask& task);
+    ResourceId SubmitAsyncLoad(ResourceId id, Core::StreamRequest request);
+    void CompleteAsyncLoad(ResourceId id, const std::string& filename, std::shared_ptr<IResource> resource);
 
     std::shared_ptr<ITexture> LoadTextureSync(const std::string& filename, bool generateMips);
+    std::shared_ptr<ITexture> CreateTextureFromKtx2(const uint8_t* data, size_t size, const std::string& filename);
     std::shared_ptr<IShader> LoadShaderSync(const std::string& filename, const std::string& entryPoint, const std::string& target, const std::vector<std::string>& defines);
+    std::shared_ptr<IShader> BuildShader(const std::string& source, const std::string& entryPoint, const std::string& target, const std::vector<std::string>& defines);
 
     void UpdateResourceStats() const;
     void UpdateFileTimestamps();
@@ -114,6 +136,7 @@ private:
 
     bool LoadFromCache(const std::string& filename, std::vector<uint8_t>& data);
     void SaveToCache(const std::string& filename, const void* data, size_t size);
+    bool ReadFileData(const std::string& filename, Core::VfsFile& archived, std::vector<uint8_t>& fileData);
     bool LoadImageFromFile(const std::string& filename, std::vector<uint8_t>& data, TextureDesc& desc);
 
 private:
@@ -125,11 +148,10 @@ private:
     std::unordered_map<std::string, ResourceId> m_nameToId;
     mutable std::shared_mutex m_resourceMutex;
 
-    std::queue<ResourceLoadTask> m_loadQueue;
-    std::mutex m_loadQueueMutex;
-    std::condition_variable m_loadQueueCV;
-    std::thread m_loadingThread;
-    std::atomic<bool> m_shouldStopLoading;
+    std::unique_ptr<Core::StreamingLoader> m_streamingLoader;
+    std::unique_ptr<TextureStreamer> m_textureStreamer;
+    std::unordered_map<ResourceId, Core::StreamRequestId> m_asyncRequests;
+    mutable std::mutex m_asyncMutex;
 
     bool m_hotReloadEnabled;
     float m_hotReloadTimer;
@@ -2,6 +2,7 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include "core/ObjectPool.h"
 
 // 前向声明
 namespace PrismaEngine::Graphic {
@@ -10,6 +11,15 @@ namespace PrismaEngine::Graphic {
 
 class SceneNode {
 public:
+    virtual ~SceneNode() = default;
+
+    // 从对象池创建节点, T 可以是 SceneNode 的派生类
+    template<typename T = SceneNode, typename... Args>
+    static std::shared_ptr<T> Create(Args&&... args) {
+        return PrismaEngine::Core::ObjectPool<T, PrismaEngine::Core::MemoryTag::Scene>::MakeShared(
+            std::forward<Args>(args)...);
+    }
+
     // 添加子节点
     void AddChild(std::shared_ptr<SceneNode> child) {
         child->m_parent = this;
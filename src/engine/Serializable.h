@@ -25,93 +25,37 @@ public:
 
 // GLM 向量类型序列化（跨平台）
 template <> inline void OutputArchive::SerializeValue(const std::string& key, const PrismaEngine::Vector3& value) {
-    SetCurrent(key);
-    uint32_t size = 3;
-    BeginArray(key, size);
-    WriteFloat(value.x);
-    WriteFloat(value.y);
-    WriteFloat(value.z);
-    EndArray();
+    SerializeArray(key, &value.x, 3);
 }
 
 template <> inline void InputArchive::DeserializeValue(const std::string& key, PrismaEngine::Vector3& value) {
-    uint32_t size = 0;
-    BeginArray(key, size);
-    if (size >= 3) {
-        value.x = ReadFloat();
-        value.y = ReadFloat();
-        value.z = ReadFloat();
-    }
-    EndArray();
+    DeserializeArray(key, &value.x, 3);
 }
 
 template <> inline void OutputArchive::SerializeValue(const std::string& key, const PrismaEngine::Vector4& value) {
-    SetCurrent(key);
-    uint32_t size = 4;
-    BeginArray(key, size);
-    WriteFloat(value.x);
-    WriteFloat(value.y);
-    WriteFloat(value.z);
-    WriteFloat(value.w);
-    EndArray();
+    SerializeArray(key, &value.x, 4);
 }
 
 template <> inline void InputArchive::DeserializeValue(const std::string& key, PrismaEngine::Vector4& value) {
-    uint32_t size = 0;
-    BeginArray(key, size);
-    if (size >= 4) {
-        value.x = ReadFloat();
-        value.y = ReadFloat();
-        value.z = ReadFloat();
-        value.w = ReadFloat();
-    }
-    EndArray();
+    DeserializeArray(key, &value.x, 4);
 }
 
 #ifdef _WIN32
 // DirectXMath 类型序列化（仅 Windows 平台）
 template <> inline void OutputArchive::SerializeValue(const std::string& key, const DirectX::XMFLOAT3& value) {
-    SetCurrent(key);
-    uint32_t size = 3;
-    BeginArray(key, size);
-    WriteFloat(value.x);
-    WriteFloat(value.y);
-    WriteFloat(value.z);
-    EndArray();
+    SerializeArray(key, &value.x, 3);
 }
 
 template <> inline void InputArchive::DeserializeValue(const std::string& key, DirectX::XMFLOAT3& value) {
-    uint32_t size = 0;
-    BeginArray(key, size);
-    if (size >= 3) {
-        value.x = ReadFloat();
-        value.y = ReadFloat();
-        value.z = ReadFloat();
-    }
-    EndArray();
+    DeserializeArray(key, &value.x, 3);
 }
 
 template <> inline void OutputArchive::SerializeValue(const std::string& key, const DirectX::XMFLOAT4& value) {
-    SetCurrent(key);
-    uint32_t size = 4;
-    BeginArray(key, size);
-    WriteFloat(value.x);
-    WriteFloat(value.y);
-    WriteFloat(value.z);
-    WriteFloat(value.w);
-    EndArray();
+    SerializeArray(key, &value.x, 4);
 }
 
 template <> inline void InputArchive::DeserializeValue(const std::string& key, DirectX::XMFLOAT4& value) {
-    uint32_t size = 0;
-    BeginArray(key, size);
-    if (size >= 4) {
-        value.x = ReadFloat();
-        value.y = ReadFloat();
-        value.z = ReadFloat();
-        value.w = ReadFloat();
-    }
-    EndArray();
+    DeserializeArray(key, &value.x, 4);
 }
 #endif
 
@@ -69,7 +69,7 @@ std::shared_ptr<GameObject> TriangleExample::CreateTriangle(const std::string& n
                                                           PrismaEngine::Color color)
 {
     // 创建游戏对象
-    auto gameObject = std::make_shared<GameObject>(name);
+    auto gameObject = GameObject::Create(name);
     
     // 添加变换组件并设置位置
     auto transform = gameObject->GetTransform();
@@ -106,7 +106,7 @@ std::shared_ptr<GameObject> TriangleExample::CreateTriangle(const std::string& n
 std::shared_ptr<GameObject> TriangleExample::CreateQuad(const std::string& name, PrismaEngine::Vector3 pos,PrismaEngine::Color color,float size)
 {
     // 创建游戏对象
-    auto gameObject = std::make_shared<GameObject>(name);
+    auto gameObject = GameObject::Create(name);
 
     // 添加变换组件并设置位置
     auto transform = gameObject->GetTransform();
@@ -156,7 +156,7 @@ std::shared_ptr<GameObject> TriangleExample::CreateCube(const std::string& name,
                                                         PrismaEngine::Color color, float size)
 {
     // 创建游戏对象
-    auto gameObject = std::make_shared<GameObject>(name);
+    auto gameObject = GameObject::Create(name);
 
     // 添加变换组件并设置位置
     auto transform = gameObject->GetTransform();
@@ -228,7 +228,7 @@ std::shared_ptr<GameObject> TriangleExample::CreateGround(const std::string& nam
                                                          PrismaEngine::Color color, float size)
 {
     // 创建游戏对象
-    auto gameObject = std::make_shared<GameObject>(name);
+    auto gameObject = GameObject::Create(name);
 
     // 添加变换组件并设置位置
     auto transform = gameObject->GetTransform();
@@ -281,7 +281,7 @@ std::shared_ptr<GameObject> TriangleExample::CreateCamera(const std::string& nam
     using namespace PrismaEngine::Graphic;
 
     // 创建游戏对象
-    auto game_object = std::make_shared<GameObject>(name);
+    auto game_object = GameObject::Create(name);
 
     // 添加变换组件并设置位置
     auto transform = game_object->GetTransform();
@@ -315,7 +315,7 @@ std::shared_ptr<GameObject> TriangleExample::CreateDebugText(const std::string&
     using namespace PrismaEngine;
 
     // 创建游戏对象
-    auto gameObject = std::make_shared<GameObject>(name);
+    auto gameObject = GameObject::Create(name);
 
     // 添加变换组件并设置位置（屏幕中央）
     auto transform = gameObject->GetTransform();
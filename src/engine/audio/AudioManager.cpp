@@ -1,5 +1,6 @@
 #include "AudioManager.h"
 #include "Logger.h"
+#include "core/ObjectPool.h"
 #include <filesystem>
 #include <algorithm>
 
@@ -70,7 +71,7 @@ bool AudioManager::Initialize(int maxSources) {
 
     // 创建AudioSource包装
     for (int i = 0; i < maxSources; ++i) {
-        auto source = std::make_shared<AudioSource>();
+        auto source = Core::ObjectPool<AudioSource, Core::MemoryTag::Audio>::MakeShared();
         source->m_sourceHandle = reinterpret_cast<void*>(sourceIds[i]);
         m_sources.push_back(source);
         m_availableSources.push_back(source);
@@ -1,6 +1,12 @@
 #pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace PrismaEngine {
 // ============================================================================
@@ -21,6 +27,16 @@ public:
     virtual bool IsLoaded() const                        = 0;
     virtual AssetType GetType() const                 = 0;
 
+    // 从内存加载 (例如归档中的条目); 不支持时返回 false, 由调用方回退到文件加载
+    virtual bool LoadFromMemory(const std::filesystem::path& path, const uint8_t* data, size_t size) {
+        (void)path; (void)data; (void)size;
+        return false;
+    }
+
+    // 加载时读取的其他文件 (纹理、材质库等), 热重载时这些文件变化也会触发重载
+    // 相对路径按资源搜索路径解析
+    virtual std::vector<std::filesystem::path> GetFileDependencies() const { return {}; }
+
     const std::filesystem::path& GetPath() const { return m_path; }
     const std::string& GetName() const { return m_name; }
 
@@ -38,20 +54,52 @@ protected:
     friend class ResourceFallback;
 };
 
-// 资源句柄（同前）
+// 资源槽: 同一路径的所有句柄共享, 热重载时 AssetManager 在帧边界替换其中的资源
+struct AssetSlot {
+    std::shared_ptr<AssetBase> owner;              // 仅由 AssetManager 修改
+    std::atomic<AssetBase*> current{nullptr};
+    std::atomic<uint32_t> version{0};              // 每次替换递增
+
+    // 重载批次中已加载但尚未提交的新资源, 只对执行重载的线程可见,
+    // 使依赖它的资源在同一批次中重载时看到新版本
+    std::atomic<AssetBase*> staged{nullptr};
+    std::atomic<std::thread::id> stagingThread{};
+
+    AssetSlot() = default;
+    explicit AssetSlot(std::shared_ptr<AssetBase> asset) : owner(std::move(asset)), current(owner.get()) {}
+
+    AssetBase* Get() const {
+        AssetBase* pending = staged.load(std::memory_order_acquire);
+        if (pending && stagingThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+            return pending;
+        }
+        return current.load(std::memory_order_acquire);
+    }
+};
+
+// 资源句柄
+// 指向资源槽, 热重载后自动指向新资源; 被替换的资源在下一帧才释放, 因此本帧内取得的指针保持有效
 template <typename T> class ResourceHandle {
 public:
     ResourceHandle() = default;
-    explicit ResourceHandle(std::shared_ptr<T> resource) : m_resource(resource) {}
+    explicit ResourceHandle(std::shared_ptr<T> resource)
+        : m_slot(resource ? std::make_shared<AssetSlot>(std::move(resource)) : nullptr) {}
+    explicit ResourceHandle(std::shared_ptr<AssetSlot> slot) : m_slot(std::move(slot)) {}
 
-    T* Get() const { return m_resource.get(); }
+    T* Get() const { return m_slot ? static_cast<T*>(m_slot->Get()) : nullptr; }
     T* operator->() const { return Get(); }
     T& operator*() const { return *Get(); }
-    [[nodiscard]] bool IsValid() const { return m_resource != nullptr && m_resource->IsLoaded(); }
+    [[nodiscard]] bool IsValid() const {
+        T* resource = Get();
+        return resource != nullptr && resource->IsLoaded();
+    }
     explicit operator bool() const { return IsValid(); }
 
+    // 热重载版本号, 可用于检测资源是否已被替换 (例如重建派生的 GPU 数据)
+    uint32_t GetVersion() const { return m_slot ? m_slot->version.load(std::memory_order_acquire) : 0; }
+
 private:
-    std::shared_ptr<T> m_resource;
+    std::shared_ptr<AssetSlot> m_slot;
 };
 
 }  // namespace Engine
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "AssetDependencyGraph.h"
+#include <deque>
+#include <mutex>
+
+namespace PrismaEngine {
+namespace Core {
+
+void AssetDependencyGraph::AddDependency(const std::string& asset, const std::string& dependency) {
+    if (asset == dependency) return;
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_nodes[asset].dependencies.insert(dependency);
+    m_nodes[dependency].dependents.insert(asset);
+}
+
+void AssetDependencyGraph::ClearDependencies(const std::string& asset) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_nodes.find(asset);
+    if (it == m_nodes.end()) return;
+
+    for (const std::string& dependency : it->second.dependencies) {
+        auto dep = m_nodes.find(dependency);
+        if (dep != m_nodes.end()) dep->second.dependents.erase(asset);
+    }
+    it->second.dependencies.clear();
+}
+
+void AssetDependencyGraph::Remove(const std::string& asset) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_nodes.find(asset);
+    if (it == m_nodes.end()) return;
+
+    for (const std::string& dependency : it->second.dependencies) {
+        auto dep = m_nodes.find(dependency);
+        if (dep != m_nodes.end()) dep->second.dependents.erase(asset);
+    }
+    // 保留依赖它的资源的出边: 资源重新加载后这些资源仍需随之重载
+    it->second.dependencies.clear();
+    if (it->second.dependents.empty()) {
+        m_nodes.erase(it);
+    }
+}
+
+void AssetDependencyGraph::Clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_nodes.clear();
+}
+
+std::vector<std::string> AssetDependencyGraph::GetDependencies(const std::string& asset) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_nodes.find(asset);
+    if (it == m_nodes.end()) return {};
+    return { it->second.dependencies.begin(), it->second.dependencies.end() };
+}
+
+std::vector<std::string> AssetDependencyGraph::GetDependents(const std::string& asset) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_nodes.find(asset);
+    if (it == m_nodes.end()) return {};
+    return { it->second.dependents.begin(), it->second.dependents.end() };
+}
+
+std::vector<std::string> AssetDependencyGraph::CollectDependents(const std::vector<std::string>& roots) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+    // 沿反向边收集受影响的集合
+    std::vector<std::string> affected;
+    std::unordered_map<std::string, size_t> index;
+    std::deque<std::string> queue(roots.begin(), roots.end());
+    while (!queue.empty()) {
+        std::string current = std::move(queue.front());
+        queue.pop_front();
+        if (!index.emplace(current, affected.size()).second) continue;
+        affected.push_back(current);
+
+        auto it = m_nodes.find(current);
+        if (it == m_nodes.end()) continue;
+        for (const std::string& dependent : it->second.dependents) {
+            if (!index.count(dependent)) queue.push_back(dependent);
+        }
+    }
+
+    // 在受影响的子图上做 Kahn 拓扑排序: 入度为集合内尚未重载的依赖数
+    std::vector<uint32_t> pending(affected.size(), 0);
+    for (size_t i = 0; i < affected.size(); ++i) {
+        auto it = m_nodes.find(affected[i]);
+        if (it == m_nodes.end()) continue;
+        for (const std::string& dependency : it->second.dependencies) {
+            if (index.count(dependency)) ++pending[i];
+        }
+    }
+
+    std::vector<std::string> order;
+    order.reserve(affected.size());
+    std::vector<bool> emitted(affected.size(), false);
+    std::deque<size_t> ready;
+    for (size_t i = 0; i < affected.size(); ++i) {
+        if (pending[i] == 0) ready.push_back(i);
+    }
+    while (!ready.empty()) {
+        size_t current = ready.front();
+        ready.pop_front();
+        emitted[current] = true;
+        order.push_back(affected[current]);
+
+        auto it = m_nodes.find(affected[current]);
+        if (it == m_nodes.end()) continue;
+        for (const std::string& dependent : it->second.dependents) {
+            auto dep = index.find(dependent);
+            if (dep != index.end() && --pending[dep->second] == 0) ready.push_back(dep->second);
+        }
+    }
+
+    // 循环依赖: 剩余节点按发现顺序追加
+    for (size_t i = 0; i < affected.size(); ++i) {
+        if (!emitted[i]) order.push_back(affected[i]);
+    }
+    return order;
+}
+
+} // namespace Core
+} // namespace PrismaEngine
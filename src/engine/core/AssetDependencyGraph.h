@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Export.h"
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief 资源依赖图 (线程安全)
+ * 节点为资源路径, 边 A -> B 表示 A 加载时使用了 B。
+ * 热重载时由变化的资源沿反向边找出所有受影响的资源, 并按依赖在前的顺序重载。
+ */
+class ENGINE_API AssetDependencyGraph {
+public:
+    void AddDependency(const std::string& asset, const std::string& dependency);
+
+    /**
+     * @brief 清除 asset 的所有出边 (重新加载前调用, 加载过程会重新记录)
+     */
+    void ClearDependencies(const std::string& asset);
+
+    void Remove(const std::string& asset);
+    void Clear();
+
+    std::vector<std::string> GetDependencies(const std::string& asset) const;
+    std::vector<std::string> GetDependents(const std::string& asset) const;
+
+    /**
+     * @brief 收集 roots 及所有直接或间接依赖它们的资源
+     * @return 拓扑序 (被依赖者在前); 循环依赖中的节点追加在末尾
+     */
+    std::vector<std::string> CollectDependents(const std::vector<std::string>& roots) const;
+
+private:
+    struct Node {
+        std::unordered_set<std::string> dependencies;
+        std::unordered_set<std::string> dependents;
+    };
+
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<std::string, Node> m_nodes;
+};
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -1,11 +1,78 @@
 #include "AssetManager.h"
+#include "AssetDependencyGraph.h"
+#include "FileWatcher.h"
+#include "Hash64.h"
+#include "JobSystem.h"
+#include "VirtualFileSystem.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <future>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace PrismaEngine {
 
+namespace {
+
+// 资源缓存键: 64 位哈希 + 原始路径, 哈希冲突时按路径区分
+struct AssetKey {
+    uint64_t hash = 0;
+    std::string path;
+
+    explicit AssetKey(const std::string& assetPath) : hash(Core::Hash64::Hash(assetPath)), path(assetPath) {}
+
+    bool operator==(const AssetKey& other) const { return hash == other.hash && path == other.path; }
+};
+
+struct AssetKeyHasher {
+    size_t operator()(const AssetKey& key) const { return static_cast<size_t>(key.hash); }
+};
+
+// 缓存条目: 已加载的资源槽, 或正在加载时的共享结果
+struct AssetEntry {
+    std::shared_ptr<AssetSlot> slot;
+    std::shared_future<std::shared_ptr<AssetSlot>> pending;
+    std::thread::id loaderThread;
+    std::function<std::shared_ptr<AssetBase>(const std::string&)> reloader;
+};
+
+bool IsSlotLoaded(const std::shared_ptr<AssetSlot>& slot) {
+    if (!slot) return false;
+    AssetBase* asset = slot->Get();
+    return asset && asset->IsLoaded();
+}
+
+// 当前线程正在加载的资源栈, 栈顶为嵌套 Load 的请求者
+thread_local std::vector<std::string> t_loadStack;
+
+// 一次热重载: 按依赖顺序在后台重载, 完成后由主线程提交
+struct ReloadItem {
+    std::string path;
+    std::shared_ptr<AssetSlot> slot;
+    std::function<std::shared_ptr<AssetBase>(const std::string&)> reloader;
+    std::shared_ptr<AssetBase> result;
+};
+
+struct ReloadBatch {
+    std::vector<ReloadItem> items;
+    std::atomic<bool> done{false};
+};
+
+constexpr size_t AssetShardCount = 16;
+
+struct AssetShard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<AssetKey, AssetEntry, AssetKeyHasher> entries;
+};
+
+} // namespace
+
 struct AssetManager::Impl {
     mutable std::mutex configMutex;
     bool initialized = false;
@@ -13,12 +80,77 @@ struct AssetManager::Impl {
 
     mutable std::shared_mutex pathsMutex;
     std::vector<std::filesystem::path> searchPaths;
+    std::vector<std::filesystem::path> mountedArchives;
+
+    // 搜索路径解析结果缓存, 避免重复访问文件系统 (搜索路径变化时清空)
+    mutable std::mutex resolvedMutex;
+    mutable std::unordered_map<std::string, std::filesystem::path> resolvedPaths;
+
+    // 资源缓存按哈希高位分片, 降低并发加载时的锁竞争
+    std::array<AssetShard, AssetShardCount> shards;
 
-    mutable std::shared_mutex resourcesMutex;
-    std::unordered_map<Core::StringHash::HashType, std::shared_ptr<AssetBase>> resources;
-    std::unordered_map<Core::StringHash::HashType, std::string> pathCache;
+    AssetShard& GetShard(const AssetKey& key) { return shards[key.hash >> 60]; }
+
+    // 资源间依赖和资源依赖的文件 (文件键为 FileWatcher::MakeKey)
+    Core::AssetDependencyGraph graph;
+    std::mutex filesMutex;
+    std::unordered_map<std::string, std::unordered_set<std::string>> fileOwners;
+    std::unordered_map<std::string, std::vector<std::string>> assetFiles;
+
+    // 热重载状态, 除 watcher 外只在主线程 (Update) 访问
+    std::mutex watcherMutex;
+    std::unique_ptr<Core::FileWatcher> watcher;
+    std::atomic<bool> hotReload{false};
+    std::unordered_set<std::string> changedFiles;
+    std::shared_ptr<ReloadBatch> batch;
+    std::vector<std::shared_ptr<AssetBase>> retired;  // 上一帧被替换的资源, 下一帧释放
+
+    void SetAssetFiles(const std::string& asset, std::vector<std::string> files) {
+        std::lock_guard<std::mutex> lock(filesMutex);
+        ForgetAssetFilesLocked(asset);
+        for (const std::string& file : files) {
+            fileOwners[file].insert(asset);
+        }
+        assetFiles[asset] = std::move(files);
+    }
+
+    void ForgetAssetFilesLocked(const std::string& asset) {
+        auto it = assetFiles.find(asset);
+        if (it == assetFiles.end()) return;
+        for (const std::string& file : it->second) {
+            auto owners = fileOwners.find(file);
+            if (owners == fileOwners.end()) continue;
+            owners->second.erase(asset);
+            if (owners->second.empty()) fileOwners.erase(owners);
+        }
+        assetFiles.erase(it);
+    }
+
+    void WaitForReload() {
+        if (!batch) return;
+        while (!batch->done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
 };
 
+namespace {
+
+// 加载期间的依赖记录范围: 清除旧的出边, 嵌套的 Load 会重新记录
+class LoadScope {
+public:
+    LoadScope(Core::AssetDependencyGraph& graph, const std::string& path) {
+        graph.ClearDependencies(path);
+        t_loadStack.push_back(path);
+    }
+    ~LoadScope() { t_loadStack.pop_back(); }
+
+    LoadScope(const LoadScope&)            = delete;
+    LoadScope& operator=(const LoadScope&) = delete;
+};
+
+} // namespace
+
 std::shared_ptr<AssetManager> AssetManager::GetInstance() {
     static std::shared_ptr<AssetManager> instance = std::shared_ptr<AssetManager>(new AssetManager());
     return instance;
@@ -39,6 +171,37 @@ void AssetManager::Shutdown() {
     UnloadAll();
 }
 
+void AssetManager::Update(float deltaTime) {
+    (void)deltaTime;
+
+    // 上一帧替换下来的资源此时已无人在本帧取得其指针
+    for (auto& asset : m_impl->retired) {
+        asset->Unload();
+    }
+    m_impl->retired.clear();
+
+    if (m_impl->batch && m_impl->batch->done.load(std::memory_order_acquire)) {
+        CommitReload();
+    }
+
+    if (!m_impl->hotReload.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_impl->watcherMutex);
+        if (m_impl->watcher) {
+            for (const auto& file : m_impl->watcher->Poll()) {
+                m_impl->changedFiles.insert(file.generic_string());
+            }
+        }
+    }
+
+    if (!m_impl->batch && !m_impl->changedFiles.empty()) {
+        ScheduleReload();
+    }
+}
+
 bool AssetManager::Initialize(const std::filesystem::path& project_root) {
     LOG_INFO("Resource", "资源系统正在初始化...");
     std::unique_lock<std::mutex> config_lock(m_impl->configMutex);
@@ -64,6 +227,19 @@ bool AssetManager::Initialize(const std::filesystem::path& project_root) {
     AddSearchPath(m_impl->projectRoot / "Assets/Models");
     AddSearchPath(m_impl->projectRoot / "Assets/Audio");
 
+    // 挂载项目根目录下的归档 (按文件名排序, 后挂载的优先, 便于补丁包覆盖)
+    std::vector<std::filesystem::path> archives;
+    std::error_code ec;
+    for (const auto& item : std::filesystem::directory_iterator(m_impl->projectRoot, ec)) {
+        if (item.is_regular_file(ec) && item.path().extension() == ".pak") {
+            archives.push_back(item.path());
+        }
+    }
+    std::sort(archives.begin(), archives.end());
+    for (const auto& archive : archives) {
+        MountArchive(archive);
+    }
+
     config_lock.lock();
     m_impl->initialized = true;
     LOG_INFO("Resource", "资源系统初始化完成。");
@@ -78,56 +254,382 @@ void AssetManager::AddSearchPath(const std::filesystem::path& path) {
             m_impl->searchPaths.push_back(absolute_path);
         }
     }
+
+    {
+        std::lock_guard<std::mutex> lock(m_impl->watcherMutex);
+        if (m_impl->watcher) {
+            m_impl->watcher->AddDirectory(absolute_path);
+        }
+    }
+
+    std::lock_guard<std::mutex> resolved_lock(m_impl->resolvedMutex);
+    m_impl->resolvedPaths.clear();
+}
+
+bool AssetManager::MountArchive(const std::filesystem::path& archivePath) {
+    if (!Core::VirtualFileSystem::GetInstance().Mount(archivePath)) {
+        LOG_ERROR("Resource", "归档挂载失败: {0}", archivePath.string());
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_impl->pathsMutex);
+    m_impl->mountedArchives.push_back(std::filesystem::absolute(archivePath));
+    return true;
+}
+
+bool AssetManager::LoadInstance(const std::string& relative_path, AssetBase& asset) {
+    std::vector<std::string> files;
+    if (!LoadFromArchive(relative_path, asset)) {
+        auto fullPath = FindResource(relative_path);
+        if (!fullPath) {
+            LOG_ERROR("Resource", "资源未找到: {0}", relative_path);
+            return false;
+        }
+
+        if (!asset.Load(*fullPath)) {
+            LOG_ERROR("Resource", "资源加载失败: {0}", relative_path);
+            return false;
+        }
+        files.push_back(Core::FileWatcher::MakeKey(*fullPath));
+    }
+
+    for (const auto& dependency : asset.GetFileDependencies()) {
+        if (dependency.is_absolute()) {
+            files.push_back(Core::FileWatcher::MakeKey(dependency));
+        } else if (auto resolved = FindResource(dependency.generic_string())) {
+            files.push_back(Core::FileWatcher::MakeKey(*resolved));
+        }
+    }
+    m_impl->SetAssetFiles(relative_path, std::move(files));
+    return true;
+}
+
+bool AssetManager::LoadFromArchive(const std::string& relative_path, AssetBase& asset) {
+    Core::VfsFile file = Core::VirtualFileSystem::GetInstance().Open(relative_path);
+    if (!file) {
+        return false;
+    }
+
+    if (!asset.LoadFromMemory(relative_path, file.Data(), file.Size())) {
+        LOG_WARNING("Resource", "资源不支持从归档加载, 回退到文件系统: {0}", relative_path);
+        return false;
+    }
+    return true;
 }
 
 std::optional<std::filesystem::path> AssetManager::FindResource(const std::string& relative_path) const {
     std::filesystem::path path(relative_path);
     if (path.is_absolute() && std::filesystem::exists(path)) return path;
 
+    {
+        std::lock_guard<std::mutex> resolved_lock(m_impl->resolvedMutex);
+        auto it = m_impl->resolvedPaths.find(relative_path);
+        if (it != m_impl->resolvedPaths.end()) return it->second;
+    }
+
     std::shared_lock<std::shared_mutex> lock(m_impl->pathsMutex);
     for (const auto& search_path : m_impl->searchPaths) {
         std::filesystem::path full_path = search_path / relative_path;
-        if (std::filesystem::exists(full_path)) return std::filesystem::absolute(full_path);
+        if (std::filesystem::exists(full_path)) {
+            auto absolute_path = std::filesystem::absolute(full_path);
+            std::lock_guard<std::mutex> resolved_lock(m_impl->resolvedMutex);
+            m_impl->resolvedPaths[relative_path] = absolute_path;
+            return absolute_path;
+        }
     }
     return std::nullopt;
 }
 
-std::shared_ptr<AssetBase> AssetManager::GetCachedAsset(Core::StringHash::HashType hash) {
-    std::shared_lock<std::shared_mutex> lock(m_impl->resourcesMutex);
-    auto it = m_impl->resources.find(hash);
-    if (it != m_impl->resources.end() && it->second->IsLoaded()) {
-        return it->second;
+std::shared_ptr<AssetSlot> AssetManager::GetCachedSlot(const std::string& path) {
+    AssetKey key(path);
+    AssetShard& shard = m_impl->GetShard(key);
+
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end() && IsSlotLoaded(it->second.slot)) {
+        return it->second.slot;
     }
     return nullptr;
 }
 
-void AssetManager::RegisterAsset(Core::StringHash::HashType hash, const std::string& path, std::shared_ptr<AssetBase> asset) {
-    std::unique_lock<std::shared_mutex> lock(m_impl->resourcesMutex);
-    m_impl->resources[hash] = asset;
-    m_impl->pathCache[hash] = path;
+std::shared_ptr<AssetSlot> AssetManager::AcquireAsset(const std::string& path, const AssetLoader& loader, AssetReloader reloader) {
+    // 嵌套在另一个资源的加载中: 记录依赖 (已缓存的资源同样记录)
+    if (!t_loadStack.empty()) {
+        m_impl->graph.AddDependency(t_loadStack.back(), path);
+    }
+
+    AssetKey key(path);
+    AssetShard& shard = m_impl->GetShard(key);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && IsSlotLoaded(it->second.slot)) {
+            return it->second.slot;
+        }
+    }
+
+    std::promise<std::shared_ptr<AssetSlot>> promise;
+    std::shared_future<std::shared_ptr<AssetSlot>> pending;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        AssetEntry& entry = shard.entries[key];
+        if (IsSlotLoaded(entry.slot)) {
+            return entry.slot;
+        }
+
+        if (entry.pending.valid()) {
+            // 同一线程在加载过程中再次请求自身 (循环依赖), 等待会死锁
+            if (entry.loaderThread == std::this_thread::get_id()) {
+                LOG_ERROR("Resource", "检测到资源循环加载: {0}", path);
+                return nullptr;
+            }
+            pending = entry.pending;
+        } else {
+            entry.slot.reset();
+            entry.pending      = promise.get_future().share();
+            entry.loaderThread = std::this_thread::get_id();
+        }
+    }
+
+    // 已有其他线程在加载, 等待其结果
+    if (pending.valid()) {
+        return pending.get();
+    }
+
+    // 加载失败 (包括抛出异常) 时同样要唤醒等待者
+    std::shared_ptr<AssetSlot> slot;
+    std::exception_ptr error;
+    try {
+        LoadScope scope(m_impl->graph, path);
+        if (auto asset = loader()) {
+            slot = std::make_shared<AssetSlot>(std::move(asset));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        // 加载期间条目可能已被 Unload 移除, 此时不再缓存
+        if (it != shard.entries.end() && it->second.loaderThread == std::this_thread::get_id()) {
+            if (slot) {
+                it->second.slot         = slot;
+                it->second.pending      = {};
+                it->second.loaderThread = {};
+                it->second.reloader     = std::move(reloader);
+            } else {
+                shard.entries.erase(it);
+            }
+        }
+    }
+
+    promise.set_value(slot);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return slot;
+}
+
+// ============================================================================
+// 热重载
+// ============================================================================
+
+void AssetManager::EnableHotReload(bool enable) {
+    std::lock_guard<std::mutex> lock(m_impl->watcherMutex);
+    m_impl->hotReload.store(enable, std::memory_order_relaxed);
+    if (!enable) {
+        m_impl->watcher.reset();
+        return;
+    }
+    if (m_impl->watcher) {
+        return;
+    }
+
+    m_impl->watcher = std::make_unique<Core::FileWatcher>();
+    std::shared_lock<std::shared_mutex> paths_lock(m_impl->pathsMutex);
+    for (const auto& path : m_impl->searchPaths) {
+        m_impl->watcher->AddDirectory(path);
+    }
+    LOG_INFO("Resource", "资源热重载已启用 ({0})", m_impl->watcher->IsNative() ? "系统通知" : "轮询");
+}
+
+bool AssetManager::IsHotReloadEnabled() const {
+    return m_impl->hotReload.load(std::memory_order_relaxed);
+}
+
+std::vector<std::string> AssetManager::GetDependencies(const std::string& relative_path) const {
+    return m_impl->graph.GetDependencies(relative_path);
+}
+
+std::vector<std::string> AssetManager::GetDependents(const std::string& relative_path) const {
+    return m_impl->graph.GetDependents(relative_path);
+}
+
+void AssetManager::ScheduleReload() {
+    std::vector<std::string> roots;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->filesMutex);
+        for (const std::string& file : m_impl->changedFiles) {
+            auto it = m_impl->fileOwners.find(file);
+            if (it != m_impl->fileOwners.end()) {
+                roots.insert(roots.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+    m_impl->changedFiles.clear();
+    if (roots.empty()) {
+        return;
+    }
+
+    auto batch = std::make_shared<ReloadBatch>();
+    for (const std::string& path : m_impl->graph.CollectDependents(roots)) {
+        AssetKey key(path);
+        AssetShard& shard = m_impl->GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end() || !it->second.slot) {
+            continue;
+        }
+        if (!it->second.reloader) {
+            LOG_WARNING("Resource", "资源类型不支持热重载: {0}", path);
+            continue;
+        }
+        batch->items.push_back({ path, it->second.slot, it->second.reloader, nullptr });
+    }
+    if (batch->items.empty()) {
+        return;
+    }
+
+    LOG_INFO("Resource", "热重载 {0} 个资源", batch->items.size());
+    m_impl->batch = batch;
+
+    // 整批在一个任务中按拓扑序执行: 依赖者重载时通过 AssetSlot::staged 看到已重载的新版本
+    JobSystem::GetInstance().SubmitJob([this, batch]() {
+        const std::thread::id self = std::this_thread::get_id();
+        for (ReloadItem& item : batch->items) {
+            item.slot->stagingThread.store(self, std::memory_order_relaxed);
+        }
+
+        for (ReloadItem& item : batch->items) {
+            try {
+                LoadScope scope(m_impl->graph, item.path);
+                item.result = item.reloader(item.path);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Resource", "资源重载异常: {0}: {1}", item.path, e.what());
+            } catch (...) {
+                LOG_ERROR("Resource", "资源重载异常: {0}", item.path);
+            }
+
+            if (item.result) {
+                item.slot->staged.store(item.result.get(), std::memory_order_release);
+            } else {
+                LOG_WARNING("Resource", "资源重载失败, 保留旧版本: {0}", item.path);
+            }
+        }
+
+        for (ReloadItem& item : batch->items) {
+            item.slot->stagingThread.store(std::thread::id(), std::memory_order_relaxed);
+        }
+        batch->done.store(true, std::memory_order_release);
+    });
+}
+
+void AssetManager::CommitReload() {
+    std::shared_ptr<ReloadBatch> batch = std::move(m_impl->batch);
+
+    size_t reloaded = 0;
+    for (ReloadItem& item : batch->items) {
+        AssetSlot& slot = *item.slot;
+        slot.staged.store(nullptr, std::memory_order_relaxed);
+        if (!item.result) {
+            continue;
+        }
+
+        AssetKey key(item.path);
+        std::unique_lock<std::shared_mutex> lock(m_impl->GetShard(key).mutex);
+        m_impl->retired.push_back(std::move(slot.owner));
+        slot.owner = std::move(item.result);
+        slot.current.store(slot.owner.get(), std::memory_order_release);
+        slot.version.fetch_add(1, std::memory_order_acq_rel);
+        ++reloaded;
+    }
+    LOG_INFO("Resource", "热重载完成: {0}/{1}", reloaded, batch->items.size());
 }
 
 void AssetManager::Unload(const std::string& name) {
-    Core::StringHash hash(name);
-    std::unique_lock<std::shared_mutex> lock(m_impl->resourcesMutex);
-    auto it = m_impl->resources.find(hash);
-    if (it != m_impl->resources.end()) {
-        it->second->Unload();
-        m_impl->resources.erase(it);
-        m_impl->pathCache.erase(hash);
+    AssetKey key(name);
+    AssetShard& shard = m_impl->GetShard(key);
+
+    std::shared_ptr<AssetBase> asset;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return;
+        }
+        if (it->second.slot) {
+            asset = it->second.slot->owner;
+        }
+        shard.entries.erase(it);
+    }
+
+    m_impl->graph.Remove(name);
+    {
+        std::lock_guard<std::mutex> lock(m_impl->filesMutex);
+        m_impl->ForgetAssetFilesLocked(name);
+    }
+
+    if (asset) {
+        asset->Unload();
     }
 }
 
 void AssetManager::UnloadAll() {
-    std::unique_lock<std::shared_mutex> lock(m_impl->resourcesMutex);
-    for (auto& pair : m_impl->resources) {
-        if (pair.second) pair.second->Unload();
+    // 进行中的重载结果直接丢弃
+    m_impl->WaitForReload();
+    m_impl->batch.reset();
+    for (auto& asset : m_impl->retired) {
+        asset->Unload();
+    }
+    m_impl->retired.clear();
+    m_impl->changedFiles.clear();
+
+    for (AssetShard& shard : m_impl->shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto& [key, entry] : shard.entries) {
+            if (entry.slot && entry.slot->owner) entry.slot->owner->Unload();
+        }
+        shard.entries.clear();
+    }
+
+    m_impl->graph.Clear();
+    {
+        std::lock_guard<std::mutex> lock(m_impl->filesMutex);
+        m_impl->fileOwners.clear();
+        m_impl->assetFiles.clear();
+    }
+    {
+        // 搜索路径随后清空, 重新初始化时再添加监视
+        std::lock_guard<std::mutex> lock(m_impl->watcherMutex);
+        if (m_impl->watcher) {
+            m_impl->watcher = std::make_unique<Core::FileWatcher>();
+        }
     }
-    m_impl->resources.clear();
-    m_impl->pathCache.clear();
 
     std::unique_lock<std::shared_mutex> paths_lock(m_impl->pathsMutex);
     m_impl->searchPaths.clear();
+    for (const auto& archive : m_impl->mountedArchives) {
+        Core::VirtualFileSystem::GetInstance().Unmount(archive);
+    }
+    m_impl->mountedArchives.clear();
+    paths_lock.unlock();
+
+    {
+        std::lock_guard<std::mutex> resolved_lock(m_impl->resolvedMutex);
+        m_impl->resolvedPaths.clear();
+    }
 
     std::lock_guard<std::mutex> config_lock(m_impl->configMutex);
     m_impl->initialized = false;
@@ -2,11 +2,13 @@
 #include "AssetBase.h"
 #include "Logger.h"
 #include "ManagerBase.h"
-#include "StringHash.h"
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace PrismaEngine {
 
@@ -18,43 +20,69 @@ public:
     ~AssetManager() override;
 
     int Initialize() override;
+    void Update(float deltaTime) override;
     void Shutdown() override;
     static constexpr const char* GetStaticName() { return "AssetManager"; }
 
     bool Initialize(const std::filesystem::path& project_root);
     void AddSearchPath(const std::filesystem::path& path);
+
+    // 挂载 PAK 归档, 归档中的资源优先于搜索路径
+    bool MountArchive(const std::filesystem::path& archivePath);
     std::optional<std::filesystem::path> FindResource(const std::string& relative_path) const;
 
-    template <typename T> ResourceHandle<T> GetCachedResource(Core::StringHash::HashType hash) {
-        auto asset = GetCachedAsset(hash);
-        return ResourceHandle<T>(std::dynamic_pointer_cast<T>(asset));
+    template <typename T> ResourceHandle<T> GetCachedResource(const std::string& relative_path) {
+        auto slot = GetCachedSlot(relative_path);
+        if (!slot || !dynamic_cast<T*>(slot->Get()))
+            return ResourceHandle<T>();
+        return ResourceHandle<T>(std::move(slot));
     }
 
+    /**
+     * @brief 加载资源 (线程安全)
+     * 多个线程同时请求同一路径时只加载一次, 其余请求等待首个加载完成并共享结果。
+     * 在另一个资源的加载过程中调用时, 记录两者间的依赖, 用于热重载。
+     * 无构造参数且可默认构造的资源类型支持热重载。
+     */
     template <typename T, typename... Args> ResourceHandle<T> Load(const std::string& relative_path, Args&&... args) {
         if (!IsInitialized())
             Initialize(std::filesystem::current_path());
 
-        Core::StringHash hash(relative_path);
-        auto cached = GetCachedResource<T>(hash);
-        if (cached)
-            return cached;
-
-        auto fullPath = FindResource(relative_path);
-        if (!fullPath) {
-            LOG_ERROR("Resource", "资源未找到: {0}", relative_path);
-            return ResourceHandle<T>();
+        AssetReloader reloader;
+        if constexpr (sizeof...(Args) == 0 && std::is_default_constructible_v<T>) {
+            reloader = [this](const std::string& path) -> std::shared_ptr<AssetBase> {
+                auto resource = std::make_shared<T>();
+                return LoadInstance(path, *resource) ? resource : nullptr;
+            };
         }
 
-        auto resource = std::make_shared<T>(std::forward<Args>(args)...);
-        if (!resource->Load(*fullPath)) {
-            LOG_ERROR("Resource", "资源加载失败: {0}", relative_path);
+        auto slot = AcquireAsset(relative_path, [&]() -> std::shared_ptr<AssetBase> {
+            auto resource = std::make_shared<T>(std::forward<Args>(args)...);
+            return LoadInstance(relative_path, *resource) ? resource : nullptr;
+        }, std::move(reloader));
+
+        if (!slot)
+            return ResourceHandle<T>();
+        if (!dynamic_cast<T*>(slot->Get())) {
+            LOG_ERROR("Resource", "资源类型不匹配: {0}", relative_path);
             return ResourceHandle<T>();
         }
-
-        RegisterAsset(hash, relative_path, resource);
-        return ResourceHandle<T>(resource);
+        return ResourceHandle<T>(std::move(slot));
     }
 
+    // === 热重载 ===
+
+    /**
+     * @brief 启用热重载: 监视所有搜索路径, 文件变化时重载对应资源及依赖它的资源
+     * 重载在后台线程按依赖顺序执行, 整批完成后在 Update 中一次性替换, 渲染不会看到部分更新的状态。
+     */
+    void EnableHotReload(bool enable);
+    bool IsHotReloadEnabled() const;
+
+    // 资源间的依赖 (在加载过程中通过 Load 请求的其他资源)
+    std::vector<std::string> GetDependencies(const std::string& relative_path) const;
+    std::vector<std::string> GetDependents(const std::string& relative_path) const;
+
     void CreateDefaultAssets();
     void Unload(const std::string& name);
     void UnloadAll();
@@ -62,8 +90,23 @@ public:
 
 private:
     // Pimpl 支持方法
-    std::shared_ptr<AssetBase> GetCachedAsset(Core::StringHash::HashType hash);
-    void RegisterAsset(Core::StringHash::HashType hash, const std::string& path, std::shared_ptr<AssetBase> asset);
+    using AssetLoader   = std::function<std::shared_ptr<AssetBase>()>;
+    using AssetReloader = std::function<std::shared_ptr<AssetBase>(const std::string&)>;
+
+    std::shared_ptr<AssetSlot> GetCachedSlot(const std::string& path);
+
+    // 返回已缓存的资源; 未缓存时由首个请求者调用 loader, 并发请求等待同一结果
+    // reloader 为空时该资源不参与热重载
+    std::shared_ptr<AssetSlot> AcquireAsset(const std::string& path, const AssetLoader& loader, AssetReloader reloader);
+
+    // 依次从归档、搜索路径加载资源, 并记录其依赖的文件
+    bool LoadInstance(const std::string& relative_path, AssetBase& asset);
+
+    // 从已挂载的归档加载资源, 条目不存在或资源不支持内存加载时返回 false
+    bool LoadFromArchive(const std::string& relative_path, AssetBase& asset);
+
+    void ScheduleReload();
+    void CommitReload();
 
     struct Impl;
     std::unique_ptr<Impl> m_impl;
@@ -1,5 +1,6 @@
 #include "AsyncLoader.h"
 #include "Logger.h"
+#include "ResourceManager.h"
 #include <algorithm>
 #include <atomic>
 #include <chrono>
@@ -9,6 +10,7 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 namespace PrismaEngine {
@@ -122,35 +124,110 @@ namespace Core {
         // ============================================================================
         // 内部资源加载器实现
         // ============================================================================
+        // 纹理请求转交给 ResourceManager 的流式加载器 (按优先级读取、并行解码、按预算上传),
+        // 回调在 ResourceManager::Update 中调用
         class AsyncResourceLoaderImpl : public AsyncResourceLoader {
             public:
-                explicit AsyncResourceLoaderImpl(ThreadPool* pool) : m_pool(pool) {}
+                // 回调持有 this, 销毁前取消未完成的请求
+                ~AsyncResourceLoaderImpl() override {
+                    cancelAll();
+                }
 
                 uint64_t loadTexture(const std::string& filePath,
-                                     std::function<void(std::shared_ptr<class ITexture>)> callback) override {
-                    (void)filePath; (void)callback;
-                    return 0;
+                                     std::function<void(std::shared_ptr<Graphic::ITexture>)> callback) override {
+                    auto manager = Graphic::ResourceManager::GetInstance();
+
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    uint64_t id = manager->LoadTextureAsync(filePath, 0.0f,
+                        [this, callback](Graphic::ResourceId resourceId, std::shared_ptr<Graphic::ITexture> texture) {
+                            finish(resourceId, texture != nullptr);
+                            if (callback) callback(texture);
+                        });
+
+                    if (id == 0) {
+                        ++m_failed;
+                        ++m_total;
+                        return 0;
+                    }
+                    m_pending.insert(id);
+                    ++m_total;
+                    return id;
                 }
 
                 uint64_t loadModel(const std::string& filePath,
-                                   std::function<void(std::shared_ptr<class IMesh>)> callback) override {
-                    (void)filePath; (void)callback;
+                                   std::function<void(std::shared_ptr<Graphic::IMesh>)> callback) override {
+                    // 网格只能由具体后端创建, 资源工厂没有通用的网格创建接口
+                    LOG_WARNING("Core", "当前渲染后端不支持异步加载模型: {0}", filePath);
+                    (void)callback;
                     return 0;
                 }
 
                 std::vector<uint64_t> loadTextures(const std::vector<std::string>& filePaths,
-                                                   std::function<void(size_t index, std::shared_ptr<class ITexture>)> callback) override {
-                    (void)filePaths; (void)callback;
-                    return {};
+                                                   std::function<void(size_t index, std::shared_ptr<Graphic::ITexture>)> callback) override {
+                    std::vector<uint64_t> ids;
+                    ids.reserve(filePaths.size());
+                    for (size_t i = 0; i < filePaths.size(); ++i) {
+                        ids.push_back(loadTexture(filePaths[i], [callback, i](std::shared_ptr<Graphic::ITexture> texture) {
+                            if (callback) callback(i, texture);
+                        }));
+                    }
+                    return ids;
+                }
+
+                LoadingProgress getProgress() const override {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    LoadingProgress progress;
+                    progress.totalTasks     = m_total;
+                    progress.completedTasks = m_completed;
+                    progress.failedTasks    = m_failed;
+                    progress.progress       = m_total > 0 ? static_cast<float>(m_completed + m_failed) / static_cast<float>(m_total) : 1.0f;
+                    return progress;
+                }
+
+                bool setPriority(uint64_t taskId, float priority) override {
+                    return Graphic::ResourceManager::GetInstance()->SetAsyncLoadPriority(taskId, priority);
                 }
 
-                LoadingProgress getProgress() const override { return {}; }
-                void cancelAll() override {}
+                bool cancel(uint64_t taskId) override {
+                    if (!Graphic::ResourceManager::GetInstance()->CancelAsyncLoad(taskId)) {
+                        return false;
+                    }
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_pending.erase(taskId) > 0) ++m_failed;
+                    return true;
+                }
+
+                void cancelAll() override {
+                    std::vector<uint64_t> pending;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        pending.assign(m_pending.begin(), m_pending.end());
+                    }
+                    for (uint64_t id : pending) {
+                        cancel(id);
+                    }
+                }
+
+                // 回调由 ResourceManager::Update 驱动
                 void update() override {}
-                bool isLoading() const override { return false; }
+
+                bool isLoading() const override {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return !m_pending.empty();
+                }
 
             private:
-                ThreadPool* m_pool;
+                void finish(uint64_t id, bool success) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_pending.erase(id) == 0) return;
+                    if (success) ++m_completed; else ++m_failed;
+                }
+
+                mutable std::mutex m_mutex;
+                std::unordered_set<uint64_t> m_pending;
+                size_t m_total = 0;
+                size_t m_completed = 0;
+                size_t m_failed = 0;
         };
 
         // ============================================================================
@@ -196,7 +273,8 @@ namespace Core {
     }
 
     std::unique_ptr<AsyncResourceLoader> AsyncResourceLoader::create(ThreadPool* threadPool) {
-        return std::make_unique<AsyncResourceLoaderImpl>(threadPool);
+        (void)threadPool;
+        return std::make_unique<AsyncResourceLoaderImpl>();
     }
 
     std::unique_ptr<ChunkGenerationSystem> ChunkGenerationSystem::create(size_t numThreads) {
@@ -14,6 +14,11 @@
 #include <exception>
 
 namespace PrismaEngine {
+    namespace Graphic {
+        class ITexture;
+        class IMesh;
+    }
+
     namespace Core {
 
         /**
@@ -368,7 +373,7 @@ namespace PrismaEngine {
              * @return 任务 ID
              */
             virtual uint64_t loadTexture(const std::string& filePath,
-                                         std::function<void(std::shared_ptr<class ITexture>)> callback) = 0;
+                                         std::function<void(std::shared_ptr<Graphic::ITexture>)> callback) = 0;
 
             /**
              * @brief 异步加载模型
@@ -377,7 +382,7 @@ namespace PrismaEngine {
              * @return 任务 ID
              */
             virtual uint64_t loadModel(const std::string& filePath,
-                                       std::function<void(std::shared_ptr<class IMesh>)> callback) = 0;
+                                       std::function<void(std::shared_ptr<Graphic::IMesh>)> callback) = 0;
 
             /**
              * @brief 批量加载纹理
@@ -387,7 +392,7 @@ namespace PrismaEngine {
              */
             virtual std::vector<uint64_t> loadTextures(
                 const std::vector<std::string>& filePaths,
-                std::function<void(size_t index, std::shared_ptr<class ITexture>)> callback
+                std::function<void(size_t index, std::shared_ptr<Graphic::ITexture>)> callback
             ) = 0;
 
             /**
@@ -402,6 +407,16 @@ namespace PrismaEngine {
 
             virtual LoadingProgress getProgress() const = 0;
 
+            /**
+             * @brief 调整任务优先级 (数值越小越优先)
+             */
+            virtual bool setPriority(uint64_t taskId, float priority) = 0;
+
+            /**
+             * @brief 取消任务
+             */
+            virtual bool cancel(uint64_t taskId) = 0;
+
             /**
              * @brief 取消所有任务
              */
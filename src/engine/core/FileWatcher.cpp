@@ -0,0 +1,184 @@
+#include "FileWatcher.h"
+#include "Logger.h"
+#include <algorithm>
+#include <unordered_set>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace PrismaEngine {
+namespace Core {
+
+FileWatcher::FileWatcher() {
+#if defined(__linux__)
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify < 0) {
+        LOG_WARNING("FileWatcher", "inotify 不可用, 回退到轮询");
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#if defined(__linux__)
+    if (m_inotify >= 0) {
+        close(m_inotify);
+    }
+#endif
+}
+
+bool FileWatcher::IsNative() const {
+    return m_inotify >= 0;
+}
+
+std::string FileWatcher::MakeKey(const std::filesystem::path& path) {
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    return (ec ? path : absolute).lexically_normal().generic_string();
+}
+
+bool FileWatcher::AddDirectory(const std::filesystem::path& directory, bool recursive) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        return false;
+    }
+
+    std::filesystem::path normalized = std::filesystem::path(MakeKey(directory));
+    for (const WatchedDirectory& watched : m_directories) {
+        // 已被递归监视的目录覆盖
+        auto [end, _] = std::mismatch(watched.path.begin(), watched.path.end(), normalized.begin(), normalized.end());
+        if (end == watched.path.end() && (watched.recursive || watched.path == normalized)) {
+            return true;
+        }
+    }
+
+    m_directories.push_back({ normalized, recursive });
+    if (!IsNative()) {
+        ScanTimestamps(m_directories.back(), nullptr);
+        return true;
+    }
+    return AddWatch(normalized, recursive);
+}
+
+bool FileWatcher::AddWatch(const std::filesystem::path& directory, bool recursive) {
+#if defined(__linux__)
+    constexpr uint32_t Mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF;
+    int wd = inotify_add_watch(m_inotify, directory.c_str(), Mask);
+    if (wd < 0) {
+        LOG_WARNING("FileWatcher", "无法监视目录: {0} (errno {1})", directory.string(), errno);
+        return false;
+    }
+    m_watches[wd] = { directory, recursive };
+
+    if (recursive) {
+        std::error_code ec;
+        for (const auto& item : std::filesystem::directory_iterator(directory, ec)) {
+            if (item.is_directory(ec)) {
+                AddWatch(item.path(), true);
+            }
+        }
+    }
+    return true;
+#else
+    (void)directory;
+    (void)recursive;
+    return false;
+#endif
+}
+
+std::vector<std::filesystem::path> FileWatcher::Poll() {
+    std::vector<std::filesystem::path> changed;
+
+#if defined(__linux__)
+    if (IsNative()) {
+        alignas(inotify_event) char buffer[16 * 1024];
+        for (;;) {
+            ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+            if (length <= 0) break;  // EAGAIN: 没有更多事件
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    LOG_WARNING("FileWatcher", "inotify 事件队列溢出, 部分变化可能丢失");
+                    continue;
+                }
+
+                auto it = m_watches.find(event->wd);
+                if (it == m_watches.end()) continue;
+                if (event->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+                    m_watches.erase(it);
+                    continue;
+                }
+                if (event->len == 0) continue;
+
+                std::filesystem::path path = it->second.path / event->name;
+                if (event->mask & IN_ISDIR) {
+                    // 新建的子目录: 补充监视, 其中已存在的文件在下一次写入时才会报告
+                    if ((event->mask & (IN_CREATE | IN_MOVED_TO)) && it->second.recursive) {
+                        AddWatch(path, true);
+                    }
+                    continue;
+                }
+                // IN_CREATE 之后总会有 IN_CLOSE_WRITE, 只报告写入完成的文件
+                if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    changed.push_back(std::move(path));
+                }
+            }
+        }
+    }
+#endif
+
+    if (!IsNative()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_lastScan < m_pollInterval) {
+            return changed;
+        }
+        m_lastScan = now;
+        for (const WatchedDirectory& directory : m_directories) {
+            ScanTimestamps(directory, &changed);
+        }
+    }
+
+    // 同一文件在一帧内可能产生多个事件
+    std::unordered_set<std::string> seen;
+    std::vector<std::filesystem::path> unique;
+    unique.reserve(changed.size());
+    for (auto& path : changed) {
+        if (seen.insert(path.generic_string()).second) {
+            unique.push_back(std::move(path));
+        }
+    }
+    return unique;
+}
+
+void FileWatcher::ScanTimestamps(const WatchedDirectory& directory, std::vector<std::filesystem::path>* changed) {
+    auto visit = [&](const std::filesystem::directory_entry& item) {
+        std::error_code ec;
+        if (!item.is_regular_file(ec)) return;
+        auto time = item.last_write_time(ec);
+        if (ec) return;
+
+        std::string key = item.path().lexically_normal().generic_string();
+        auto [it, inserted] = m_timestamps.try_emplace(key, time);
+        if (!inserted && it->second != time) {
+            it->second = time;
+            if (changed) changed->push_back(std::filesystem::path(key));
+        } else if (inserted && changed) {
+            changed->push_back(std::filesystem::path(key));
+        }
+    };
+
+    std::error_code ec;
+    if (directory.recursive) {
+        for (const auto& item : std::filesystem::recursive_directory_iterator(directory.path, ec)) visit(item);
+    } else {
+        for (const auto& item : std::filesystem::directory_iterator(directory.path, ec)) visit(item);
+    }
+}
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Export.h"
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief 目录变化监视器
+ * Linux/Android 使用 inotify, 只在内核报告事件时才有开销; 其他平台定期比较文件修改时间。
+ * Poll 不阻塞, 应在主线程每帧调用。
+ */
+class ENGINE_API FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&)            = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief 监视目录 (默认包括子目录及之后新建的子目录), 已被监视的目录会被忽略
+     */
+    bool AddDirectory(const std::filesystem::path& directory, bool recursive = true);
+
+    /**
+     * @brief 返回上次调用以来写入完成、创建或移入的文件 (规范化的绝对路径, 已去重)
+     */
+    std::vector<std::filesystem::path> Poll();
+
+    /**
+     * @brief 是否使用系统通知 (否则为轮询)
+     */
+    bool IsNative() const;
+
+    // 轮询模式下两次扫描的最小间隔
+    void SetPollInterval(std::chrono::milliseconds interval) { m_pollInterval = interval; }
+
+    /**
+     * @brief 统一的路径键: 绝对、规范化、使用 '/' 分隔
+     */
+    static std::string MakeKey(const std::filesystem::path& path);
+
+private:
+    struct WatchedDirectory {
+        std::filesystem::path path;
+        bool recursive = true;
+    };
+
+    bool AddWatch(const std::filesystem::path& directory, bool recursive);
+    void ScanTimestamps(const WatchedDirectory& directory, std::vector<std::filesystem::path>* changed);
+
+    std::vector<WatchedDirectory> m_directories;
+    std::chrono::milliseconds m_pollInterval{500};
+    std::chrono::steady_clock::time_point m_lastScan{};
+
+    // inotify 句柄和 watch 描述符到目录的映射; 不可用时为 -1, 使用轮询
+    int m_inotify = -1;
+    std::unordered_map<int, WatchedDirectory> m_watches;
+
+    // 轮询模式下的文件修改时间快照
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_timestamps;
+};
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,256 @@
+#include "FrameAllocator.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Core {
+
+// ========== LinearArena ==========
+
+struct alignas(std::max_align_t) LinearArena::Block {
+    Block* next;
+    size_t size;        // 数据区大小
+
+    std::byte* Data() { return reinterpret_cast<std::byte*>(this + 1); }
+};
+
+LinearArena::LinearArena(size_t blockSize, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream ? upstream : std::pmr::new_delete_resource())
+    , m_blockSize(std::max<size_t>(blockSize, 256)) {
+}
+
+LinearArena::~LinearArena() {
+    FreeBlocks();
+}
+
+LinearArena::Block* LinearArena::AllocateBlock(size_t dataSize) {
+    void* memory = m_upstream->allocate(sizeof(Block) + dataSize, alignof(Block));
+    Block* block = ::new (memory) Block{nullptr, dataSize};
+    m_capacity += dataSize;
+    ++m_upstreamAllocations;
+    return block;
+}
+
+void LinearArena::FreeBlocks() {
+    Block* block = m_first;
+    while (block) {
+        Block* next = block->next;
+        m_upstream->deallocate(block, sizeof(Block) + block->size, alignof(Block));
+        block = next;
+    }
+    m_first = m_current = nullptr;
+    m_cursor = m_end = nullptr;
+    m_base = 0;
+    m_capacity = 0;
+}
+
+void LinearArena::SetCurrent(Block* block) {
+    m_current = block;
+    m_cursor  = block->Data();
+    m_end     = block->Data() + block->size;
+}
+
+void* LinearArena::AllocateSlow(size_t size, size_t alignment) {
+    const size_t required = size + (alignment > alignof(Block) ? alignment : 0);
+
+    if (!m_current) {
+        m_first = AllocateBlock(std::max(m_blockSize, required));
+        SetCurrent(m_first);
+    } else {
+        // 先尝试复用 Rewind 后保留的后续块, 空间不足的块被跳过
+        m_peak = std::max(m_peak, GetUsedBytes());
+        Block* block = m_current;
+        while (block->next && block->next->size < required) {
+            m_base += block->size;
+            block = block->next;
+        }
+        m_base += block->size;
+        if (!block->next) {
+            Block* fresh = AllocateBlock(std::max(m_blockSize, required));
+            block->next = fresh;
+        }
+        SetCurrent(block->next);
+    }
+
+    void* result = Allocate(size, alignment);
+    m_peak = std::max(m_peak, GetUsedBytes());
+    return result;
+}
+
+LinearArena::Marker LinearArena::GetMarker() const {
+    Marker marker;
+    marker.block = m_current;
+    marker.offset = m_current ? static_cast<size_t>(m_cursor - m_current->Data()) : 0;
+    marker.base = m_base;
+    return marker;
+}
+
+void LinearArena::Rewind(const Marker& marker) {
+    m_peak = std::max(m_peak, GetUsedBytes());
+    if (!marker.block) {
+        if (m_first) SetCurrent(m_first);
+        m_base = 0;
+        return;
+    }
+    SetCurrent(static_cast<Block*>(marker.block));
+    m_cursor += marker.offset;
+    m_base = marker.base;
+}
+
+void LinearArena::Reset() {
+    size_t peak = GetPeakBytes();
+    m_peak = 0;
+    if (!m_first) return;
+
+    if (m_first->next) {
+        // 合并为单个块, 按块大小向上取整以留出余量
+        size_t size = (peak + m_blockSize - 1) / m_blockSize * m_blockSize;
+        FreeBlocks();
+        m_first = AllocateBlock(std::max(size, m_blockSize));
+    }
+    SetCurrent(m_first);
+    m_base = 0;
+}
+
+size_t LinearArena::GetUsedBytes() const {
+    if (!m_current) return 0;
+    return m_base + static_cast<size_t>(m_cursor - m_current->Data());
+}
+
+size_t LinearArena::GetPeakBytes() const {
+    return std::max(m_peak, GetUsedBytes());
+}
+
+// ========== FrameMemory ==========
+
+namespace {
+
+// 帧 arena 的内存块计入 MemoryTag::Frame
+std::pmr::memory_resource* GetFrameUpstream() {
+    static TaggedMemoryResource* resource = new TaggedMemoryResource(MemoryTag::Frame);
+    return resource;
+}
+
+struct ThreadArenas {
+    LinearArena frame{LinearArena::DefaultBlockSize, GetFrameUpstream()};
+    LinearArena twoFrame[2] = {LinearArena(LinearArena::DefaultBlockSize, GetFrameUpstream()),
+                               LinearArena(LinearArena::DefaultBlockSize, GetFrameUpstream())};
+    LinearArena scratch{LinearArena::DefaultBlockSize, GetFrameUpstream()};
+
+    uint64_t frameStamp = 0;
+    uint64_t twoFrameStamp[2] = {0, 0};
+
+    // 由所属线程在重置时发布, 供 GetStats 在其他线程读取
+    std::atomic<size_t> publishedCapacity{0};
+    std::atomic<size_t> publishedPeak{0};
+    std::atomic<uint64_t> publishedUpstream{0};
+
+    void Publish(size_t peak) {
+        publishedCapacity.store(frame.GetCapacity() + twoFrame[0].GetCapacity() + twoFrame[1].GetCapacity() +
+                                scratch.GetCapacity(), std::memory_order_relaxed);
+        publishedPeak.store(peak, std::memory_order_relaxed);
+        publishedUpstream.store(frame.GetUpstreamAllocations() + twoFrame[0].GetUpstreamAllocations() +
+                                twoFrame[1].GetUpstreamAllocations() + scratch.GetUpstreamAllocations(),
+                                std::memory_order_relaxed);
+    }
+};
+
+struct ArenaRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadArenas>> all;
+    std::vector<ThreadArenas*> freeList;     // 已退出线程留下的 arena, 由新线程复用
+};
+
+// 有意不析构: 分离的线程可能在静态对象销毁后才退出
+ArenaRegistry& GetRegistry() {
+    static ArenaRegistry* registry = new ArenaRegistry();
+    return *registry;
+}
+
+std::atomic<uint64_t> g_frameIndex{1};
+
+struct ThreadArenaHandle {
+    ThreadArenas* arenas = nullptr;
+
+    ~ThreadArenaHandle() {
+        if (!arenas) return;
+        ArenaRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.freeList.push_back(arenas);
+    }
+};
+
+thread_local ThreadArenaHandle t_arenas;
+
+ThreadArenas& GetThreadArenas() {
+    if (t_arenas.arenas) return *t_arenas.arenas;
+
+    ArenaRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (!registry.freeList.empty()) {
+        t_arenas.arenas = registry.freeList.back();
+        registry.freeList.pop_back();
+    } else {
+        registry.all.push_back(std::make_unique<ThreadArenas>());
+        t_arenas.arenas = registry.all.back().get();
+    }
+    return *t_arenas.arenas;
+}
+
+} // namespace
+
+LinearArena& FrameMemory::GetFrameArena() {
+    ThreadArenas& arenas = GetThreadArenas();
+    uint64_t frame = g_frameIndex.load(std::memory_order_acquire);
+    if (arenas.frameStamp != frame) {
+        size_t peak = arenas.frame.GetPeakBytes();
+        arenas.frame.Reset();
+        arenas.frameStamp = frame;
+        arenas.Publish(peak);
+    }
+    return arenas.frame;
+}
+
+LinearArena& FrameMemory::GetTwoFrameArena() {
+    ThreadArenas& arenas = GetThreadArenas();
+    uint64_t frame = g_frameIndex.load(std::memory_order_acquire);
+    // 帧 N 使用槽 N & 1, 该槽直到帧 N + 2 首次访问时才重置
+    size_t slot = static_cast<size_t>(frame & 1);
+    if (arenas.twoFrameStamp[slot] != frame) {
+        arenas.twoFrame[slot].Reset();
+        arenas.twoFrameStamp[slot] = frame;
+    }
+    return arenas.twoFrame[slot];
+}
+
+LinearArena& FrameMemory::GetScratchArena() {
+    return GetThreadArenas().scratch;
+}
+
+void FrameMemory::EndFrame() {
+    g_frameIndex.fetch_add(1, std::memory_order_acq_rel);
+}
+
+uint64_t FrameMemory::GetFrameIndex() {
+    return g_frameIndex.load(std::memory_order_acquire);
+}
+
+FrameMemory::Stats FrameMemory::GetStats() {
+    Stats stats;
+    ArenaRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    stats.threadCount = registry.all.size() - registry.freeList.size();
+    for (const auto& arenas : registry.all) {
+        stats.capacityBytes += arenas->publishedCapacity.load(std::memory_order_relaxed);
+        stats.peakBytes += arenas->publishedPeak.load(std::memory_order_relaxed);
+        stats.upstreamAllocations += arenas->publishedUpstream.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} // namespace Core
+} // namespace PrismaEngine
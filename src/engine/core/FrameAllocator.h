@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Export.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief 线性 (bump) 分配器
+ *
+ * 从上游分配的内存块中顺序分配, 释放单个对象是空操作, 只能整体 Reset 或回退到 Marker。
+ * 不调用析构函数, 因此只应存放平凡析构的数据或使用自身作为分配器的 pmr 容器。
+ * 同时是 std::pmr::memory_resource, 可直接用于 std::pmr 容器。
+ * 非线程安全, 每个线程应使用各自的实例 (见 FrameMemory)。
+ */
+class ENGINE_API LinearArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    /**
+     * @brief 分配位置, 用于 Rewind 回退
+     */
+    struct Marker {
+        void* block   = nullptr;
+        size_t offset = 0;
+        size_t base   = 0;
+    };
+
+    explicit LinearArena(size_t blockSize = DefaultBlockSize,
+                         std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~LinearArena() override;
+
+    LinearArena(const LinearArena&)            = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        // 快速路径: 当前块剩余空间足够
+        if (m_current) {
+            uintptr_t begin   = reinterpret_cast<uintptr_t>(m_cursor);
+            uintptr_t aligned = (begin + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+            if (aligned + size <= reinterpret_cast<uintptr_t>(m_end)) {
+                m_cursor = reinterpret_cast<std::byte*>(aligned + size);
+                return reinterpret_cast<void*>(aligned);
+            }
+        }
+        return AllocateSlow(size, alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        return ::new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 分配未初始化的数组
+     */
+    template<typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    Marker GetMarker() const;
+
+    /**
+     * @brief 回退到 marker, 其后分配的内存全部失效; 已分配的内存块保留供后续使用
+     */
+    void Rewind(const Marker& marker);
+
+    /**
+     * @brief 释放全部分配
+     * 本轮使用了多个内存块时合并为一个足够容纳峰值的块, 稳定状态下不再向上游分配。
+     */
+    void Reset();
+
+    size_t GetUsedBytes() const;
+    size_t GetCapacity() const { return m_capacity; }
+    size_t GetPeakBytes() const;                                       // 自上次 Reset 以来
+    uint64_t GetUpstreamAllocations() const { return m_upstreamAllocations; }
+
+private:
+    struct Block;
+
+    void* AllocateSlow(size_t size, size_t alignment);
+    Block* AllocateBlock(size_t dataSize);
+    void FreeBlocks();
+    void SetCurrent(Block* block);
+
+    void* do_allocate(size_t bytes, size_t alignment) override { return Allocate(bytes, alignment); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_blockSize;
+
+    Block* m_first   = nullptr;
+    Block* m_current = nullptr;
+    std::byte* m_cursor = nullptr;
+    std::byte* m_end    = nullptr;
+    size_t m_base = 0;              // 当前块之前各块已占用的字节数
+
+    size_t m_capacity = 0;
+    size_t m_peak     = 0;
+    uint64_t m_upstreamAllocations = 0;
+};
+
+/**
+ * @brief 作用域栈分配器
+ * 构造时记录 arena 位置, 析构时回退, 作用域内的分配全部释放。可以嵌套, 但必须按后进先出顺序销毁。
+ *
+ * @code
+ * ScopedArena scope(FrameMemory::GetScratchArena());
+ * std::pmr::vector<uint32_t> temp(scope.Resource());
+ * @endcode
+ */
+class ScopedArena {
+public:
+    explicit ScopedArena(LinearArena& arena) : m_arena(arena), m_marker(arena.GetMarker()) {}
+    ~ScopedArena() { m_arena.Rewind(m_marker); }
+
+    ScopedArena(const ScopedArena&)            = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        return m_arena.Allocate(size, alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args) { return m_arena.New<T>(std::forward<Args>(args)...); }
+
+    template<typename T>
+    T* AllocateArray(size_t count) { return m_arena.AllocateArray<T>(count); }
+
+    LinearArena& Arena() { return m_arena; }
+    std::pmr::memory_resource* Resource() { return &m_arena; }
+
+private:
+    LinearArena& m_arena;
+    LinearArena::Marker m_marker;
+};
+
+/**
+ * @brief 每线程的帧内存
+ *
+ * - 帧 arena: 本帧有效, EndFrame 之后失效
+ * - 双帧 arena: 本帧和下一帧有效, 用于需要交给下一帧 (例如渲染线程) 的数据
+ * - 临时 arena: 不随帧重置, 配合 ScopedArena 作为栈分配器使用
+ *
+ * 每个线程拥有独立的 arena, 分配无需加锁。EndFrame 只递增帧序号, 各线程在新帧首次访问时
+ * 自行重置自己的 arena, 因此不会有线程重置正在被其他线程使用的内存。
+ * 帧 arena 中的数据可以在本帧内被其他线程读取; 不与 EndFrame 同步的线程 (例如渲染线程)
+ * 读取的数据应分配在双帧 arena 中。
+ */
+class ENGINE_API FrameMemory {
+public:
+    struct Stats {
+        size_t threadCount      = 0;
+        size_t capacityBytes    = 0;    // 所有线程 arena 的总容量
+        size_t peakBytes        = 0;    // 各线程上一次重置前的峰值之和
+        uint64_t upstreamAllocations = 0;
+    };
+
+    static LinearArena& GetFrameArena();
+    static LinearArena& GetTwoFrameArena();
+    static LinearArena& GetScratchArena();
+
+    static std::pmr::memory_resource* GetFrameResource() { return &GetFrameArena(); }
+    static std::pmr::memory_resource* GetTwoFrameResource() { return &GetTwoFrameArena(); }
+
+    /**
+     * @brief 结束当前帧, 在主线程每帧末尾调用一次
+     */
+    static void EndFrame();
+
+    static uint64_t GetFrameIndex();
+
+    static Stats GetStats();
+};
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,180 @@
+#include "Lz4.h"
+#include <cstring>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Core {
+
+namespace {
+
+constexpr size_t MinMatch    = 4;
+constexpr size_t LastLiterals = 5;   // 块末尾必须为字面量的字节数
+constexpr size_t MatchLimit  = 12;   // 最后一个匹配必须在此距离之前开始
+constexpr size_t MaxOffset   = 65535;
+constexpr uint32_t HashBits  = 14;
+constexpr uint32_t NoPosition = 0xFFFFFFFF;
+
+inline uint32_t Read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t HashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HashBits);
+}
+
+// 写入长度的扩展字节 (每字节 255, 以小于 255 的字节结束)
+inline uint8_t* WriteLength(uint8_t* op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+inline uint8_t* WriteLiterals(uint8_t* op, uint8_t* token, const uint8_t* literals, size_t length) {
+    if (length >= 15) {
+        *token = 15 << 4;
+        op = WriteLength(op, length - 15);
+    } else {
+        *token = static_cast<uint8_t>(length << 4);
+    }
+    if (length > 0) {
+        std::memcpy(op, literals, length);
+    }
+    return op + length;
+}
+
+} // namespace
+
+size_t Lz4::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) {
+    if (dstCapacity < CompressBound(srcSize) || srcSize > 0x7E000000) {
+        return 0;
+    }
+
+    uint8_t* op = dst;
+    size_t anchor = 0;
+
+    if (srcSize > MatchLimit) {
+        std::vector<uint32_t> table(size_t(1) << HashBits, NoPosition);
+        const size_t matchStartLimit = srcSize - MatchLimit;
+        const size_t matchEndLimit = srcSize - LastLiterals;
+
+        size_t ip = 0;
+        while (ip < matchStartLimit) {
+            const uint32_t sequence = Read32(src + ip);
+            const uint32_t hash = HashSequence(sequence);
+            const uint32_t ref = table[hash];
+            table[hash] = static_cast<uint32_t>(ip);
+
+            if (ref == NoPosition || ip - ref > MaxOffset || Read32(src + ref) != sequence) {
+                // 长时间无匹配时加大步长, 快速跳过不可压缩数据
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            size_t matchLength = MinMatch;
+            while (ip + matchLength < matchEndLimit && src[ref + matchLength] == src[ip + matchLength]) {
+                ++matchLength;
+            }
+
+            uint8_t* token = op++;
+            op = WriteLiterals(op, token, src + anchor, ip - anchor);
+
+            const size_t offset = ip - ref;
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+
+            const size_t extra = matchLength - MinMatch;
+            if (extra >= 15) {
+                *token |= 15;
+                op = WriteLength(op, extra - 15);
+            } else {
+                *token |= static_cast<uint8_t>(extra);
+            }
+
+            ip += matchLength;
+            anchor = ip;
+
+            // 记录匹配末尾附近的位置, 提高后续命中率
+            if (ip - 2 < matchStartLimit) {
+                table[HashSequence(Read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+            }
+        }
+    }
+
+    // 最后一段字面量
+    uint8_t* token = op++;
+    op = WriteLiterals(op, token, src + anchor, srcSize - anchor);
+    return static_cast<size_t>(op - dst);
+}
+
+bool Lz4::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* const srcEnd = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const dstEnd = dst + dstSize;
+
+    for (;;) {
+        if (ip >= srcEnd) return false;
+        const uint8_t token = *ip++;
+
+        // 字面量
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            uint8_t b;
+            do {
+                if (ip >= srcEnd) return false;
+                b = *ip++;
+                literalLength += b;
+            } while (b == 255);
+        }
+        if (literalLength > static_cast<size_t>(srcEnd - ip) || literalLength > static_cast<size_t>(dstEnd - op)) {
+            return false;
+        }
+        if (literalLength > 0) {
+            std::memcpy(op, ip, literalLength);
+        }
+        ip += literalLength;
+        op += literalLength;
+
+        // 最后一个序列只有字面量
+        if (ip == srcEnd) {
+            return op == dstEnd;
+        }
+
+        // 匹配
+        if (srcEnd - ip < 2) return false;
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15) {
+            uint8_t b;
+            do {
+                if (ip >= srcEnd) return false;
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += MinMatch;
+        if (matchLength > static_cast<size_t>(dstEnd - op)) return false;
+
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            // 重叠复制 (游程)
+            for (size_t i = 0; i < matchLength; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+}
+
+} // namespace Core
+} // namespace PrismaEngine
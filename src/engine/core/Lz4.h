@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Export.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief LZ4 块格式编解码
+ * 输出与标准 LZ4 块格式兼容 (不含帧头)，解压速度优先，
+ * 用于归档中需要快速加载的条目
+ */
+class ENGINE_API Lz4 {
+public:
+    /**
+     * @brief 压缩输出的最大字节数
+     */
+    static size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+    /**
+     * @brief 压缩数据块
+     * @param dstCapacity 必须不小于 CompressBound(srcSize)
+     * @return 压缩后的字节数，失败返回 0
+     */
+    static size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+    /**
+     * @brief 解压数据块
+     * @param dstSize 原始数据大小，解压结果必须恰好填满
+     * @return 输入损坏或大小不符时返回 false
+     */
+    static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+};
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,172 @@
+#include "MappedFile.h"
+#include "Logger.h"
+#include <utility>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace PrismaEngine {
+namespace Core {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+#if defined(_WIN32)
+        m_fileHandle    = std::exchange(other.m_fileHandle, nullptr);
+        m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::filesystem::path& path, AccessPattern pattern) {
+    Close();
+
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (pattern == AccessPattern::Sequential) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (pattern == AccessPattern::Random) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("MappedFile", "无法打开文件: {0}", path.string());
+        return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        LOG_ERROR("MappedFile", "无法获取文件大小: {0}", path.string());
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_size       = static_cast<size_t>(fileSize.QuadPart);
+    m_open       = true;
+
+    // 空文件无法创建映射，视为成功打开的空视图
+    if (m_size == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        LOG_ERROR("MappedFile", "CreateFileMapping 失败: {0}", path.string());
+        Close();
+        return false;
+    }
+    m_mappingHandle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        LOG_ERROR("MappedFile", "MapViewOfFile 失败: {0}", path.string());
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(view);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_fileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+    m_data          = nullptr;
+    m_size          = 0;
+    m_open          = false;
+    m_fileHandle    = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path, AccessPattern pattern) {
+    Close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("MappedFile", "无法打开文件: {0}", path.string());
+        return false;
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        LOG_ERROR("MappedFile", "无法获取文件大小: {0}", path.string());
+        return false;
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    m_open = true;
+
+    if (m_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void* view = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后文件描述符即可关闭，映射本身保持有效
+    ::close(fd);
+
+    if (view == MAP_FAILED) {
+        LOG_ERROR("MappedFile", "mmap 失败: {0}", path.string());
+        m_size = 0;
+        m_open = false;
+        return false;
+    }
+
+#if defined(POSIX_MADV_SEQUENTIAL) && !defined(__EMSCRIPTEN__)
+    if (pattern == AccessPattern::Sequential) {
+        ::posix_madvise(view, m_size, POSIX_MADV_SEQUENTIAL);
+    } else if (pattern == AccessPattern::Random) {
+        ::posix_madvise(view, m_size, POSIX_MADV_RANDOM);
+    }
+#else
+    (void)pattern;
+#endif
+
+    m_data = static_cast<const uint8_t*>(view);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#endif
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Export.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief 只读内存映射文件
+ * 将整个文件映射到进程地址空间，由操作系统按页加载，
+ * 调用方可以直接在映射区上读取数据而无需额外拷贝
+ */
+class ENGINE_API MappedFile {
+public:
+    /**
+     * @brief 访问模式提示 (传递给 madvise / 预读策略)
+     */
+    enum class AccessPattern {
+        Normal,      // 默认
+        Sequential,  // 顺序读取 (解析器)
+        Random       // 随机访问 (归档查找)
+    };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief 映射文件，失败时返回 false 并保持关闭状态
+     */
+    bool Open(const std::filesystem::path& path, AccessPattern pattern = AccessPattern::Normal);
+
+    /**
+     * @brief 解除映射并关闭文件
+     */
+    void Close();
+
+    bool IsOpen() const { return m_open; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    std::span<const uint8_t> Bytes() const { return {m_data, m_size}; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size         = 0;
+    bool m_open           = false;
+#if defined(_WIN32)
+    void* m_fileHandle    = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,130 @@
+#include "MemoryTracker.h"
+#include <atomic>
+#include <new>
+
+namespace PrismaEngine {
+namespace Core {
+
+namespace {
+
+// 每个标签独占缓存行, 避免不同子系统的计数互相干扰
+struct alignas(64) TagCounters {
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> liveCount{0};
+    std::atomic<int64_t> reservedBytes{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+
+    // 速率, 只由 Update 写入
+    std::atomic<float> allocationsPerSecond{0.0f};
+    std::atomic<float> bytesPerSecond{0.0f};
+    uint64_t windowAllocations = 0;
+    uint64_t windowBytes       = 0;
+};
+
+TagCounters g_counters[MemoryTracker::TagCount];
+float g_windowTime = 0.0f;
+
+TagCounters& Counters(MemoryTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return g_counters[index < MemoryTracker::TagCount ? index : 0];
+}
+
+} // namespace
+
+void MemoryTracker::RecordAllocation(MemoryTag tag, size_t bytes) {
+    TagCounters& counters = Counters(tag);
+    counters.liveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    counters.liveCount.fetch_add(1, std::memory_order_relaxed);
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::RecordFree(MemoryTag tag, size_t bytes) {
+    TagCounters& counters = Counters(tag);
+    counters.liveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    counters.liveCount.fetch_sub(1, std::memory_order_relaxed);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::RecordReserve(MemoryTag tag, int64_t bytes) {
+    Counters(tag).reservedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void* MemoryTracker::Allocate(MemoryTag tag, size_t bytes, size_t alignment) {
+    void* ptr = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        ? ::operator new(bytes, std::align_val_t(alignment))
+        : ::operator new(bytes);
+    RecordAllocation(tag, bytes);
+    return ptr;
+}
+
+void MemoryTracker::Free(MemoryTag tag, void* ptr, size_t bytes, size_t alignment) {
+    if (!ptr) return;
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(ptr, std::align_val_t(alignment));
+    } else {
+        ::operator delete(ptr);
+    }
+    RecordFree(tag, bytes);
+}
+
+MemoryTagStats MemoryTracker::GetStats(MemoryTag tag) {
+    const TagCounters& counters = Counters(tag);
+    MemoryTagStats stats;
+    stats.liveBytes            = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.liveCount            = counters.liveCount.load(std::memory_order_relaxed);
+    stats.reservedBytes        = counters.reservedBytes.load(std::memory_order_relaxed);
+    stats.totalAllocations     = counters.allocations.load(std::memory_order_relaxed);
+    stats.totalFrees           = counters.frees.load(std::memory_order_relaxed);
+    stats.allocationsPerSecond = counters.allocationsPerSecond.load(std::memory_order_relaxed);
+    stats.bytesPerSecond       = counters.bytesPerSecond.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::array<MemoryTagStats, MemoryTracker::TagCount> MemoryTracker::GetAllStats() {
+    std::array<MemoryTagStats, TagCount> stats;
+    for (size_t i = 0; i < TagCount; ++i) {
+        stats[i] = GetStats(static_cast<MemoryTag>(i));
+    }
+    return stats;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::General:   return "General";
+        case MemoryTag::Frame:     return "Frame";
+        case MemoryTag::Scene:     return "Scene";
+        case MemoryTag::Component: return "Component";
+        case MemoryTag::Audio:     return "Audio";
+        case MemoryTag::Render:    return "Render";
+        case MemoryTag::Resource:  return "Resource";
+        case MemoryTag::Physics:   return "Physics";
+        case MemoryTag::Script:    return "Script";
+        case MemoryTag::UI:        return "UI";
+        default:                   return "Unknown";
+    }
+}
+
+void MemoryTracker::Update(float deltaTime) {
+    constexpr float Window = 1.0f;
+
+    g_windowTime += deltaTime;
+    if (g_windowTime < Window) return;
+
+    for (TagCounters& counters : g_counters) {
+        uint64_t allocations = counters.allocations.load(std::memory_order_relaxed);
+        uint64_t bytes       = counters.allocatedBytes.load(std::memory_order_relaxed);
+        counters.allocationsPerSecond.store(
+            static_cast<float>(allocations - counters.windowAllocations) / g_windowTime, std::memory_order_relaxed);
+        counters.bytesPerSecond.store(
+            static_cast<float>(bytes - counters.windowBytes) / g_windowTime, std::memory_order_relaxed);
+        counters.windowAllocations = allocations;
+        counters.windowBytes       = bytes;
+    }
+    g_windowTime = 0.0f;
+}
+
+} // namespace Core
+} // namespace PrismaEngine
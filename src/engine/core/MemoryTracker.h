@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Export.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief 内存分配的归属子系统
+ */
+enum class MemoryTag : uint8_t {
+    General,
+    Frame,      // 帧 arena 的内存块
+    Scene,      // GameObject、SceneNode
+    Component,
+    Audio,
+    Render,     // GPU 资源的 CPU 端对象
+    Resource,   // 资源与资源缓存
+    Physics,
+    Script,
+    UI,
+    Count
+};
+
+/**
+ * @brief 单个标签的统计
+ */
+struct MemoryTagStats {
+    int64_t liveBytes         = 0;  // 当前在用的字节数 (对象池按槽大小计算)
+    int64_t liveCount         = 0;
+    int64_t reservedBytes     = 0;  // 对象池的内存页, 不计入 liveBytes
+    uint64_t totalAllocations = 0;
+    uint64_t totalFrees       = 0;
+    float allocationsPerSecond = 0.0f;
+    float bytesPerSecond       = 0.0f;
+};
+
+/**
+ * @brief 按标签统计内存分配 (线程安全)
+ *
+ * 记录使用原子计数, 开销为每次分配几次无竞争的原子加法。
+ * 分配速率由 Update 按约一秒的窗口计算, 应每帧在主线程调用。
+ */
+class ENGINE_API MemoryTracker {
+public:
+    static constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+
+    static void RecordAllocation(MemoryTag tag, size_t bytes);
+    static void RecordFree(MemoryTag tag, size_t bytes);
+
+    /**
+     * @brief 记录对象池等预留但未逐个分配的内存, bytes 可为负
+     */
+    static void RecordReserve(MemoryTag tag, int64_t bytes);
+
+    /**
+     * @brief 带统计的堆分配, 用于不经过对象池的对象
+     */
+    static void* Allocate(MemoryTag tag, size_t bytes, size_t alignment = alignof(std::max_align_t));
+    static void Free(MemoryTag tag, void* ptr, size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    static MemoryTagStats GetStats(MemoryTag tag);
+    static std::array<MemoryTagStats, TagCount> GetAllStats();
+
+    static const char* GetTagName(MemoryTag tag);
+
+    static void Update(float deltaTime);
+};
+
+/**
+ * @brief 带标签统计的 std::pmr::memory_resource, 将分配转发给上游
+ */
+class ENGINE_API TaggedMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit TaggedMemoryResource(MemoryTag tag,
+                                  std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : m_tag(tag), m_upstream(upstream) {}
+
+    MemoryTag GetTag() const { return m_tag; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = m_upstream->allocate(bytes, alignment);
+        MemoryTracker::RecordAllocation(m_tag, bytes);
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        m_upstream->deallocate(ptr, bytes, alignment);
+        MemoryTracker::RecordFree(m_tag, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    MemoryTag m_tag;
+    std::pmr::memory_resource* m_upstream;
+};
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,111 @@
+#include "ObjectPool.h"
+#include <algorithm>
+
+namespace PrismaEngine {
+namespace Core {
+
+namespace {
+
+struct PoolRegistry {
+    std::mutex mutex;
+    std::vector<PoolStorage*> pools;
+};
+
+// 有意不析构, 与池本身的生命周期一致
+PoolRegistry& GetPoolRegistry() {
+    static PoolRegistry* registry = new PoolRegistry();
+    return *registry;
+}
+
+constexpr size_t TargetSlabBytes = 16 * 1024;
+constexpr size_t MinSlotsPerSlab = 16;
+
+} // namespace
+
+PoolStorage::PoolStorage(const char* name, size_t slotSize, size_t slotAlign, MemoryTag tag, size_t slotsPerSlab)
+    : m_name(name)
+    , m_tag(tag) {
+    m_slotAlign = std::max(slotAlign, alignof(FreeSlot));
+    // 槽大小向上取整到对齐, 保证每个槽都满足对齐要求且能容纳空闲链表指针
+    m_slotSize = std::max(slotSize, sizeof(FreeSlot));
+    m_slotSize = (m_slotSize + m_slotAlign - 1) / m_slotAlign * m_slotAlign;
+    m_slotsPerSlab = slotsPerSlab ? slotsPerSlab : std::max(MinSlotsPerSlab, TargetSlabBytes / m_slotSize);
+
+    PoolRegistry& registry = GetPoolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.pools.push_back(this);
+}
+
+PoolStorage::~PoolStorage() {
+    {
+        PoolRegistry& registry = GetPoolRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.pools.erase(std::remove(registry.pools.begin(), registry.pools.end(), this), registry.pools.end());
+    }
+
+    const size_t slabBytes = m_slotSize * m_slotsPerSlab;
+    for (void* slab : m_slabs) {
+        ::operator delete(slab, std::align_val_t(m_slotAlign));
+    }
+    MemoryTracker::RecordReserve(m_tag, -static_cast<int64_t>(slabBytes * m_slabs.size()));
+}
+
+void PoolStorage::AllocateSlab() {
+    const size_t slabBytes = m_slotSize * m_slotsPerSlab;
+    auto* slab = static_cast<std::byte*>(::operator new(slabBytes, std::align_val_t(m_slotAlign)));
+    m_slabs.push_back(slab);
+    MemoryTracker::RecordReserve(m_tag, static_cast<int64_t>(slabBytes));
+
+    // 倒序压入, 使新页按地址顺序被分配
+    for (size_t i = m_slotsPerSlab; i-- > 0;) {
+        auto* slot = reinterpret_cast<FreeSlot*>(slab + i * m_slotSize);
+        slot->next = m_freeList;
+        m_freeList = slot;
+    }
+}
+
+void* PoolStorage::Allocate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_freeList) AllocateSlab();
+    FreeSlot* slot = m_freeList;
+    m_freeList = slot->next;
+    ++m_liveCount;
+    MemoryTracker::RecordAllocation(m_tag, m_slotSize);
+    return slot;
+}
+
+void PoolStorage::Deallocate(void* ptr) {
+    if (!ptr) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto* slot = static_cast<FreeSlot*>(ptr);
+    slot->next = m_freeList;
+    m_freeList = slot;
+    --m_liveCount;
+    MemoryTracker::RecordFree(m_tag, m_slotSize);
+}
+
+PoolStorage::Stats PoolStorage::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    stats.name      = m_name;
+    stats.tag       = m_tag;
+    stats.slotSize  = m_slotSize;
+    stats.slabCount = m_slabs.size();
+    stats.capacity  = m_slabs.size() * m_slotsPerSlab;
+    stats.liveCount = m_liveCount;
+    return stats;
+}
+
+std::vector<PoolStorage::Stats> PoolStorage::GetAllStats() {
+    PoolRegistry& registry = GetPoolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<Stats> stats;
+    stats.reserve(registry.pools.size());
+    for (const PoolStorage* pool : registry.pools) {
+        stats.push_back(pool->GetStats());
+    }
+    return stats;
+}
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Export.h"
+#include "MemoryTracker.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief 固定大小槽的内存池 (线程安全)
+ *
+ * 以内存页 (slab) 为单位向系统申请, 空闲槽串成单向链表, 后释放的槽先被复用以保持局部性。
+ * 内存页在池的生命周期内不归还, 长时间运行时不会产生碎片。
+ */
+class ENGINE_API PoolStorage {
+public:
+    struct Stats {
+        const char* name   = nullptr;
+        MemoryTag tag      = MemoryTag::General;
+        size_t slotSize    = 0;
+        size_t slabCount   = 0;
+        size_t capacity    = 0;   // 槽总数
+        size_t liveCount   = 0;
+    };
+
+    PoolStorage(const char* name, size_t slotSize, size_t slotAlign, MemoryTag tag, size_t slotsPerSlab = 0);
+    ~PoolStorage();
+
+    PoolStorage(const PoolStorage&)            = delete;
+    PoolStorage& operator=(const PoolStorage&) = delete;
+
+    void* Allocate();
+    void Deallocate(void* ptr);
+
+    Stats GetStats() const;
+
+    /**
+     * @brief 所有已创建的池的统计
+     */
+    static std::vector<Stats> GetAllStats();
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    void AllocateSlab();
+
+    const char* m_name;
+    MemoryTag m_tag;
+    size_t m_slotSize;
+    size_t m_slotAlign;
+    size_t m_slotsPerSlab;
+
+    mutable std::mutex m_mutex;
+    FreeSlot* m_freeList = nullptr;
+    std::vector<void*> m_slabs;
+    size_t m_liveCount = 0;
+};
+
+/**
+ * @brief 类型化的对象池
+ *
+ * 每个 (T, Tag) 组合共享一个 PoolStorage。池在首次使用时创建且不会销毁,
+ * 因此静态析构期间释放对象也是安全的。
+ *
+ * @code
+ * auto object = ObjectPool<GameObject, MemoryTag::Scene>::MakeShared("Player");
+ * @endcode
+ */
+template<typename T, MemoryTag Tag = MemoryTag::General>
+class ObjectPool {
+public:
+    static PoolStorage& Storage() {
+        static PoolStorage* storage = new PoolStorage(typeid(T).name(), sizeof(T), alignof(T), Tag);
+        return *storage;
+    }
+
+    template<typename... Args>
+    static T* New(Args&&... args) {
+        void* memory = Storage().Allocate();
+        try {
+            return ::new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            Storage().Deallocate(memory);
+            throw;
+        }
+    }
+
+    static void Delete(T* object) {
+        if (!object) return;
+        object->~T();
+        Storage().Deallocate(object);
+    }
+
+    /**
+     * @brief 创建 shared_ptr, 对象和控制块一起从池中分配
+     */
+    template<typename... Args>
+    static std::shared_ptr<T> MakeShared(Args&&... args);
+};
+
+/**
+ * @brief 从对象池分配单个对象的 STL 分配器, 批量分配退回到带统计的堆分配
+ * 主要用于 std::allocate_shared, 控制块经 rebind 后从自己大小对应的池中分配。
+ */
+template<typename T, MemoryTag Tag = MemoryTag::General>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = PoolAllocator<U, Tag>;
+    };
+
+    PoolAllocator() noexcept = default;
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count == 1) {
+            return static_cast<T*>(ObjectPool<T, Tag>::Storage().Allocate());
+        }
+        return static_cast<T*>(MemoryTracker::Allocate(Tag, sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        if (count == 1) {
+            ObjectPool<T, Tag>::Storage().Deallocate(ptr);
+        } else {
+            MemoryTracker::Free(Tag, ptr, sizeof(T) * count, alignof(T));
+        }
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U, Tag>&) const noexcept { return true; }
+};
+
+template<typename T, MemoryTag Tag>
+template<typename... Args>
+std::shared_ptr<T> ObjectPool<T, Tag>::MakeShared(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T, Tag>(), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief 让类的 new/delete 走对象池
+ *
+ * 适用于通过 unique_ptr 或裸指针持有、经接口基类删除的对象 (基类需有虚析构函数)。
+ * 大小与 T 不同的派生类退回到带统计的堆分配。
+ */
+template<typename T, MemoryTag Tag>
+class PooledObject {
+public:
+    static void* operator new(size_t size) {
+        if (size == sizeof(T)) return ObjectPool<T, Tag>::Storage().Allocate();
+        return MemoryTracker::Allocate(Tag, size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+        if (!ptr) return;
+        if (size == sizeof(T)) {
+            ObjectPool<T, Tag>::Storage().Deallocate(ptr);
+        } else {
+            MemoryTracker::Free(Tag, ptr, size);
+        }
+    }
+};
+
+} // namespace Core
+} // namespace PrismaEngine
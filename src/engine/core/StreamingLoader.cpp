@@ -0,0 +1,429 @@
+#include "StreamingLoader.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+
+namespace PrismaEngine {
+namespace Core {
+
+struct StreamingLoader::Entry {
+    StreamRequestId id = InvalidStreamRequest;
+    StreamRequest request;
+    StreamPayload payload;
+    StreamState state      = StreamState::Queued;
+    QueueKey key{};
+    uint64_t bufferedBytes = 0;  // 计入 Stats::bufferedBytes 的字节数
+};
+
+namespace {
+
+// I/O 阶段: 优先从已挂载的归档读取, 否则读取整个文件
+bool ReadSource(StreamPayload& payload) {
+    if (VfsFile archived = VirtualFileSystem::GetInstance().Open(payload.path)) {
+        payload.archived = std::move(archived);
+        return true;
+    }
+
+    std::ifstream file(payload.path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    file.seekg(0);
+    payload.fileData.resize(static_cast<size_t>(size));
+    return size == 0 || file.read(reinterpret_cast<char*>(payload.fileData.data()), size).good();
+}
+
+} // namespace
+
+bool StreamingLoader::QueueKey::operator<(const QueueKey& other) const {
+    if (deadline != other.deadline) return deadline < other.deadline;
+    if (priority != other.priority) return priority < other.priority;
+    return sequence < other.sequence;
+}
+
+// ============================================================================
+// 生命周期
+// ============================================================================
+
+StreamingLoader::StreamingLoader() : StreamingLoader(StreamingConfig{}) {
+}
+
+StreamingLoader::StreamingLoader(const StreamingConfig& config) : m_config(config) {
+    const uint32_t threadCount = std::max(config.ioThreadCount, 1u);
+    m_ioThreads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        m_ioThreads.emplace_back(&StreamingLoader::IoThreadFunction, this);
+    }
+}
+
+StreamingLoader::~StreamingLoader() {
+    Shutdown();
+}
+
+void StreamingLoader::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        for (auto& [id, entry] : m_entries) {
+            if (entry->state == StreamState::Reading || entry->state == StreamState::Decoding) {
+                entry->state = StreamState::Cancelled;
+            }
+        }
+    }
+    m_ioCondition.notify_all();
+
+    for (std::thread& thread : m_ioThreads) {
+        if (thread.joinable()) thread.join();
+    }
+    m_ioThreads.clear();
+
+    // 解码作业持有 this, 必须等待其结束
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_decodeCondition.wait(lock, [this] { return m_activeDecodes == 0; });
+    m_queue.clear();
+    m_ready.clear();
+    m_failed.clear();
+    m_entries.clear();
+    m_stats.bufferedBytes = 0;
+}
+
+// ============================================================================
+// 请求管理
+// ============================================================================
+
+StreamRequestId StreamingLoader::Submit(StreamRequest request) {
+    auto entry          = std::make_shared<Entry>();
+    entry->payload.path = request.path;
+    entry->request      = std::move(request);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return InvalidStreamRequest;
+        }
+
+        entry->id  = m_nextId++;
+        entry->key = {entry->request.deadline, entry->request.priority, m_nextSequence++};
+        m_entries.emplace(entry->id, entry);
+        m_queue.emplace(entry->key, entry->id);
+    }
+    m_ioCondition.notify_one();
+    return entry->id;
+}
+
+bool StreamingLoader::Cancel(StreamRequestId id) {
+    bool cancelled = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(id);
+        if (it != m_entries.end()) {
+            std::shared_ptr<Entry> entry = it->second;
+            cancelled                    = CancelLocked(entry);
+        }
+    }
+    if (cancelled) {
+        m_ioCondition.notify_all();
+    }
+    return cancelled;
+}
+
+void StreamingLoader::CancelAll() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::shared_ptr<Entry>> entries;
+        entries.reserve(m_entries.size());
+        for (const auto& [id, entry] : m_entries) {
+            entries.push_back(entry);
+        }
+        for (const auto& entry : entries) {
+            CancelLocked(entry);
+        }
+    }
+    m_ioCondition.notify_all();
+}
+
+bool StreamingLoader::CancelLocked(const std::shared_ptr<Entry>& entry) {
+    switch (entry->state) {
+    case StreamState::Queued:
+        m_queue.erase({entry->key, entry->id});
+        Retire(entry);
+        break;
+    case StreamState::Reading:
+    case StreamState::Decoding:
+        // 由所在阶段结束时丢弃
+        entry->state = StreamState::Cancelled;
+        break;
+    case StreamState::Ready:
+        m_ready.erase(std::find(m_ready.begin(), m_ready.end(), entry));
+        Retire(entry);
+        break;
+    case StreamState::Failed:
+        m_failed.erase(std::find(m_failed.begin(), m_failed.end(), entry));
+        Retire(entry);
+        break;
+    default:
+        return false;
+    }
+
+    ++m_stats.cancelledCount;
+    return true;
+}
+
+bool StreamingLoader::SetPriority(StreamRequestId id, float priority) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) {
+        return false;
+    }
+
+    Entry& entry            = *it->second;
+    QueueKey key            = entry.key;
+    key.priority            = priority;
+    entry.request.priority  = priority;
+    UpdateKey(entry, key);
+    return true;
+}
+
+bool StreamingLoader::SetDeadline(StreamRequestId id, Clock::time_point deadline) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) {
+        return false;
+    }
+
+    Entry& entry           = *it->second;
+    QueueKey key           = entry.key;
+    key.deadline           = deadline;
+    entry.request.deadline = deadline;
+    UpdateKey(entry, key);
+    return true;
+}
+
+void StreamingLoader::UpdateKey(Entry& entry, const QueueKey& key) {
+    if (entry.state == StreamState::Queued) {
+        m_queue.erase({entry.key, entry.id});
+        m_queue.emplace(key, entry.id);
+    }
+    // 等待上传的请求在 Update 中按键排序, 直接修改即可
+    entry.key = key;
+}
+
+StreamState StreamingLoader::GetState(StreamRequestId id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(id);
+    return it != m_entries.end() ? it->second->state : StreamState::Unknown;
+}
+
+void StreamingLoader::SetBufferedBytes(Entry& entry, uint64_t bytes) {
+    m_stats.bufferedBytes = m_stats.bufferedBytes - entry.bufferedBytes + bytes;
+    entry.bufferedBytes   = bytes;
+}
+
+void StreamingLoader::Retire(const std::shared_ptr<Entry>& entry) {
+    const StreamRequestId id = entry->id;
+    SetBufferedBytes(*entry, 0);
+    m_entries.erase(id);
+}
+
+// ============================================================================
+// I/O 阶段
+// ============================================================================
+
+void StreamingLoader::IoThreadFunction() {
+    for (;;) {
+        std::shared_ptr<Entry> entry;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // 已缓冲的数据超过上限时暂停读取, 等待上传阶段消化
+            m_ioCondition.wait(lock, [this] {
+                return m_stopping || (!m_queue.empty() && m_stats.bufferedBytes < m_config.maxBufferedBytes);
+            });
+            if (m_stopping) {
+                return;
+            }
+
+            auto first = m_queue.begin();
+            entry      = m_entries.at(first->second);
+            m_queue.erase(first);
+            entry->state = StreamState::Reading;
+        }
+
+        const bool read = ReadSource(entry->payload);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (entry->state == StreamState::Cancelled) {
+            Retire(entry);
+            continue;
+        }
+
+        if (!read) {
+            LOG_WARNING("Streaming", "读取失败: {0}", entry->payload.path);
+            entry->state = StreamState::Failed;
+            m_failed.push_back(entry);
+            continue;
+        }
+
+        SetBufferedBytes(*entry, entry->payload.Size());
+
+        if (!entry->request.decode) {
+            entry->state = StreamState::Ready;
+            m_ready.push_back(entry);
+            continue;
+        }
+
+        entry->state = StreamState::Decoding;
+        ++m_activeDecodes;
+        lock.unlock();
+
+        JobSystem::GetInstance().SubmitJob([this, entry]() { Decode(entry); });
+    }
+}
+
+// ============================================================================
+// 解码阶段
+// ============================================================================
+
+void StreamingLoader::Decode(const std::shared_ptr<Entry>& entry) {
+    bool decoded = false;
+    try {
+        decoded = entry->request.decode(entry->payload);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Streaming", "解码异常: {0} ({1})", entry->payload.path, e.what());
+    } catch (...) {
+        // 任何异常都必须走到下面的 --m_activeDecodes, 否则 Shutdown 会一直等待
+        LOG_ERROR("Streaming", "解码异常: {0} (未知异常)", entry->payload.path);
+    }
+
+    if (decoded && entry->payload.decoded) {
+        entry->payload.ReleaseSource();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (entry->state == StreamState::Cancelled) {
+        Retire(entry);
+    } else if (decoded) {
+        const uint64_t bytes = entry->payload.uploadBytes > 0 ? entry->payload.uploadBytes : entry->payload.Size();
+        SetBufferedBytes(*entry, bytes);
+        entry->state = StreamState::Ready;
+        m_ready.push_back(entry);
+    } else {
+        LOG_WARNING("Streaming", "解码失败: {0}", entry->payload.path);
+        SetBufferedBytes(*entry, 0);
+        entry->state = StreamState::Failed;
+        m_failed.push_back(entry);
+    }
+
+    --m_activeDecodes;
+    // 在持有锁时通知, Shutdown 被唤醒后才能销毁对象
+    m_decodeCondition.notify_all();
+    m_ioCondition.notify_all();
+}
+
+// ============================================================================
+// 上传阶段
+// ============================================================================
+
+size_t StreamingLoader::Update() {
+    std::vector<std::shared_ptr<Entry>> uploads;
+    std::vector<std::shared_ptr<Entry>> failed;
+    uint64_t uploadedBytes = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto& entry : m_failed) {
+            Retire(entry);
+            ++m_stats.failedCount;
+        }
+        failed.swap(m_failed);
+
+        std::sort(m_ready.begin(), m_ready.end(),
+                  [](const auto& a, const auto& b) { return a->key < b->key; });
+
+        // 按优先级取出不超过预算的请求, 至少取出一个以保证前进;
+        // 超过截止时间的请求排在最前且不受预算限制
+        const auto now = Clock::now();
+        size_t count   = 0;
+        for (const auto& entry : m_ready) {
+            const bool overdue = entry->key.deadline <= now;
+            if (!overdue && count > 0 && uploadedBytes + entry->bufferedBytes > m_config.uploadBytesPerFrame) {
+                break;
+            }
+            uploadedBytes += entry->bufferedBytes;
+            entry->state = StreamState::Uploading;
+            ++count;
+        }
+
+        uploads.assign(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(count));
+        m_ready.erase(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    for (const auto& entry : failed) {
+        if (entry->request.onFailed) entry->request.onFailed(entry->id);
+    }
+
+    std::vector<bool> succeeded(uploads.size(), true);
+    for (size_t i = 0; i < uploads.size(); ++i) {
+        Entry& entry = *uploads[i];
+        if (entry.request.upload) {
+            succeeded[i] = entry.request.upload(entry.payload);
+        }
+        if (!succeeded[i]) {
+            LOG_WARNING("Streaming", "上传失败: {0}", entry.payload.path);
+            if (entry.request.onFailed) entry.request.onFailed(entry.id);
+        }
+    }
+
+    size_t completed = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < uploads.size(); ++i) {
+            Retire(uploads[i]);
+            if (succeeded[i]) {
+                ++completed;
+                ++m_stats.completedCount;
+            } else {
+                ++m_stats.failedCount;
+            }
+        }
+        m_stats.uploadedBytes = uploadedBytes;
+    }
+
+    if (!uploads.empty()) {
+        m_ioCondition.notify_all();
+    }
+    return completed;
+}
+
+void StreamingLoader::SetUploadBudget(uint64_t bytesPerFrame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_config.uploadBytesPerFrame = bytesPerFrame;
+}
+
+// ============================================================================
+// 统计
+// ============================================================================
+
+bool StreamingLoader::IsIdle() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.empty();
+}
+
+StreamingLoader::Stats StreamingLoader::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats    = m_stats;
+    stats.queued   = m_queue.size();
+    stats.ready    = m_ready.size();
+    stats.inFlight = m_entries.size() - m_queue.size() - m_ready.size() - m_failed.size();
+    return stats;
+}
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Export.h"
+#include "VirtualFileSystem.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Core {
+
+using StreamRequestId = uint64_t;
+constexpr StreamRequestId InvalidStreamRequest = 0;
+
+/**
+ * @brief 流式加载请求状态
+ */
+enum class StreamState : uint8_t {
+    Unknown,    // 不存在或已结束
+    Queued,     // 等待读取
+    Reading,    // I/O 阶段
+    Decoding,   // 解码阶段 (工作线程)
+    Ready,      // 等待上传 (主线程)
+    Uploading,  // 上传中, 已无法取消
+    Failed,     // 失败, 等待 Update 回调
+    Cancelled   // 已取消, 等待所在阶段丢弃
+};
+
+/**
+ * @brief 在各阶段之间传递的请求数据
+ * 归档中的条目直接引用映射区, 其余文件读入 fileData。
+ */
+struct ENGINE_API StreamPayload {
+    // VfsFile 只可移动; 导出类需显式声明, 避免生成复制构造
+    StreamPayload()                                = default;
+    StreamPayload(StreamPayload&&)                 = default;
+    StreamPayload& operator=(StreamPayload&&)      = default;
+    StreamPayload(const StreamPayload&)            = delete;
+    StreamPayload& operator=(const StreamPayload&) = delete;
+
+    std::string path;
+    VfsFile archived;
+    std::vector<uint8_t> fileData;
+
+    // 解码阶段的输出; 设置后原始数据会在解码完成时释放
+    std::shared_ptr<void> decoded;
+
+    // 上传阶段计入每帧预算的字节数, 为 0 时按原始数据大小计算
+    uint64_t uploadBytes = 0;
+
+    const uint8_t* Data() const { return archived ? archived.Data() : fileData.data(); }
+    size_t Size() const { return archived ? archived.Size() : fileData.size(); }
+
+    void ReleaseSource() {
+        archived = VfsFile();
+        std::vector<uint8_t>().swap(fileData);
+    }
+};
+
+/**
+ * @brief 流式加载请求
+ */
+struct StreamRequest {
+    using Clock = std::chrono::steady_clock;
+
+    std::string path;
+
+    // 数值越小越优先 (例如到相机的距离); 截止时间更早的请求先于优先级比较
+    float priority = 0.0f;
+    Clock::time_point deadline = Clock::time_point::max();
+
+    // 在工作线程上执行, 为空时跳过解码阶段
+    std::function<bool(StreamPayload&)> decode;
+    // 在 Update 中 (主线程) 执行, 为空时跳过上传阶段
+    std::function<bool(StreamPayload&)> upload;
+    // 读取/解码/上传失败时在 Update 中调用 (取消的请求不会回调)
+    std::function<void(StreamRequestId)> onFailed;
+};
+
+struct StreamingConfig {
+    uint32_t ioThreadCount       = 2;                     // I/O 线程数, 即同时进行的读取数
+    uint64_t maxBufferedBytes    = 256ull * 1024 * 1024;  // 已读取但尚未上传的数据上限, 超过时暂停读取
+    uint64_t uploadBytesPerFrame = 32ull * 1024 * 1024;   // 每帧上传预算
+};
+
+/**
+ * @brief 分阶段的流式加载器
+ *
+ * 请求依次经过三个阶段:
+ *   1. I/O: 固定数量的 I/O 线程按优先级取出请求并读取数据 (优先从 VFS 读取)
+ *   2. 解码: 提交到 JobSystem 并行执行
+ *   3. 上传: 在 Update 中按优先级执行, 每帧受字节预算限制; 已超过截止时间的请求不受预算限制
+ * 请求可在任意阶段取消, 排队和等待上传的请求可调整优先级。
+ */
+class ENGINE_API StreamingLoader {
+public:
+    using Clock = StreamRequest::Clock;
+
+    struct Stats {
+        size_t queued            = 0;
+        size_t inFlight          = 0;  // 读取和解码中
+        size_t ready             = 0;
+        uint64_t bufferedBytes   = 0;
+        uint64_t uploadedBytes   = 0;  // 上一次 Update 上传的字节数
+        uint64_t completedCount  = 0;
+        uint64_t failedCount     = 0;
+        uint64_t cancelledCount  = 0;
+    };
+
+    StreamingLoader();
+    explicit StreamingLoader(const StreamingConfig& config);
+    ~StreamingLoader();
+
+    StreamingLoader(const StreamingLoader&)            = delete;
+    StreamingLoader& operator=(const StreamingLoader&) = delete;
+
+    /**
+     * @brief 提交请求
+     * @return 请求 ID, 加载器已关闭时返回 InvalidStreamRequest
+     */
+    StreamRequestId Submit(StreamRequest request);
+
+    /**
+     * @brief 取消请求, 已结束或不存在时返回 false
+     */
+    bool Cancel(StreamRequestId id);
+
+    /**
+     * @brief 调整优先级 (排队和等待上传的请求会按新优先级重新排序)
+     */
+    bool SetPriority(StreamRequestId id, float priority);
+    bool SetDeadline(StreamRequestId id, Clock::time_point deadline);
+
+    StreamState GetState(StreamRequestId id) const;
+
+    /**
+     * @brief 执行上传阶段和失败回调, 每帧在主线程调用
+     * @return 本次完成上传的请求数
+     */
+    size_t Update();
+
+    void SetUploadBudget(uint64_t bytesPerFrame);
+
+    /**
+     * @brief 取消所有请求
+     */
+    void CancelAll();
+
+    /**
+     * @brief 取消所有请求并等待 I/O 线程和解码作业退出
+     */
+    void Shutdown();
+
+    bool IsIdle() const;
+    Stats GetStats() const;
+
+private:
+    struct Entry;
+
+    // 队列排序键: 截止时间, 优先级, 提交顺序
+    struct QueueKey {
+        Clock::time_point deadline;
+        float priority;
+        uint64_t sequence;
+
+        bool operator<(const QueueKey& other) const;
+    };
+
+    void IoThreadFunction();
+    void Decode(const std::shared_ptr<Entry>& entry);
+
+    // 以下函数要求持有 m_mutex
+    bool CancelLocked(const std::shared_ptr<Entry>& entry);
+    void SetBufferedBytes(Entry& entry, uint64_t bytes);
+    void Retire(const std::shared_ptr<Entry>& entry);
+    void UpdateKey(Entry& entry, const QueueKey& key);
+
+    StreamingConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_ioCondition;
+    std::condition_variable m_decodeCondition;
+
+    std::unordered_map<StreamRequestId, std::shared_ptr<Entry>> m_entries;
+    std::set<std::pair<QueueKey, StreamRequestId>> m_queue;
+    std::vector<std::shared_ptr<Entry>> m_ready;
+    std::vector<std::shared_ptr<Entry>> m_failed;
+
+    std::vector<std::thread> m_ioThreads;
+    StreamRequestId m_nextId = 1;
+    uint64_t m_nextSequence  = 0;
+    size_t m_activeDecodes   = 0;
+    bool m_stopping          = false;
+    Stats m_stats;
+};
+
+} // namespace Core
+} // namespace PrismaEngine
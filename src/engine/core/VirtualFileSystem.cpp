@@ -0,0 +1,282 @@
+#include "VirtualFileSystem.h"
+#include "Hash64.h"
+#include "Logger.h"
+#include "Lz4.h"
+#include "MappedFile.h"
+#include "../packing/PakFormat.h"
+#include <algorithm>
+#include <mutex>
+
+#ifdef PRISMA_USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace PrismaEngine {
+namespace Core {
+
+using namespace Packing;
+
+// ============================================================================
+// VfsFile
+// ============================================================================
+
+VfsFile::VfsFile(VfsFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+VfsFile& VfsFile::operator=(VfsFile&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    const bool ownsData = !other.m_buffer.empty() && other.m_data == other.m_buffer.data();
+    m_owner       = std::move(other.m_owner);
+    m_buffer      = std::move(other.m_buffer);
+    m_data        = ownsData ? m_buffer.data() : other.m_data;
+    m_size        = other.m_size;
+    m_contentHash = other.m_contentHash;
+    m_valid       = other.m_valid;
+
+    other.m_buffer.clear();
+    other.m_data        = nullptr;
+    other.m_size        = 0;
+    other.m_contentHash = 0;
+    other.m_valid       = false;
+    return *this;
+}
+
+// ============================================================================
+// 已挂载的归档
+// ============================================================================
+
+struct VirtualFileSystem::Archive {
+    std::filesystem::path path;
+    MappedFile file;
+    const PakHeader* header = nullptr;
+    const PakEntry* entries = nullptr;
+    const char* strings     = nullptr;
+
+    // 校验归档结构 (映射后调用), verify 为 true 时同时校验条目表哈希
+    bool Validate(bool verify);
+
+    std::string_view GetName(const PakEntry& entry) const {
+        return {strings + entry.nameOffset, entry.nameLength};
+    }
+
+    // 条目表按 pathHash 排序, 哈希相同的条目按路径区分
+    bool Find(uint64_t hash, std::string_view name, uint32_t& outIndex) const {
+        const PakEntry* end = entries + header->entryCount;
+        const PakEntry* it  = std::lower_bound(entries, end, hash,
+                                               [](const PakEntry& e, uint64_t h) { return e.pathHash < h; });
+        for (; it != end && it->pathHash == hash; ++it) {
+            if (GetName(*it) == name) {
+                outIndex = static_cast<uint32_t>(it - entries);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+bool VirtualFileSystem::Archive::Validate(bool verify) {
+    const uint8_t* data = file.Data();
+    const uint64_t size = file.Size();
+
+    if (size < sizeof(PakHeader)) {
+        LOG_ERROR("VFS", "归档过小: {0}", path.string());
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const PakHeader*>(data);
+    if (header->magic != PakMagic || header->version != PakVersion) {
+        LOG_ERROR("VFS", "不是有效的归档或版本不兼容: {0}", path.string());
+        return false;
+    }
+
+    const uint64_t tableSize = static_cast<uint64_t>(header->entryCount) * sizeof(PakEntry);
+    if (header->fileSize != size || header->entryTableOffset % alignof(uint64_t) != 0 ||
+        header->entryTableOffset > size || tableSize > size - header->entryTableOffset ||
+        header->stringTableOffset > size || header->stringTableSize > size - header->stringTableOffset) {
+        LOG_ERROR("VFS", "归档结构损坏: {0}", path.string());
+        return false;
+    }
+
+    const auto* entries = reinterpret_cast<const PakEntry*>(data + header->entryTableOffset);
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const PakEntry& entry = entries[i];
+        const bool badRange   = entry.offset > size || entry.storedSize > size - entry.offset;
+        const bool badName    = static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header->stringTableSize;
+        const bool badOrder   = i > 0 && entries[i - 1].pathHash > entry.pathHash;
+        const bool badMode    = entry.compression > static_cast<uint8_t>(PakCompression::Zstd) ||
+                             (entry.compression == static_cast<uint8_t>(PakCompression::None) &&
+                              entry.storedSize != entry.size);
+        if (badRange || badName || badOrder || badMode) {
+            LOG_ERROR("VFS", "归档条目 {0} 损坏: {1}", i, path.string());
+            return false;
+        }
+    }
+
+    if (verify && Hash64::Hash(data + header->stringTableOffset, header->stringTableSize,
+                               Hash64::Hash(entries, tableSize)) != header->contentHash) {
+        LOG_ERROR("VFS", "归档哈希校验失败: {0}", path.string());
+        return false;
+    }
+
+    this->header  = header;
+    this->entries = entries;
+    this->strings = reinterpret_cast<const char*>(data + header->stringTableOffset);
+    return true;
+}
+
+namespace {
+
+bool DecompressEntry(const PakEntry& entry, const uint8_t* stored, std::vector<uint8_t>& out) {
+    out.resize(entry.size);
+
+    switch (static_cast<PakCompression>(entry.compression)) {
+    case PakCompression::LZ4:
+        return Lz4::Decompress(stored, entry.storedSize, out.data(), out.size());
+#ifdef PRISMA_USE_ZSTD
+    case PakCompression::Zstd: {
+        size_t written = ZSTD_decompress(out.data(), out.size(), stored, entry.storedSize);
+        return !ZSTD_isError(written) && written == out.size();
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// 挂载管理
+// ============================================================================
+
+bool VirtualFileSystem::Mount(const std::filesystem::path& archivePath, bool verify) {
+    auto archive  = std::make_shared<Archive>();
+    archive->path = std::filesystem::absolute(archivePath);
+
+    if (!archive->file.Open(archive->path, MappedFile::AccessPattern::Random)) {
+        return false;
+    }
+    if (!archive->Validate(verify)) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = std::find_if(m_archives.begin(), m_archives.end(),
+                           [&](const auto& mounted) { return mounted->path == archive->path; });
+    if (it != m_archives.end()) {
+        m_archives.erase(it);
+    }
+    m_archives.push_back(archive);
+
+    LOG_INFO("VFS", "已挂载归档: {0} ({1} 个条目)", archive->path.string(), archive->header->entryCount);
+    return true;
+}
+
+bool VirtualFileSystem::Unmount(const std::filesystem::path& archivePath) {
+    auto absolutePath = std::filesystem::absolute(archivePath);
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = std::find_if(m_archives.begin(), m_archives.end(),
+                           [&](const auto& mounted) { return mounted->path == absolutePath; });
+    if (it == m_archives.end()) {
+        return false;
+    }
+    m_archives.erase(it);
+    return true;
+}
+
+void VirtualFileSystem::UnmountAll() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_archives.clear();
+}
+
+bool VirtualFileSystem::HasMounts() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return !m_archives.empty();
+}
+
+size_t VirtualFileSystem::GetMountCount() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_archives.size();
+}
+
+// ============================================================================
+// 条目访问
+// ============================================================================
+
+bool VirtualFileSystem::Find(std::string_view path, std::shared_ptr<const Archive>& outArchive,
+                             uint32_t& outIndex) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (m_archives.empty()) {
+        return false;
+    }
+
+    const std::string normalized = NormalizePakPath(path);
+    const uint64_t hash          = HashPakPath(normalized);
+
+    for (auto it = m_archives.rbegin(); it != m_archives.rend(); ++it) {
+        if ((*it)->Find(hash, normalized, outIndex)) {
+            outArchive = *it;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool VirtualFileSystem::Exists(std::string_view path) const {
+    std::shared_ptr<const Archive> archive;
+    uint32_t index = 0;
+    return Find(path, archive, index);
+}
+
+bool VirtualFileSystem::GetFileSize(std::string_view path, uint64_t& outSize) const {
+    std::shared_ptr<const Archive> archive;
+    uint32_t index = 0;
+    if (!Find(path, archive, index)) {
+        return false;
+    }
+    outSize = archive->entries[index].size;
+    return true;
+}
+
+VfsFile VirtualFileSystem::Open(std::string_view path) const {
+    VfsFile result;
+
+    std::shared_ptr<const Archive> archive;
+    uint32_t index = 0;
+    if (!Find(path, archive, index)) {
+        return result;
+    }
+
+    const PakEntry& entry = archive->entries[index];
+    const uint8_t* stored = archive->file.Data() + entry.offset;
+
+    if (entry.compression == static_cast<uint8_t>(PakCompression::None)) {
+        result.m_data = stored;
+        result.m_size = static_cast<size_t>(entry.size);
+    } else {
+        if (!DecompressEntry(entry, stored, result.m_buffer)) {
+            LOG_ERROR("VFS", "条目解压失败: {0} ({1})", std::string(path), archive->path.string());
+            return VfsFile();
+        }
+        result.m_data = result.m_buffer.data();
+        result.m_size = result.m_buffer.size();
+    }
+
+    result.m_owner       = archive;
+    result.m_contentHash = entry.contentHash;
+    result.m_valid       = true;
+    return result;
+}
+
+bool VirtualFileSystem::Verify(std::string_view path) const {
+    VfsFile file = Open(path);
+    return file && Hash64::Hash(file.Data(), file.Size()) == file.GetContentHash();
+}
+
+} // namespace Core
+} // namespace PrismaEngine
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Export.h"
+#include "Singleton.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Core {
+
+/**
+ * @brief 从虚拟文件系统打开的文件
+ * 未压缩条目直接指向归档的内存映射区 (零拷贝)，压缩条目持有解压后的缓冲区。
+ * 对象存活期间归档保持映射，即使已被卸载。
+ */
+class ENGINE_API VfsFile {
+public:
+    VfsFile() = default;
+
+    // 压缩条目的 m_data 指向自身缓冲区, 只允许移动并在移动时重新绑定
+    VfsFile(VfsFile&& other) noexcept;
+    VfsFile& operator=(VfsFile&& other) noexcept;
+    VfsFile(const VfsFile&)            = delete;
+    VfsFile& operator=(const VfsFile&) = delete;
+
+    bool IsValid() const { return m_valid; }
+    explicit operator bool() const { return m_valid; }
+
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    std::span<const uint8_t> Bytes() const { return {m_data, m_size}; }
+    std::string_view Text() const { return {reinterpret_cast<const char*>(m_data), m_size}; }
+
+    // 是否直接引用归档映射区
+    bool IsZeroCopy() const { return m_valid && m_buffer.empty() && m_size > 0; }
+
+    // 条目内容哈希 (Hash64)
+    uint64_t GetContentHash() const { return m_contentHash; }
+
+private:
+    friend class VirtualFileSystem;
+
+    std::shared_ptr<const void> m_owner;
+    std::vector<uint8_t> m_buffer;
+    const uint8_t* m_data  = nullptr;
+    size_t m_size          = 0;
+    uint64_t m_contentHash = 0;
+    bool m_valid           = false;
+};
+
+/**
+ * @brief 虚拟文件系统 - 挂载 PAK 归档并按归档内路径查找
+ * 后挂载的归档优先 (可用于补丁包)。查找为条目表上的二分查找，不访问文件系统。
+ */
+class ENGINE_API VirtualFileSystem : public Singleton<VirtualFileSystem> {
+    friend class Singleton<VirtualFileSystem>;
+
+public:
+    /**
+     * @brief 挂载归档
+     * @param verify 为 true 时校验条目表和字符串表哈希
+     */
+    bool Mount(const std::filesystem::path& archivePath, bool verify = false);
+
+    /**
+     * @brief 卸载归档，已打开的 VfsFile 仍然有效
+     */
+    bool Unmount(const std::filesystem::path& archivePath);
+    void UnmountAll();
+
+    bool HasMounts() const;
+    size_t GetMountCount() const;
+
+    /**
+     * @brief 查询条目是否存在
+     */
+    bool Exists(std::string_view path) const;
+
+    /**
+     * @brief 获取条目原始大小，不存在时返回 false
+     */
+    bool GetFileSize(std::string_view path, uint64_t& outSize) const;
+
+    /**
+     * @brief 打开条目，不存在或解压失败时返回无效文件
+     */
+    VfsFile Open(std::string_view path) const;
+
+    /**
+     * @brief 校验条目内容哈希 (会解压压缩条目)
+     */
+    bool Verify(std::string_view path) const;
+
+private:
+    VirtualFileSystem() = default;
+    ~VirtualFileSystem() override = default;
+
+    struct Archive;
+
+    // 查找条目所在的归档和条目下标
+    bool Find(std::string_view path, std::shared_ptr<const Archive>& outArchive, uint32_t& outIndex) const;
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<std::shared_ptr<const Archive>> m_archives;  // 按挂载顺序
+};
+
+} // namespace Core
+} // namespace PrismaEngine
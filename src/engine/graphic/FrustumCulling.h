@@ -290,13 +290,24 @@ namespace PrismaEngine {
             template<typename AABBGetter>
             std::vector<size_t> cull(const AABBGetter& getter, size_t count) const {
                 std::vector<size_t> visible;
+                cull(getter, count, visible);
+                return visible;
+            }
+
+            /**
+             * @brief 剔除不可见的 AABB, 结果写入调用方提供的容器
+             *
+             * 容器先被清空; 每帧复用同一容器或传入帧 arena 上的 std::pmr::vector 可避免堆分配。
+             */
+            template<typename AABBGetter, typename Container>
+            void cull(const AABBGetter& getter, size_t count, Container& visible) const {
+                visible.clear();
                 for (size_t i = 0; i < count; ++i) {
                     auto [minAABB, maxAABB] = getter(i);
                     if (m_frustum.isVisible(minAABB, maxAABB)) {
                         visible.push_back(i);
                     }
                 }
-                return visible;
             }
 
             /**
@@ -306,13 +317,7 @@ namespace PrismaEngine {
             std::vector<size_t> cullWithStats(const AABBGetter& getter, size_t count, CullingStats& stats) const {
                 stats.totalObjects = count;
                 std::vector<size_t> visible;
-
-                for (size_t i = 0; i < count; ++i) {
-                    auto [minAABB, maxAABB] = getter(i);
-                    if (m_frustum.isVisible(minAABB, maxAABB)) {
-                        visible.push_back(i);
-                    }
-                }
+                cull(getter, count, visible);
 
                 stats.visibleObjects = visible.size();
                 stats.culledObjects = count - visible.size();
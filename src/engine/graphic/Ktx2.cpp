@@ -0,0 +1,353 @@
+#include "Ktx2.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        // ============================================================================
+        // 内部辅助
+        // ============================================================================
+
+        namespace {
+            constexpr uint8_t Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+            constexpr size_t HeaderSize     = 80;
+            constexpr size_t LevelIndexSize = 24;
+
+            // 数据格式描述符 (Khronos Data Format) 中使用的常量
+            enum : uint32_t {
+                ColorModelRGBSDA = 1,
+                ColorModelBC1A   = 128,
+                ColorModelBC2    = 129,
+                ColorModelBC3    = 130,
+                ColorModelBC4    = 131,
+                ColorModelBC5    = 132,
+                ColorModelBC7    = 134,
+                ColorModelETC2   = 161,
+                ColorModelASTC   = 162,
+
+                PrimariesBT709   = 1,
+                TransferLinear   = 1,
+                TransferSRGB     = 2,
+
+                ChannelRed       = 0,
+                ChannelGreen     = 1,
+                ChannelBlue      = 2,
+                ChannelAlpha     = 15,
+
+                QualifierLinear  = 1u << 4,
+                QualifierSigned  = 1u << 6,
+            };
+
+            struct FormatMapping {
+                TextureFormat format;
+                uint32_t vkFormat;
+            };
+
+            constexpr FormatMapping FormatMappings[] = {
+                { TextureFormat::R8_UNorm,         9 },
+                { TextureFormat::RG8_UNorm,        16 },
+                { TextureFormat::RGBA8_UNorm,      37 },
+                { TextureFormat::RGBA8_UNorm_sRGB, 43 },
+                { TextureFormat::BGRA8_UNorm,      44 },
+                { TextureFormat::BGRA8_UNorm_sRGB, 50 },
+                { TextureFormat::RGBA16_Float,     97 },
+                { TextureFormat::RGBA32_Float,     109 },
+                { TextureFormat::BC1_UNorm,        133 },
+                { TextureFormat::BC1_SRGB,         134 },
+                { TextureFormat::BC2_UNorm,        135 },
+                { TextureFormat::BC2_SRGB,         136 },
+                { TextureFormat::BC3_UNorm,        137 },
+                { TextureFormat::BC3_SRGB,         138 },
+                { TextureFormat::BC4_UNorm,        139 },
+                { TextureFormat::BC4_SNorm,        140 },
+                { TextureFormat::BC5_UNorm,        141 },
+                { TextureFormat::BC5_SNorm,        142 },
+                { TextureFormat::BC7_UNorm,        145 },
+                { TextureFormat::BC7_SRGB,         146 },
+                { TextureFormat::ETC2_RGB8_UNorm,  147 },
+                { TextureFormat::ETC2_RGB8_SRGB,   148 },
+                { TextureFormat::ETC2_RGBA8_UNorm, 151 },
+                { TextureFormat::ETC2_RGBA8_SRGB,  152 },
+                { TextureFormat::ASTC_4x4_UNorm,   157 },
+                { TextureFormat::ASTC_4x4_SRGB,    158 },
+            };
+
+            bool IsSrgb(TextureFormat format) {
+                switch (format) {
+                    case TextureFormat::RGBA8_UNorm_sRGB:
+                    case TextureFormat::BGRA8_UNorm_sRGB:
+                    case TextureFormat::BC1_SRGB:
+                    case TextureFormat::BC2_SRGB:
+                    case TextureFormat::BC3_SRGB:
+                    case TextureFormat::BC7_SRGB:
+                    case TextureFormat::ETC2_RGB8_SRGB:
+                    case TextureFormat::ETC2_RGBA8_SRGB:
+                    case TextureFormat::ASTC_4x4_SRGB:
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            struct Sample {
+                uint32_t bitOffset;
+                uint32_t bitLength;
+                uint32_t channel;
+                uint32_t upper;
+            };
+
+            struct Descriptor {
+                uint32_t colorModel = 0;
+                std::vector<Sample> samples;
+            };
+
+            /**
+             * @brief 构造格式的数据格式描述符; 未列出的非压缩格式按 8 位通道依次描述
+             */
+            Descriptor DescribeFormat(TextureFormat format, const TextureFormatBlockInfo& info) {
+                Descriptor desc;
+                switch (format) {
+                    case TextureFormat::BC1_UNorm:
+                    case TextureFormat::BC1_SRGB:
+                        desc.colorModel = ColorModelBC1A;
+                        desc.samples = { { 0, 64, 1, UINT32_MAX } };  // BC1A_ALPHAPRESENT
+                        break;
+                    case TextureFormat::BC2_UNorm:
+                    case TextureFormat::BC2_SRGB:
+                        desc.colorModel = ColorModelBC2;
+                        desc.samples = { { 0, 64, ChannelAlpha, UINT32_MAX }, { 64, 64, ChannelRed, UINT32_MAX } };
+                        break;
+                    case TextureFormat::BC3_UNorm:
+                    case TextureFormat::BC3_SRGB:
+                        desc.colorModel = ColorModelBC3;
+                        desc.samples = { { 0, 64, ChannelAlpha, UINT32_MAX }, { 64, 64, ChannelRed, UINT32_MAX } };
+                        break;
+                    case TextureFormat::BC4_UNorm:
+                    case TextureFormat::BC4_SNorm:
+                        desc.colorModel = ColorModelBC4;
+                        desc.samples = { { 0, 64, ChannelRed, UINT32_MAX } };
+                        break;
+                    case TextureFormat::BC5_UNorm:
+                    case TextureFormat::BC5_SNorm:
+                        desc.colorModel = ColorModelBC5;
+                        desc.samples = { { 0, 64, ChannelRed, UINT32_MAX }, { 64, 64, ChannelGreen, UINT32_MAX } };
+                        break;
+                    case TextureFormat::BC7_UNorm:
+                    case TextureFormat::BC7_SRGB:
+                        desc.colorModel = ColorModelBC7;
+                        desc.samples = { { 0, 128, ChannelRed, UINT32_MAX } };
+                        break;
+                    case TextureFormat::ETC2_RGB8_UNorm:
+                    case TextureFormat::ETC2_RGB8_SRGB:
+                        desc.colorModel = ColorModelETC2;
+                        desc.samples = { { 0, 64, 2, UINT32_MAX } };  // ETC2_COLOR
+                        break;
+                    case TextureFormat::ETC2_RGBA8_UNorm:
+                    case TextureFormat::ETC2_RGBA8_SRGB:
+                        desc.colorModel = ColorModelETC2;
+                        desc.samples = { { 0, 64, ChannelAlpha, UINT32_MAX }, { 64, 64, 2, UINT32_MAX } };
+                        break;
+                    case TextureFormat::ASTC_4x4_UNorm:
+                    case TextureFormat::ASTC_4x4_SRGB:
+                        desc.colorModel = ColorModelASTC;
+                        desc.samples = { { 0, 128, ChannelRed, UINT32_MAX } };
+                        break;
+                    case TextureFormat::BGRA8_UNorm:
+                    case TextureFormat::BGRA8_UNorm_sRGB:
+                        desc.colorModel = ColorModelRGBSDA;
+                        desc.samples = { { 0, 8, ChannelBlue, 255 }, { 8, 8, ChannelGreen, 255 },
+                                         { 16, 8, ChannelRed, 255 }, { 24, 8, ChannelAlpha, 255 } };
+                        break;
+                    default: {
+                        desc.colorModel = ColorModelRGBSDA;
+                        uint32_t channels = std::min(info.bytesPerBlock, 4u);
+                        uint32_t bits = info.bytesPerBlock * 8 / std::max(channels, 1u);
+                        static constexpr uint32_t Order[] = { ChannelRed, ChannelGreen, ChannelBlue, ChannelAlpha };
+                        for (uint32_t i = 0; i < channels; ++i) {
+                            uint32_t upper = bits >= 32 ? UINT32_MAX : (1u << bits) - 1;
+                            desc.samples.push_back({ i * bits, bits, Order[i], upper });
+                        }
+                        break;
+                    }
+                }
+                return desc;
+            }
+
+            template<typename T>
+            void Append(std::vector<uint8_t>& out, T value) {
+                uint8_t bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                out.insert(out.end(), bytes, bytes + sizeof(T));
+            }
+
+            template<typename T>
+            T Read(const uint8_t* data, size_t offset) {
+                T value;
+                std::memcpy(&value, data + offset, sizeof(T));
+                return value;
+            }
+
+            std::vector<uint8_t> BuildDescriptor(TextureFormat format, const TextureFormatBlockInfo& info) {
+                Descriptor desc = DescribeFormat(format, info);
+                bool srgb = IsSrgb(format);
+                bool isSigned = format == TextureFormat::BC4_SNorm || format == TextureFormat::BC5_SNorm;
+                uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(desc.samples.size());
+
+                std::vector<uint8_t> out;
+                Append<uint32_t>(out, 4 + blockSize);                  // dfdTotalSize
+                Append<uint32_t>(out, 0);                              // vendorId = Khronos, descriptorType = basic
+                Append<uint32_t>(out, 2u | (blockSize << 16));         // versionNumber = 2
+                Append<uint32_t>(out, desc.colorModel | (PrimariesBT709 << 8) |
+                                      ((srgb ? TransferSRGB : TransferLinear) << 16));
+                Append<uint32_t>(out, (info.blockWidth - 1) | ((info.blockHeight - 1) << 8));
+                Append<uint32_t>(out, info.bytesPerBlock);             // bytesPlane0
+                Append<uint32_t>(out, 0);
+
+                for (const Sample& sample : desc.samples) {
+                    uint32_t qualifiers = 0;
+                    if (srgb && sample.channel == ChannelAlpha) qualifiers |= QualifierLinear;
+                    if (isSigned) qualifiers |= QualifierSigned;
+                    Append<uint32_t>(out, sample.bitOffset | ((sample.bitLength - 1) << 16) |
+                                          ((sample.channel | qualifiers) << 24));
+                    Append<uint32_t>(out, 0);                          // samplePosition
+                    Append<uint32_t>(out, 0);                          // sampleLower
+                    Append<uint32_t>(out, sample.upper);
+                }
+                return out;
+            }
+
+            bool Fail(std::string* error, const char* message) {
+                if (error) *error = message;
+                return false;
+            }
+        } // namespace
+
+        // ============================================================================
+        // Ktx2 实现
+        // ============================================================================
+
+        bool Ktx2::IsKtx2(const uint8_t* data, size_t size) {
+            return data && size >= sizeof(Identifier) && std::memcmp(data, Identifier, sizeof(Identifier)) == 0;
+        }
+
+        bool Ktx2::Parse(const uint8_t* data, size_t size, Image& image, std::string* error) {
+            if (!IsKtx2(data, size) || size < HeaderSize) return Fail(error, "不是 KTX2 文件");
+
+            uint32_t vkFormat    = Read<uint32_t>(data, 12);
+            uint32_t width       = Read<uint32_t>(data, 20);
+            uint32_t height      = Read<uint32_t>(data, 24);
+            uint32_t depth       = Read<uint32_t>(data, 28);
+            uint32_t layerCount  = Read<uint32_t>(data, 32);
+            uint32_t faceCount   = Read<uint32_t>(data, 36);
+            uint32_t levelCount  = std::max(Read<uint32_t>(data, 40), 1u);
+            uint32_t supercompression = Read<uint32_t>(data, 44);
+
+            if (depth > 1 || layerCount > 1 || faceCount != 1) return Fail(error, "只支持 2D 纹理");
+            if (supercompression != 0) return Fail(error, "不支持超压缩");
+            if (width == 0 || height == 0 || levelCount > 32) return Fail(error, "纹理尺寸无效");
+
+            TextureFormat format = FromVkFormat(vkFormat);
+            if (format == TextureFormat::Unknown) return Fail(error, "不支持的纹理格式");
+
+            if (HeaderSize + static_cast<size_t>(levelCount) * LevelIndexSize > size) return Fail(error, "级别索引越界");
+
+            image.format = format;
+            image.width  = width;
+            image.height = height;
+            image.levels.clear();
+            image.levels.reserve(levelCount);
+
+            for (uint32_t mip = 0; mip < levelCount; ++mip) {
+                size_t entry    = HeaderSize + static_cast<size_t>(mip) * LevelIndexSize;
+                uint64_t offset = Read<uint64_t>(data, entry);
+                uint64_t length = Read<uint64_t>(data, entry + 8);
+
+                Level level;
+                level.width  = std::max(1u, width >> mip);
+                level.height = std::max(1u, height >> mip);
+                if (length != ComputeTextureLevelSize(format, level.width, level.height)) {
+                    return Fail(error, "级别大小与格式不符");
+                }
+                if (offset > size || length > size - offset) return Fail(error, "级别数据越界");
+
+                level.data = data + offset;
+                level.size = length;
+                image.levels.push_back(level);
+            }
+            return true;
+        }
+
+        std::vector<uint8_t> Ktx2::Write(TextureFormat format, uint32_t width, uint32_t height,
+                                         const std::vector<std::vector<uint8_t>>& levels) {
+            uint32_t vkFormat = ToVkFormat(format);
+            TextureFormatBlockInfo info = GetTextureFormatBlockInfo(format);
+            if (vkFormat == 0 || levels.empty() || width == 0 || height == 0) return {};
+
+            for (size_t mip = 0; mip < levels.size(); ++mip) {
+                uint32_t w = std::max(1u, width >> mip);
+                uint32_t h = std::max(1u, height >> mip);
+                if (levels[mip].size() != ComputeTextureLevelSize(format, w, h)) return {};
+            }
+
+            auto levelCount = static_cast<uint32_t>(levels.size());
+            std::vector<uint8_t> descriptor = BuildDescriptor(format, info);
+            size_t dfdOffset = HeaderSize + static_cast<size_t>(levelCount) * LevelIndexSize;
+
+            std::vector<uint8_t> out;
+            out.insert(out.end(), Identifier, Identifier + sizeof(Identifier));
+            Append<uint32_t>(out, vkFormat);
+            Append<uint32_t>(out, IsCompressedFormat(format) ? 1u : info.bytesPerBlock);  // typeSize
+            Append<uint32_t>(out, width);
+            Append<uint32_t>(out, height);
+            Append<uint32_t>(out, 0);            // pixelDepth
+            Append<uint32_t>(out, 0);            // layerCount
+            Append<uint32_t>(out, 1);            // faceCount
+            Append<uint32_t>(out, levelCount);
+            Append<uint32_t>(out, 0);            // supercompressionScheme
+            Append<uint32_t>(out, static_cast<uint32_t>(dfdOffset));
+            Append<uint32_t>(out, static_cast<uint32_t>(descriptor.size()));
+            Append<uint32_t>(out, 0);            // kvdByteOffset
+            Append<uint32_t>(out, 0);            // kvdByteLength
+            Append<uint64_t>(out, 0);            // sgdByteOffset
+            Append<uint64_t>(out, 0);            // sgdByteLength
+
+            // 级别索引稍后回填
+            size_t indexOffset = out.size();
+            out.resize(out.size() + static_cast<size_t>(levelCount) * LevelIndexSize);
+            out.insert(out.end(), descriptor.begin(), descriptor.end());
+
+            // 级别数据从最低精度开始存放, 每级按 lcm(块大小, 4) 对齐
+            size_t alignment = std::lcm<size_t>(info.bytesPerBlock, 4);
+            for (size_t i = levels.size(); i-- > 0; ) {
+                out.resize((out.size() + alignment - 1) / alignment * alignment);
+                uint64_t offset = out.size();
+                uint64_t length = levels[i].size();
+                out.insert(out.end(), levels[i].begin(), levels[i].end());
+
+                size_t entry = indexOffset + i * LevelIndexSize;
+                std::memcpy(&out[entry], &offset, sizeof(offset));
+                std::memcpy(&out[entry + 8], &length, sizeof(length));
+                std::memcpy(&out[entry + 16], &length, sizeof(length));  // uncompressedByteLength
+            }
+            return out;
+        }
+
+        uint32_t Ktx2::ToVkFormat(TextureFormat format) {
+            for (const auto& mapping : FormatMappings) {
+                if (mapping.format == format) return mapping.vkFormat;
+            }
+            return 0;
+        }
+
+        TextureFormat Ktx2::FromVkFormat(uint32_t vkFormat) {
+            for (const auto& mapping : FormatMappings) {
+                if (mapping.vkFormat == vkFormat) return mapping.format;
+            }
+            return TextureFormat::Unknown;
+        }
+
+    } // namespace Graphic
+} // namespace PrismaEngine
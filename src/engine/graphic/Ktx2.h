@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Export.h"
+#include "interfaces/RenderTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        /**
+         * @brief KTX2 纹理容器读写
+         *
+         * 只支持无超压缩的单层 2D 纹理, 用于离线烘焙的纹理 (预生成 MIP 的 BCn/ETC2/ASTC 数据),
+         * 运行时解析后各级别数据可以直接上传, 无需解码。
+         */
+        class ENGINE_API Ktx2 {
+        public:
+            /**
+             * @brief 单个 MIP 级别, 数据指向解析时传入的缓冲区
+             */
+            struct Level {
+                const uint8_t* data = nullptr;
+                uint64_t size       = 0;
+                uint32_t width      = 0;
+                uint32_t height     = 0;
+            };
+
+            struct Image {
+                TextureFormat format = TextureFormat::Unknown;
+                uint32_t width  = 0;
+                uint32_t height = 0;
+                std::vector<Level> levels;  // levels[0] 为最高精度
+            };
+
+            static bool IsKtx2(const uint8_t* data, size_t size);
+
+            /**
+             * @brief 解析容器, 不复制数据 (Image 中的指针在 data 释放前有效)
+             */
+            static bool Parse(const uint8_t* data, size_t size, Image& image, std::string* error = nullptr);
+
+            /**
+             * @brief 写入容器
+             * @param levels 各级别数据, levels[0] 为最高精度, 大小必须与格式一致
+             * @return 失败时返回空
+             */
+            static std::vector<uint8_t> Write(TextureFormat format, uint32_t width, uint32_t height,
+                                              const std::vector<std::vector<uint8_t>>& levels);
+
+            // 与 VkFormat 的相互转换, 不支持的格式返回 0 / Unknown
+            static uint32_t ToVkFormat(TextureFormat format);
+            static TextureFormat FromVkFormat(uint32_t vkFormat);
+        };
+
+    } // namespace Graphic
+} // namespace PrismaEngine
@@ -139,3 +139,15 @@ void Material::Unload() {
 bool Material::IsLoaded() const {
     return m_isLoaded;
 }
+
+std::vector<std::filesystem::path> Material::GetFileDependencies() const {
+    std::vector<std::filesystem::path> files;
+    for (const std::string* texture : { &m_properties.albedoTexture, &m_properties.normalTexture,
+                                        &m_properties.metallicTexture, &m_properties.roughnessTexture,
+                                        &m_properties.emissiveTexture }) {
+        if (!texture->empty()) {
+            files.emplace_back(*texture);
+        }
+    }
+    return files;
+}
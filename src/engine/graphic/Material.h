@@ -3,6 +3,7 @@
 #include "../math/MathTypes.h"
 #include <string>
 #include <memory>
+#include <vector>
 
 // 前向声明
 namespace PrismaEngine::Graphic {
@@ -65,6 +66,9 @@ namespace PrismaEngine {
             return AssetType::Material;
         }
 
+        // 引用的纹理文件, 热重载时纹理变化会触发材质重载
+        std::vector<std::filesystem::path> GetFileDependencies() const override;
+
         // 获取材质属性
         const MaterialProperties& GetProperties() const { return m_properties; }
 
@@ -0,0 +1,825 @@
+#include "MeshOptimizer.h"
+#include "core/Hash64.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        namespace {
+
+            constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+            // ====================================================================
+            // 顶点缓存优化 (Forsyth)
+            // ====================================================================
+
+            constexpr uint32_t ForsythCacheSize = 32;
+            constexpr uint32_t ForsythValenceLimit = 32;
+
+            struct ForsythTables {
+                float cache[ForsythCacheSize];
+                float valence[ForsythValenceLimit];
+
+                ForsythTables() {
+                    // 最近使用的三个顶点得分固定, 避免总是选择刚输出的三角形的相邻三角形而形成细长条带
+                    for (uint32_t i = 0; i < ForsythCacheSize; ++i) {
+                        cache[i] = i < 3 ? 0.75f
+                                         : std::pow(1.0f - float(i - 3) / float(ForsythCacheSize - 3), 1.5f);
+                    }
+                    // 剩余三角形越少的顶点越优先, 尽早清理孤立三角形
+                    valence[0] = 0.0f;
+                    for (uint32_t i = 1; i < ForsythValenceLimit; ++i) {
+                        valence[i] = 2.0f / std::sqrt(float(i));
+                    }
+                }
+
+                float Score(int32_t cachePosition, uint32_t liveTriangles) const {
+                    if (liveTriangles == 0) return -1.0f;
+                    float score = cachePosition >= 0 ? cache[cachePosition] : 0.0f;
+                    return score + valence[std::min(liveTriangles, ForsythValenceLimit - 1)];
+                }
+            };
+
+            const ForsythTables& GetForsythTables() {
+                static const ForsythTables tables;
+                return tables;
+            }
+
+            // ====================================================================
+            // 几何辅助
+            // ====================================================================
+
+            struct Float3 {
+                float x, y, z;
+            };
+
+            inline Float3 Sub(const Float3& a, const Float3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+            inline Float3 Cross(const Float3& a, const Float3& b) {
+                return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+            }
+            inline float Dot(const Float3& a, const Float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+            inline float Length(const Float3& a) { return std::sqrt(Dot(a, a)); }
+
+            inline Float3 PositionOf(const Vertex& vertex) {
+                return {vertex.position.x, vertex.position.y, vertex.position.z};
+            }
+
+            // 对称 4x4 二次误差矩阵, Error 按总权重归一化为平均距离的平方
+            struct Quadric {
+                double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+                double a11 = 0, a12 = 0, a13 = 0;
+                double a22 = 0, a23 = 0;
+                double a33 = 0;
+                double weight = 0;
+
+                static Quadric FromPlane(double a, double b, double c, double d, double weight) {
+                    Quadric q;
+                    q.a00 = weight * a * a; q.a01 = weight * a * b; q.a02 = weight * a * c; q.a03 = weight * a * d;
+                    q.a11 = weight * b * b; q.a12 = weight * b * c; q.a13 = weight * b * d;
+                    q.a22 = weight * c * c; q.a23 = weight * c * d;
+                    q.a33 = weight * d * d;
+                    q.weight = weight;
+                    return q;
+                }
+
+                Quadric& operator+=(const Quadric& o) {
+                    a00 += o.a00; a01 += o.a01; a02 += o.a02; a03 += o.a03;
+                    a11 += o.a11; a12 += o.a12; a13 += o.a13;
+                    a22 += o.a22; a23 += o.a23;
+                    a33 += o.a33;
+                    weight += o.weight;
+                    return *this;
+                }
+
+                double Error(const Float3& p) const {
+                    const double x = p.x, y = p.y, z = p.z;
+                    double error = a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x
+                                 + a11 * y * y + 2 * a12 * y * z + 2 * a13 * y
+                                 + a22 * z * z + 2 * a23 * z
+                                 + a33;
+                    return weight > 0 ? std::max(error, 0.0) / weight : 0.0;
+                }
+            };
+
+            inline uint64_t EdgeKey(uint32_t a, uint32_t b) { return (uint64_t(a) << 32) | b; }
+
+            // 按三角形构建 顶点 -> 三角形 的压缩邻接表
+            void BuildAdjacency(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                std::vector<uint32_t>& offsets, std::vector<uint32_t>& triangles) {
+                offsets.assign(vertexCount + 1, 0);
+                for (size_t i = 0; i < indexCount; ++i) {
+                    ++offsets[indices[i] + 1];
+                }
+                for (size_t v = 0; v < vertexCount; ++v) {
+                    offsets[v + 1] += offsets[v];
+                }
+
+                triangles.resize(indexCount);
+                std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indexCount; ++i) {
+                    triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+        } // namespace
+
+        // ========================================================================
+        // 焊接与顶点重排
+        // ========================================================================
+
+        size_t MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+            struct VertexHasher {
+                const std::vector<Vertex>* vertices;
+                size_t operator()(uint32_t index) const {
+                    return static_cast<size_t>(Core::Hash64::Hash(&(*vertices)[index], sizeof(Vertex)));
+                }
+            };
+            struct VertexEqual {
+                const std::vector<Vertex>* vertices;
+                bool operator()(uint32_t a, uint32_t b) const {
+                    return std::memcmp(&(*vertices)[a], &(*vertices)[b], sizeof(Vertex)) == 0;
+                }
+            };
+
+            std::unordered_map<uint32_t, uint32_t, VertexHasher, VertexEqual> unique(
+                vertices.size(), VertexHasher{&vertices}, VertexEqual{&vertices});
+
+            std::vector<uint32_t> remap(vertices.size());
+            std::vector<Vertex> welded;
+            welded.reserve(vertices.size());
+            for (uint32_t i = 0; i < vertices.size(); ++i) {
+                auto [it, inserted] = unique.try_emplace(i, static_cast<uint32_t>(welded.size()));
+                if (inserted) {
+                    welded.push_back(vertices[i]);
+                }
+                remap[i] = it->second;
+            }
+
+            for (uint32_t& index : indices) {
+                index = remap[index];
+            }
+            vertices = std::move(welded);
+            return vertices.size();
+        }
+
+        void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+            std::vector<uint32_t> remap(vertices.size(), InvalidIndex);
+            std::vector<Vertex> ordered;
+            ordered.reserve(vertices.size());
+
+            for (uint32_t& index : indices) {
+                if (remap[index] == InvalidIndex) {
+                    remap[index] = static_cast<uint32_t>(ordered.size());
+                    ordered.push_back(vertices[index]);
+                }
+                index = remap[index];
+            }
+            vertices = std::move(ordered);
+        }
+
+        // ========================================================================
+        // 顶点缓存
+        // ========================================================================
+
+        float MeshOptimizer::ComputeACMR(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                         uint32_t cacheSize) {
+            if (indexCount < 3) return 0.0f;
+
+            // 记录每个顶点进入 FIFO 的时间戳, 距今不超过 cacheSize 即命中
+            std::vector<uint32_t> timestamps(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+            size_t misses = 0;
+            for (size_t i = 0; i < indexCount; ++i) {
+                uint32_t index = indices[i];
+                if (time - timestamps[index] > cacheSize) {
+                    timestamps[index] = time++;
+                    ++misses;
+                }
+            }
+            return float(misses) / float(indexCount / 3);
+        }
+
+        void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) {
+            const size_t triangleCount = indexCount / 3;
+            if (triangleCount == 0) return;
+
+            const ForsythTables& tables = GetForsythTables();
+            const std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+
+            std::vector<uint32_t> offsets, adjacency;
+            BuildAdjacency(source.data(), source.size(), vertexCount, offsets, adjacency);
+
+            std::vector<uint32_t> liveTriangles(vertexCount);
+            std::vector<int32_t> cachePosition(vertexCount, -1);
+            std::vector<float> vertexScore(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                liveTriangles[v] = offsets[v + 1] - offsets[v];
+                vertexScore[v]   = tables.Score(-1, liveTriangles[v]);
+            }
+
+            std::vector<float> triangleScore(triangleCount);
+            std::vector<bool> emitted(triangleCount, false);
+            for (size_t t = 0; t < triangleCount; ++t) {
+                triangleScore[t] = vertexScore[source[t * 3]] + vertexScore[source[t * 3 + 1]] + vertexScore[source[t * 3 + 2]];
+            }
+
+            std::vector<uint32_t> cache, nextCache;
+            cache.reserve(ForsythCacheSize + 3);
+            nextCache.reserve(ForsythCacheSize + 3);
+
+            uint32_t best = static_cast<uint32_t>(std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+            size_t cursor = 0;
+            size_t written = 0;
+
+            while (written < triangleCount) {
+                if (best == InvalidIndex) {
+                    // 缓存中没有剩余三角形的顶点, 按输入顺序取下一个未输出的三角形
+                    while (emitted[cursor]) ++cursor;
+                    best = static_cast<uint32_t>(cursor);
+                }
+
+                const uint32_t* triangle = &source[best * 3];
+                std::memcpy(indices + written * 3, triangle, sizeof(uint32_t) * 3);
+                ++written;
+                emitted[best] = true;
+
+                // 从三个顶点的存活列表中移除该三角形
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t v = triangle[k];
+                    uint32_t* begin = &adjacency[offsets[v]];
+                    uint32_t* end = begin + liveTriangles[v];
+                    uint32_t* it = std::find(begin, end, best);
+                    std::swap(*it, *(end - 1));
+                    --liveTriangles[v];
+                }
+
+                // 新缓存: 三角形顶点在前, 其余按原顺序
+                nextCache.assign(triangle, triangle + 3);
+                for (uint32_t v : cache) {
+                    if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                        nextCache.push_back(v);
+                    }
+                }
+                for (size_t i = ForsythCacheSize; i < nextCache.size(); ++i) {
+                    cachePosition[nextCache[i]] = -1;
+                    vertexScore[nextCache[i]] = tables.Score(-1, liveTriangles[nextCache[i]]);
+                }
+                if (nextCache.size() > ForsythCacheSize) nextCache.resize(ForsythCacheSize);
+                cache.swap(nextCache);
+
+                for (size_t i = 0; i < cache.size(); ++i) {
+                    cachePosition[cache[i]] = static_cast<int32_t>(i);
+                    vertexScore[cache[i]] = tables.Score(static_cast<int32_t>(i), liveTriangles[cache[i]]);
+                }
+
+                // 只有缓存中顶点的三角形得分会变化, 下一个三角形也从中选择
+                best = InvalidIndex;
+                float bestScore = -FLT_MAX;
+                for (uint32_t v : cache) {
+                    for (uint32_t i = offsets[v]; i < offsets[v] + liveTriangles[v]; ++i) {
+                        uint32_t t = adjacency[i];
+                        float score = vertexScore[source[t * 3]] + vertexScore[source[t * 3 + 1]] + vertexScore[source[t * 3 + 2]];
+                        triangleScore[t] = score;
+                        if (score > bestScore) {
+                            bestScore = score;
+                            best = t;
+                        }
+                    }
+                }
+            }
+        }
+
+        // ========================================================================
+        // 过度绘制
+        // ========================================================================
+
+        void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, size_t indexCount, const std::vector<Vertex>& vertices,
+                                             float threshold) {
+            constexpr uint32_t CacheSize = 16;
+            constexpr size_t MinSoftCluster = 8;  // 过小的簇排序收益有限, 缓存损失却更大
+
+            const size_t triangleCount = indexCount / 3;
+            if (triangleCount < MinSoftCluster * 2) return;
+
+            std::vector<uint32_t> timestamps(vertices.size(), 0);
+            uint32_t time = CacheSize + 1;
+            auto countMisses = [&](size_t t) {
+                uint32_t misses = 0;
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t index = indices[t * 3 + k];
+                    if (time - timestamps[index] > CacheSize) {
+                        timestamps[index] = time++;
+                        ++misses;
+                    }
+                }
+                return misses;
+            };
+            auto resetCache = [&]() { time += CacheSize + 1; };
+
+            // 1. 硬边界: 三个顶点都不在缓存中的三角形, 在此切分不损失命中率
+            std::vector<size_t> hardStarts;
+            for (size_t t = 0; t < triangleCount; ++t) {
+                if (countMisses(t) == 3) hardStarts.push_back(t);
+            }
+            hardStarts.push_back(triangleCount);
+
+            // 2. 软边界: 簇内 (缓存在簇起点清空) 的 ACMR 不超过硬簇 ACMR * threshold 时继续切分
+            std::vector<size_t> clusters;
+            for (size_t h = 0; h + 1 < hardStarts.size(); ++h) {
+                const size_t begin = hardStarts[h];
+                const size_t end = hardStarts[h + 1];
+
+                resetCache();
+                uint32_t hardMisses = 0;
+                for (size_t t = begin; t < end; ++t) hardMisses += countMisses(t);
+                const float target = float(hardMisses) / float(end - begin) * threshold;
+
+                resetCache();
+                size_t softStart = begin;
+                uint32_t softMisses = 0;
+                clusters.push_back(begin);
+                for (size_t t = begin; t < end; ++t) {
+                    softMisses += countMisses(t);
+                    const size_t softCount = t + 1 - softStart;
+                    if (softCount >= MinSoftCluster && end - (t + 1) >= MinSoftCluster &&
+                        float(softMisses) / float(softCount) <= target) {
+                        softStart = t + 1;
+                        softMisses = 0;
+                        clusters.push_back(softStart);
+                        resetCache();
+                    }
+                }
+            }
+            clusters.push_back(triangleCount);
+
+            // 3. 按簇朝外程度排序: dot(簇中心 - 网格中心, 簇法线) 越大越先绘制, 先画的外侧面遮挡后画的内侧面
+            const size_t clusterCount = clusters.size() - 1;
+            std::vector<Float3> centroids(clusterCount, Float3{0, 0, 0});
+            std::vector<Float3> normals(clusterCount, Float3{0, 0, 0});
+            std::vector<float> areas(clusterCount, 0.0f);
+            Float3 meshCentroid{0, 0, 0};
+            float meshArea = 0.0f;
+
+            for (size_t c = 0; c < clusterCount; ++c) {
+                for (size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+                    Float3 p0 = PositionOf(vertices[indices[t * 3]]);
+                    Float3 p1 = PositionOf(vertices[indices[t * 3 + 1]]);
+                    Float3 p2 = PositionOf(vertices[indices[t * 3 + 2]]);
+                    Float3 n = Cross(Sub(p1, p0), Sub(p2, p0));
+                    float area = Length(n) * 0.5f;
+
+                    Float3 center{(p0.x + p1.x + p2.x) / 3, (p0.y + p1.y + p2.y) / 3, (p0.z + p1.z + p2.z) / 3};
+                    centroids[c] = {centroids[c].x + center.x * area, centroids[c].y + center.y * area, centroids[c].z + center.z * area};
+                    normals[c]   = {normals[c].x + n.x, normals[c].y + n.y, normals[c].z + n.z};
+                    areas[c] += area;
+                }
+                meshCentroid = {meshCentroid.x + centroids[c].x, meshCentroid.y + centroids[c].y, meshCentroid.z + centroids[c].z};
+                meshArea += areas[c];
+            }
+            if (meshArea <= 0.0f) return;
+            meshCentroid = {meshCentroid.x / meshArea, meshCentroid.y / meshArea, meshCentroid.z / meshArea};
+
+            std::vector<float> sortKey(clusterCount, 0.0f);
+            for (size_t c = 0; c < clusterCount; ++c) {
+                if (areas[c] <= 0.0f) continue;
+                Float3 center{centroids[c].x / areas[c], centroids[c].y / areas[c], centroids[c].z / areas[c]};
+                float length = Length(normals[c]);
+                if (length <= 0.0f) continue;
+                Float3 normal{normals[c].x / length, normals[c].y / length, normals[c].z / length};
+                sortKey[c] = Dot(Sub(center, meshCentroid), normal);
+            }
+
+            std::vector<uint32_t> order(clusterCount);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+            const std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+            size_t written = 0;
+            for (uint32_t c : order) {
+                const size_t count = (clusters[c + 1] - clusters[c]) * 3;
+                std::memcpy(indices + written, &source[clusters[c] * 3], count * sizeof(uint32_t));
+                written += count;
+            }
+        }
+
+        // ========================================================================
+        // 简化
+        // ========================================================================
+
+        std::vector<uint32_t> MeshOptimizer::Simplify(const uint32_t* indices, size_t indexCount,
+                                                      const std::vector<Vertex>& vertices, size_t targetIndexCount,
+                                                      float targetError, float* resultError) {
+            std::vector<uint32_t> result(indices, indices + indexCount / 3 * 3);
+            if (resultError) *resultError = 0.0f;
+
+            const size_t vertexCount = vertices.size();
+            if (result.size() <= targetIndexCount || vertexCount == 0) return result;
+
+            // 位置归一化到单位尺寸, 误差因此与网格大小无关
+            Float3 minBounds{FLT_MAX, FLT_MAX, FLT_MAX};
+            Float3 maxBounds{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+            for (const Vertex& vertex : vertices) {
+                Float3 p = PositionOf(vertex);
+                minBounds = {std::min(minBounds.x, p.x), std::min(minBounds.y, p.y), std::min(minBounds.z, p.z)};
+                maxBounds = {std::max(maxBounds.x, p.x), std::max(maxBounds.y, p.y), std::max(maxBounds.z, p.z)};
+            }
+            const float extent = std::max({maxBounds.x - minBounds.x, maxBounds.y - minBounds.y, maxBounds.z - minBounds.z});
+            const float scale = extent > 0.0f ? 1.0f / extent : 0.0f;
+
+            std::vector<Float3> positions(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                Float3 p = PositionOf(vertices[v]);
+                positions[v] = {(p.x - minBounds.x) * scale, (p.y - minBounds.y) * scale, (p.z - minBounds.z) * scale};
+            }
+
+            // 位置相同的顶点 (属性接缝) 共享一个代表顶点, 拓扑和误差都在代表顶点上计算
+            struct PositionHasher {
+                const std::vector<Float3>* positions;
+                size_t operator()(uint32_t v) const {
+                    return static_cast<size_t>(Core::Hash64::Hash(&(*positions)[v], sizeof(Float3)));
+                }
+            };
+            struct PositionEqual {
+                const std::vector<Float3>* positions;
+                bool operator()(uint32_t a, uint32_t b) const {
+                    return std::memcmp(&(*positions)[a], &(*positions)[b], sizeof(Float3)) == 0;
+                }
+            };
+            std::unordered_map<uint32_t, uint32_t, PositionHasher, PositionEqual> positionLookup(
+                vertexCount, PositionHasher{&positions}, PositionEqual{&positions});
+
+            std::vector<uint32_t> rep(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v) {
+                rep[v] = positionLookup.try_emplace(v, v).first->second;
+            }
+
+            // 锁定接缝顶点 (同一位置被多个顶点使用) 和开放边界顶点
+            std::vector<uint32_t> firstUser(vertexCount, InvalidIndex);
+            std::vector<bool> locked(vertexCount, false);
+            for (uint32_t index : result) {
+                uint32_t r = rep[index];
+                if (firstUser[r] == InvalidIndex) firstUser[r] = index;
+                else if (firstUser[r] != index) locked[r] = true;
+            }
+
+            std::unordered_set<uint64_t> edges;
+            edges.reserve(result.size());
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    edges.insert(EdgeKey(rep[result[i + k]], rep[result[i + (k + 1) % 3]]));
+                }
+            }
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t a = rep[result[i + k]];
+                    uint32_t b = rep[result[i + (k + 1) % 3]];
+                    if (!edges.count(EdgeKey(b, a))) {
+                        locked[a] = true;
+                        locked[b] = true;
+                    }
+                }
+            }
+
+            // 按面积加权的平面二次误差
+            std::vector<Quadric> quadrics(vertexCount);
+            for (size_t i = 0; i < result.size(); i += 3) {
+                const Float3& p0 = positions[rep[result[i]]];
+                const Float3& p1 = positions[rep[result[i + 1]]];
+                const Float3& p2 = positions[rep[result[i + 2]]];
+                Float3 n = Cross(Sub(p1, p0), Sub(p2, p0));
+                float length = Length(n);
+                if (length <= 0.0f) continue;
+
+                double a = n.x / length, b = n.y / length, c = n.z / length;
+                double d = -(a * p0.x + b * p0.y + c * p0.z);
+                Quadric q = Quadric::FromPlane(a, b, c, d, length * 0.5);
+                for (int k = 0; k < 3; ++k) {
+                    quadrics[rep[result[i + k]]] += q;
+                }
+            }
+
+            struct Collapse {
+                uint32_t from;  // 被移除的顶点
+                uint32_t to;    // 保留的顶点
+                float cost;
+            };
+
+            const double errorLimit = double(targetError) * double(targetError);
+            double maxError = 0.0;
+
+            std::vector<uint32_t> repIndices(result.size());
+            std::vector<uint32_t> offsets, adjacency;
+            std::vector<Collapse> candidates;
+            std::vector<bool> touched(vertexCount);
+            std::vector<uint32_t> collapseTo(vertexCount);
+
+            while (result.size() > targetIndexCount) {
+                for (size_t i = 0; i < result.size(); ++i) repIndices[i] = rep[result[i]];
+                repIndices.resize(result.size());
+                BuildAdjacency(repIndices.data(), repIndices.size(), vertexCount, offsets, adjacency);
+
+                candidates.clear();
+                for (size_t i = 0; i < result.size(); i += 3) {
+                    for (int k = 0; k < 3; ++k) {
+                        uint32_t a = result[i + k];
+                        uint32_t b = result[i + (k + 1) % 3];
+                        uint32_t ra = rep[a], rb = rep[b];
+                        // 每条边两个方向都尝试, 顶点只能折叠到相邻顶点上
+                        if (!locked[ra]) {
+                            Quadric q = quadrics[ra];
+                            q += quadrics[rb];
+                            candidates.push_back({a, b, float(q.Error(positions[rb]))});
+                        }
+                        if (!locked[rb]) {
+                            Quadric q = quadrics[rb];
+                            q += quadrics[ra];
+                            candidates.push_back({b, a, float(q.Error(positions[ra]))});
+                        }
+                    }
+                }
+                std::sort(candidates.begin(), candidates.end(),
+                          [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+                std::fill(touched.begin(), touched.end(), false);
+                std::iota(collapseTo.begin(), collapseTo.end(), 0u);
+
+                // 每次折叠约移除两个三角形; 同一轮中一环邻域有重叠的折叠推迟到下一轮
+                const size_t trianglesToRemove = (result.size() - targetIndexCount) / 3;
+                size_t removed = 0;
+                size_t collapsed = 0;
+
+                for (const Collapse& collapse : candidates) {
+                    if (collapse.cost > errorLimit) break;
+
+                    const uint32_t ra = rep[collapse.from];
+                    const uint32_t rb = rep[collapse.to];
+                    if (touched[ra] || touched[rb]) continue;
+
+                    // 检查 ra 的一环: 共享边的三角形必须使用同一个目标顶点 (否则会跨越接缝), 其余三角形不能翻转
+                    bool valid = true;
+                    size_t degenerate = 0;
+                    for (uint32_t i = offsets[ra]; i < offsets[ra + 1] && valid; ++i) {
+                        const uint32_t t = adjacency[i];
+                        const uint32_t* tri = &result[t * 3];
+                        const uint32_t* repTri = &repIndices[t * 3];
+
+                        int corner = repTri[0] == ra ? 0 : (repTri[1] == ra ? 1 : 2);
+                        int other1 = (corner + 1) % 3, other2 = (corner + 2) % 3;
+                        if (repTri[other1] == rb || repTri[other2] == rb) {
+                            uint32_t target = repTri[other1] == rb ? tri[other1] : tri[other2];
+                            valid = target == collapse.to;
+                            ++degenerate;
+                            continue;
+                        }
+
+                        const Float3& p1 = positions[repTri[other1]];
+                        const Float3& p2 = positions[repTri[other2]];
+                        Float3 before = Cross(Sub(p1, positions[ra]), Sub(p2, positions[ra]));
+                        Float3 after = Cross(Sub(p1, positions[rb]), Sub(p2, positions[rb]));
+                        float lengthProduct = Length(before) * Length(after);
+                        // 拒绝翻转和面积退化为 0 的三角形, 以及法线旋转超过约 75 度的情况
+                        valid = lengthProduct > 0.0f && Dot(before, after) >= 0.25f * lengthProduct;
+                    }
+                    if (!valid || degenerate == 0) continue;
+
+                    collapseTo[collapse.from] = collapse.to;
+                    quadrics[rb] += quadrics[ra];
+                    maxError = std::max(maxError, double(collapse.cost));
+
+                    for (uint32_t i = offsets[ra]; i < offsets[ra + 1]; ++i) {
+                        const uint32_t* repTri = &repIndices[adjacency[i] * 3];
+                        touched[repTri[0]] = touched[repTri[1]] = touched[repTri[2]] = true;
+                    }
+                    ++collapsed;
+                    removed += degenerate;
+                    if (removed >= trianglesToRemove) break;
+                }
+
+                if (collapsed == 0) break;
+
+                size_t write = 0;
+                for (size_t i = 0; i < result.size(); i += 3) {
+                    uint32_t a = collapseTo[result[i]];
+                    uint32_t b = collapseTo[result[i + 1]];
+                    uint32_t c = collapseTo[result[i + 2]];
+                    if (rep[a] == rep[b] || rep[b] == rep[c] || rep[a] == rep[c]) continue;
+                    result[write++] = a;
+                    result[write++] = b;
+                    result[write++] = c;
+                }
+                result.resize(write);
+            }
+
+            if (resultError) *resultError = static_cast<float>(std::sqrt(maxError));
+            return result;
+        }
+
+        // ========================================================================
+        // 量化
+        // ========================================================================
+
+        void MeshOptimizer::EncodeOctahedral(float x, float y, float z, int16_t out[2]) {
+            float l1 = std::fabs(x) + std::fabs(y) + std::fabs(z);
+            if (l1 <= 0.0f) {
+                out[0] = out[1] = 0;
+                return;
+            }
+            x /= l1;
+            y /= l1;
+            if (z < 0.0f) {
+                float ox = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                float oy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+                x = ox;
+                y = oy;
+            }
+            out[0] = static_cast<int16_t>(std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+            out[1] = static_cast<int16_t>(std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f));
+        }
+
+        void MeshOptimizer::DecodeOctahedral(const int16_t in[2], float out[3]) {
+            float x = std::max(in[0] / 32767.0f, -1.0f);
+            float y = std::max(in[1] / 32767.0f, -1.0f);
+            float z = 1.0f - std::fabs(x) - std::fabs(y);
+            float t = std::max(-z, 0.0f);
+            x += x >= 0.0f ? -t : t;
+            y += y >= 0.0f ? -t : t;
+
+            float length = std::sqrt(x * x + y * y + z * z);
+            out[0] = x / length;
+            out[1] = y / length;
+            out[2] = z / length;
+        }
+
+        uint16_t MeshOptimizer::FloatToHalf(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+            const uint32_t exponent = (bits >> 23) & 0xFFu;
+            uint32_t mantissa = bits & 0x7FFFFFu;
+
+            if (exponent == 0xFF) {
+                return sign | 0x7C00u | (mantissa ? 0x200u : 0u);  // Inf / NaN
+            }
+
+            const int32_t halfExponent = int32_t(exponent) - 127 + 15;
+            if (halfExponent >= 31) {
+                return sign | 0x7C00u;  // 溢出为无穷大
+            }
+            if (halfExponent <= 0) {
+                if (halfExponent < -10) return sign;  // 下溢为 0
+                // 非规格化数
+                mantissa |= 0x800000u;
+                const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+                uint32_t half = mantissa >> shift;
+                if ((mantissa >> (shift - 1)) & 1u) ++half;
+                return sign | static_cast<uint16_t>(half);
+            }
+
+            // 就近舍入, 进位可以正确地进入指数位
+            uint32_t half = (uint32_t(halfExponent) << 10) | (mantissa >> 13);
+            if (mantissa & 0x1000u) ++half;
+            return sign | static_cast<uint16_t>(half);
+        }
+
+        float MeshOptimizer::HalfToFloat(uint16_t value) {
+            const uint32_t sign = uint32_t(value & 0x8000u) << 16;
+            const uint32_t exponent = (value >> 10) & 0x1Fu;
+            const uint32_t mantissa = value & 0x3FFu;
+
+            uint32_t bits;
+            if (exponent == 0) {
+                float result = std::ldexp(float(mantissa), -24);
+                return sign ? -result : result;
+            } else if (exponent == 31) {
+                bits = sign | 0x7F800000u | (mantissa << 13);
+            } else {
+                bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+            }
+
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        std::vector<QuantizedVertex> MeshOptimizer::Quantize(const std::vector<Vertex>& vertices) {
+            auto snorm8 = [](float v) { return static_cast<int8_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 127.0f)); };
+            auto unorm8 = [](float v) { return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+
+            std::vector<QuantizedVertex> result(vertices.size());
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                const Vertex& source = vertices[i];
+                QuantizedVertex& target = result[i];
+
+                target.position[0] = source.position.x;
+                target.position[1] = source.position.y;
+                target.position[2] = source.position.z;
+                target.uv[0] = FloatToHalf(source.uv.x);
+                target.uv[1] = FloatToHalf(source.uv.y);
+                EncodeOctahedral(source.normal.x, source.normal.y, source.normal.z, target.normal);
+
+                float length = std::sqrt(source.tangent.x * source.tangent.x + source.tangent.y * source.tangent.y +
+                                         source.tangent.z * source.tangent.z);
+                float inv = length > 0.0f ? 1.0f / length : 0.0f;
+                target.tangent[0] = snorm8(source.tangent.x * inv);
+                target.tangent[1] = snorm8(source.tangent.y * inv);
+                target.tangent[2] = snorm8(source.tangent.z * inv);
+                target.tangent[3] = source.tangent.w < 0.0f ? int8_t(-127) : int8_t(127);
+
+                target.color[0] = unorm8(source.color.x);
+                target.color[1] = unorm8(source.color.y);
+                target.color[2] = unorm8(source.color.z);
+                target.color[3] = unorm8(source.color.w);
+            }
+            return result;
+        }
+
+        // ========================================================================
+        // 完整流程
+        // ========================================================================
+
+        void MeshOptimizer::Optimize(SubMesh& subMesh, const MeshOptimizationSettings& settings) {
+            subMesh.lods.clear();
+            subMesh.quantizedVertices.clear();
+            if (subMesh.indices.size() < 3 || subMesh.vertices.empty()) return;
+            subMesh.indices.resize(subMesh.indices.size() / 3 * 3);
+
+            if (settings.weldVertices) {
+                WeldVertices(subMesh.vertices, subMesh.indices);
+            }
+
+            // LOD 链: 每级由上一级继续简化, 误差按上界累加
+            std::vector<std::vector<uint32_t>> levels;
+            std::vector<float> errors;
+            levels.push_back(std::move(subMesh.indices));
+            errors.push_back(0.0f);
+
+            const size_t minIndexCount = size_t(settings.lodMinTriangles) * 3;
+            while (levels.size() < settings.maxLodCount) {
+                const std::vector<uint32_t>& previous = levels.back();
+                if (previous.size() <= minIndexCount) break;
+
+                size_t target = std::max(size_t(float(previous.size()) * settings.lodReduction) / 3 * 3, minIndexCount);
+                float remainingError = settings.lodMaxError - errors.back();
+                if (remainingError <= 0.0f) break;
+
+                float error = 0.0f;
+                std::vector<uint32_t> lod = Simplify(previous.data(), previous.size(), subMesh.vertices, target,
+                                                     remainingError, &error);
+                // 简化几乎无效时 (锁定顶点过多或已达到误差上限) 停止
+                if (lod.empty() || float(lod.size()) > float(previous.size()) * 0.9f) break;
+
+                errors.push_back(errors.back() + error);
+                levels.push_back(std::move(lod));
+            }
+
+            for (std::vector<uint32_t>& level : levels) {
+                if (settings.optimizeVertexCache) {
+                    OptimizeVertexCache(level.data(), level.size(), subMesh.vertices.size());
+                }
+                if (settings.optimizeOverdraw) {
+                    OptimizeOverdraw(level.data(), level.size(), subMesh.vertices, settings.overdrawThreshold);
+                }
+            }
+
+            size_t totalIndices = 0;
+            for (const auto& level : levels) totalIndices += level.size();
+            subMesh.indices.clear();
+            subMesh.indices.reserve(totalIndices);
+
+            if (levels.size() > 1) {
+                float previousScreenSize = FLT_MAX;
+                uint32_t indexOffset = 0;
+                for (size_t i = 0; i < levels.size(); ++i) {
+                    MeshLod lod;
+                    lod.indexOffset = indexOffset;
+                    lod.indexCount = static_cast<uint32_t>(levels[i].size());
+                    lod.error = errors[i];
+                    // 投影误差 error * screenSize 不超过 lodPixelError 像素时可用
+                    lod.screenSize = errors[i] > 0.0f ? std::min(settings.lodPixelError / errors[i], previousScreenSize) : FLT_MAX;
+                    previousScreenSize = lod.screenSize;
+                    indexOffset += lod.indexCount;
+                    subMesh.lods.push_back(lod);
+                }
+            }
+            for (const auto& level : levels) {
+                subMesh.indices.insert(subMesh.indices.end(), level.begin(), level.end());
+            }
+
+            // 顶点按 LOD0 的首次使用顺序排列, 较粗的级别只引用其子集
+            if (settings.optimizeVertexFetch) {
+                OptimizeVertexFetch(subMesh.vertices, subMesh.indices);
+            }
+            if (settings.quantize) {
+                subMesh.quantizedVertices = Quantize(subMesh.vertices);
+            }
+        }
+
+    } // namespace Graphic
+} // namespace PrismaEngine
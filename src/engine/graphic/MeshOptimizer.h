@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Export.h"
+#include "SubMesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        /**
+         * @brief 导入时的网格优化选项
+         */
+        struct MeshOptimizationSettings {
+            bool weldVertices        = true;   // 合并完全相同的顶点
+            bool optimizeVertexCache = true;   // 按顶点后变换缓存重排三角形
+            bool optimizeOverdraw    = true;   // 在缓存命中率损失有限的前提下由外向内排列三角形簇
+            float overdrawThreshold  = 1.05f;  // 允许的 ACMR 增长比例
+            bool optimizeVertexFetch = true;   // 按首次使用顺序重排顶点
+            bool quantize            = false;  // 生成 SubMesh::quantizedVertices
+
+            // LOD 链: 每级目标索引数为上一级的 lodReduction 倍, 误差超过 lodMaxError 或简化不再有效时停止
+            uint32_t maxLodCount  = 4;         // 包括原始网格, 1 表示不生成 LOD
+            float lodReduction    = 0.5f;
+            float lodMaxError     = 0.05f;     // 相对网格包围盒尺寸
+            uint32_t lodMinTriangles = 64;
+            float lodPixelError   = 1.0f;      // 计算屏幕尺寸阈值时允许的投影误差 (像素)
+        };
+
+        /**
+         * @brief 网格优化
+         *
+         * 索引均为三角形列表。简化使用二次误差度量的半边折叠 (顶点只会折叠到已有顶点上,
+         * 因此各 LOD 可以共享同一个顶点数组); 位于开放边界或属性接缝上的顶点不会被移动。
+         */
+        class ENGINE_API MeshOptimizer {
+        public:
+            /**
+             * @brief 执行完整的导入优化: 焊接、LOD 生成、各级别的缓存与过度绘制优化、顶点重排和量化
+             */
+            static void Optimize(SubMesh& subMesh, const MeshOptimizationSettings& settings = MeshOptimizationSettings());
+
+            /**
+             * @brief 合并逐字节相同的顶点并重写索引
+             * @return 合并后的顶点数
+             */
+            static size_t WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+            /**
+             * @brief 重排三角形以提高顶点后变换缓存命中率 (Forsyth 线性时间算法)
+             */
+            static void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+            /**
+             * @brief 将缓存优化后的三角形切分成簇, 按簇朝外程度排序以减少过度绘制
+             * @param threshold 允许的 ACMR 增长比例, 1.0 表示不牺牲缓存命中率
+             */
+            static void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const std::vector<Vertex>& vertices,
+                                         float threshold = 1.05f);
+
+            /**
+             * @brief 按索引中首次出现的顺序重排顶点, 未被引用的顶点被丢弃
+             */
+            static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+            /**
+             * @brief 简化网格
+             * @param targetIndexCount 目标索引数, 达到目标或误差超过 targetError 时停止
+             * @param targetError 相对网格包围盒尺寸的最大误差
+             * @param resultError 输出实际误差 (相对尺寸)
+             */
+            static std::vector<uint32_t> Simplify(const uint32_t* indices, size_t indexCount,
+                                                  const std::vector<Vertex>& vertices, size_t targetIndexCount,
+                                                  float targetError, float* resultError = nullptr);
+
+            /**
+             * @brief 量化顶点属性 (half UV, 八面体编码法线)
+             */
+            static std::vector<QuantizedVertex> Quantize(const std::vector<Vertex>& vertices);
+
+            /**
+             * @brief 模拟 FIFO 顶点缓存, 返回每个三角形的平均缓存未命中数 (ACMR)
+             */
+            static float ComputeACMR(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                     uint32_t cacheSize = 16);
+
+            // 八面体编码与半精度转换
+            static void EncodeOctahedral(float x, float y, float z, int16_t out[2]);
+            static void DecodeOctahedral(const int16_t in[2], float out[3]);
+            static uint16_t FloatToHalf(float value);
+            static float HalfToFloat(uint16_t value);
+        };
+
+    } // namespace Graphic
+} // namespace PrismaEngine
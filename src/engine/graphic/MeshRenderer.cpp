@@ -3,11 +3,34 @@
 #include "GameObject.h"
 #include "Logger.h"
 #include "RenderCommandContext.h"
+#include <algorithm>
 #include <cassert>
+#include <cfloat>
 
 using PrismaEngine::Graphic::RenderCommandContext;
 
-void MeshRenderer::DrawMesh(RenderCommandContext* context, std::shared_ptr<Mesh> mesh)
+using PrismaEngine::Graphic::LodView;
+
+float MeshRenderer::ComputeScreenSize(const LodView& lodView) const
+{
+    if (lodView.projectionScale <= 0.0f || !m_mesh || !GetOwner() || !GetOwner()->GetTransform()) {
+        return 0.0f;
+    }
+
+    const auto transform = GetOwner()->GetTransform();
+    const BoundingBox& bounds = m_mesh->globalBoundingBox;
+    const float maxScale = std::max({std::abs(transform->scale.x), std::abs(transform->scale.y), std::abs(transform->scale.z)});
+    const float radius = glm::length(bounds.maxBounds - bounds.minBounds) * 0.5f * maxScale;
+    const PrismaEngine::Vector3 center = PrismaEngine::Vector3(transform->GetMatrix() * glm::vec4((bounds.minBounds + bounds.maxBounds) * 0.5f, 1.0f));
+
+    const float distance = glm::length(center - lodView.cameraPosition);
+    if (distance <= radius) {
+        return FLT_MAX;  // 相机在包围球内
+    }
+    return radius * 2.0f * lodView.projectionScale / distance;
+}
+
+void MeshRenderer::DrawMesh(RenderCommandContext* context, std::shared_ptr<Mesh> mesh, float screenSize)
 {
     LOG_DEBUG("MeshRenderer", "DrawMesh called. mesh ptr={0}, subMeshes={1}", reinterpret_cast<uintptr_t>(mesh.get()), mesh ? mesh->subMeshes.size() : 0);
 
@@ -33,9 +56,16 @@ void MeshRenderer::DrawMesh(RenderCommandContext* context, std::shared_ptr<Mesh>
         }
 
         if (subMesh.indicesCount() > 0) {
-            // If indices exist, attempt indexed draw
-            LOG_TRACE("MeshRenderer", "Calling DrawIndexed for SubMesh[{0}] indexCount={1}", i, subMesh.indicesCount());
-            context->DrawIndexed(subMesh.indicesCount(), 0, 0);
+            // 各 LOD 共享顶点缓冲, 只绘制选中级别的索引区间
+            uint32_t lodIndex = 0;
+            if (m_forcedLod >= 0) {
+                lodIndex = static_cast<uint32_t>(m_forcedLod);
+            } else if (screenSize > 0.0f) {
+                lodIndex = subMesh.SelectLod(screenSize);
+            }
+            const MeshLod lod = subMesh.GetLod(lodIndex);
+            LOG_TRACE("MeshRenderer", "Calling DrawIndexed for SubMesh[{0}] lod={1} indexCount={2}", i, lodIndex, lod.indexCount);
+            context->DrawIndexed(lod.indexCount, lod.indexOffset, 0);
         } else {
             // Fallback to non-indexed draw (use renderer's currently bound vertex buffer)
             LOG_TRACE("MeshRenderer", "Calling Draw (non-indexed) for SubMesh[{0}] vertexCount={1}", i, subMesh.verticesCount());
@@ -46,6 +76,11 @@ void MeshRenderer::DrawMesh(RenderCommandContext* context, std::shared_ptr<Mesh>
 
 // 将内联实现移出到此处
 void MeshRenderer::Render(PrismaEngine::Graphic::RenderCommandContext* context)
+{
+    Render(context, LodView{});
+}
+
+void MeshRenderer::Render(PrismaEngine::Graphic::RenderCommandContext* context, const LodView& lodView)
 {
     LOG_DEBUG("MeshRenderer", "Render called. mesh present={0} material present={1} context ptr={2}", (bool)m_mesh, (bool)m_material, reinterpret_cast<uintptr_t>(context));
 
@@ -84,7 +119,7 @@ void MeshRenderer::Render(PrismaEngine::Graphic::RenderCommandContext* context)
     }
 
     // 绘制网格
-    DrawMesh(context, m_mesh);
+    DrawMesh(context, m_mesh, ComputeScreenSize(lodView));
 }
 
 void MeshRenderer::Update(float deltaTime) {}
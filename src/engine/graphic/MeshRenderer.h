@@ -22,14 +22,23 @@ private:
     std::shared_ptr<Mesh> m_mesh;
     std::shared_ptr<PrismaEngine::Material> m_material;
 
+    int m_forcedLod = -1;
+
 protected:
-    void DrawMesh(PrismaEngine::Graphic::RenderCommandContext* context, std::shared_ptr<Mesh> mesh);
+    // screenSize 为 0 时绘制 LOD0
+    void DrawMesh(PrismaEngine::Graphic::RenderCommandContext* context, std::shared_ptr<Mesh> mesh, float screenSize = 0.0f);
+
+    // 网格包围球在视图中的投影直径 (像素), 视图未设置投影比例时返回 0
+    float ComputeScreenSize(const PrismaEngine::Graphic::LodView& lodView) const;
 
 public:
     // 移除了内联的Render实现，在cpp文件中实现
 
     void Render(PrismaEngine::Graphic::RenderCommandContext* context) override;
 
+    // 按 Pass 的 LOD 视图选择级别后绘制; 不带视图的版本总是绘制 LOD0
+    void Render(PrismaEngine::Graphic::RenderCommandContext* context, const PrismaEngine::Graphic::LodView& lodView);
+
     void SetMesh(std::shared_ptr<Mesh> mesh) {
         m_mesh = std::move(mesh);
     }
@@ -45,6 +54,10 @@ public:
     [[nodiscard]] std::shared_ptr<PrismaEngine::Material> GetMaterial() const override {
         return m_material;
     }
+    // 强制使用指定 LOD, -1 表示按屏幕尺寸自动选择
+    void SetForcedLod(int lod) { m_forcedLod = lod; }
+    [[nodiscard]] int GetForcedLod() const { return m_forcedLod; }
+
     void Update(float deltaTime) override;
     MeshRenderer();
     ~MeshRenderer() override;
@@ -0,0 +1,100 @@
+#include "MipGenerator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        namespace {
+            constexpr uint32_t BytesPerPixel = 4;
+
+            // sRGB -> 线性查找表
+            const std::array<float, 256>& SrgbToLinearTable() {
+                static const std::array<float, 256> table = [] {
+                    std::array<float, 256> values{};
+                    for (int i = 0; i < 256; ++i) {
+                        float c = static_cast<float>(i) / 255.0f;
+                        values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                    }
+                    return values;
+                }();
+                return table;
+            }
+
+            uint8_t LinearToSrgb(float linear) {
+                float c = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+                return static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        } // namespace
+
+        uint32_t MipGenerator::ComputeMipCount(uint32_t width, uint32_t height) {
+            uint32_t maxDim = std::max(width, height);
+            uint32_t count = 1;
+            while (maxDim > 1) {
+                maxDim >>= 1;
+                ++count;
+            }
+            return count;
+        }
+
+        std::vector<uint8_t> MipGenerator::Downsample(const uint8_t* src, uint32_t width, uint32_t height, bool srgb) {
+            uint32_t dstWidth  = std::max(1u, width / 2);
+            uint32_t dstHeight = std::max(1u, height / 2);
+            std::vector<uint8_t> dst(static_cast<size_t>(dstWidth) * dstHeight * BytesPerPixel);
+            const auto& toLinear = SrgbToLinearTable();
+
+            for (uint32_t y = 0; y < dstHeight; ++y) {
+                uint32_t y0 = std::min(y * 2, height - 1);
+                uint32_t y1 = std::min(y * 2 + 1, height - 1);
+                for (uint32_t x = 0; x < dstWidth; ++x) {
+                    uint32_t x0 = std::min(x * 2, width - 1);
+                    uint32_t x1 = std::min(x * 2 + 1, width - 1);
+
+                    const uint8_t* p00 = &src[(static_cast<size_t>(y0) * width + x0) * BytesPerPixel];
+                    const uint8_t* p01 = &src[(static_cast<size_t>(y0) * width + x1) * BytesPerPixel];
+                    const uint8_t* p10 = &src[(static_cast<size_t>(y1) * width + x0) * BytesPerPixel];
+                    const uint8_t* p11 = &src[(static_cast<size_t>(y1) * width + x1) * BytesPerPixel];
+                    uint8_t* out = &dst[(static_cast<size_t>(y) * dstWidth + x) * BytesPerPixel];
+
+                    for (uint32_t c = 0; c < BytesPerPixel; ++c) {
+                        if (srgb && c < 3) {
+                            float sum = toLinear[p00[c]] + toLinear[p01[c]] + toLinear[p10[c]] + toLinear[p11[c]];
+                            out[c] = LinearToSrgb(sum * 0.25f);
+                        } else {
+                            out[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+                        }
+                    }
+                }
+            }
+            return dst;
+        }
+
+        std::vector<std::vector<uint8_t>> MipGenerator::Generate(std::vector<uint8_t> level0, uint32_t width, uint32_t height,
+                                                                 uint32_t firstMip, uint32_t mipCount, bool srgb) {
+            uint32_t fullCount = ComputeMipCount(width, height);
+            mipCount = mipCount == 0 ? fullCount : std::min(mipCount, fullCount);
+
+            std::vector<std::vector<uint8_t>> levels;
+            if (firstMip >= mipCount) return levels;
+            levels.reserve(mipCount - firstMip);
+
+            std::vector<uint8_t> pixels = std::move(level0);
+            for (uint32_t mip = 0; mip < mipCount; ++mip) {
+                bool last = mip + 1 == mipCount;
+                std::vector<uint8_t> next;
+                if (!last) {
+                    next   = Downsample(pixels.data(), width, height, srgb);
+                    width  = std::max(1u, width / 2);
+                    height = std::max(1u, height / 2);
+                }
+                if (mip >= firstMip) {
+                    levels.push_back(std::move(pixels));
+                }
+                pixels = std::move(next);
+            }
+            return levels;
+        }
+
+    } // namespace Graphic
+} // namespace PrismaEngine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Export.h"
+#include <cstdint>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        /**
+         * @brief RGBA8 图像的 MIP 链生成
+         * 2x2 盒式滤波, 奇数尺寸时边缘像素重复采样; sRGB 图像在线性空间中平均颜色通道
+         */
+        class ENGINE_API MipGenerator {
+        public:
+            /**
+             * @brief 完整 MIP 链的级别数 (直到 1x1)
+             */
+            static uint32_t ComputeMipCount(uint32_t width, uint32_t height);
+
+            /**
+             * @brief 生成下一级
+             */
+            static std::vector<uint8_t> Downsample(const uint8_t* src, uint32_t width, uint32_t height, bool srgb = false);
+
+            /**
+             * @brief 生成 [firstMip, mipCount) 级别
+             * @param level0 第 0 级像素, 会被移动
+             * @param mipCount 为 0 时生成完整 MIP 链
+             */
+            static std::vector<std::vector<uint8_t>> Generate(std::vector<uint8_t> level0, uint32_t width, uint32_t height,
+                                                              uint32_t firstMip = 0, uint32_t mipCount = 0,
+                                                              bool srgb = false);
+        };
+
+    } // namespace Graphic
+} // namespace PrismaEngine
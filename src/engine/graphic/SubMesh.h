@@ -11,6 +11,15 @@
 #include "interfaces/RenderTypes.h"
 namespace PrismaEngine {
 using namespace Graphic;
+
+// 细节层次: indices 中的一段索引, 与其他级别共享顶点数组
+struct MeshLod {
+    uint32_t indexOffset = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;       // 简化误差, 相对网格包围盒尺寸
+    float screenSize = 0.0f;  // 网格投影尺寸 (像素) 不超过该值时可使用此级别
+};
+
 struct SubMesh {
     std::string name;
     uint32_t materialIndex; // 对应材质数组的索引
@@ -18,6 +27,25 @@ struct SubMesh {
     std::vector<uint32_t> indices; // 子网格的顶点索引数据
     uint32_t verticesCount() const { return static_cast<uint32_t>(vertices.size()); }
     uint32_t indicesCount() const { return static_cast<uint32_t>(indices.size()); }
+
+    // LOD 为空时 indices 整体为唯一级别; 否则 lods[0] 为原始网格, 各级别依次存放在 indices 中
+    std::vector<MeshLod> lods;
+    uint32_t lodCount() const { return lods.empty() ? 1u : static_cast<uint32_t>(lods.size()); }
+    MeshLod GetLod(uint32_t lod) const {
+        if (lods.empty()) return MeshLod{0, indicesCount(), 0.0f, 0.0f};
+        return lods[lod < lods.size() ? lod : lods.size() - 1];
+    }
+    // 选择投影尺寸下可用的最粗级别
+    uint32_t SelectLod(float screenSize) const {
+        uint32_t selected = 0;
+        for (uint32_t i = 1; i < lods.size() && lods[i].screenSize >= screenSize; ++i) {
+            selected = i;
+        }
+        return selected;
+    }
+
+    // MeshOptimizer 量化后的顶点, 与 vertices 一一对应 (未量化时为空)
+    std::vector<QuantizedVertex> quantizedVertices;
     // 图形API资源句柄
     VertexBufferHandle vertexBufferHandle;
     IndexBufferHandle indexBufferHandle;
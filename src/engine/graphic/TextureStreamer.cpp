@@ -0,0 +1,434 @@
+#include "TextureStreamer.h"
+#include "Ktx2.h"
+#include "MipGenerator.h"
+#include "ResourceManager.h"
+#include "Logger.h"
+#include "interfaces/IRenderDevice.h"
+#include "interfaces/IResourceFactory.h"
+#include "interfaces/ITexture.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        // ============================================================================
+        // 内部辅助
+        // ============================================================================
+
+        namespace {
+            // 请求目标为尾部级别 (首次加载时尺寸未知)
+            constexpr uint32_t TailMipRequest = UINT32_MAX;
+
+            // GPU 显存信息不可用时的默认预算
+            constexpr uint64_t DefaultMemoryBudget = 256ull * 1024 * 1024;
+
+            uint32_t MipDimension(uint32_t size, uint32_t mip) {
+                return std::max(1u, size >> mip);
+            }
+
+            uint32_t ComputeTailMip(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t maxSize) {
+                uint32_t mip = 0;
+                while (mip + 1 < mipCount && std::max(MipDimension(width, mip), MipDimension(height, mip)) > maxSize) {
+                    ++mip;
+                }
+                return mip;
+            }
+
+            /**
+             * @brief 解码结果: MIP 链中 [firstMip, mipCount) 的级别
+             */
+            struct DecodedMipChain {
+                TextureFormat format = TextureFormat::RGBA8_UNorm;
+                uint32_t width    = 0;
+                uint32_t height   = 0;
+                uint32_t mipCount = 0;
+                uint32_t firstMip = 0;
+                std::vector<std::vector<uint8_t>> levels;
+            };
+
+            /**
+             * @brief 复制离线烘焙的 KTX2 中从 targetMip 开始的级别, 无需解码
+             */
+            bool LoadKtx2MipChain(const Core::StreamPayload& payload, uint32_t targetMip, uint32_t initialMaxSize,
+                                  DecodedMipChain& chain) {
+                Ktx2::Image image;
+                if (!Ktx2::Parse(payload.Data(), payload.Size(), image)) {
+                    return false;
+                }
+
+                chain.format   = image.format;
+                chain.width    = image.width;
+                chain.height   = image.height;
+                chain.mipCount = static_cast<uint32_t>(image.levels.size());
+                chain.firstMip = targetMip == TailMipRequest
+                    ? ComputeTailMip(chain.width, chain.height, chain.mipCount, initialMaxSize)
+                    : std::min(targetMip, chain.mipCount - 1);
+
+                for (uint32_t mip = chain.firstMip; mip < chain.mipCount; ++mip) {
+                    const Ktx2::Level& level = image.levels[mip];
+                    chain.levels.emplace_back(level.data, level.data + level.size);
+                }
+                return true;
+            }
+
+            /**
+             * @brief 解码图像并生成从 targetMip 开始的 MIP 链
+             */
+            bool DecodeMipChain(const Core::StreamPayload& payload, uint32_t targetMip, uint32_t initialMaxSize,
+                                DecodedMipChain& chain) {
+                if (Ktx2::IsKtx2(payload.Data(), payload.Size())) {
+                    return LoadKtx2MipChain(payload, targetMip, initialMaxSize, chain);
+                }
+
+                std::vector<uint8_t> pixels;
+                TextureDesc desc;
+                if (!ResourceManager::DecodeImage(payload.Data(), payload.Size(), pixels, desc)) {
+                    return false;
+                }
+
+                chain.format   = desc.format;
+                chain.width    = static_cast<uint32_t>(desc.width);
+                chain.height   = static_cast<uint32_t>(desc.height);
+                chain.mipCount = MipGenerator::ComputeMipCount(chain.width, chain.height);
+                chain.firstMip = targetMip == TailMipRequest
+                    ? ComputeTailMip(chain.width, chain.height, chain.mipCount, initialMaxSize)
+                    : std::min(targetMip, chain.mipCount - 1);
+                chain.levels   = MipGenerator::Generate(std::move(pixels), chain.width, chain.height,
+                                                        chain.firstMip, chain.mipCount);
+                return true;
+            }
+
+            TextureDesc MakeChainDesc(const StreamedTexture& texture, uint32_t firstMip) {
+                TextureDesc desc;
+                desc.type      = TextureType::Texture2D;
+                desc.format    = texture.GetFormat();
+                desc.width     = MipDimension(texture.GetWidth(), firstMip);
+                desc.height    = MipDimension(texture.GetHeight(), firstMip);
+                desc.mipLevels = texture.GetMipCount() - firstMip;
+                desc.filename  = texture.GetPath();
+                desc.name      = texture.GetPath();
+                return desc;
+            }
+        } // namespace
+
+        // ============================================================================
+        // TextureStreamer 实现
+        // ============================================================================
+
+        TextureStreamer::TextureStreamer(IRenderDevice* device, Core::StreamingLoader& loader,
+                                         const TextureStreamingConfig& config)
+            : m_device(device)
+            , m_loader(loader)
+            , m_config(config) {
+            m_budget = m_config.memoryBudget;
+            if (m_budget == 0 && m_device) {
+                auto memory = m_device->GetGPUMemoryInfo();
+                m_budget = static_cast<uint64_t>(static_cast<double>(memory.totalMemory) * m_config.memoryBudgetRatio);
+            }
+            if (m_budget == 0) {
+                m_budget = DefaultMemoryBudget;
+            }
+            LOG_INFO("TextureStreamer", "纹理流式加载预算: {0} MB", m_budget / (1024 * 1024));
+        }
+
+        TextureStreamer::~TextureStreamer() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& texture : m_textures) {
+                CancelRequest(*texture);
+            }
+            m_textures.clear();
+        }
+
+        std::shared_ptr<StreamedTexture> TextureStreamer::Load(const std::string& path, float priority) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& texture : m_textures) {
+                if (texture->GetPath() == path) return texture;
+            }
+
+            auto texture = std::make_shared<StreamedTexture>(path);
+            texture->m_priority = priority;
+            m_textures.push_back(texture);
+            RequestMip(texture, TailMipRequest, priority);
+            return texture;
+        }
+
+        void TextureStreamer::RequestMip(const TexturePtr& texture, uint32_t targetMip, float priority) {
+            std::weak_ptr<StreamedTexture> weak = texture;
+            uint32_t initialMaxSize = m_config.initialMaxSize;
+
+            Core::StreamRequest request;
+            request.path     = texture->GetPath();
+            request.priority = priority;
+
+            // 工作线程: 解码并生成所需级别
+            request.decode = [targetMip, initialMaxSize](Core::StreamPayload& payload) {
+                auto chain = std::make_shared<DecodedMipChain>();
+                if (!DecodeMipChain(payload, targetMip, initialMaxSize, *chain)) {
+                    return false;
+                }
+                payload.uploadBytes = 0;
+                for (const auto& level : chain->levels) payload.uploadBytes += level.size();
+                payload.decoded = chain;
+                return true;
+            };
+
+            // 主线程: 创建新纹理并替换
+            request.upload = [this, weak, targetMip](Core::StreamPayload& payload) {
+                auto texture = weak.lock();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!texture) return true;
+                return ApplyUpload(texture, targetMip, payload);
+            };
+
+            request.onFailed = [this, weak](Core::StreamRequestId) {
+                auto texture = weak.lock();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!texture) return;
+                LOG_WARNING("TextureStreamer", "纹理流式加载失败: {0}", texture->GetPath());
+                texture->m_request = Core::InvalidStreamRequest;
+                ReleaseReservation(*texture);
+            };
+
+            texture->m_requestMip = targetMip;
+            texture->m_request    = m_loader.Submit(std::move(request));
+        }
+
+        void TextureStreamer::CancelRequest(StreamedTexture& texture) {
+            if (texture.m_request == Core::InvalidStreamRequest) return;
+            if (m_loader.Cancel(texture.m_request)) {
+                texture.m_request = Core::InvalidStreamRequest;
+                ReleaseReservation(texture);
+            }
+        }
+
+        void TextureStreamer::ReleaseReservation(StreamedTexture& texture) {
+            m_reservedBytes -= texture.m_reservedBytes;
+            texture.m_reservedBytes = 0;
+        }
+
+        bool TextureStreamer::ApplyUpload(const TexturePtr& texture, uint32_t targetMip, const Core::StreamPayload& payload) {
+            texture->m_request = Core::InvalidStreamRequest;
+            ReleaseReservation(*texture);
+
+            auto chain = std::static_pointer_cast<DecodedMipChain>(payload.decoded);
+            bool initial = targetMip == TailMipRequest;
+            if (initial) {
+                texture->m_format    = chain->format;
+                texture->m_width     = chain->width;
+                texture->m_height    = chain->height;
+                texture->m_mipCount  = chain->mipCount;
+                texture->m_tailMip   = chain->firstMip;
+                texture->m_wantedMip = chain->firstMip;
+                texture->m_lastUsedFrame = m_frame;
+                texture->m_residentMip.store(chain->mipCount, std::memory_order_release);
+            } else if (chain->firstMip >= texture->GetResidentMip()) {
+                // 等待期间已经驻留了同等或更高精度的级别
+                return true;
+            }
+
+            uint64_t newBytes = ComputeChainSize(chain->format, chain->width, chain->height, chain->firstMip, chain->mipCount);
+            uint64_t oldBytes = ResidentBytes(*texture);
+            // 尾部级别总是允许驻留; 升级在请求时已腾出空间, 这里再确认一次
+            if (!initial && newBytes > oldBytes && !MakeRoom(newBytes - oldBytes, texture.get())) {
+                return true;
+            }
+
+            IResourceFactory* factory = m_device ? m_device->GetResourceFactory() : nullptr;
+            if (!factory) return false;
+
+            std::shared_ptr<ITexture> gpuTexture = factory->CreateTextureImpl(MakeChainDesc(*texture, chain->firstMip));
+            if (!gpuTexture) return false;
+
+            for (uint32_t i = 0; i < chain->levels.size(); ++i) {
+                uint32_t mip = chain->firstMip + i;
+                const auto& level = chain->levels[i];
+                gpuTexture->UpdateData(level.data(), level.size(), i, 0, 0, 0, 0,
+                                       MipDimension(chain->width, mip), MipDimension(chain->height, mip), 1);
+            }
+
+            texture->SetTexture(std::move(gpuTexture), chain->firstMip);
+            m_residentBytes = m_residentBytes - oldBytes + newBytes;
+            if (!initial) ++m_upgradedCount;
+            return true;
+        }
+
+        bool TextureStreamer::Downgrade(StreamedTexture& texture, uint32_t newResidentMip) {
+            uint32_t residentMip = texture.GetResidentMip();
+            if (newResidentMip <= residentMip || newResidentMip >= texture.GetMipCount()) return false;
+
+            auto oldTexture = texture.GetTexture();
+            IResourceFactory* factory = m_device ? m_device->GetResourceFactory() : nullptr;
+            if (!oldTexture || !factory) return false;
+
+            // 新纹理复用旧纹理中较低精度的级别, 无需重新读取文件
+            std::shared_ptr<ITexture> gpuTexture = factory->CreateTextureImpl(MakeChainDesc(texture, newResidentMip));
+            if (!gpuTexture) return false;
+
+            uint32_t levelCount = texture.GetMipCount() - newResidentMip;
+            for (uint32_t i = 0; i < levelCount; ++i) {
+                gpuTexture->CopyFrom(oldTexture.get(), newResidentMip - residentMip + i, 0, i, 0);
+            }
+
+            uint64_t oldBytes = ResidentBytes(texture);
+            texture.SetTexture(std::move(gpuTexture), newResidentMip);
+            m_residentBytes = m_residentBytes - oldBytes + ResidentBytes(texture);
+            m_evictedMips += newResidentMip - residentMip;
+            return true;
+        }
+
+        bool TextureStreamer::MakeRoom(uint64_t bytes, const StreamedTexture* requester) {
+            if (m_residentBytes + m_reservedBytes + bytes <= m_budget) return true;
+
+            // 本帧用到的纹理不回收, 其余按最近使用帧从旧到新逐级丢弃最高精度级别
+            std::vector<StreamedTexture*> candidates;
+            for (auto& texture : m_textures) {
+                if (texture.get() == requester || !texture->IsResident()) continue;
+                if (texture->m_lastUsedFrame >= m_frame) continue;
+                if (texture->GetResidentMip() >= texture->m_tailMip) continue;
+                candidates.push_back(texture.get());
+            }
+            std::sort(candidates.begin(), candidates.end(), [](const StreamedTexture* a, const StreamedTexture* b) {
+                return a->m_lastUsedFrame < b->m_lastUsedFrame;
+            });
+
+            for (StreamedTexture* texture : candidates) {
+                while (m_residentBytes + m_reservedBytes + bytes > m_budget && texture->GetResidentMip() < texture->m_tailMip) {
+                    if (!Downgrade(*texture, texture->GetResidentMip() + 1)) break;
+                    texture->m_wantedMip = std::max(texture->m_wantedMip, texture->GetResidentMip());
+                }
+                if (m_residentBytes + m_reservedBytes + bytes <= m_budget) return true;
+            }
+            return false;
+        }
+
+        void TextureStreamer::Update() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_frame;
+
+            struct Upgrade {
+                TexturePtr texture;
+                float priority;
+            };
+            std::vector<Upgrade> upgrades;
+
+            for (auto it = m_textures.begin(); it != m_textures.end(); ) {
+                TexturePtr& texture = *it;
+
+                // 只剩流式加载器持有的纹理直接释放
+                if (texture.use_count() == 1) {
+                    CancelRequest(*texture);
+                    ReleaseReservation(*texture);
+                    m_residentBytes -= ResidentBytes(*texture);
+                    it = m_textures.erase(it);
+                    continue;
+                }
+                ++it;
+
+                if (texture->m_mipCount == 0) continue;  // 尾部级别尚未加载
+
+                float screenPixels = texture->m_feedback.exchange(0.0f, std::memory_order_relaxed);
+                if (screenPixels > 0.0f) {
+                    uint32_t mip = SelectMip(texture->m_width, texture->m_height, texture->m_mipCount, screenPixels);
+                    texture->m_wantedMip = std::min(mip, texture->m_tailMip);
+                    texture->m_lastUsedFrame = m_frame;
+                } else if (m_frame - texture->m_lastUsedFrame > m_config.feedbackTimeoutFrames) {
+                    texture->m_wantedMip = texture->m_tailMip;
+                }
+
+                uint32_t residentMip = texture->GetResidentMip();
+
+                // 不再需要升级时取消进行中的请求
+                if (texture->m_request != Core::InvalidStreamRequest) {
+                    if (texture->m_requestMip != TailMipRequest && texture->m_wantedMip >= residentMip) {
+                        CancelRequest(*texture);
+                    }
+                    if (texture->m_request != Core::InvalidStreamRequest) continue;
+                }
+
+                if (texture->m_wantedMip < residentMip) {
+                    // 缺的级别越多越优先
+                    float deficit = static_cast<float>(residentMip - texture->m_wantedMip);
+                    upgrades.push_back({ texture, texture->m_priority - deficit });
+                } else if (texture->m_wantedMip > residentMip &&
+                           m_frame - texture->m_lastUsedFrame > m_config.feedbackTimeoutFrames) {
+                    // 长时间未使用, 退回尾部级别
+                    Downgrade(*texture, texture->m_wantedMip);
+                }
+            }
+
+            std::sort(upgrades.begin(), upgrades.end(), [](const Upgrade& a, const Upgrade& b) {
+                return a.priority < b.priority;
+            });
+
+            uint32_t submitted = 0;
+            for (auto& upgrade : upgrades) {
+                if (submitted >= m_config.maxUpgradesPerFrame) break;
+
+                StreamedTexture& texture = *upgrade.texture;
+                uint32_t residentMip = texture.GetResidentMip();
+                uint64_t residentBytes = ResidentBytes(texture);
+
+                // 预算不足时退而求其次, 选择能放下的最高精度级别
+                uint32_t targetMip = texture.m_wantedMip;
+                uint64_t growth = 0;
+                while (targetMip < residentMip) {
+                    growth = ComputeChainSize(texture.m_format, texture.m_width, texture.m_height, targetMip, texture.m_mipCount) - residentBytes;
+                    if (MakeRoom(growth, &texture)) break;
+                    ++targetMip;
+                }
+                if (targetMip >= residentMip) continue;
+
+                texture.m_wantedMip = targetMip;
+                RequestMip(upgrade.texture, targetMip, upgrade.priority);
+                texture.m_reservedBytes = growth;
+                m_reservedBytes += growth;
+                ++submitted;
+            }
+        }
+
+        void TextureStreamer::SetMemoryBudget(uint64_t bytes) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_budget = bytes > 0 ? bytes : DefaultMemoryBudget;
+            MakeRoom(0, nullptr);
+        }
+
+        TextureStreamer::Stats TextureStreamer::GetStats() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Stats stats;
+            stats.textureCount  = m_textures.size();
+            stats.residentBytes = m_residentBytes;
+            stats.memoryBudget  = m_budget;
+            stats.upgradedCount = m_upgradedCount;
+            stats.evictedMips   = m_evictedMips;
+            for (const auto& texture : m_textures) {
+                if (texture->m_request != Core::InvalidStreamRequest) ++stats.pendingRequests;
+            }
+            return stats;
+        }
+
+        uint64_t TextureStreamer::ResidentBytes(const StreamedTexture& texture) const {
+            if (!texture.IsResident()) return 0;
+            return ComputeChainSize(texture.m_format, texture.m_width, texture.m_height, texture.GetResidentMip(), texture.m_mipCount);
+        }
+
+        uint64_t TextureStreamer::ComputeChainSize(TextureFormat format, uint32_t width, uint32_t height,
+                                                   uint32_t firstMip, uint32_t mipCount) {
+            uint64_t bytes = 0;
+            for (uint32_t mip = firstMip; mip < mipCount; ++mip) {
+                bytes += ComputeTextureLevelSize(format, MipDimension(width, mip), MipDimension(height, mip));
+            }
+            return bytes;
+        }
+
+        uint32_t TextureStreamer::SelectMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenPixels) {
+            if (mipCount == 0) return 0;
+            float maxDim = static_cast<float>(std::max(width, height));
+            if (screenPixels >= maxDim) return 0;
+
+            float mip = std::floor(std::log2(maxDim / std::max(screenPixels, 1.0f)));
+            return std::min(static_cast<uint32_t>(mip), mipCount - 1);
+        }
+
+    } // namespace Graphic
+} // namespace PrismaEngine
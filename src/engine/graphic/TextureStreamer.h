@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Export.h"
+#include "core/StreamingLoader.h"
+#include "interfaces/RenderTypes.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Graphic {
+
+        // 前向声明
+        class ITexture;
+        class IRenderDevice;
+        class TextureStreamer;
+
+        /**
+         * @brief 按 MIP 级别流式加载的纹理
+         *
+         * GPU 纹理只包含 [GetResidentMip(), GetMipCount()) 范围内的级别,
+         * 即 GPU 纹理的第 0 级对应完整 MIP 链的第 GetResidentMip() 级。
+         * 驻留级别变化时 GPU 纹理会被替换, 渲染时应每帧通过 GetTexture 获取。
+         */
+        class ENGINE_API StreamedTexture {
+        public:
+            explicit StreamedTexture(std::string path) : m_path(std::move(path)) {}
+
+            const std::string& GetPath() const { return m_path; }
+
+            /**
+             * @brief 获取当前驻留的 GPU 纹理, 尾部 MIP 加载完成前为空
+             */
+            std::shared_ptr<ITexture> GetTexture() const {
+                std::lock_guard<std::mutex> lock(m_textureMutex);
+                return m_texture;
+            }
+
+            // 完整 MIP 链的格式和尺寸, 首次加载完成前尺寸为 0
+            TextureFormat GetFormat() const { return m_format; }
+            uint32_t GetWidth() const { return m_width; }
+            uint32_t GetHeight() const { return m_height; }
+            uint32_t GetMipCount() const { return m_mipCount; }
+
+            /**
+             * @brief 当前驻留的最高精度级别, 未驻留时等于 GetMipCount()
+             */
+            uint32_t GetResidentMip() const { return m_residentMip.load(std::memory_order_acquire); }
+            uint32_t GetRequestedMip() const { return m_wantedMip; }
+            bool IsResident() const { return GetResidentMip() < m_mipCount; }
+
+            /**
+             * @brief 上报本帧在屏幕上的最大投影尺寸 (像素), 可在任意线程调用
+             */
+            void ReportScreenSize(float pixels) {
+                float current = m_feedback.load(std::memory_order_relaxed);
+                while (pixels > current &&
+                       !m_feedback.compare_exchange_weak(current, pixels, std::memory_order_relaxed)) {
+                }
+            }
+
+        private:
+            friend class TextureStreamer;
+
+            void SetTexture(std::shared_ptr<ITexture> texture, uint32_t residentMip) {
+                std::lock_guard<std::mutex> lock(m_textureMutex);
+                m_texture = std::move(texture);
+                m_residentMip.store(residentMip, std::memory_order_release);
+            }
+
+            std::string m_path;
+
+            mutable std::mutex m_textureMutex;
+            std::shared_ptr<ITexture> m_texture;
+
+            TextureFormat m_format = TextureFormat::RGBA8_UNorm;
+            uint32_t m_width    = 0;
+            uint32_t m_height   = 0;
+            uint32_t m_mipCount = 0;
+            std::atomic<uint32_t> m_residentMip{0};
+            std::atomic<float> m_feedback{0.0f};
+
+            // 以下字段只在主线程 (TextureStreamer::Update) 访问
+            uint32_t m_tailMip   = 0;       // 常驻的尾部级别
+            uint32_t m_wantedMip = 0;       // 根据屏幕尺寸反馈期望的级别
+            uint64_t m_lastUsedFrame = 0;   // 最近一次收到反馈的帧
+            float m_priority = 0.0f;        // Load 时指定的基础优先级
+            Core::StreamRequestId m_request = Core::InvalidStreamRequest;
+            uint32_t m_requestMip = 0;      // 进行中的请求的目标级别
+            uint64_t m_reservedBytes = 0;   // 进行中的升级预留的预算
+        };
+
+        /**
+         * @brief 纹理流式加载配置
+         */
+        struct TextureStreamingConfig {
+            uint64_t memoryBudget      = 0;      // 纹理显存预算 (字节), 0 表示按 GPU 显存比例计算
+            float memoryBudgetRatio    = 0.5f;   // memoryBudget 为 0 时占 GPU 总显存的比例
+            uint32_t initialMaxSize    = 64;     // 首次加载的尾部 MIP 的最大边长
+            uint32_t feedbackTimeoutFrames = 30; // 超过此帧数未收到反馈的纹理退回尾部级别
+            uint32_t maxUpgradesPerFrame   = 8;  // 每帧最多发起的升级请求数
+        };
+
+        /**
+         * @brief MIP 级别纹理流式加载器
+         *
+         * - Load 只加载尾部 MIP (不超过 initialMaxSize), 纹理可以立即使用
+         * - 渲染器通过 StreamedTexture::ReportScreenSize 上报屏幕尺寸, Update 据此请求更高精度的级别
+         * - 驻留总量超过预算时, 优先丢弃最久未使用的纹理的最高级别
+         * 读取和解码使用 Core::StreamingLoader, 因此 Update 应在其 Update 之后调用。
+         */
+        class ENGINE_API TextureStreamer {
+        public:
+            struct Stats {
+                size_t textureCount      = 0;
+                size_t pendingRequests   = 0;
+                uint64_t residentBytes   = 0;
+                uint64_t memoryBudget    = 0;
+                uint64_t upgradedCount   = 0;  // 完成的升级次数
+                uint64_t evictedMips     = 0;  // 因预算或超时丢弃的级别数
+            };
+
+            TextureStreamer(IRenderDevice* device, Core::StreamingLoader& loader,
+                            const TextureStreamingConfig& config = TextureStreamingConfig());
+            ~TextureStreamer();
+
+            TextureStreamer(const TextureStreamer&)            = delete;
+            TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+            /**
+             * @brief 开始流式加载纹理, 同一路径返回同一对象
+             * @param priority 尾部 MIP 的加载优先级, 数值越小越优先
+             */
+            std::shared_ptr<StreamedTexture> Load(const std::string& path, float priority = 0.0f);
+
+            /**
+             * @brief 处理屏幕尺寸反馈、调度升级和执行预算回收, 每帧在主线程调用
+             */
+            void Update();
+
+            void SetMemoryBudget(uint64_t bytes);
+            uint64_t GetMemoryBudget() const { return m_budget; }
+
+            Stats GetStats() const;
+
+            /**
+             * @brief 计算 MIP 链中 [firstMip, mipCount) 级别的总字节数
+             */
+            static uint64_t ComputeChainSize(TextureFormat format, uint32_t width, uint32_t height,
+                                             uint32_t firstMip, uint32_t mipCount);
+
+            /**
+             * @brief 由屏幕尺寸计算需要的最高精度级别
+             */
+            static uint32_t SelectMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenPixels);
+
+        private:
+            using TexturePtr = std::shared_ptr<StreamedTexture>;
+
+            void RequestMip(const TexturePtr& texture, uint32_t targetMip, float priority);
+            void CancelRequest(StreamedTexture& texture);
+            void ReleaseReservation(StreamedTexture& texture);
+            bool ApplyUpload(const TexturePtr& texture, uint32_t targetMip, const Core::StreamPayload& payload);
+            bool Downgrade(StreamedTexture& texture, uint32_t newResidentMip);
+            bool MakeRoom(uint64_t bytes, const StreamedTexture* requester);
+            uint64_t ResidentBytes(const StreamedTexture& texture) const;
+
+            IRenderDevice* m_device;
+            Core::StreamingLoader& m_loader;
+            TextureStreamingConfig m_config;
+            uint64_t m_budget = 0;
+
+            // 主线程访问; Load 可在其他线程调用, 因此由 m_mutex 保护
+            mutable std::mutex m_mutex;
+            std::vector<TexturePtr> m_textures;
+
+            uint64_t m_frame = 0;
+            uint64_t m_residentBytes = 0;
+            uint64_t m_reservedBytes = 0;
+            uint64_t m_upgradedCount = 0;
+            uint64_t m_evictedMips = 0;
+        };
+
+    } // namespace Graphic
+} // namespace PrismaEngine
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/ObjectPool.h"
 #include "interfaces/IBuffer.h"
 #include "interfaces/IResourceManager.h"
 #include <directx/d3dx12.h>
@@ -13,7 +14,7 @@ class DX12RenderDevice;
 
 /// @brief DirectX12缓冲区适配器
 /// 实现IBuffer接口，包装ID3D12Resource
-class DX12Buffer : public IBuffer {
+class DX12Buffer : public IBuffer, public Core::PooledObject<DX12Buffer, Core::MemoryTag::Render> {
 public:
     /// @brief 构造函数
     /// @param device DirectX12渲染设备
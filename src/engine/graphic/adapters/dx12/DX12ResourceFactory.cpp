@@ -835,6 +835,18 @@ D3D12_RESOURCE_DESC DX12ResourceFactory::GetD3D12TextureDesc(const TextureDesc&
         case TextureFormat::RGBA32_Float: dxgiFormat = DXGI_FORMAT_R32G32B32A32_FLOAT; break;
         case TextureFormat::D32_Float: dxgiFormat = DXGI_FORMAT_D32_FLOAT; break;
         case TextureFormat::D24_UNorm_S8_UInt: dxgiFormat = DXGI_FORMAT_D24_UNORM_S8_UINT; break;
+        case TextureFormat::BC1_UNorm: dxgiFormat = DXGI_FORMAT_BC1_UNORM; break;
+        case TextureFormat::BC1_SRGB: dxgiFormat = DXGI_FORMAT_BC1_UNORM_SRGB; break;
+        case TextureFormat::BC2_UNorm: dxgiFormat = DXGI_FORMAT_BC2_UNORM; break;
+        case TextureFormat::BC2_SRGB: dxgiFormat = DXGI_FORMAT_BC2_UNORM_SRGB; break;
+        case TextureFormat::BC3_UNorm: dxgiFormat = DXGI_FORMAT_BC3_UNORM; break;
+        case TextureFormat::BC3_SRGB: dxgiFormat = DXGI_FORMAT_BC3_UNORM_SRGB; break;
+        case TextureFormat::BC4_UNorm: dxgiFormat = DXGI_FORMAT_BC4_UNORM; break;
+        case TextureFormat::BC4_SNorm: dxgiFormat = DXGI_FORMAT_BC4_SNORM; break;
+        case TextureFormat::BC5_UNorm: dxgiFormat = DXGI_FORMAT_BC5_UNORM; break;
+        case TextureFormat::BC5_SNorm: dxgiFormat = DXGI_FORMAT_BC5_SNORM; break;
+        case TextureFormat::BC7_UNorm: dxgiFormat = DXGI_FORMAT_BC7_UNORM; break;
+        case TextureFormat::BC7_SRGB: dxgiFormat = DXGI_FORMAT_BC7_UNORM_SRGB; break;
         default: dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM; break;
     }
     d3d12Desc.Format = dxgiFormat;
@@ -1067,6 +1079,30 @@ DXGI_FORMAT DX12ResourceFactory::GetDXGIFormat(TextureFormat format) const {
             return DXGI_FORMAT_D24_UNORM_S8_UINT;
         case TextureFormat::D32_Float_S8_UInt:
             return DXGI_FORMAT_D32_FLOAT_S8X24_UINT;
+        case TextureFormat::BC1_UNorm:
+            return DXGI_FORMAT_BC1_UNORM;
+        case TextureFormat::BC1_SRGB:
+            return DXGI_FORMAT_BC1_UNORM_SRGB;
+        case TextureFormat::BC2_UNorm:
+            return DXGI_FORMAT_BC2_UNORM;
+        case TextureFormat::BC2_SRGB:
+            return DXGI_FORMAT_BC2_UNORM_SRGB;
+        case TextureFormat::BC3_UNorm:
+            return DXGI_FORMAT_BC3_UNORM;
+        case TextureFormat::BC3_SRGB:
+            return DXGI_FORMAT_BC3_UNORM_SRGB;
+        case TextureFormat::BC4_UNorm:
+            return DXGI_FORMAT_BC4_UNORM;
+        case TextureFormat::BC4_SNorm:
+            return DXGI_FORMAT_BC4_SNORM;
+        case TextureFormat::BC5_UNorm:
+            return DXGI_FORMAT_BC5_UNORM;
+        case TextureFormat::BC5_SNorm:
+            return DXGI_FORMAT_BC5_SNORM;
+        case TextureFormat::BC7_UNorm:
+            return DXGI_FORMAT_BC7_UNORM;
+        case TextureFormat::BC7_SRGB:
+            return DXGI_FORMAT_BC7_UNORM_SRGB;
         default:
             return DXGI_FORMAT_UNKNOWN;
     }
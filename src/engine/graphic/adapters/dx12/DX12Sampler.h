@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/ObjectPool.h"
 #include "interfaces/ISampler.h"
 #include <directx/d3dx12.h>
 #include <d3d12.h>
@@ -11,7 +12,7 @@ class DX12RenderDevice;
 
 /// @brief DirectX12采样器适配器
 /// 实现ISampler接口，包装采样器描述符
-class DX12Sampler : public ISampler {
+class DX12Sampler : public ISampler, public Core::PooledObject<DX12Sampler, Core::MemoryTag::Render> {
 public:
     /// @brief 构造函数
     /// @param device DirectX12渲染设备
@@ -487,6 +487,18 @@ DXGI_FORMAT DX12Texture::GetDXGIFormat() const {
         case TextureFormat::D32_Float: return DXGI_FORMAT_D32_FLOAT;
         case TextureFormat::D24_UNorm_S8_UInt: return DXGI_FORMAT_D24_UNORM_S8_UINT;
         case TextureFormat::D32_Float_S8_UInt: return DXGI_FORMAT_D32_FLOAT_S8X24_UINT;
+        case TextureFormat::BC1_UNorm: return DXGI_FORMAT_BC1_UNORM;
+        case TextureFormat::BC1_SRGB: return DXGI_FORMAT_BC1_UNORM_SRGB;
+        case TextureFormat::BC2_UNorm: return DXGI_FORMAT_BC2_UNORM;
+        case TextureFormat::BC2_SRGB: return DXGI_FORMAT_BC2_UNORM_SRGB;
+        case TextureFormat::BC3_UNorm: return DXGI_FORMAT_BC3_UNORM;
+        case TextureFormat::BC3_SRGB: return DXGI_FORMAT_BC3_UNORM_SRGB;
+        case TextureFormat::BC4_UNorm: return DXGI_FORMAT_BC4_UNORM;
+        case TextureFormat::BC4_SNorm: return DXGI_FORMAT_BC4_SNORM;
+        case TextureFormat::BC5_UNorm: return DXGI_FORMAT_BC5_UNORM;
+        case TextureFormat::BC5_SNorm: return DXGI_FORMAT_BC5_SNORM;
+        case TextureFormat::BC7_UNorm: return DXGI_FORMAT_BC7_UNORM;
+        case TextureFormat::BC7_SRGB: return DXGI_FORMAT_BC7_UNORM_SRGB;
         default: return DXGI_FORMAT_UNKNOWN;
     }
 }
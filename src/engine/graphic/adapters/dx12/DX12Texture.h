@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include "core/ObjectPool.h"
 #include "interfaces/ITexture.h"
 #include <directx/d3dx12.h>
 
@@ -12,7 +13,7 @@ class DX12RenderDevice;
 
 /// @brief DirectX12纹理适配器
 /// 实现ITexture接口，包装ID3D12Resource
-class DX12Texture : public ITexture //,public ID3D12Resource
+class DX12Texture : public ITexture, public Core::PooledObject<DX12Texture, Core::MemoryTag::Render> //,public ID3D12Resource
 {
 public:
     /// @brief 构造函数
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "math/MathTypes.h"
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -48,6 +49,18 @@ struct Vertex {
     constexpr static uint32_t GetVertexStride() { return sizeof(Vertex); }
 };
 
+// 压缩顶点 (28 字节, Vertex 为 96 字节), 由 MeshOptimizer::Quantize 生成
+// 位置 RGB32_Float, UV RG16_Float, 法线八面体编码 RG16_SNorm, 切线 RGBA8_SNorm (w 为手性), 颜色 RGBA8_UNorm
+struct QuantizedVertex {
+    float position[3];
+    uint16_t uv[2];
+    int16_t normal[2];
+    int8_t tangent[4];
+    uint8_t color[4];
+    constexpr static uint32_t GetVertexStride() { return sizeof(QuantizedVertex); }
+};
+static_assert(sizeof(QuantizedVertex) == 28, "QuantizedVertex layout must stay packed");
+
 
 // 简单的包围盒结构
 struct BoundingBox {
@@ -90,6 +103,23 @@ struct BoundingBox {
     }
 };
 
+// LOD 选择使用的视图参数, 由渲染管线按视图每帧更新
+struct LodView {
+    PrismaMath::vec3 cameraPosition = PrismaMath::vec3(0.0f);
+    float projectionScale = 0.0f;  // 视口高度 / (2 * tan(fovY / 2)), 为 0 时总是使用 LOD0
+
+    // fovY 为弧度; 视口高度或视角无效时返回只使用 LOD0 的视图
+    static LodView FromCamera(const PrismaMath::vec3& position, float fovY, uint32_t viewportHeight) {
+        LodView view;
+        view.cameraPosition = position;
+        const float halfTan = std::tan(fovY * 0.5f);
+        if (viewportHeight > 0 && halfTan > 0.0f) {
+            view.projectionScale = static_cast<float>(viewportHeight) / (2.0f * halfTan);
+        }
+        return view;
+    }
+};
+
 // 资源ID类型
 using ResourceId = uint64_t;
 
@@ -224,8 +254,112 @@ enum class TextureFormat {
     BC5_SNorm,      // BC5 SNorm
     BC7_UNorm,      // BC7
     BC7_SRGB,       // BC7 sRGB
+    ETC2_RGB8_UNorm,    // ETC2 RGB (兼容 ETC1)
+    ETC2_RGB8_SRGB,     // ETC2 RGB sRGB
+    ETC2_RGBA8_UNorm,   // ETC2 RGB + EAC Alpha
+    ETC2_RGBA8_SRGB,    // ETC2 RGB + EAC Alpha sRGB
+    ASTC_4x4_UNorm,     // ASTC 4x4
+    ASTC_4x4_SRGB,      // ASTC 4x4 sRGB
+};
+
+// 纹理格式的块信息, 非压缩格式的块大小为 1x1
+struct TextureFormatBlockInfo {
+    uint32_t blockWidth  = 1;
+    uint32_t blockHeight = 1;
+    uint32_t bytesPerBlock = 0;  // 0 表示格式未知
 };
 
+inline TextureFormatBlockInfo GetTextureFormatBlockInfo(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8_UNorm:
+        case TextureFormat::R8_SNorm:
+        case TextureFormat::R8_UInt:
+        case TextureFormat::R8_SInt:
+            return {1, 1, 1};
+        case TextureFormat::RG8_UNorm:
+        case TextureFormat::RG8_SNorm:
+        case TextureFormat::R16_UNorm:
+        case TextureFormat::R16_SNorm:
+        case TextureFormat::R16_Float:
+        case TextureFormat::R16_UInt:
+        case TextureFormat::R16_SInt:
+        case TextureFormat::D16_UNorm:
+            return {1, 1, 2};
+        case TextureFormat::RGB8_UNorm:
+            return {1, 1, 3};
+        case TextureFormat::RG16_UNorm:
+        case TextureFormat::RG16_SNorm:
+        case TextureFormat::RG16_Float:
+        case TextureFormat::RG16_UInt:
+        case TextureFormat::RG16_SInt:
+        case TextureFormat::R32_Float:
+        case TextureFormat::R32_UInt:
+        case TextureFormat::R32_SInt:
+        case TextureFormat::RGBA8_UNorm:
+        case TextureFormat::RGBA8_UNorm_sRGB:
+        case TextureFormat::RGBA8_SNorm:
+        case TextureFormat::RGBA8_UInt:
+        case TextureFormat::RGBA8_SInt:
+        case TextureFormat::BGRA8_UNorm:
+        case TextureFormat::BGRA8_UNorm_sRGB:
+        case TextureFormat::D24_UNorm_S8_UInt:
+        case TextureFormat::D32_Float:
+            return {1, 1, 4};
+        case TextureFormat::RGBA16_UNorm:
+        case TextureFormat::RGBA16_SNorm:
+        case TextureFormat::RGBA16_Float:
+        case TextureFormat::RGBA16_UInt:
+        case TextureFormat::RGBA16_SInt:
+        case TextureFormat::RG32_Float:
+        case TextureFormat::RG32_UInt:
+        case TextureFormat::RG32_SInt:
+        case TextureFormat::D32_Float_S8_UInt:
+            return {1, 1, 8};
+        case TextureFormat::RGB32_Float:
+        case TextureFormat::RGB32_UInt:
+        case TextureFormat::RGB32_SInt:
+            return {1, 1, 12};
+        case TextureFormat::RGBA32_Float:
+        case TextureFormat::RGBA32_UInt:
+        case TextureFormat::RGBA32_SInt:
+            return {1, 1, 16};
+        case TextureFormat::BC1_UNorm:
+        case TextureFormat::BC1_SRGB:
+        case TextureFormat::BC4_UNorm:
+        case TextureFormat::BC4_SNorm:
+        case TextureFormat::ETC2_RGB8_UNorm:
+        case TextureFormat::ETC2_RGB8_SRGB:
+            return {4, 4, 8};
+        case TextureFormat::BC2_UNorm:
+        case TextureFormat::BC2_SRGB:
+        case TextureFormat::BC3_UNorm:
+        case TextureFormat::BC3_SRGB:
+        case TextureFormat::BC5_UNorm:
+        case TextureFormat::BC5_SNorm:
+        case TextureFormat::BC7_UNorm:
+        case TextureFormat::BC7_SRGB:
+        case TextureFormat::ETC2_RGBA8_UNorm:
+        case TextureFormat::ETC2_RGBA8_SRGB:
+        case TextureFormat::ASTC_4x4_UNorm:
+        case TextureFormat::ASTC_4x4_SRGB:
+            return {4, 4, 16};
+        default:
+            return {};
+    }
+}
+
+inline bool IsCompressedFormat(TextureFormat format) {
+    return GetTextureFormatBlockInfo(format).blockWidth > 1;
+}
+
+// 单个 MIP 级别的字节数 (按块对齐)
+inline uint64_t ComputeTextureLevelSize(TextureFormat format, uint64_t width, uint64_t height) {
+    TextureFormatBlockInfo info = GetTextureFormatBlockInfo(format);
+    uint64_t blocksX = (width + info.blockWidth - 1) / info.blockWidth;
+    uint64_t blocksY = (height + info.blockHeight - 1) / info.blockHeight;
+    return blocksX * blocksY * info.bytesPerBlock;
+}
+
 // 着色器类型
 enum class ShaderType {
     Vertex,
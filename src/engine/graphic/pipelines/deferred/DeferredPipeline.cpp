@@ -136,17 +136,21 @@ void DeferredPipeline::UpdatePassesCameraData(PrismaEngine::Graphic::ICamera* ca
     // 从相机接口获取视图和投影矩阵
     PrismaMath::mat4 view       = camera->GetViewMatrix();
     PrismaMath::mat4 projection = camera->GetProjectionMatrix();
+    // LOD 选择随视口与视角每帧更新
+    LodView lodView = LodView::FromCamera(camera->GetPosition(), camera->GetFOV(), GetHeight());
 
     // 更新几何通道
     if (m_geometryPass) {
         m_geometryPass->SetViewMatrix(view);
         m_geometryPass->SetProjectionMatrix(projection);
+        m_geometryPass->SetLodView(lodView);
     }
 
     // 更新透明物体通道
     if (m_transparentPass) {
         m_transparentPass->SetViewMatrix(view);
         m_transparentPass->SetProjectionMatrix(projection);
+        m_transparentPass->SetLodView(lodView);
     }
 
     // 天空盒需要特殊的视图矩阵（移除平移部分）
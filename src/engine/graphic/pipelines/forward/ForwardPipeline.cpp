@@ -210,18 +210,23 @@ void ForwardPipeline::UpdatePassesCameraData(PrismaEngine::Graphic::ICamera* cam
 
     PrismaMath::mat4 view = camera->GetViewMatrix();
     PrismaMath::mat4 projection = camera->GetProjectionMatrix();
+    // LOD 选择随视口与视角每帧更新
+    LodView lodView = LodView::FromCamera(camera->GetPosition(), camera->GetFOV(), GetHeight());
 
     if (m_depthPrePass) {
         m_depthPrePass->SetViewMatrix(view);
         m_depthPrePass->SetProjectionMatrix(projection);
+        m_depthPrePass->SetLodView(lodView);
     }
     if (m_opaquePass) {
         m_opaquePass->SetViewMatrix(view);
         m_opaquePass->SetProjectionMatrix(projection);
+        m_opaquePass->SetLodView(lodView);
     }
     if (m_transparentPass) {
         m_transparentPass->SetViewMatrix(view);
         m_transparentPass->SetProjectionMatrix(projection);
+        m_transparentPass->SetLodView(lodView);
     }
     if (m_skyboxPass) {
         PrismaMath::mat4 skyboxView = view;
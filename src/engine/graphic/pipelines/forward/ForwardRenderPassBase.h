@@ -42,12 +42,19 @@ public:
     /// @brief 获取视图投影矩阵
     const PrismaMath::mat4& GetViewProjectionMatrix() const { return m_viewProjection; }
 
+    /// @brief 设置 LOD 选择使用的视图
+    void SetLodView(const LodView& lodView) { m_lodView = lodView; }
+
+    /// @brief 获取 LOD 选择使用的视图
+    const LodView& GetLodView() const { return m_lodView; }
+
 protected:
     void UpdateViewProjection() { m_viewProjection = m_projection * m_view; }
 
     PrismaMath::mat4 m_view;
     PrismaMath::mat4 m_projection;
     PrismaMath::mat4 m_viewProjection;
+    LodView m_lodView;
 };
 }
 
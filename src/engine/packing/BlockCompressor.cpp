@@ -0,0 +1,549 @@
+#include "BlockCompressor.h"
+#include "../JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace PrismaEngine {
+namespace Packing {
+
+using Graphic::TextureFormat;
+
+namespace {
+
+constexpr int PixelCount = 16;
+
+int Clamp255(int value) {
+    return std::clamp(value, 0, 255);
+}
+
+int Square(int value) {
+    return value * value;
+}
+
+// ========== BC1 颜色块 ==========
+
+uint16_t PackRGB565(float r, float g, float b) {
+    int r5 = std::clamp(static_cast<int>(r * 31.0f / 255.0f + 0.5f), 0, 31);
+    int g6 = std::clamp(static_cast<int>(g * 63.0f / 255.0f + 0.5f), 0, 63);
+    int b5 = std::clamp(static_cast<int>(b * 31.0f / 255.0f + 0.5f), 0, 31);
+    return static_cast<uint16_t>((r5 << 11) | (g6 << 5) | b5);
+}
+
+void UnpackRGB565(uint16_t color, int out[3]) {
+    int r5 = (color >> 11) & 31;
+    int g6 = (color >> 5) & 63;
+    int b5 = color & 31;
+    out[0] = (r5 << 3) | (r5 >> 2);
+    out[1] = (g6 << 2) | (g6 >> 4);
+    out[2] = (b5 << 3) | (b5 >> 2);
+}
+
+// 四色模式调色板: c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+void BuildPalette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+}
+
+int SelectColorIndices(const uint8_t* rgba, uint16_t c0, uint16_t c1, uint8_t indices[PixelCount]) {
+    int palette[4][3];
+    BuildPalette(c0, c1, palette);
+
+    int total = 0;
+    for (int i = 0; i < PixelCount; ++i) {
+        const uint8_t* p = rgba + i * 4;
+        int bestError = std::numeric_limits<int>::max();
+        for (int j = 0; j < 4; ++j) {
+            int error = Square(p[0] - palette[j][0]) + Square(p[1] - palette[j][1]) + Square(p[2] - palette[j][2]);
+            if (error < bestError) {
+                bestError  = error;
+                indices[i] = static_cast<uint8_t>(j);
+            }
+        }
+        total += bestError;
+    }
+    return total;
+}
+
+/**
+ * @brief 已知索引时用最小二乘求解端点
+ */
+bool RefineEndpoints(const uint8_t* rgba, const uint8_t indices[PixelCount], uint16_t& c0, uint16_t& c1) {
+    static constexpr float Weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[3] = {}, bx[3] = {};
+    for (int i = 0; i < PixelCount; ++i) {
+        float a = Weights[indices[i]];
+        float b = 1.0f - a;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < 3; ++c) {
+            ax[c] += a * rgba[i * 4 + c];
+            bx[c] += b * rgba[i * 4 + c];
+        }
+    }
+
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+
+    float e0[3], e1[3];
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.0f, 255.0f);
+        e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.0f, 255.0f);
+    }
+    c0 = PackRGB565(e0[0], e0[1], e0[2]);
+    c1 = PackRGB565(e1[0], e1[1], e1[2]);
+    return true;
+}
+
+/**
+ * @brief 颜色块编码 (BC1/BC3 共用), 始终使用四色模式
+ */
+void EncodeColorBlock(const uint8_t* rgba, uint8_t* out) {
+    // 主轴: 协方差矩阵的幂迭代
+    float mean[3] = {};
+    for (int i = 0; i < PixelCount; ++i) {
+        for (int c = 0; c < 3; ++c) mean[c] += rgba[i * 4 + c];
+    }
+    for (float& m : mean) m /= PixelCount;
+
+    float cov[6] = {};
+    for (int i = 0; i < PixelCount; ++i) {
+        float r = rgba[i * 4 + 0] - mean[0];
+        float g = rgba[i * 4 + 1] - mean[1];
+        float b = rgba[i * 4 + 2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float length = std::max({ std::fabs(x), std::fabs(y), std::fabs(z) });
+        if (length < 1e-6f) break;
+        axis[0] = x / length;
+        axis[1] = y / length;
+        axis[2] = z / length;
+    }
+
+    float minT = std::numeric_limits<float>::max();
+    float maxT = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < PixelCount; ++i) {
+        float t = (rgba[i * 4 + 0] - mean[0]) * axis[0] +
+                  (rgba[i * 4 + 1] - mean[1]) * axis[1] +
+                  (rgba[i * 4 + 2] - mean[2]) * axis[2];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+
+    float lengthSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    minT /= lengthSq;
+    maxT /= lengthSq;
+    uint16_t c0 = PackRGB565(std::clamp(mean[0] + maxT * axis[0], 0.0f, 255.0f),
+                             std::clamp(mean[1] + maxT * axis[1], 0.0f, 255.0f),
+                             std::clamp(mean[2] + maxT * axis[2], 0.0f, 255.0f));
+    uint16_t c1 = PackRGB565(std::clamp(mean[0] + minT * axis[0], 0.0f, 255.0f),
+                             std::clamp(mean[1] + minT * axis[1], 0.0f, 255.0f),
+                             std::clamp(mean[2] + minT * axis[2], 0.0f, 255.0f));
+
+    uint8_t indices[PixelCount];
+    int bestError = SelectColorIndices(rgba, c0, c1, indices);
+
+    // 端点精化
+    for (int iteration = 0; iteration < 2 && bestError > 0; ++iteration) {
+        uint16_t r0 = c0, r1 = c1;
+        if (!RefineEndpoints(rgba, indices, r0, r1)) break;
+
+        uint8_t refined[PixelCount];
+        int error = SelectColorIndices(rgba, r0, r1, refined);
+        if (error >= bestError) break;
+        bestError = error;
+        c0 = r0;
+        c1 = r1;
+        std::memcpy(indices, refined, sizeof(indices));
+    }
+
+    // c0 > c1 时为四色模式; 相等时所有像素使用 c0
+    if (c0 < c1) {
+        std::swap(c0, c1);
+        for (uint8_t& index : indices) index ^= 1;
+    } else if (c0 == c1) {
+        std::memset(indices, 0, sizeof(indices));
+    }
+
+    uint32_t bits = 0;
+    for (int i = 0; i < PixelCount; ++i) {
+        bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+    }
+    out[0] = static_cast<uint8_t>(c0);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    for (int i = 0; i < 4; ++i) out[4 + i] = static_cast<uint8_t>(bits >> (i * 8));
+}
+
+// ========== BC3 Alpha 块 ==========
+
+void EncodeBC3Alpha(const uint8_t* rgba, uint8_t* out) {
+    int minA = 255, maxA = 0;
+    for (int i = 0; i < PixelCount; ++i) {
+        minA = std::min<int>(minA, rgba[i * 4 + 3]);
+        maxA = std::max<int>(maxA, rgba[i * 4 + 3]);
+    }
+
+    out[0] = static_cast<uint8_t>(maxA);
+    out[1] = static_cast<uint8_t>(minA);
+    uint64_t bits = 0;
+
+    if (maxA > minA) {
+        // 八值模式: a0 > a1
+        int palette[8];
+        palette[0] = maxA;
+        palette[1] = minA;
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * maxA + (i - 1) * minA) / 7;
+        }
+        for (int i = 0; i < PixelCount; ++i) {
+            int alpha = rgba[i * 4 + 3];
+            int best = 0;
+            for (int j = 1; j < 8; ++j) {
+                if (std::abs(palette[j] - alpha) < std::abs(palette[best] - alpha)) best = j;
+            }
+            bits |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+}
+
+// ========== ETC1/ETC2 颜色块 ==========
+
+constexpr int EtcModifiers[8][2] = {
+    { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+};
+
+// 像素索引 0..3 对应的修正值: +a, +b, -a, -b
+int EtcModifier(int table, int selector) {
+    int value = EtcModifiers[table][selector & 1];
+    return selector & 2 ? -value : value;
+}
+
+struct EtcSubBlock {
+    int pixels[8];  // 行优先像素序号
+};
+
+/**
+ * @brief 为子块选择最佳修正表和像素索引
+ */
+int EncodeEtcSubBlock(const uint8_t* rgba, const EtcSubBlock& sub, const int base[3],
+                      int& bestTable, uint8_t selectors[PixelCount]) {
+    int bestError = std::numeric_limits<int>::max();
+    uint8_t candidate[8];
+
+    for (int table = 0; table < 8; ++table) {
+        int error = 0;
+        for (int i = 0; i < 8 && error < bestError; ++i) {
+            const uint8_t* p = rgba + sub.pixels[i] * 4;
+            int pixelBest = std::numeric_limits<int>::max();
+            for (int selector = 0; selector < 4; ++selector) {
+                int modifier = EtcModifier(table, selector);
+                int e = Square(Clamp255(base[0] + modifier) - p[0]) +
+                        Square(Clamp255(base[1] + modifier) - p[1]) +
+                        Square(Clamp255(base[2] + modifier) - p[2]);
+                if (e < pixelBest) {
+                    pixelBest    = e;
+                    candidate[i] = static_cast<uint8_t>(selector);
+                }
+            }
+            error += pixelBest;
+        }
+        if (error < bestError) {
+            bestError = error;
+            bestTable = table;
+            for (int i = 0; i < 8; ++i) selectors[sub.pixels[i]] = candidate[i];
+        }
+    }
+    return bestError;
+}
+
+struct EtcBlock {
+    bool differential = false;
+    bool flip         = false;
+    int codes[2][3]   = {};   // 个别模式为 4 位颜色; 差分模式为 5 位基色和 3 位差值
+    int tables[2]     = {};
+    uint8_t selectors[PixelCount] = {};
+    int error = std::numeric_limits<int>::max();
+};
+
+void PackEtcBlock(const EtcBlock& block, uint8_t* out) {
+    uint64_t bits = 0;
+    for (int c = 0; c < 3; ++c) {
+        int shift = 56 - c * 8;
+        if (block.differential) {
+            bits |= static_cast<uint64_t>(block.codes[0][c] & 31) << (shift + 3);
+            bits |= static_cast<uint64_t>(block.codes[1][c] & 7) << shift;
+        } else {
+            bits |= static_cast<uint64_t>(block.codes[0][c] & 15) << (shift + 4);
+            bits |= static_cast<uint64_t>(block.codes[1][c] & 15) << shift;
+        }
+    }
+    bits |= static_cast<uint64_t>(block.tables[0]) << 37;
+    bits |= static_cast<uint64_t>(block.tables[1]) << 34;
+    bits |= static_cast<uint64_t>(block.differential ? 1 : 0) << 33;
+    bits |= static_cast<uint64_t>(block.flip ? 1 : 0) << 32;
+
+    // 像素按列优先编号, 高位和低位分开存放
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            int selector = block.selectors[y * 4 + x];
+            int k = x * 4 + y;
+            bits |= static_cast<uint64_t>(selector >> 1) << (16 + k);
+            bits |= static_cast<uint64_t>(selector & 1) << k;
+        }
+    }
+    for (int i = 0; i < 8; ++i) out[i] = static_cast<uint8_t>(bits >> (56 - i * 8));
+}
+
+void EncodeEtcColorBlock(const uint8_t* rgba, uint8_t* out) {
+    EtcBlock best;
+
+    for (int flip = 0; flip < 2; ++flip) {
+        EtcSubBlock subs[2];
+        int counts[2] = {};
+        float average[2][3] = {};
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                int s = flip ? (y >= 2) : (x >= 2);
+                int k = y * 4 + x;
+                subs[s].pixels[counts[s]++] = k;
+                for (int c = 0; c < 3; ++c) average[s][c] += rgba[k * 4 + c];
+            }
+        }
+        for (auto& avg : average) {
+            for (float& value : avg) value /= 8.0f;
+        }
+
+        // 个别模式: 两个子块各用 4 位颜色
+        {
+            EtcBlock block;
+            block.flip  = flip != 0;
+            block.error = 0;
+            for (int s = 0; s < 2; ++s) {
+                int base[3];
+                for (int c = 0; c < 3; ++c) {
+                    block.codes[s][c] = std::clamp(static_cast<int>(average[s][c] * 15.0f / 255.0f + 0.5f), 0, 15);
+                    base[c] = block.codes[s][c] * 17;
+                }
+                block.error += EncodeEtcSubBlock(rgba, subs[s], base, block.tables[s], block.selectors);
+            }
+            if (block.error < best.error) best = block;
+        }
+
+        // 差分模式: 5 位基色 + 3 位有符号差值 (范围 -4..3, 结果不越界, 保证与 ETC1 兼容)
+        {
+            EtcBlock block;
+            block.differential = true;
+            block.flip  = flip != 0;
+            block.error = 0;
+            int first[3], second[3];
+            for (int c = 0; c < 3; ++c) {
+                first[c]  = std::clamp(static_cast<int>(average[0][c] * 31.0f / 255.0f + 0.5f), 0, 31);
+                int other = std::clamp(static_cast<int>(average[1][c] * 31.0f / 255.0f + 0.5f), 0, 31);
+                int delta = std::clamp(other - first[c], -4, 3);
+                second[c] = first[c] + delta;
+                block.codes[0][c] = first[c];
+                block.codes[1][c] = delta;
+            }
+            for (int s = 0; s < 2; ++s) {
+                const int* code = s == 0 ? first : second;
+                int base[3];
+                for (int c = 0; c < 3; ++c) base[c] = (code[c] << 3) | (code[c] >> 2);
+                block.error += EncodeEtcSubBlock(rgba, subs[s], base, block.tables[s], block.selectors);
+            }
+            if (block.error < best.error) best = block;
+        }
+    }
+
+    PackEtcBlock(best, out);
+}
+
+// ========== EAC Alpha 块 ==========
+
+constexpr int EacModifiers[16][8] = {
+    { -3, -6, -9, -15, 2, 5, 8, 14 },
+    { -3, -7, -10, -13, 2, 6, 9, 12 },
+    { -2, -5, -8, -13, 1, 4, 7, 12 },
+    { -2, -4, -6, -13, 1, 3, 5, 12 },
+    { -3, -6, -8, -12, 2, 5, 7, 11 },
+    { -3, -7, -9, -11, 2, 6, 8, 10 },
+    { -4, -7, -8, -11, 3, 6, 7, 10 },
+    { -3, -5, -8, -11, 2, 4, 7, 10 },
+    { -2, -6, -8, -10, 1, 5, 7, 9 },
+    { -2, -5, -8, -10, 1, 4, 7, 9 },
+    { -2, -4, -8, -10, 1, 3, 7, 9 },
+    { -2, -5, -7, -10, 1, 4, 6, 9 },
+    { -3, -4, -7, -10, 2, 3, 6, 9 },
+    { -1, -2, -3, -10, 0, 1, 2, 9 },
+    { -4, -6, -8, -9, 3, 5, 7, 8 },
+    { -3, -5, -7, -9, 2, 4, 6, 8 },
+};
+
+int EvaluateEac(const uint8_t* rgba, int base, int multiplier, int table, uint8_t indices[PixelCount], int limit) {
+    int total = 0;
+    for (int i = 0; i < PixelCount && total < limit; ++i) {
+        int alpha = rgba[i * 4 + 3];
+        int pixelBest = std::numeric_limits<int>::max();
+        for (int j = 0; j < 8; ++j) {
+            int error = Square(Clamp255(base + EacModifiers[table][j] * multiplier) - alpha);
+            if (error < pixelBest) {
+                pixelBest  = error;
+                indices[i] = static_cast<uint8_t>(j);
+            }
+        }
+        total += pixelBest;
+    }
+    return total;
+}
+
+void EncodeEacAlpha(const uint8_t* rgba, uint8_t* out) {
+    int minA = 255, maxA = 0;
+    for (int i = 0; i < PixelCount; ++i) {
+        minA = std::min<int>(minA, rgba[i * 4 + 3]);
+        maxA = std::max<int>(maxA, rgba[i * 4 + 3]);
+    }
+
+    int bestBase = minA, bestMultiplier = 1, bestTable = 13;
+    uint8_t bestIndices[PixelCount];
+    std::fill(std::begin(bestIndices), std::end(bestIndices), static_cast<uint8_t>(4));  // 表 13 的 0 修正值
+
+    if (maxA > minA) {
+        int bestError = std::numeric_limits<int>::max();
+        uint8_t indices[PixelCount];
+        for (int table = 0; table < 16 && bestError > 0; ++table) {
+            int low  = EacModifiers[table][3];
+            int high = EacModifiers[table][7];
+            int ideal = (maxA - minA + (high - low) - 1) / (high - low);
+            for (int multiplier = std::max(1, ideal - 1); multiplier <= std::min(15, ideal + 1); ++multiplier) {
+                int center = static_cast<int>(std::lround((minA + maxA) * 0.5 - (low + high) * multiplier * 0.5));
+                for (int base = center - 1; base <= center + 1; ++base) {
+                    int clamped = Clamp255(base);
+                    int error = EvaluateEac(rgba, clamped, multiplier, table, indices, bestError);
+                    if (error < bestError) {
+                        bestError      = error;
+                        bestBase       = clamped;
+                        bestMultiplier = multiplier;
+                        bestTable      = table;
+                        std::memcpy(bestIndices, indices, sizeof(indices));
+                    }
+                }
+            }
+        }
+    }
+
+    // 像素按列优先编号, 每个 3 位, 从高位开始
+    uint64_t bits = 0;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            int k = x * 4 + y;
+            bits |= static_cast<uint64_t>(bestIndices[y * 4 + x]) << (45 - k * 3);
+        }
+    }
+    out[0] = static_cast<uint8_t>(bestBase);
+    out[1] = static_cast<uint8_t>((bestMultiplier << 4) | bestTable);
+    for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(bits >> (40 - i * 8));
+}
+
+} // namespace
+
+// ============================================================================
+// BlockCompressor 实现
+// ============================================================================
+
+void BlockCompressor::EncodeBC1(const uint8_t* rgba, uint8_t* out) {
+    EncodeColorBlock(rgba, out);
+}
+
+void BlockCompressor::EncodeBC3(const uint8_t* rgba, uint8_t* out) {
+    EncodeBC3Alpha(rgba, out);
+    EncodeColorBlock(rgba, out + 8);
+}
+
+void BlockCompressor::EncodeETC2RGB(const uint8_t* rgba, uint8_t* out) {
+    EncodeEtcColorBlock(rgba, out);
+}
+
+void BlockCompressor::EncodeETC2RGBA(const uint8_t* rgba, uint8_t* out) {
+    EncodeEacAlpha(rgba, out);
+    EncodeEtcColorBlock(rgba, out + 8);
+}
+
+bool BlockCompressor::IsSupported(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1_UNorm:
+        case TextureFormat::BC1_SRGB:
+        case TextureFormat::BC3_UNorm:
+        case TextureFormat::BC3_SRGB:
+        case TextureFormat::ETC2_RGB8_UNorm:
+        case TextureFormat::ETC2_RGB8_SRGB:
+        case TextureFormat::ETC2_RGBA8_UNorm:
+        case TextureFormat::ETC2_RGBA8_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool BlockCompressor::Compress(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height,
+                               std::vector<uint8_t>& out, bool parallel) {
+    void (*encode)(const uint8_t*, uint8_t*) = nullptr;
+    switch (format) {
+        case TextureFormat::BC1_UNorm:
+        case TextureFormat::BC1_SRGB:         encode = &EncodeBC1; break;
+        case TextureFormat::BC3_UNorm:
+        case TextureFormat::BC3_SRGB:         encode = &EncodeBC3; break;
+        case TextureFormat::ETC2_RGB8_UNorm:
+        case TextureFormat::ETC2_RGB8_SRGB:   encode = &EncodeETC2RGB; break;
+        case TextureFormat::ETC2_RGBA8_UNorm:
+        case TextureFormat::ETC2_RGBA8_SRGB:  encode = &EncodeETC2RGBA; break;
+        default:
+            return false;
+    }
+    if (!rgba || width == 0 || height == 0) return false;
+
+    const uint32_t bytesPerBlock = Graphic::GetTextureFormatBlockInfo(format).bytesPerBlock;
+    const uint32_t blocksX = (width + BlockSize - 1) / BlockSize;
+    const uint32_t blocksY = (height + BlockSize - 1) / BlockSize;
+    out.resize(static_cast<size_t>(blocksX) * blocksY * bytesPerBlock);
+
+    auto encodeRow = [&](size_t by) {
+        uint8_t block[PixelCount * 4];
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            for (uint32_t y = 0; y < BlockSize; ++y) {
+                uint32_t sy = std::min(static_cast<uint32_t>(by) * BlockSize + y, height - 1);
+                for (uint32_t x = 0; x < BlockSize; ++x) {
+                    uint32_t sx = std::min(bx * BlockSize + x, width - 1);
+                    std::memcpy(&block[(y * BlockSize + x) * 4], &rgba[(static_cast<size_t>(sy) * width + sx) * 4], 4);
+                }
+            }
+            encode(block, &out[(by * blocksX + bx) * bytesPerBlock]);
+        }
+    };
+
+    if (parallel && blocksY > 1) {
+        JobSystem::GetInstance().ParallelFor(blocksY, encodeRow);
+    } else {
+        for (uint32_t by = 0; by < blocksY; ++by) encodeRow(by);
+    }
+    return true;
+}
+
+} // namespace Packing
+} // namespace PrismaEngine
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "graphic/interfaces/RenderTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Packing {
+
+/**
+ * @brief GPU 块压缩格式编码器 (离线烘焙用)
+ *
+ * 每个块为 4x4 像素, 输入为行优先的 RGBA8:
+ *   - BC1:  8 字节, 不透明纹理 (桌面)
+ *   - BC3:  16 字节, BC4 风格的 Alpha + BC1 颜色 (桌面)
+ *   - ETC2 RGB:  8 字节, 只使用与 ETC1 兼容的模式 (移动端)
+ *   - ETC2 RGBA: 16 字节, EAC Alpha + ETC2 RGB (移动端)
+ */
+class BlockCompressor {
+public:
+    static constexpr uint32_t BlockSize = 4;
+
+    static void EncodeBC1(const uint8_t* rgba, uint8_t* out);
+    static void EncodeBC3(const uint8_t* rgba, uint8_t* out);
+    static void EncodeETC2RGB(const uint8_t* rgba, uint8_t* out);
+    static void EncodeETC2RGBA(const uint8_t* rgba, uint8_t* out);
+
+    static bool IsSupported(Graphic::TextureFormat format);
+
+    /**
+     * @brief 压缩整张图像, 不足 4 像素的边缘块重复边缘像素
+     * @param parallel 是否按块行并行 (使用 JobSystem)
+     * @return 不支持的格式返回 false
+     */
+    static bool Compress(Graphic::TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height,
+                         std::vector<uint8_t>& out, bool parallel = true);
+};
+
+} // namespace Packing
+} // namespace PrismaEngine
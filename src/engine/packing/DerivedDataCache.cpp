@@ -0,0 +1,120 @@
+#include "DerivedDataCache.h"
+#include "../core/Hash64.h"
+#include "../core/MappedFile.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace PrismaEngine {
+namespace Packing {
+
+namespace {
+
+constexpr uint32_t EntryMagic   = 0x43444450; // 'PDDC'
+constexpr uint32_t EntryVersion = 1;
+
+// 条目文件头
+struct EntryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t size;
+    uint64_t contentHash;
+};
+
+} // namespace
+
+uint64_t DerivedDataCache::MakeKey(std::string_view generator, uint32_t version,
+                                   const void* params, size_t paramsSize,
+                                   const uint8_t* source, size_t sourceSize) {
+    uint64_t seed = Core::Hash64::Hash(generator.data(), generator.size(), version);
+    seed = Core::Hash64::Hash(params, paramsSize, seed);
+    return Core::Hash64::Hash(source, sourceSize, seed);
+}
+
+std::filesystem::path DerivedDataCache::GetPath(uint64_t key) const {
+    // 按键的最高字节分目录, 避免单个目录中文件过多
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return m_root / std::string(name, 2) / (std::string(name) + ".ddc");
+}
+
+bool DerivedDataCache::Get(uint64_t key, std::vector<uint8_t>& data) {
+    // 未命中是常态, 先检查文件是否存在, 避免 MappedFile 报错
+    const std::filesystem::path path = GetPath(key);
+    std::error_code ec;
+    Core::MappedFile file;
+    if (!std::filesystem::is_regular_file(path, ec) ||
+        !file.Open(path, Core::MappedFile::AccessPattern::Sequential) || file.Size() < sizeof(EntryHeader)) {
+        ++m_misses;
+        return false;
+    }
+
+    EntryHeader header;
+    std::memcpy(&header, file.Data(), sizeof(header));
+    const uint8_t* payload = file.Data() + sizeof(header);
+    if (header.magic != EntryMagic || header.version != EntryVersion || header.key != key ||
+        header.size != file.Size() - sizeof(header) ||
+        Core::Hash64::Hash(payload, static_cast<size_t>(header.size)) != header.contentHash) {
+        ++m_misses;
+        return false;
+    }
+
+    data.assign(payload, payload + header.size);
+    ++m_hits;
+    return true;
+}
+
+bool DerivedDataCache::Put(uint64_t key, const void* data, size_t size) {
+    std::filesystem::path path = GetPath(key);
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // 临时文件名包含线程标识, 同一条目的并发写入互不干扰
+    static std::atomic<uint64_t> s_counter{0};
+    std::filesystem::path tempPath = path;
+    tempPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "." +
+                std::to_string(s_counter++) + ".tmp";
+
+    EntryHeader header{};
+    header.magic       = EntryMagic;
+    header.version     = EntryVersion;
+    header.key         = key;
+    header.size        = size;
+    header.contentHash = Core::Hash64::Hash(data, size);
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    ++m_writes;
+    return true;
+}
+
+DerivedDataCache::Stats DerivedDataCache::GetStats() const {
+    Stats stats;
+    stats.hits   = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.writes = m_writes.load();
+    return stats;
+}
+
+} // namespace Packing
+} // namespace PrismaEngine
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Packing {
+
+/**
+ * @brief 派生数据缓存 (DDC)
+ *
+ * 以 "输入内容 + 生成器版本 + 生成参数" 的哈希为键保存烘焙结果,
+ * 输入未变化的资源直接复用缓存而不必重新烘焙。
+ * 每个条目是缓存目录下的一个文件, 带校验头, 损坏或截断的条目视为未命中。
+ * 写入先写临时文件再替换, 多个进程/线程可以共享同一缓存目录。
+ */
+class DerivedDataCache {
+public:
+    struct Stats {
+        uint64_t hits   = 0;
+        uint64_t misses = 0;
+        uint64_t writes = 0;
+    };
+
+    explicit DerivedDataCache(std::filesystem::path root) : m_root(std::move(root)) {}
+
+    const std::filesystem::path& GetRoot() const { return m_root; }
+
+    /**
+     * @brief 计算缓存键
+     * @param generator 生成器名称, 不同生成器的键互不冲突
+     * @param version 生成器版本, 算法变化时递增以使旧条目失效
+     * @param params 影响输出的参数 (不能包含未初始化的填充字节)
+     */
+    static uint64_t MakeKey(std::string_view generator, uint32_t version,
+                            const void* params, size_t paramsSize,
+                            const uint8_t* source, size_t sourceSize);
+
+    /**
+     * @brief 读取条目, 不存在或校验失败时返回 false
+     */
+    bool Get(uint64_t key, std::vector<uint8_t>& data);
+
+    /**
+     * @brief 写入条目 (已存在时覆盖)
+     */
+    bool Put(uint64_t key, const void* data, size_t size);
+
+    std::filesystem::path GetPath(uint64_t key) const;
+
+    Stats GetStats() const;
+
+private:
+    std::filesystem::path m_root;
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_writes{0};
+};
+
+} // namespace Packing
+} // namespace PrismaEngine
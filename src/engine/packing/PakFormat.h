@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../core/Hash64.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace PrismaEngine {
+namespace Packing {
+
+// ============================================================================
+// PAK 归档格式
+//
+// 文件布局:
+//   [PakHeader]                      64 字节
+//   [数据区]                         每个条目的数据按 PakAlignment 对齐
+//   [条目表]  PakEntry[entryCount]   按 pathHash 升序排列, 运行时二分查找
+//   [字符串表]                        条目的规范化路径 (UTF-8, 不以 0 结尾)
+//
+// 未压缩条目可直接在内存映射区上读取, 无需拷贝。
+// ============================================================================
+
+constexpr uint32_t PakMagic     = 0x4B415050;  // "PPAK"
+constexpr uint16_t PakVersion   = 1;
+constexpr uint64_t PakAlignment = 64;
+
+enum class PakCompression : uint8_t {
+    None = 0,
+    LZ4  = 1,
+    Zstd = 2
+};
+
+#pragma pack(push, 1)
+
+struct PakHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t entryCount;
+    uint32_t reserved0;
+    uint64_t entryTableOffset;
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+    uint64_t contentHash;      // 条目表和字符串表的哈希 (条目中包含各自内容的哈希)
+    uint64_t fileSize;
+    uint64_t reserved1;
+};
+
+struct PakEntry {
+    uint64_t pathHash;         // Hash64(规范化路径)
+    uint64_t offset;           // 数据在文件中的偏移 (PakAlignment 对齐)
+    uint64_t storedSize;       // 存储大小 (压缩后)
+    uint64_t size;             // 原始大小
+    uint64_t contentHash;      // Hash64(原始数据)
+    uint32_t nameOffset;       // 路径在字符串表中的偏移
+    uint16_t nameLength;
+    uint8_t compression;       // PakCompression
+    uint8_t reserved;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(PakHeader) == 64, "PakHeader must be 64 bytes");
+static_assert(sizeof(PakEntry) == 48, "PakEntry must be 48 bytes");
+
+inline uint64_t AlignPakOffset(uint64_t offset) {
+    return (offset + PakAlignment - 1) & ~(PakAlignment - 1);
+}
+
+/**
+ * @brief 规范化归档内路径: 统一使用 '/'，去掉开头的 "./" 和 '/'
+ */
+inline std::string NormalizePakPath(std::string_view path) {
+    std::string result;
+    result.reserve(path.size());
+    for (char c : path) {
+        result.push_back(c == '\\' ? '/' : c);
+    }
+
+    size_t start = 0;
+    for (;;) {
+        if (result.compare(start, 2, "./") == 0) {
+            start += 2;
+        } else if (start < result.size() && result[start] == '/') {
+            ++start;
+        } else {
+            break;
+        }
+    }
+    return result.substr(start);
+}
+
+inline uint64_t HashPakPath(std::string_view normalizedPath) {
+    return Core::Hash64::Hash(normalizedPath);
+}
+
+} // namespace Packing
+} // namespace PrismaEngine
@@ -0,0 +1,312 @@
+#include "Pipeline.h"
+#include "../JobSystem.h"
+#include "../Logger.h"
+#include "../core/Lz4.h"
+#include "../core/MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <unordered_set>
+
+#ifdef PRISMA_USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace PrismaEngine {
+namespace Packing {
+
+namespace {
+
+// 单个条目的准备结果
+struct PreparedEntry {
+    PakEntry entry{};
+    std::vector<uint8_t> compressed;  // 为空时直接从源文件拷贝
+    std::string error;
+};
+
+#ifdef PRISMA_USE_ZSTD
+constexpr int ZstdLevel = 9;
+#endif
+
+bool Compress(PakCompression compression, const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    switch (compression) {
+    case PakCompression::LZ4: {
+        out.resize(Core::Lz4::CompressBound(size));
+        size_t written = Core::Lz4::Compress(data, size, out.data(), out.size());
+        out.resize(written);
+        return written > 0;
+    }
+#ifdef PRISMA_USE_ZSTD
+    case PakCompression::Zstd: {
+        out.resize(ZSTD_compressBound(size));
+        size_t written = ZSTD_compress(out.data(), out.size(), data, size, ZstdLevel);
+        if (ZSTD_isError(written)) {
+            out.clear();
+            return false;
+        }
+        out.resize(written);
+        return true;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+bool WritePadding(std::ofstream& file, uint64_t& position, uint64_t target) {
+    static const char zeros[PakAlignment] = {};
+    while (position < target) {
+        uint64_t count = std::min<uint64_t>(target - position, PakAlignment);
+        file.write(zeros, static_cast<std::streamsize>(count));
+        position += count;
+    }
+    return file.good();
+}
+
+} // namespace
+
+bool PackingPipeline::IsPrecompressed(const std::filesystem::path& path) {
+    static const std::unordered_set<std::string> extensions = {
+        ".png", ".jpg", ".jpeg", ".webp", ".ktx2", ".basis",
+        ".ogg", ".mp3", ".opus", ".zst", ".lz4", ".zip", ".gz", ".pak"
+    };
+
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extensions.count(extension) > 0;
+}
+
+bool PackingPipeline::AddFile(const std::filesystem::path& sourcePath, std::string_view virtualPath,
+                              std::optional<PakCompression> compression) {
+    std::string normalized = NormalizePakPath(virtualPath);
+    if (normalized.empty() || normalized.size() > UINT16_MAX) {
+        LOG_ERROR("Packing", "无效的归档路径: {0}", std::string(virtualPath));
+        return false;
+    }
+
+    PakCompression resolved = compression.value_or(
+        IsPrecompressed(sourcePath) ? PakCompression::None : m_defaultCompression);
+
+#ifndef PRISMA_USE_ZSTD
+    if (resolved == PakCompression::Zstd) {
+        LOG_WARNING("Packing", "未启用 zstd, 条目改用 LZ4: {0}", normalized);
+        resolved = PakCompression::LZ4;
+    }
+#endif
+
+    m_inputs.push_back({sourcePath, std::move(normalized), resolved});
+    return true;
+}
+
+size_t PackingPipeline::AddDirectory(const std::filesystem::path& directory, std::string_view virtualPrefix) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        LOG_ERROR("Packing", "目录不存在: {0}", directory.string());
+        return 0;
+    }
+
+    std::string prefix = NormalizePakPath(virtualPrefix);
+    if (!prefix.empty() && prefix.back() != '/') {
+        prefix.push_back('/');
+    }
+
+    // 按路径排序, 保证归档内容与遍历顺序无关
+    std::vector<std::filesystem::path> files;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(directory, ec)) {
+        if (item.is_regular_file(ec)) {
+            files.push_back(item.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    size_t added = 0;
+    for (const auto& file : files) {
+        std::string relative = std::filesystem::relative(file, directory, ec).generic_string();
+        if (AddFile(file, prefix + relative)) {
+            ++added;
+        }
+    }
+    return added;
+}
+
+bool PackingPipeline::Execute() {
+    m_lastError.clear();
+    m_stats = Stats{};
+
+    if (m_outputPath.empty()) {
+        m_lastError = "Output path is not set";
+        return false;
+    }
+
+    // 检查重复路径
+    {
+        std::unordered_set<std::string_view> seen;
+        for (const Input& input : m_inputs) {
+            if (!seen.insert(input.virtualPath).second) {
+                m_lastError = "Duplicate archive path: " + input.virtualPath;
+                return false;
+            }
+        }
+    }
+
+    // 1. 并行读取、哈希并压缩各条目
+    std::vector<PreparedEntry> prepared(m_inputs.size());
+    const float maxRatio = m_maxCompressedRatio;
+
+    JobSystem::GetInstance().ParallelFor(m_inputs.size(), [&](size_t i) {
+        const Input& input = m_inputs[i];
+        PreparedEntry& out = prepared[i];
+
+        Core::MappedFile source;
+        if (!source.Open(input.sourcePath, Core::MappedFile::AccessPattern::Sequential)) {
+            out.error = "Failed to open " + input.sourcePath.string();
+            return;
+        }
+
+        out.entry.pathHash    = HashPakPath(input.virtualPath);
+        out.entry.size        = source.Size();
+        out.entry.storedSize  = source.Size();
+        out.entry.contentHash = Core::Hash64::Hash(source.Data(), source.Size());
+        out.entry.nameLength  = static_cast<uint16_t>(input.virtualPath.size());
+        out.entry.compression = static_cast<uint8_t>(PakCompression::None);
+
+        if (input.compression == PakCompression::None || source.Size() == 0) {
+            return;
+        }
+
+        std::vector<uint8_t> compressed;
+        if (Compress(input.compression, source.Data(), source.Size(), compressed) &&
+            static_cast<double>(compressed.size()) <= static_cast<double>(source.Size()) * maxRatio) {
+            out.entry.storedSize  = compressed.size();
+            out.entry.compression = static_cast<uint8_t>(input.compression);
+            out.compressed        = std::move(compressed);
+        }
+    });
+
+    for (const PreparedEntry& entry : prepared) {
+        if (!entry.error.empty()) {
+            m_lastError = entry.error;
+            return false;
+        }
+    }
+
+    // 2. 按路径哈希排序 (哈希相同时按路径), 运行时二分查找
+    std::vector<uint32_t> order(m_inputs.size());
+    for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (prepared[a].entry.pathHash != prepared[b].entry.pathHash) {
+            return prepared[a].entry.pathHash < prepared[b].entry.pathHash;
+        }
+        return m_inputs[a].virtualPath < m_inputs[b].virtualPath;
+    });
+
+    // 3. 计算布局
+    std::vector<PakEntry> entries;
+    std::string strings;
+    entries.reserve(order.size());
+
+    uint64_t offset = sizeof(PakHeader);
+    for (uint32_t index : order) {
+        PakEntry entry   = prepared[index].entry;
+        offset           = AlignPakOffset(offset);
+        entry.offset     = offset;
+        entry.nameOffset = static_cast<uint32_t>(strings.size());
+        offset += entry.storedSize;
+        strings += m_inputs[index].virtualPath;
+        entries.push_back(entry);
+
+        m_stats.rawBytes += entry.size;
+        m_stats.storedBytes += entry.storedSize;
+    }
+
+    if (strings.size() > UINT32_MAX) {
+        m_lastError = "String table is too large";
+        return false;
+    }
+
+    PakHeader header{};
+    header.magic             = PakMagic;
+    header.version           = PakVersion;
+    header.entryCount        = static_cast<uint32_t>(entries.size());
+    header.entryTableOffset  = AlignPakOffset(offset);
+    header.stringTableOffset = header.entryTableOffset + entries.size() * sizeof(PakEntry);
+    header.stringTableSize   = strings.size();
+    header.fileSize          = header.stringTableOffset + strings.size();
+    header.contentHash       = Core::Hash64::Hash(strings.data(), strings.size(),
+                                                  Core::Hash64::Hash(entries.data(), entries.size() * sizeof(PakEntry)));
+
+    // 4. 写入临时文件, 完成后替换目标文件
+    std::filesystem::path tempPath = m_outputPath;
+    tempPath += ".tmp";
+
+    std::error_code ec;
+    if (m_outputPath.has_parent_path()) {
+        std::filesystem::create_directories(m_outputPath.parent_path(), ec);
+    }
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            m_lastError = "Failed to create " + tempPath.string();
+            return false;
+        }
+
+        uint64_t position = 0;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        position += sizeof(header);
+
+        for (size_t i = 0; i < order.size() && file.good(); ++i) {
+            const PreparedEntry& source = prepared[order[i]];
+            WritePadding(file, position, entries[i].offset);
+
+            if (!source.compressed.empty()) {
+                file.write(reinterpret_cast<const char*>(source.compressed.data()),
+                           static_cast<std::streamsize>(source.compressed.size()));
+            } else if (entries[i].size > 0) {
+                Core::MappedFile input;
+                if (!input.Open(m_inputs[order[i]].sourcePath, Core::MappedFile::AccessPattern::Sequential) ||
+                    input.Size() != entries[i].size) {
+                    m_lastError = "Source file changed while packing: " + m_inputs[order[i]].sourcePath.string();
+                    break;
+                }
+                file.write(reinterpret_cast<const char*>(input.Data()), static_cast<std::streamsize>(input.Size()));
+            }
+            position += entries[i].storedSize;
+        }
+
+        if (m_lastError.empty()) {
+            WritePadding(file, position, header.entryTableOffset);
+            file.write(reinterpret_cast<const char*>(entries.data()),
+                       static_cast<std::streamsize>(entries.size() * sizeof(PakEntry)));
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        }
+
+        if (m_lastError.empty() && !file.good()) {
+            m_lastError = "Failed to write " + tempPath.string();
+        }
+    }
+
+    if (!m_lastError.empty()) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, m_outputPath, ec);
+    if (ec) {
+        m_lastError = "Failed to replace " + m_outputPath.string() + ": " + ec.message();
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    m_stats.entryCount  = entries.size();
+    m_stats.fileSize    = header.fileSize;
+    m_stats.contentHash = header.contentHash;
+
+    LOG_INFO("Packing", "归档已生成: {0} ({1} 个条目, {2} -> {3} 字节)",
+             m_outputPath.string(), m_stats.entryCount, m_stats.rawBytes, m_stats.storedBytes);
+    return true;
+}
+
+} // namespace Packing
+} // namespace PrismaEngine
@@ -5,13 +5,103 @@
 #ifndef PIPELINE_H
 #define PIPELINE_H
 
+#include "PakFormat.h"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
+namespace PrismaEngine {
+namespace Packing {
 
+/**
+ * @brief 资源处理管线基类
+ */
 class Pipeline {
+public:
+    virtual ~Pipeline() = default;
 
+    /**
+     * @brief 执行管线
+     * @return 失败时返回 false，错误信息见 GetLastError
+     */
+    virtual bool Execute() = 0;
+
+    const std::string& GetLastError() const { return m_lastError; }
+
+protected:
+    std::string m_lastError;
 };
 
-class PackingPipeline : public Pipeline {};
+/**
+ * @brief 打包管线 - 将资源文件打包为 PAK 归档
+ *
+ * 条目的读取、哈希和压缩在工作线程上并行进行，
+ * 写入时先写临时文件，完成后替换目标文件。
+ */
+class PackingPipeline : public Pipeline {
+public:
+    struct Stats {
+        size_t entryCount    = 0;
+        uint64_t rawBytes    = 0;  // 原始数据总大小
+        uint64_t storedBytes = 0;  // 存储数据总大小
+        uint64_t fileSize    = 0;
+        uint64_t contentHash = 0;
+    };
+
+    PackingPipeline() = default;
+    explicit PackingPipeline(std::filesystem::path outputPath) : m_outputPath(std::move(outputPath)) {}
+
+    void SetOutputPath(const std::filesystem::path& path) { m_outputPath = path; }
+    const std::filesystem::path& GetOutputPath() const { return m_outputPath; }
+
+    // 未单独指定压缩方式的条目使用的压缩方式
+    void SetDefaultCompression(PakCompression compression) { m_defaultCompression = compression; }
+
+    // 压缩后大小超过原始大小的此比例时按原样存储 (保留零拷贝读取)
+    void SetMaxCompressedRatio(float ratio) { m_maxCompressedRatio = ratio; }
+
+    /**
+     * @brief 添加单个文件
+     * @param virtualPath 归档内路径 (运行时按此路径查找)
+     * @param compression 为空时使用默认压缩方式; 已压缩格式 (png/ogg 等) 默认不再压缩
+     */
+    bool AddFile(const std::filesystem::path& sourcePath, std::string_view virtualPath,
+                 std::optional<PakCompression> compression = std::nullopt);
+
+    /**
+     * @brief 递归添加目录下的所有文件
+     * @param virtualPrefix 归档内路径前缀
+     * @return 添加的文件数量
+     */
+    size_t AddDirectory(const std::filesystem::path& directory, std::string_view virtualPrefix = {});
+
+    size_t GetInputCount() const { return m_inputs.size(); }
+    void Clear() { m_inputs.clear(); }
+
+    bool Execute() override;
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Input {
+        std::filesystem::path sourcePath;
+        std::string virtualPath;  // 已规范化
+        PakCompression compression;
+    };
+
+    static bool IsPrecompressed(const std::filesystem::path& path);
+
+    std::filesystem::path m_outputPath;
+    std::vector<Input> m_inputs;
+    PakCompression m_defaultCompression = PakCompression::LZ4;
+    float m_maxCompressedRatio          = 0.9f;
+    Stats m_stats;
+};
 
+} // namespace Packing
+} // namespace PrismaEngine
 
 #endif //PIPELINE_H
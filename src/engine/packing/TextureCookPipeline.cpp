@@ -0,0 +1,286 @@
+#include "TextureCookPipeline.h"
+#include "BlockCompressor.h"
+#include "../JobSystem.h"
+#include "../Logger.h"
+#include "../core/MappedFile.h"
+#include "../graphic/Ktx2.h"
+#include "../graphic/MipGenerator.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <unordered_set>
+
+namespace PrismaEngine {
+namespace Packing {
+
+using Graphic::TextureFormat;
+
+namespace {
+
+// 单个纹理的烘焙结果
+struct CookResult {
+    bool cached  = false;
+    bool written = false;
+    uint64_t rawBytes    = 0;
+    uint64_t outputBytes = 0;
+    std::string error;
+};
+
+/**
+ * @brief 输出文件内容相同时不重写, 保持时间戳不变 (增量打包依赖于此)
+ */
+bool IsUnchanged(const std::filesystem::path& path, const std::vector<uint8_t>& data) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec) || std::filesystem::file_size(path, ec) != data.size()) {
+        return false;
+    }
+
+    Core::MappedFile existing;
+    if (!existing.Open(path, Core::MappedFile::AccessPattern::Sequential) || existing.Size() != data.size()) {
+        return false;
+    }
+    // 文件已映射, 逐字节比较比两次哈希更快且不会因碰撞跳过写入
+    return std::memcmp(existing.Data(), data.data(), data.size()) == 0;
+}
+
+/**
+ * @brief 由烘焙结果推算解码后的 RGBA8 大小, 用于缓存命中时的统计
+ */
+uint64_t DecodedBytes(const std::vector<uint8_t>& ktx2) {
+    Graphic::Ktx2::Image image;
+    if (!Graphic::Ktx2::Parse(ktx2.data(), ktx2.size(), image)) {
+        return 0;
+    }
+    uint64_t bytes = 0;
+    for (const auto& level : image.levels) {
+        bytes += static_cast<uint64_t>(level.width) * level.height * 4;
+    }
+    return bytes;
+}
+
+bool WriteFileAtomically(const std::filesystem::path& path, const std::vector<uint8_t>& data, std::string& error) {
+    std::error_code ec;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    // 临时文件名包含线程标识, 多个输入写同一路径时互不干扰
+    static std::atomic<uint64_t> s_counter{0};
+    std::filesystem::path tempPath = path;
+    tempPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "." +
+                std::to_string(s_counter++) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error = "Failed to create " + tempPath.string();
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file.good()) {
+            error = "Failed to write " + tempPath.string();
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        error = "Failed to replace " + path.string() + ": " + ec.message();
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool TextureCookPipeline::IsSourceImage(const std::filesystem::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    static const std::unordered_set<std::string> extensions = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif" };
+    return extensions.count(ext) > 0;
+}
+
+bool TextureCookPipeline::AddFile(const std::filesystem::path& sourcePath, const std::filesystem::path& outputPath) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(sourcePath, ec)) {
+        LOG_WARNING("Packing", "纹理源文件不存在: {0}", sourcePath.string());
+        return false;
+    }
+
+    Input input;
+    input.sourcePath = sourcePath;
+    input.outputPath = m_outputDirectory / outputPath;
+    input.outputPath.replace_extension(".ktx2");
+    m_inputs.push_back(std::move(input));
+    return true;
+}
+
+size_t TextureCookPipeline::AddDirectory(const std::filesystem::path& directory, const std::filesystem::path& outputPrefix) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        LOG_WARNING("Packing", "纹理目录不存在: {0}", directory.string());
+        return 0;
+    }
+
+    size_t added = 0;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(directory, ec)) {
+        if (!item.is_regular_file() || !IsSourceImage(item.path())) continue;
+        if (AddFile(item.path(), outputPrefix / std::filesystem::relative(item.path(), directory, ec))) {
+            ++added;
+        }
+    }
+    return added;
+}
+
+TextureFormat TextureCookPipeline::SelectFormat(const TextureCookSettings& settings, bool hasAlpha) {
+    switch (settings.target) {
+    case TextureCookTarget::Desktop:
+        if (hasAlpha) return settings.srgb ? TextureFormat::BC3_SRGB : TextureFormat::BC3_UNorm;
+        return settings.srgb ? TextureFormat::BC1_SRGB : TextureFormat::BC1_UNorm;
+    case TextureCookTarget::Mobile:
+        if (hasAlpha) return settings.srgb ? TextureFormat::ETC2_RGBA8_SRGB : TextureFormat::ETC2_RGBA8_UNorm;
+        return settings.srgb ? TextureFormat::ETC2_RGB8_SRGB : TextureFormat::ETC2_RGB8_UNorm;
+    case TextureCookTarget::Uncompressed:
+    default:
+        return settings.srgb ? TextureFormat::RGBA8_UNorm_sRGB : TextureFormat::RGBA8_UNorm;
+    }
+}
+
+bool TextureCookPipeline::CookImage(const uint8_t* data, size_t size, const TextureCookSettings& settings,
+                                    std::vector<uint8_t>& ktx2, std::string* error, uint64_t* rawBytes) {
+    auto fail = [error](const char* message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    if (!data || size == 0 || size > static_cast<size_t>(INT_MAX)) return fail("Empty or oversized image");
+
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* image = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, STBI_rgb_alpha);
+    if (!image) return fail("Failed to decode image");
+
+    std::vector<uint8_t> pixels(image, image + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    stbi_image_free(image);
+
+    bool hasAlpha = false;
+    for (size_t i = 3; i < pixels.size(); i += 4) {
+        if (pixels[i] != 255) {
+            hasAlpha = true;
+            break;
+        }
+    }
+    TextureFormat format = SelectFormat(settings, hasAlpha);
+
+    // 超过 maxSize 的级别不输出
+    auto w = static_cast<uint32_t>(width);
+    auto h = static_cast<uint32_t>(height);
+    uint32_t firstMip = 0;
+    if (settings.maxSize > 0) {
+        while (std::max(std::max(1u, w >> firstMip), std::max(1u, h >> firstMip)) > settings.maxSize) ++firstMip;
+    }
+    uint32_t mipCount = settings.generateMips ? 0 : firstMip + 1;
+
+    std::vector<std::vector<uint8_t>> levels =
+        Graphic::MipGenerator::Generate(std::move(pixels), w, h, firstMip, mipCount, settings.srgb);
+    if (levels.empty()) return fail("Failed to generate mip chain");
+
+    uint32_t baseWidth  = std::max(1u, w >> firstMip);
+    uint32_t baseHeight = std::max(1u, h >> firstMip);
+    if (rawBytes) {
+        *rawBytes = 0;
+        for (const auto& level : levels) *rawBytes += level.size();
+    }
+
+    if (Graphic::IsCompressedFormat(format)) {
+        for (size_t i = 0; i < levels.size(); ++i) {
+            std::vector<uint8_t> compressed;
+            if (!BlockCompressor::Compress(format, levels[i].data(),
+                                           std::max(1u, baseWidth >> i), std::max(1u, baseHeight >> i), compressed)) {
+                return fail("Unsupported compressed format");
+            }
+            levels[i] = std::move(compressed);
+        }
+    }
+
+    ktx2 = Graphic::Ktx2::Write(format, baseWidth, baseHeight, levels);
+    if (ktx2.empty()) return fail("Failed to write KTX2 container");
+    return true;
+}
+
+bool TextureCookPipeline::Execute() {
+    m_lastError.clear();
+    m_stats = Stats{};
+
+    if (m_outputDirectory.empty()) {
+        m_lastError = "Output directory is not set";
+        return false;
+    }
+
+    // 参数逐字段展开, 避免结构体填充字节进入缓存键
+    const uint32_t params[4] = {
+        static_cast<uint32_t>(m_settings.target),
+        m_settings.srgb ? 1u : 0u,
+        m_settings.generateMips ? 1u : 0u,
+        m_settings.maxSize
+    };
+
+    std::vector<CookResult> results(m_inputs.size());
+    JobSystem::GetInstance().ParallelFor(m_inputs.size(), [&](size_t i) {
+        const Input& input = m_inputs[i];
+        CookResult& result = results[i];
+
+        Core::MappedFile source;
+        if (!source.Open(input.sourcePath, Core::MappedFile::AccessPattern::Sequential)) {
+            result.error = "Failed to open " + input.sourcePath.string();
+            return;
+        }
+
+        uint64_t key = DerivedDataCache::MakeKey("TextureCook", CookerVersion, params, sizeof(params),
+                                                 source.Data(), source.Size());
+        std::vector<uint8_t> cooked;
+        if (m_cache.Get(key, cooked)) {
+            result.cached   = true;
+            result.rawBytes = DecodedBytes(cooked);
+        } else {
+            std::string error;
+            if (!CookImage(source.Data(), source.Size(), m_settings, cooked, &error, &result.rawBytes)) {
+                result.error = error + ": " + input.sourcePath.string();
+                return;
+            }
+            if (!m_cache.Put(key, cooked.data(), cooked.size())) {
+                LOG_WARNING("Packing", "无法写入派生数据缓存: {0}", m_cache.GetPath(key).string());
+            }
+        }
+
+        result.outputBytes = cooked.size();
+        if (!IsUnchanged(input.outputPath, cooked)) {
+            if (!WriteFileAtomically(input.outputPath, cooked, result.error)) return;
+            result.written = true;
+        }
+    });
+
+    for (const CookResult& result : results) {
+        if (!result.error.empty()) {
+            m_lastError = result.error;
+            return false;
+        }
+        if (result.cached) ++m_stats.cachedCount; else ++m_stats.cookedCount;
+        if (result.written) ++m_stats.writtenCount;
+        m_stats.sourceBytes += result.rawBytes;
+        m_stats.outputBytes += result.outputBytes;
+    }
+
+    LOG_INFO("Packing", "纹理烘焙完成: {0} 个烘焙, {1} 个命中缓存, {2} 个文件已更新",
+             m_stats.cookedCount, m_stats.cachedCount, m_stats.writtenCount);
+    return true;
+}
+
+} // namespace Packing
+} // namespace PrismaEngine
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Pipeline.h"
+#include "DerivedDataCache.h"
+#include "graphic/interfaces/RenderTypes.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PrismaEngine {
+namespace Packing {
+
+/**
+ * @brief 纹理烘焙目标平台
+ */
+enum class TextureCookTarget : uint8_t {
+    Desktop,       // BC1 (不透明) / BC3 (带 Alpha)
+    Mobile,        // ETC2 RGB / ETC2 RGBA
+    Uncompressed   // RGBA8, 仅预生成 MIP
+};
+
+struct TextureCookSettings {
+    TextureCookTarget target = TextureCookTarget::Desktop;
+    bool srgb         = true;   // 颜色纹理; 法线/遮罩等数据纹理应关闭
+    bool generateMips = true;
+    uint32_t maxSize  = 0;      // 最高级别的最大边长, 超出的级别被丢弃; 0 表示不限制
+};
+
+/**
+ * @brief 纹理烘焙管线 - 将源图像转换为 GPU 压缩格式的 KTX2 文件
+ *
+ * 源图像解码后预生成 MIP 链并逐级块压缩, 运行时可以直接上传而无需解码。
+ * 结果按 "源文件内容 + 烘焙参数" 保存在派生数据缓存中, 未修改的纹理不会重新烘焙。
+ */
+class TextureCookPipeline : public Pipeline {
+public:
+    struct Stats {
+        size_t cookedCount   = 0;  // 实际烘焙的纹理数
+        size_t cachedCount   = 0;  // 命中缓存的纹理数
+        size_t writtenCount  = 0;  // 写入 (内容有变化) 的输出文件数
+        uint64_t sourceBytes = 0;  // 解码后的 RGBA8 总大小 (含 MIP)
+        uint64_t outputBytes = 0;
+    };
+
+    // 烘焙算法变化时递增, 使缓存中的旧结果失效
+    static constexpr uint32_t CookerVersion = 1;
+
+    TextureCookPipeline(std::filesystem::path outputDirectory, std::filesystem::path cacheDirectory)
+        : m_outputDirectory(std::move(outputDirectory)), m_cache(std::move(cacheDirectory)) {}
+
+    void SetSettings(const TextureCookSettings& settings) { m_settings = settings; }
+    const TextureCookSettings& GetSettings() const { return m_settings; }
+
+    /**
+     * @brief 添加单个源图像
+     * @param outputPath 相对输出目录的路径, 扩展名替换为 .ktx2
+     */
+    bool AddFile(const std::filesystem::path& sourcePath, const std::filesystem::path& outputPath);
+
+    /**
+     * @brief 递归添加目录下的所有图像, 输出保持相同的目录结构
+     * @return 添加的文件数量
+     */
+    size_t AddDirectory(const std::filesystem::path& directory, const std::filesystem::path& outputPrefix = {});
+
+    size_t GetInputCount() const { return m_inputs.size(); }
+    void Clear() { m_inputs.clear(); }
+
+    bool Execute() override;
+
+    const Stats& GetStats() const { return m_stats; }
+    DerivedDataCache& GetCache() { return m_cache; }
+
+    /**
+     * @brief 按目标平台和是否含 Alpha 选择格式
+     */
+    static Graphic::TextureFormat SelectFormat(const TextureCookSettings& settings, bool hasAlpha);
+
+    /**
+     * @brief 烘焙内存中的源图像为 KTX2
+     * @param rawBytes 可选, 返回解码后的 RGBA8 数据大小
+     */
+    static bool CookImage(const uint8_t* data, size_t size, const TextureCookSettings& settings,
+                          std::vector<uint8_t>& ktx2, std::string* error = nullptr, uint64_t* rawBytes = nullptr);
+
+    static bool IsSourceImage(const std::filesystem::path& path);
+
+private:
+    struct Input {
+        std::filesystem::path sourcePath;
+        std::filesystem::path outputPath;  // 绝对路径
+    };
+
+    std::filesystem::path m_outputDirectory;
+    DerivedDataCache m_cache;
+    TextureCookSettings m_settings;
+    std::vector<Input> m_inputs;
+    Stats m_stats;
+};
+
+} // namespace Packing
+} // namespace PrismaEngine
@@ -0,0 +1,454 @@
+#pragma once
+
+#include "CollisionSystem.h"
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// 定义 PRISMA_PHYSICS_NO_SIMD 可强制使用标量实现
+#if defined(PRISMA_PHYSICS_NO_SIMD)
+#elif defined(__AVX__)
+    #include <immintrin.h>
+    #define PRISMA_PHYSICS_SSE 1
+    #define PRISMA_PHYSICS_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PRISMA_PHYSICS_SSE 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define PRISMA_PHYSICS_NEON 1
+#endif
+
+namespace PrismaEngine {
+    namespace Physics {
+
+        namespace detail {
+
+            /**
+             * @brief 4 宽 float 向量, 按平台选择 SSE / NEON / 标量实现
+             */
+            struct Float4 {
+#if defined(PRISMA_PHYSICS_SSE)
+                __m128 v;
+
+                static Float4 load(const float* p) noexcept { return { _mm_load_ps(p) }; }
+                static Float4 splat(float f) noexcept { return { _mm_set1_ps(f) }; }
+                void store(float* p) const noexcept { _mm_store_ps(p, v); }
+
+                friend Float4 operator-(Float4 a, Float4 b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+                friend Float4 operator*(Float4 a, Float4 b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+                friend Float4 min(Float4 a, Float4 b) noexcept { return { _mm_min_ps(a.v, b.v) }; }
+                friend Float4 max(Float4 a, Float4 b) noexcept { return { _mm_max_ps(a.v, b.v) }; }
+
+                // 比较结果为逐通道全 1 / 全 0 掩码
+                friend Float4 cmpLt(Float4 a, Float4 b) noexcept { return { _mm_cmplt_ps(a.v, b.v) }; }
+                friend Float4 cmpLe(Float4 a, Float4 b) noexcept { return { _mm_cmple_ps(a.v, b.v) }; }
+                friend Float4 operator&(Float4 a, Float4 b) noexcept { return { _mm_and_ps(a.v, b.v) }; }
+
+                uint32_t mask() const noexcept { return static_cast<uint32_t>(_mm_movemask_ps(v)); }
+#elif defined(PRISMA_PHYSICS_NEON)
+                float32x4_t v;
+
+                static Float4 load(const float* p) noexcept { return { vld1q_f32(p) }; }
+                static Float4 splat(float f) noexcept { return { vdupq_n_f32(f) }; }
+                void store(float* p) const noexcept { vst1q_f32(p, v); }
+
+                friend Float4 operator-(Float4 a, Float4 b) noexcept { return { vsubq_f32(a.v, b.v) }; }
+                friend Float4 operator*(Float4 a, Float4 b) noexcept { return { vmulq_f32(a.v, b.v) }; }
+                friend Float4 min(Float4 a, Float4 b) noexcept { return { vminq_f32(a.v, b.v) }; }
+                friend Float4 max(Float4 a, Float4 b) noexcept { return { vmaxq_f32(a.v, b.v) }; }
+
+                friend Float4 cmpLt(Float4 a, Float4 b) noexcept { return { vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)) }; }
+                friend Float4 cmpLe(Float4 a, Float4 b) noexcept { return { vreinterpretq_f32_u32(vcleq_f32(a.v, b.v)) }; }
+                friend Float4 operator&(Float4 a, Float4 b) noexcept {
+                    return { vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) };
+                }
+
+                uint32_t mask() const noexcept {
+                    static const int32_t shifts[4] = { 0, 1, 2, 3 };
+                    uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(v), 31);
+                    bits = vshlq_u32(bits, vld1q_s32(shifts));
+                    return vaddvq_u32(bits);
+                }
+#else
+                float v[4];
+
+                static Float4 load(const float* p) noexcept { return { { p[0], p[1], p[2], p[3] } }; }
+                static Float4 splat(float f) noexcept { return { { f, f, f, f } }; }
+                void store(float* p) const noexcept { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+
+                template<typename Op>
+                static Float4 apply(Float4 a, Float4 b, Op op) noexcept {
+                    Float4 r;
+                    for (int i = 0; i < 4; ++i) r.v[i] = op(a.v[i], b.v[i]);
+                    return r;
+                }
+                static float bits(bool b) noexcept { return b ? -0.0f : 0.0f; }   // 符号位作为掩码
+
+                friend Float4 operator-(Float4 a, Float4 b) noexcept { return apply(a, b, [](float x, float y) { return x - y; }); }
+                friend Float4 operator*(Float4 a, Float4 b) noexcept { return apply(a, b, [](float x, float y) { return x * y; }); }
+                friend Float4 min(Float4 a, Float4 b) noexcept { return apply(a, b, [](float x, float y) { return y < x ? y : x; }); }
+                friend Float4 max(Float4 a, Float4 b) noexcept { return apply(a, b, [](float x, float y) { return y > x ? y : x; }); }
+                friend Float4 cmpLt(Float4 a, Float4 b) noexcept { return apply(a, b, [](float x, float y) { return bits(x < y); }); }
+                friend Float4 cmpLe(Float4 a, Float4 b) noexcept { return apply(a, b, [](float x, float y) { return bits(x <= y); }); }
+                friend Float4 operator&(Float4 a, Float4 b) noexcept {
+                    return apply(a, b, [](float x, float y) { return bits(std::signbit(x) && std::signbit(y)); });
+                }
+
+                uint32_t mask() const noexcept {
+                    uint32_t m = 0;
+                    for (int i = 0; i < 4; ++i) m |= (std::signbit(v[i]) ? 1u : 0u) << i;
+                    return m;
+                }
+#endif
+            };
+
+#if defined(PRISMA_PHYSICS_AVX)
+            /**
+             * @brief 8 宽 float 向量 (AVX)
+             */
+            struct Float8 {
+                __m256 v;
+
+                static Float8 load(const float* p) noexcept { return { _mm256_load_ps(p) }; }
+                static Float8 splat(float f) noexcept { return { _mm256_set1_ps(f) }; }
+                void store(float* p) const noexcept { _mm256_store_ps(p, v); }
+
+                friend Float8 operator-(Float8 a, Float8 b) noexcept { return { _mm256_sub_ps(a.v, b.v) }; }
+                friend Float8 operator*(Float8 a, Float8 b) noexcept { return { _mm256_mul_ps(a.v, b.v) }; }
+                friend Float8 min(Float8 a, Float8 b) noexcept { return { _mm256_min_ps(a.v, b.v) }; }
+                friend Float8 max(Float8 a, Float8 b) noexcept { return { _mm256_max_ps(a.v, b.v) }; }
+                friend Float8 cmpLt(Float8 a, Float8 b) noexcept { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+                friend Float8 cmpLe(Float8 a, Float8 b) noexcept { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+                friend Float8 operator&(Float8 a, Float8 b) noexcept { return { _mm256_and_ps(a.v, b.v) }; }
+
+                uint32_t mask() const noexcept { return static_cast<uint32_t>(_mm256_movemask_ps(v)); }
+            };
+
+            template<size_t N> struct PacketVector { using Type = Float4; };
+            template<> struct PacketVector<8> { using Type = Float8; };
+#else
+            template<size_t N> struct PacketVector { using Type = Float4; };
+#endif
+
+            // double -> float 时向外取整, 保证转换后的盒子包住原盒子, 检测结果只会多报不会漏报
+            inline float roundDown(double value) noexcept {
+                float f = static_cast<float>(value);
+                return static_cast<double>(f) > value ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+            }
+
+            inline float roundUp(double value) noexcept {
+                float f = static_cast<float>(value);
+                return static_cast<double>(f) < value ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+            }
+
+        } // namespace detail
+
+        /**
+         * @brief N 个 AABB 的 SoA 数据包 (float, 相对原点)
+         *
+         * 每个分量按通道连续存放, 一次检测 N 个盒子; 大小为 6 * N * 4 字节, 为 double AABB 的一半。
+         * 坐标相对 origin (相机或区块原点) 存放, 避免远离世界原点时 float 精度不足; origin 不存放在
+         * 数据包内, 由 AABBPacketList 或调用方统一保存, 并在需要世界坐标的接口中传入。
+         * 转换时向外取整, 所有检测都是保守的: 可能把恰好相切的盒子报告为相交, 不会漏报,
+         * 需要精确结果时再用 double 的 AABB 复核。未使用的通道填充为空盒, 不会命中任何检测。
+         *
+         * 检测函数返回位掩码, 第 i 位对应第 i 个通道。
+         */
+        template<size_t N>
+        struct alignas(N * sizeof(float)) AABBPacket {
+            static_assert(N == 4 || N == 8, "AABBPacket 只支持 4 或 8 通道");
+            static constexpr size_t Lanes = N;
+            static constexpr uint32_t AllLanes = (1u << N) - 1;
+
+            // 每个数组长 N 个 float, 整体按 N * 4 字节对齐即可保证每个数组都满足向量加载的对齐
+            float minX[N];
+            float minY[N];
+            float minZ[N];
+            float maxX[N];
+            float maxY[N];
+            float maxZ[N];
+
+            AABBPacket() noexcept { clear(); }
+
+            /**
+             * @brief 将所有通道置为空盒
+             */
+            void clear() noexcept {
+                constexpr float Inf = std::numeric_limits<float>::infinity();
+                for (size_t i = 0; i < N; ++i) {
+                    minX[i] = minY[i] = minZ[i] = Inf;
+                    maxX[i] = maxY[i] = maxZ[i] = -Inf;
+                }
+            }
+
+            void set(size_t lane, const AABB& box, const glm::dvec3& origin) noexcept {
+                minX[lane] = detail::roundDown(box.minX - origin.x);
+                minY[lane] = detail::roundDown(box.minY - origin.y);
+                minZ[lane] = detail::roundDown(box.minZ - origin.z);
+                maxX[lane] = detail::roundUp(box.maxX - origin.x);
+                maxY[lane] = detail::roundUp(box.maxY - origin.y);
+                maxZ[lane] = detail::roundUp(box.maxZ - origin.z);
+            }
+
+            /**
+             * @brief 还原为 double AABB (包含转换时的外扩)
+             */
+            AABB get(size_t lane, const glm::dvec3& origin) const noexcept {
+                return AABB(minX[lane] + origin.x, minY[lane] + origin.y, minZ[lane] + origin.z,
+                            maxX[lane] + origin.x, maxY[lane] + origin.y, maxZ[lane] + origin.z);
+            }
+
+            /**
+             * @brief 由最多 N 个 AABB 构建数据包, 多余通道为空盒
+             */
+            static AABBPacket fromAABBs(std::span<const AABB> boxes, const glm::dvec3& packetOrigin) noexcept {
+                AABBPacket packet;
+                const size_t count = boxes.size() < N ? boxes.size() : N;
+                for (size_t i = 0; i < count; ++i) packet.set(i, boxes[i], packetOrigin);
+                return packet;
+            }
+
+            // ========== 批量检测 ==========
+
+            /**
+             * @brief 转换到数据包局部坐标的查询盒, 批量查询时只需转换一次
+             */
+            struct LocalBox {
+                float minX, minY, minZ;
+                float maxX, maxY, maxZ;
+            };
+
+            /**
+             * @brief 转换到数据包局部坐标的射线
+             */
+            struct LocalRay {
+                float originX, originY, originZ;
+                float invDirX, invDirY, invDirZ;   // 方向分量为 0 时为 ±FLT_MAX
+                float maxDistance;
+            };
+
+            // 向外取整, 用于相交检测
+            static LocalBox toLocal(const AABB& box, const glm::dvec3& packetOrigin) noexcept {
+                return { detail::roundDown(box.minX - packetOrigin.x), detail::roundDown(box.minY - packetOrigin.y),
+                         detail::roundDown(box.minZ - packetOrigin.z), detail::roundUp(box.maxX - packetOrigin.x),
+                         detail::roundUp(box.maxY - packetOrigin.y), detail::roundUp(box.maxZ - packetOrigin.z) };
+            }
+
+            static LocalRay toLocal(const glm::dvec3& rayOrigin, const glm::dvec3& direction, double maxDistance,
+                                    const glm::dvec3& packetOrigin) noexcept {
+                constexpr float Big = std::numeric_limits<float>::max();
+                // 方向分量为 0 时用极大值代替倒数, slab 退化为起点是否在区间内
+                auto inverse = [](double d) {
+                    return d != 0.0 ? static_cast<float>(1.0 / d) : (std::signbit(d) ? -Big : Big);
+                };
+                return { static_cast<float>(rayOrigin.x - packetOrigin.x), static_cast<float>(rayOrigin.y - packetOrigin.y),
+                         static_cast<float>(rayOrigin.z - packetOrigin.z), inverse(direction.x), inverse(direction.y),
+                         inverse(direction.z), static_cast<float>(maxDistance) };
+            }
+
+            /**
+             * @brief 与 box 严格相交 (同 AABB::intersects) 的通道
+             */
+            uint32_t overlapMask(const AABB& box, const glm::dvec3& origin) const noexcept {
+                return overlapMask(toLocal(box, origin));
+            }
+
+            uint32_t overlapMask(const LocalBox& query) const noexcept {
+                using V = typename detail::PacketVector<N>::Type;
+                const V qMinX = V::splat(query.minX), qMaxX = V::splat(query.maxX);
+                const V qMinY = V::splat(query.minY), qMaxY = V::splat(query.maxY);
+                const V qMinZ = V::splat(query.minZ), qMaxZ = V::splat(query.maxZ);
+
+                uint32_t result = 0;
+                for (size_t base = 0; base < N; base += sizeof(V) / sizeof(float)) {
+                    V hit = cmpLt(V::load(minX + base), qMaxX) & cmpLt(qMinX, V::load(maxX + base));
+                    hit = hit & cmpLt(V::load(minY + base), qMaxY) & cmpLt(qMinY, V::load(maxY + base));
+                    hit = hit & cmpLt(V::load(minZ + base), qMaxZ) & cmpLt(qMinZ, V::load(maxZ + base));
+                    result |= hit.mask() << base;
+                }
+                return result;
+            }
+
+            /**
+             * @brief 包含点 (含边界) 的通道
+             */
+            uint32_t containsPointMask(const glm::dvec3& point, const glm::dvec3& origin) const noexcept {
+                using V = typename detail::PacketVector<N>::Type;
+                const V lo[3] = { V::splat(detail::roundUp(point.x - origin.x)),
+                                  V::splat(detail::roundUp(point.y - origin.y)),
+                                  V::splat(detail::roundUp(point.z - origin.z)) };
+                const V hi[3] = { V::splat(detail::roundDown(point.x - origin.x)),
+                                  V::splat(detail::roundDown(point.y - origin.y)),
+                                  V::splat(detail::roundDown(point.z - origin.z)) };
+
+                uint32_t result = 0;
+                for (size_t base = 0; base < N; base += sizeof(V) / sizeof(float)) {
+                    V hit = cmpLe(V::load(minX + base), lo[0]) & cmpLe(hi[0], V::load(maxX + base));
+                    hit = hit & cmpLe(V::load(minY + base), lo[1]) & cmpLe(hi[1], V::load(maxY + base));
+                    hit = hit & cmpLe(V::load(minZ + base), lo[2]) & cmpLe(hi[2], V::load(maxZ + base));
+                    result |= hit.mask() << base;
+                }
+                return result;
+            }
+
+            /**
+             * @brief 完全包含 box 的通道
+             */
+            uint32_t containsBoxMask(const AABB& box, const glm::dvec3& origin) const noexcept {
+                using V = typename detail::PacketVector<N>::Type;
+                const V qMinX = V::splat(detail::roundUp(box.minX - origin.x));
+                const V qMinY = V::splat(detail::roundUp(box.minY - origin.y));
+                const V qMinZ = V::splat(detail::roundUp(box.minZ - origin.z));
+                const V qMaxX = V::splat(detail::roundDown(box.maxX - origin.x));
+                const V qMaxY = V::splat(detail::roundDown(box.maxY - origin.y));
+                const V qMaxZ = V::splat(detail::roundDown(box.maxZ - origin.z));
+
+                uint32_t result = 0;
+                for (size_t base = 0; base < N; base += sizeof(V) / sizeof(float)) {
+                    V hit = cmpLe(V::load(minX + base), qMinX) & cmpLe(qMaxX, V::load(maxX + base));
+                    hit = hit & cmpLe(V::load(minY + base), qMinY) & cmpLe(qMaxY, V::load(maxY + base));
+                    hit = hit & cmpLe(V::load(minZ + base), qMinZ) & cmpLe(qMaxZ, V::load(maxZ + base));
+                    result |= hit.mask() << base;
+                }
+                return result;
+            }
+
+            /**
+             * @brief 射线 slab 检测, 返回在 [0, maxDistance] 内命中的通道
+             * @param direction 不要求归一化, 距离以 direction 的长度为单位
+             * @param origin 数据包坐标的原点
+             * @param outNear 可选, 写入每个通道的进入参数 (未命中的通道值无意义)
+             */
+            uint32_t rayMask(const glm::dvec3& rayOrigin, const glm::dvec3& direction, double maxDistance,
+                             const glm::dvec3& origin, float* outNear = nullptr) const noexcept {
+                return rayMask(toLocal(rayOrigin, direction, maxDistance, origin), outNear);
+            }
+
+            uint32_t rayMask(const LocalRay& ray, float* outNear = nullptr) const noexcept {
+                using V = typename detail::PacketVector<N>::Type;
+                const V ox = V::splat(ray.originX), oy = V::splat(ray.originY), oz = V::splat(ray.originZ);
+                const V ix = V::splat(ray.invDirX), iy = V::splat(ray.invDirY), iz = V::splat(ray.invDirZ);
+                const V zero = V::splat(0.0f);
+                const V limit = V::splat(ray.maxDistance);
+
+                uint32_t result = 0;
+                for (size_t base = 0; base < N; base += sizeof(V) / sizeof(float)) {
+                    V t1 = (V::load(minX + base) - ox) * ix;
+                    V t2 = (V::load(maxX + base) - ox) * ix;
+                    V tNear = min(t1, t2);
+                    V tFar = max(t1, t2);
+
+                    t1 = (V::load(minY + base) - oy) * iy;
+                    t2 = (V::load(maxY + base) - oy) * iy;
+                    tNear = max(tNear, min(t1, t2));
+                    tFar = min(tFar, max(t1, t2));
+
+                    t1 = (V::load(minZ + base) - oz) * iz;
+                    t2 = (V::load(maxZ + base) - oz) * iz;
+                    tNear = max(tNear, min(t1, t2));
+                    tFar = min(tFar, max(t1, t2));
+
+                    tNear = max(tNear, zero);
+                    // 空通道的 slab 区间会退化为 (-inf, inf), 需单独排除
+                    const V valid = cmpLe(V::load(minX + base), V::load(maxX + base));
+                    const V hit = valid & cmpLe(tNear, tFar) & cmpLe(tNear, limit);
+                    result |= hit.mask() << base;
+                    if (outNear) tNear.store(outNear + base);
+                }
+                return result;
+            }
+        };
+
+        static_assert(sizeof(AABBPacket<4>) == 6 * 4 * sizeof(float));
+        static_assert(sizeof(AABBPacket<8>) == 6 * 8 * sizeof(float));
+
+        using AABB4 = AABBPacket<4>;
+        using AABB8 = AABBPacket<8>;
+
+        /**
+         * @brief 打包成 AABBPacket 数组的盒子列表, 用于对大量静态盒子做批量查询
+         * 盒子下标即插入顺序, 第 i 个盒子位于 packets[i / N] 的第 i % N 通道。
+         */
+        template<size_t N = 8>
+        class AABBPacketList {
+        public:
+            using Packet = AABBPacket<N>;
+
+            explicit AABBPacketList(const glm::dvec3& origin = glm::dvec3(0.0)) : m_origin(origin) {}
+
+            const glm::dvec3& getOrigin() const noexcept { return m_origin; }
+            size_t size() const noexcept { return m_count; }
+            std::span<const Packet> packets() const noexcept { return m_packets; }
+
+            void clear() noexcept {
+                m_packets.clear();
+                m_count = 0;
+            }
+
+            /**
+             * @brief 重建列表并设置新的原点
+             */
+            void build(std::span<const AABB> boxes, const glm::dvec3& origin) {
+                m_origin = origin;
+                clear();
+                m_packets.reserve((boxes.size() + N - 1) / N);
+                for (const AABB& box : boxes) add(box);
+            }
+
+            uint32_t add(const AABB& box) {
+                const size_t lane = m_count % N;
+                if (lane == 0) m_packets.emplace_back();
+                m_packets.back().set(lane, box, m_origin);
+                return static_cast<uint32_t>(m_count++);
+            }
+
+            /**
+             * @brief 对与 box 相交的每个盒子调用 fn(uint32_t index) (保守)
+             */
+            template<typename Fn>
+            void queryOverlaps(const AABB& box, Fn&& fn) const {
+                const typename Packet::LocalBox query = Packet::toLocal(box, m_origin);
+                for (size_t p = 0; p < m_packets.size(); ++p) {
+                    if (uint32_t mask = m_packets[p].overlapMask(query)) forEachLane(p, mask, fn);
+                }
+            }
+
+            /**
+             * @brief 对射线在 maxDistance 内穿过的每个盒子调用 fn(uint32_t index, float tNear) (保守)
+             */
+            template<typename Fn>
+            void queryRay(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance, Fn&& fn) const {
+                alignas(32) float tNear[N];
+                const typename Packet::LocalRay ray = Packet::toLocal(origin, direction, maxDistance, m_origin);
+                for (size_t p = 0; p < m_packets.size(); ++p) {
+                    uint32_t mask = m_packets[p].rayMask(ray, tNear);
+                    while (mask) {
+                        const uint32_t lane = static_cast<uint32_t>(std::countr_zero(mask));
+                        mask &= mask - 1;
+                        fn(static_cast<uint32_t>(p * N + lane), tNear[lane]);
+                    }
+                }
+            }
+
+        private:
+            template<typename Fn>
+            static void forEachLane(size_t packet, uint32_t mask, Fn& fn) {
+                while (mask) {
+                    const uint32_t lane = static_cast<uint32_t>(std::countr_zero(mask));
+                    mask &= mask - 1;
+                    fn(static_cast<uint32_t>(packet * N + lane));
+                }
+            }
+
+            glm::dvec3 m_origin;
+            std::vector<Packet> m_packets;
+            size_t m_count = 0;
+        };
+
+    } // namespace Physics
+} // namespace PrismaEngine
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CollisionSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Physics {
+
+        /**
+         * @brief 均匀网格宽阶段 - 实体之间的候选对查找
+         *
+         * 每帧由实体 AABB 列表整体重建, 复杂度 O(n)。
+         * 每个实体只按最小角所在的格子登记一次, 查询时将范围向负方向扩展最大实体尺寸,
+         * 因此同一实体不会被重复返回。网格按哈希存储, 不限制世界范围。
+         * 远大于格子尺寸的实体单独存放并线性检测, 避免拖大所有查询的范围。
+         */
+        class UniformGridBroadphase {
+        public:
+            explicit UniformGridBroadphase(double cellSize = 2.0)
+                : m_cellSize(cellSize), m_invCellSize(1.0 / cellSize) {}
+
+            double getCellSize() const noexcept { return m_cellSize; }
+            size_t size() const noexcept { return m_boxes.size(); }
+            const AABB& getBox(uint32_t index) const { return m_boxes[index]; }
+
+            /**
+             * @brief 由实体包围盒重建网格, 实体索引即 boxes 中的下标
+             */
+            void build(std::span<const AABB> boxes) {
+                const size_t count = boxes.size();
+                m_boxes.assign(boxes.begin(), boxes.end());
+                m_oversized.clear();
+                m_maxExtent = glm::dvec3(0.0);
+
+                size_t bucketCount = 16;
+                while (bucketCount < count * 2) bucketCount <<= 1;
+                m_bucketMask = bucketCount - 1;
+
+                // 计数排序: 先统计每个桶的数量, 再按前缀和放置
+                m_bucketStart.assign(bucketCount + 1, 0);
+                m_entryBucket.resize(count);
+                const double oversizedLimit = m_cellSize * OversizedCells;
+                for (size_t i = 0; i < count; ++i) {
+                    const AABB& box = m_boxes[i];
+                    if (box.getXsize() > oversizedLimit || box.getYsize() > oversizedLimit ||
+                        box.getZsize() > oversizedLimit) {
+                        m_oversized.push_back(static_cast<uint32_t>(i));
+                        m_entryBucket[i] = InvalidBucket;
+                        continue;
+                    }
+                    m_maxExtent = glm::max(m_maxExtent, glm::dvec3(box.getXsize(), box.getYsize(), box.getZsize()));
+                    uint32_t bucket = bucketOf(cellCoord(box.minX), cellCoord(box.minY), cellCoord(box.minZ));
+                    m_entryBucket[i] = bucket;
+                    ++m_bucketStart[bucket + 1];
+                }
+                for (size_t b = 0; b < bucketCount; ++b) {
+                    m_bucketStart[b + 1] += m_bucketStart[b];
+                }
+
+                m_entries.resize(count - m_oversized.size());
+                m_cursor.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+                for (size_t i = 0; i < count; ++i) {
+                    uint32_t bucket = m_entryBucket[i];
+                    if (bucket != InvalidBucket) {
+                        m_entries[m_cursor[bucket]++] = static_cast<uint32_t>(i);
+                    }
+                }
+            }
+
+            /**
+             * @brief 查找与 box 相交的实体, 对每个结果调用 fn(uint32_t index)
+             */
+            template<typename Fn>
+            void query(const AABB& box, Fn&& fn) const {
+                if (m_boxes.empty()) return;
+
+                const int64_t x0 = cellCoord(box.minX - m_maxExtent.x), x1 = cellCoord(box.maxX);
+                const int64_t y0 = cellCoord(box.minY - m_maxExtent.y), y1 = cellCoord(box.maxY);
+                const int64_t z0 = cellCoord(box.minZ - m_maxExtent.z), z1 = cellCoord(box.maxZ);
+
+                for (int64_t cx = x0; cx <= x1; ++cx) {
+                    for (int64_t cz = z0; cz <= z1; ++cz) {
+                        for (int64_t cy = y0; cy <= y1; ++cy) {
+                            uint32_t bucket = bucketOf(cx, cy, cz);
+                            for (uint32_t e = m_bucketStart[bucket]; e < m_bucketStart[bucket + 1]; ++e) {
+                                uint32_t index = m_entries[e];
+                                const AABB& other = m_boxes[index];
+                                // 哈希冲突的桶可能在范围内出现多次, 只在实体真正所在的格子上报告
+                                if (cellCoord(other.minX) != cx || cellCoord(other.minY) != cy ||
+                                    cellCoord(other.minZ) != cz) {
+                                    continue;
+                                }
+                                if (other.intersects(box)) fn(index);
+                            }
+                        }
+                    }
+                }
+
+                for (uint32_t index : m_oversized) {
+                    if (m_boxes[index].intersects(box)) fn(index);
+                }
+            }
+
+            /**
+             * @brief 枚举所有相交的实体对, 对每对调用一次 fn(uint32_t a, uint32_t b), a < b
+             */
+            template<typename Fn>
+            void forEachPair(Fn&& fn) const {
+                for (uint32_t i = 0; i < m_boxes.size(); ++i) {
+                    query(m_boxes[i], [&](uint32_t other) {
+                        if (other > i) fn(i, other);
+                    });
+                }
+            }
+
+        private:
+            static constexpr uint32_t InvalidBucket = 0xFFFFFFFFu;
+            static constexpr double OversizedCells = 4.0;
+
+            int64_t cellCoord(double value) const noexcept {
+                return static_cast<int64_t>(std::floor(value * m_invCellSize));
+            }
+
+            uint32_t bucketOf(int64_t x, int64_t y, int64_t z) const noexcept {
+                uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B185EBCA87ull ^
+                             static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full ^
+                             static_cast<uint64_t>(z) * 0x165667B19E3779F9ull;
+                h ^= h >> 29;
+                return static_cast<uint32_t>(h & m_bucketMask);
+            }
+
+            double m_cellSize;
+            double m_invCellSize;
+            glm::dvec3 m_maxExtent{0.0};
+            uint64_t m_bucketMask = 0;
+
+            std::vector<AABB> m_boxes;
+            std::vector<uint32_t> m_bucketStart;   // 桶 b 的条目范围为 [start[b], start[b + 1])
+            std::vector<uint32_t> m_entries;
+            std::vector<uint32_t> m_entryBucket;
+            std::vector<uint32_t> m_cursor;
+            std::vector<uint32_t> m_oversized;
+        };
+
+    } // namespace Physics
+} // namespace PrismaEngine
@@ -0,0 +1,484 @@
+#pragma once
+
+#include "Broadphase.h"
+#include "CollisionSystem.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Physics {
+
+        using RigidBodyId = uint32_t;
+        constexpr RigidBodyId InvalidRigidBody = 0xFFFFFFFFu;
+
+        /**
+         * @brief 刚体创建参数, 形状为不旋转的轴对齐盒
+         */
+        struct RigidBodyDesc {
+            glm::dvec3 position{0.0};         // 盒子中心
+            glm::dvec3 halfExtents{0.5};
+            glm::dvec3 velocity{0.0};
+            double mass = 1.0;                // <= 0 表示静态刚体
+            double restitution = 0.0;
+            double friction = 0.5;
+        };
+
+        /**
+         * @brief 物理世界参数
+         */
+        struct PhysicsWorldSettings {
+            glm::dvec3 gravity{0.0, -9.81, 0.0};
+            double fixedTimeStep = 1.0 / 60.0;
+            int maxSubSteps = 4;               // 单帧最多补算的固定步数, 超出部分丢弃
+            int solverIterations = 8;
+            double baumgarte = 0.2;            // 穿透修正系数
+            double penetrationSlop = 0.005;    // 允许的穿透量, 保持静止接触稳定
+            double restitutionThreshold = 1.0; // 低于该相对速度不反弹
+            size_t integrationBatchSize = 256;
+        };
+
+        /**
+         * @brief 接触流形
+         * 轴对齐盒之间的接触法线总是坐标轴, 无旋转时一个接触点即可描述。
+         * 按 (idA, idB) 排序后与上一步的接触合并, 继承累积冲量用于热启动。
+         */
+        struct ContactManifold {
+            RigidBodyId idA = InvalidRigidBody;   // idA < idB
+            RigidBodyId idB = InvalidRigidBody;
+            uint32_t bodyA = 0;                   // 本步的稠密下标
+            uint32_t bodyB = 0;
+            int normalAxis = 0;
+            double normalSign = 1.0;              // 法线 = normalSign * 轴, 由 A 指向 B
+            double penetration = 0.0;
+            double effectiveMass = 0.0;
+            double friction = 0.0;
+            double bias = 0.0;
+            double normalImpulse = 0.0;
+            double tangentImpulse[2] = { 0.0, 0.0 };
+
+            uint64_t key() const noexcept { return (static_cast<uint64_t>(idA) << 32) | idB; }
+        };
+
+        /**
+         * @brief 刚体物理世界
+         *
+         * 刚体按 SoA 存储 (位置、速度、逆质量等各自连续), 固定步长推进并保留上一步位置供渲染插值。
+         * 每一步: 并行积分速度 -> 网格宽阶段 -> 生成接触并热启动 -> 按岛并行迭代求解 -> 并行积分位置。
+         * 岛之间不共享动态刚体, 岛内按接触键的固定顺序求解, 因此结果与线程数无关, 完全确定。
+         */
+        class PhysicsWorld {
+        public:
+            explicit PhysicsWorld(const PhysicsWorldSettings& settings = PhysicsWorldSettings())
+                : m_settings(settings) {}
+
+            const PhysicsWorldSettings& getSettings() const noexcept { return m_settings; }
+            void setSettings(const PhysicsWorldSettings& settings) { m_settings = settings; }
+            void setGravity(const glm::dvec3& gravity) noexcept { m_settings.gravity = gravity; }
+
+            // ========== 刚体管理 ==========
+
+            RigidBodyId createBody(const RigidBodyDesc& desc) {
+                RigidBodyId id;
+                if (!m_freeIds.empty()) {
+                    id = m_freeIds.back();
+                    m_freeIds.pop_back();
+                } else {
+                    id = static_cast<RigidBodyId>(m_denseIndex.size());
+                    m_denseIndex.push_back(InvalidRigidBody);
+                }
+
+                m_denseIndex[id] = static_cast<uint32_t>(m_ids.size());
+                m_ids.push_back(id);
+                m_positions.push_back(desc.position);
+                m_previousPositions.push_back(desc.position);
+                m_velocities.push_back(desc.mass > 0.0 ? desc.velocity : glm::dvec3(0.0));
+                m_halfExtents.push_back(desc.halfExtents);
+                m_inverseMasses.push_back(desc.mass > 0.0 ? 1.0 / desc.mass : 0.0);
+                m_restitutions.push_back(desc.restitution);
+                m_frictions.push_back(desc.friction);
+                return id;
+            }
+
+            void destroyBody(RigidBodyId id) {
+                if (!isValid(id)) return;
+                const uint32_t index = m_denseIndex[id];
+                const uint32_t last = static_cast<uint32_t>(m_ids.size() - 1);
+                if (index != last) {
+                    // 与末尾交换后弹出, 数组保持紧凑
+                    m_ids[index]               = m_ids[last];
+                    m_positions[index]         = m_positions[last];
+                    m_previousPositions[index] = m_previousPositions[last];
+                    m_velocities[index]        = m_velocities[last];
+                    m_halfExtents[index]       = m_halfExtents[last];
+                    m_inverseMasses[index]     = m_inverseMasses[last];
+                    m_restitutions[index]      = m_restitutions[last];
+                    m_frictions[index]         = m_frictions[last];
+                    m_denseIndex[m_ids[index]] = index;
+                }
+                m_ids.pop_back();
+                m_positions.pop_back();
+                m_previousPositions.pop_back();
+                m_velocities.pop_back();
+                m_halfExtents.pop_back();
+                m_inverseMasses.pop_back();
+                m_restitutions.pop_back();
+                m_frictions.pop_back();
+
+                m_denseIndex[id] = InvalidRigidBody;
+                m_freeIds.push_back(id);
+
+                // 缓存的接触引用了该刚体, 直接丢弃
+                std::erase_if(m_previousContacts, [id](const ContactManifold& c) { return c.idA == id || c.idB == id; });
+            }
+
+            void clear() {
+                m_ids.clear();
+                m_denseIndex.clear();
+                m_freeIds.clear();
+                m_positions.clear();
+                m_previousPositions.clear();
+                m_velocities.clear();
+                m_halfExtents.clear();
+                m_inverseMasses.clear();
+                m_restitutions.clear();
+                m_frictions.clear();
+                m_contacts.clear();
+                m_previousContacts.clear();
+                m_accumulator = 0.0;
+                m_islandCount = 0;
+            }
+
+            bool isValid(RigidBodyId id) const noexcept {
+                return id < m_denseIndex.size() && m_denseIndex[id] != InvalidRigidBody;
+            }
+
+            size_t getBodyCount() const noexcept { return m_ids.size(); }
+
+            glm::dvec3 getPosition(RigidBodyId id) const { return m_positions[m_denseIndex[id]]; }
+            glm::dvec3 getVelocity(RigidBodyId id) const { return m_velocities[m_denseIndex[id]]; }
+            bool isStatic(RigidBodyId id) const { return m_inverseMasses[m_denseIndex[id]] == 0.0; }
+
+            /**
+             * @brief 瞬移刚体, 同时重置插值起点
+             */
+            void setPosition(RigidBodyId id, const glm::dvec3& position) {
+                const uint32_t index = m_denseIndex[id];
+                m_positions[index] = position;
+                m_previousPositions[index] = position;
+            }
+
+            void setVelocity(RigidBodyId id, const glm::dvec3& velocity) {
+                const uint32_t index = m_denseIndex[id];
+                if (m_inverseMasses[index] > 0.0) m_velocities[index] = velocity;
+            }
+
+            void applyImpulse(RigidBodyId id, const glm::dvec3& impulse) {
+                const uint32_t index = m_denseIndex[id];
+                m_velocities[index] += impulse * m_inverseMasses[index];
+            }
+
+            AABB getBounds(RigidBodyId id) const { return boundsOf(m_denseIndex[id]); }
+
+            /**
+             * @brief 渲染用的插值位置, 位于上一固定步与当前固定步之间
+             */
+            glm::dvec3 getInterpolatedPosition(RigidBodyId id) const {
+                const uint32_t index = m_denseIndex[id];
+                const double alpha = getInterpolationAlpha();
+                return m_previousPositions[index] + (m_positions[index] - m_previousPositions[index]) * alpha;
+            }
+
+            double getInterpolationAlpha() const noexcept {
+                return m_settings.fixedTimeStep > 0.0 ? m_accumulator / m_settings.fixedTimeStep : 1.0;
+            }
+
+            std::span<const ContactManifold> getContacts() const noexcept { return m_contacts; }
+            size_t getIslandCount() const noexcept { return m_islandCount; }
+
+            // ========== 模拟 ==========
+
+            /**
+             * @brief 累积帧时间并执行整数个固定步
+             * @return 本帧执行的固定步数
+             */
+            int step(double frameDeltaTime) {
+                const double dt = m_settings.fixedTimeStep;
+                if (dt <= 0.0 || frameDeltaTime <= 0.0) return 0;
+
+                m_accumulator += frameDeltaTime;
+                int steps = 0;
+                while (m_accumulator >= dt && steps < m_settings.maxSubSteps) {
+                    fixedStep(dt);
+                    m_accumulator -= dt;
+                    ++steps;
+                }
+                // 卡顿时丢弃补不完的时间, 避免越补越慢
+                if (m_accumulator >= dt) m_accumulator = std::fmod(m_accumulator, dt);
+                return steps;
+            }
+
+            void fixedStep(double dt) {
+                integrateVelocities(dt);
+                findContacts(dt);
+                buildIslands();
+                solveIslands();
+                integratePositions(dt);
+                m_previousContacts.assign(m_contacts.begin(), m_contacts.end());
+            }
+
+        private:
+            AABB boundsOf(uint32_t index) const noexcept {
+                const glm::dvec3& p = m_positions[index];
+                const glm::dvec3& h = m_halfExtents[index];
+                return AABB(p.x - h.x, p.y - h.y, p.z - h.z, p.x + h.x, p.y + h.y, p.z + h.z);
+            }
+
+            /**
+             * @brief 按固定大小分批并行执行 fn(begin, end), 批次划分与线程数无关
+             */
+            template<typename Fn>
+            void parallelRange(size_t count, Fn&& fn) const {
+                const size_t batchSize = std::max<size_t>(m_settings.integrationBatchSize, 1);
+                const size_t batchCount = (count + batchSize - 1) / batchSize;
+                if (batchCount <= 1) {
+                    if (count) fn(size_t(0), count);
+                    return;
+                }
+                JobSystem::GetInstance().ParallelFor(batchCount, [&](size_t batch) {
+                    fn(batch * batchSize, std::min(count, (batch + 1) * batchSize));
+                });
+            }
+
+            void integrateVelocities(double dt) {
+                const glm::dvec3 deltaV = m_settings.gravity * dt;
+                parallelRange(m_ids.size(), [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        if (m_inverseMasses[i] > 0.0) m_velocities[i] += deltaV;
+                    }
+                });
+            }
+
+            void integratePositions(double dt) {
+                parallelRange(m_ids.size(), [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        m_previousPositions[i] = m_positions[i];
+                        m_positions[i] += m_velocities[i] * dt;
+                    }
+                });
+            }
+
+            void findContacts(double dt) {
+                const size_t count = m_ids.size();
+                m_boxes.resize(count);
+                for (size_t i = 0; i < count; ++i) m_boxes[i] = boundsOf(static_cast<uint32_t>(i));
+                m_broadphase.build(m_boxes);
+
+                m_contacts.clear();
+                m_broadphase.forEachPair([&](uint32_t a, uint32_t b) {
+                    if (m_inverseMasses[a] == 0.0 && m_inverseMasses[b] == 0.0) return;
+                    if (m_ids[a] > m_ids[b]) std::swap(a, b);
+                    addContact(a, b, dt);
+                });
+
+                // 按稳定 ID 排序, 既保证求解顺序确定, 也便于与上一步的接触归并
+                std::sort(m_contacts.begin(), m_contacts.end(),
+                          [](const ContactManifold& l, const ContactManifold& r) { return l.key() < r.key(); });
+
+                auto previous = m_previousContacts.begin();
+                for (ContactManifold& contact : m_contacts) {
+                    while (previous != m_previousContacts.end() && previous->key() < contact.key()) ++previous;
+                    if (previous != m_previousContacts.end() && previous->key() == contact.key() &&
+                        previous->normalAxis == contact.normalAxis && previous->normalSign == contact.normalSign) {
+                        contact.normalImpulse = previous->normalImpulse;
+                        contact.tangentImpulse[0] = previous->tangentImpulse[0];
+                        contact.tangentImpulse[1] = previous->tangentImpulse[1];
+                    }
+                }
+            }
+
+            void addContact(uint32_t a, uint32_t b, double dt) {
+                const AABB& boxA = m_boxes[a];
+                const AABB& boxB = m_boxes[b];
+                const double overlap[3] = {
+                    std::min(boxA.maxX, boxB.maxX) - std::max(boxA.minX, boxB.minX),
+                    std::min(boxA.maxY, boxB.maxY) - std::max(boxA.minY, boxB.minY),
+                    std::min(boxA.maxZ, boxB.maxZ) - std::max(boxA.minZ, boxB.minZ),
+                };
+
+                // 沿穿透最浅的轴分离
+                int axis = 0;
+                if (overlap[1] < overlap[axis]) axis = 1;
+                if (overlap[2] < overlap[axis]) axis = 2;
+                if (overlap[axis] <= 0.0) return;
+
+                ContactManifold contact;
+                contact.idA = m_ids[a];
+                contact.idB = m_ids[b];
+                contact.bodyA = a;
+                contact.bodyB = b;
+                contact.normalAxis = axis;
+                contact.normalSign = m_positions[b][axis] >= m_positions[a][axis] ? 1.0 : -1.0;
+                contact.penetration = overlap[axis];
+                contact.effectiveMass = 1.0 / (m_inverseMasses[a] + m_inverseMasses[b]);
+                contact.friction = std::sqrt(m_frictions[a] * m_frictions[b]);
+
+                const double normalVelocity = (m_velocities[b][axis] - m_velocities[a][axis]) * contact.normalSign;
+                const double restitution = std::max(m_restitutions[a], m_restitutions[b]);
+                double bias = m_settings.baumgarte / dt * std::max(contact.penetration - m_settings.penetrationSlop, 0.0);
+                if (normalVelocity < -m_settings.restitutionThreshold) {
+                    bias = std::max(bias, -restitution * normalVelocity);
+                }
+                contact.bias = bias;
+                m_contacts.push_back(contact);
+            }
+
+            uint32_t findRoot(uint32_t index) {
+                while (m_islandParent[index] != index) {
+                    m_islandParent[index] = m_islandParent[m_islandParent[index]];
+                    index = m_islandParent[index];
+                }
+                return index;
+            }
+
+            /**
+             * @brief 按接触连通的动态刚体划分岛, 静态刚体不连接岛
+             * 根总是集合中最小的下标, 岛按根排序, 划分结果只取决于输入。
+             */
+            void buildIslands() {
+                const uint32_t count = static_cast<uint32_t>(m_ids.size());
+                m_islandParent.resize(count);
+                for (uint32_t i = 0; i < count; ++i) m_islandParent[i] = i;
+
+                for (const ContactManifold& contact : m_contacts) {
+                    if (m_inverseMasses[contact.bodyA] == 0.0 || m_inverseMasses[contact.bodyB] == 0.0) continue;
+                    uint32_t rootA = findRoot(contact.bodyA);
+                    uint32_t rootB = findRoot(contact.bodyB);
+                    if (rootA == rootB) continue;
+                    if (rootA < rootB) m_islandParent[rootB] = rootA;
+                    else m_islandParent[rootA] = rootB;
+                }
+
+                // 根下标 -> 岛编号, 按根的大小顺序编号
+                m_islandOfRoot.assign(count, InvalidRigidBody);
+                m_contactIsland.resize(m_contacts.size());
+                for (size_t c = 0; c < m_contacts.size(); ++c) {
+                    const ContactManifold& contact = m_contacts[c];
+                    const uint32_t body = m_inverseMasses[contact.bodyA] > 0.0 ? contact.bodyA : contact.bodyB;
+                    m_contactIsland[c] = findRoot(body);
+                    m_islandOfRoot[m_contactIsland[c]] = 0;
+                }
+                m_islandCount = 0;
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (m_islandOfRoot[i] != InvalidRigidBody) m_islandOfRoot[i] = static_cast<uint32_t>(m_islandCount++);
+                }
+
+                // 计数排序得到每个岛的接触列表, 岛内保持接触键的顺序
+                m_islandStart.assign(m_islandCount + 1, 0);
+                for (size_t c = 0; c < m_contacts.size(); ++c) {
+                    m_contactIsland[c] = m_islandOfRoot[m_contactIsland[c]];
+                    ++m_islandStart[m_contactIsland[c] + 1];
+                }
+                for (size_t i = 0; i < m_islandCount; ++i) m_islandStart[i + 1] += m_islandStart[i];
+                m_islandContacts.resize(m_contacts.size());
+                m_islandCursor.assign(m_islandStart.begin(), m_islandStart.end() - 1);
+                for (size_t c = 0; c < m_contacts.size(); ++c) {
+                    m_islandContacts[m_islandCursor[m_contactIsland[c]]++] = static_cast<uint32_t>(c);
+                }
+            }
+
+            void solveIslands() {
+                if (m_islandCount == 0) return;
+                auto solve = [this](size_t island) {
+                    const uint32_t begin = m_islandStart[island];
+                    const uint32_t end = m_islandStart[island + 1];
+                    for (uint32_t i = begin; i < end; ++i) warmStart(m_contacts[m_islandContacts[i]]);
+                    for (int iteration = 0; iteration < m_settings.solverIterations; ++iteration) {
+                        for (uint32_t i = begin; i < end; ++i) solveContact(m_contacts[m_islandContacts[i]]);
+                    }
+                };
+                if (m_islandCount == 1) {
+                    solve(0);
+                } else {
+                    JobSystem::GetInstance().ParallelFor(m_islandCount, solve);
+                }
+            }
+
+            // 冲量只写入动态刚体; 静态刚体可能同时属于多个岛, 只读不写
+            void applyAxisImpulse(const ContactManifold& contact, int axis, double impulse) {
+                const double invA = m_inverseMasses[contact.bodyA];
+                const double invB = m_inverseMasses[contact.bodyB];
+                if (invA > 0.0) m_velocities[contact.bodyA][axis] -= impulse * invA;
+                if (invB > 0.0) m_velocities[contact.bodyB][axis] += impulse * invB;
+            }
+
+            static int tangentAxis(int normalAxis, int which) noexcept {
+                return (normalAxis + 1 + which) % 3;
+            }
+
+            void warmStart(const ContactManifold& contact) {
+                applyAxisImpulse(contact, contact.normalAxis, contact.normalImpulse * contact.normalSign);
+                applyAxisImpulse(contact, tangentAxis(contact.normalAxis, 0), contact.tangentImpulse[0]);
+                applyAxisImpulse(contact, tangentAxis(contact.normalAxis, 1), contact.tangentImpulse[1]);
+            }
+
+            void solveContact(ContactManifold& contact) {
+                const glm::dvec3& vA = m_velocities[contact.bodyA];
+                const glm::dvec3& vB = m_velocities[contact.bodyB];
+
+                // 法向: 累积冲量非负
+                const int axis = contact.normalAxis;
+                const double normalVelocity = (vB[axis] - vA[axis]) * contact.normalSign;
+                double lambda = contact.effectiveMass * (contact.bias - normalVelocity);
+                const double previousNormal = contact.normalImpulse;
+                contact.normalImpulse = std::max(previousNormal + lambda, 0.0);
+                applyAxisImpulse(contact, axis, (contact.normalImpulse - previousNormal) * contact.normalSign);
+
+                // 切向: 两个切轴分别限制在摩擦锥内
+                const double maxFriction = contact.friction * contact.normalImpulse;
+                for (int which = 0; which < 2; ++which) {
+                    const int tangent = tangentAxis(axis, which);
+                    const double tangentVelocity = m_velocities[contact.bodyB][tangent] - m_velocities[contact.bodyA][tangent];
+                    const double previous = contact.tangentImpulse[which];
+                    contact.tangentImpulse[which] = std::clamp(previous - contact.effectiveMass * tangentVelocity,
+                                                               -maxFriction, maxFriction);
+                    applyAxisImpulse(contact, tangent, contact.tangentImpulse[which] - previous);
+                }
+            }
+
+            PhysicsWorldSettings m_settings;
+            double m_accumulator = 0.0;
+
+            // 稳定 ID <-> 稠密下标
+            std::vector<RigidBodyId> m_ids;
+            std::vector<uint32_t> m_denseIndex;
+            std::vector<RigidBodyId> m_freeIds;
+
+            // SoA 刚体数据, 按稠密下标访问
+            std::vector<glm::dvec3> m_positions;
+            std::vector<glm::dvec3> m_previousPositions;
+            std::vector<glm::dvec3> m_velocities;
+            std::vector<glm::dvec3> m_halfExtents;
+            std::vector<double> m_inverseMasses;
+            std::vector<double> m_restitutions;
+            std::vector<double> m_frictions;
+
+            // 每步重建的临时数据, 容量跨帧复用
+            UniformGridBroadphase m_broadphase;
+            std::vector<AABB> m_boxes;
+            std::vector<ContactManifold> m_contacts;
+            std::vector<ContactManifold> m_previousContacts;   // 按 key 排序, 用于热启动
+            std::vector<uint32_t> m_islandParent;
+            std::vector<uint32_t> m_islandOfRoot;
+            std::vector<uint32_t> m_contactIsland;
+            std::vector<uint32_t> m_islandStart;
+            std::vector<uint32_t> m_islandCursor;
+            std::vector<uint32_t> m_islandContacts;
+            size_t m_islandCount = 0;
+        };
+
+    } // namespace Physics
+} // namespace PrismaEngine
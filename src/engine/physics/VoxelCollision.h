@@ -0,0 +1,359 @@
+#pragma once
+
+#include "Broadphase.h"
+#include "CollisionSystem.h"
+#include "JobSystem.h"
+#include "core/FrameAllocator.h"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Physics {
+
+        /**
+         * @brief 方块碰撞形状 - 方块局部坐标 [0, 1]^3 内的若干 AABB
+         * 对应 Minecraft: net.minecraft.world.phys.shapes.VoxelShape
+         */
+        struct BlockShape {
+            const AABB* boxes = nullptr;
+            uint32_t count = 0;
+
+            bool isEmpty() const noexcept { return count == 0; }
+
+            static BlockShape empty() noexcept { return BlockShape(); }
+
+            static BlockShape fullCube() noexcept {
+                static constexpr AABB box(0.0, 0.0, 0.0, 1.0, 1.0, 1.0);
+                return BlockShape{ &box, 1 };
+            }
+        };
+
+        /**
+         * @brief 方块 ID 到碰撞形状的映射
+         * ID 0 为空气; 未注册的非零 ID 视为完整方块。
+         */
+        class BlockShapeTable {
+        public:
+            BlockShapeTable() { m_shapes.push_back(BlockShape::empty()); }
+
+            void setEmpty(uint32_t id) { slot(id) = BlockShape::empty(); }
+            void setFullCube(uint32_t id) { slot(id) = BlockShape::fullCube(); }
+
+            /**
+             * @brief 设置自定义形状, 盒子会被裁剪到单位立方体内
+             */
+            void setShape(uint32_t id, const std::vector<AABB>& boxes) {
+                auto storage = std::make_unique<AABB[]>(boxes.size());
+                for (size_t i = 0; i < boxes.size(); ++i) {
+                    storage[i] = boxes[i].intersection(AABB(0.0, 0.0, 0.0, 1.0, 1.0, 1.0));
+                }
+                slot(id) = BlockShape{ storage.get(), static_cast<uint32_t>(boxes.size()) };
+                m_storage.push_back(std::move(storage));
+            }
+
+            BlockShape get(uint32_t id) const noexcept {
+                return id < m_shapes.size() ? m_shapes[id] : BlockShape::fullCube();
+            }
+
+        private:
+            BlockShape& slot(uint32_t id) {
+                if (id >= m_shapes.size()) m_shapes.resize(id + 1, BlockShape::fullCube());
+                return m_shapes[id];
+            }
+
+            std::vector<BlockShape> m_shapes;
+            std::vector<std::unique_ptr<AABB[]>> m_storage;
+        };
+
+        /**
+         * @brief 体素碰撞世界: 按方块坐标返回碰撞形状
+         * 实现必须支持多线程并发读取; moveEntities 会为每个作业复制一份, 因此复制应当廉价。
+         */
+        template<typename T>
+        concept VoxelCollisionWorld = std::copy_constructible<T> && requires(const T& world, int x, int y, int z) {
+            { world.getBlockShape(x, y, z) } -> std::convertible_to<BlockShape>;
+        };
+
+        /**
+         * @brief 直接读取区块存储的碰撞视图
+         *
+         * 区块为 16^3 的方块 ID 数组, 布局为 x + y * 16 + z * 256 (与 Graphic::VoxelChunk 一致)。
+         * 视图缓存最近访问的区块, 相邻方块的查询只是一次数组读取; 未加载的区块按 unloaded 形状处理,
+         * 默认视为实心以防止实体进入。
+         */
+        class ChunkGridView {
+        public:
+            static constexpr int ChunkSize = 16;
+
+            // 返回区块的方块数组, 未加载时返回 nullptr
+            using ChunkLookup = std::function<const uint16_t*(int chunkX, int chunkY, int chunkZ)>;
+            // 返回已加载区块是否全为无碰撞方块, 用于射线整块跳过
+            using EmptyLookup = std::function<bool(int chunkX, int chunkY, int chunkZ)>;
+
+            ChunkGridView(ChunkLookup lookup, const BlockShapeTable& shapes,
+                          BlockShape unloaded = BlockShape::fullCube(), EmptyLookup isEmpty = nullptr)
+                : m_lookup(std::move(lookup)), m_isEmpty(std::move(isEmpty)), m_shapes(&shapes), m_unloaded(unloaded) {}
+
+            BlockShape getBlockShape(int x, int y, int z) const {
+                const uint16_t* blocks = chunkAt(x >> 4, y >> 4, z >> 4);
+                if (!blocks) return m_unloaded;
+                return m_shapes->get(blocks[(x & 15) + (y & 15) * ChunkSize + (z & 15) * ChunkSize * ChunkSize]);
+            }
+
+            /**
+             * @brief 区块 (以区块坐标表示) 内是否没有任何碰撞形状
+             */
+            bool isSectionEmpty(int chunkX, int chunkY, int chunkZ) const {
+                if (!chunkAt(chunkX, chunkY, chunkZ)) return m_unloaded.isEmpty();
+                return m_isEmpty && m_isEmpty(chunkX, chunkY, chunkZ);
+            }
+
+        private:
+            const uint16_t* chunkAt(int cx, int cy, int cz) const {
+                if (!m_cacheValid || cx != m_cacheX || cy != m_cacheY || cz != m_cacheZ) {
+                    m_cacheBlocks = m_lookup(cx, cy, cz);
+                    m_cacheX = cx;
+                    m_cacheY = cy;
+                    m_cacheZ = cz;
+                    m_cacheValid = true;
+                }
+                return m_cacheBlocks;
+            }
+
+            ChunkLookup m_lookup;
+            EmptyLookup m_isEmpty;
+            const BlockShapeTable* m_shapes;
+            BlockShape m_unloaded;
+
+            // 单线程缓存, 每个作业使用自己的副本
+            mutable const uint16_t* m_cacheBlocks = nullptr;
+            mutable int m_cacheX = 0, m_cacheY = 0, m_cacheZ = 0;
+            mutable bool m_cacheValid = false;
+        };
+
+        /**
+         * @brief 批量移动的实体状态
+         */
+        struct EntityMotion {
+            AABB box;                      // 输入当前包围盒, 输出移动后的包围盒
+            glm::dvec3 movement{0.0};      // 输入期望位移, 输出实际位移
+            double stepHeight = 0.0;       // 可自动走上的台阶高度 (Minecraft: maxUpStep)
+            bool onGround = false;         // 输入上一步是否着地, 输出本步结果
+            bool horizontalCollision = false;
+            bool verticalCollision = false;
+        };
+
+        /**
+         * @brief 体素世界碰撞
+         * 对应 Minecraft: Entity.collide / Shapes.collide
+         */
+        class VoxelCollision {
+        public:
+            static constexpr double Epsilon = 1e-7;
+
+            /**
+             * @brief 收集与 region 相交的方块碰撞盒 (世界坐标)
+             */
+            template<VoxelCollisionWorld World, typename Container>
+            static void collectBlockBoxes(const World& world, const AABB& region, Container& out) {
+                const int x0 = static_cast<int>(std::floor(region.minX - Epsilon));
+                const int y0 = static_cast<int>(std::floor(region.minY - Epsilon));
+                const int z0 = static_cast<int>(std::floor(region.minZ - Epsilon));
+                const int x1 = static_cast<int>(std::floor(region.maxX + Epsilon));
+                const int y1 = static_cast<int>(std::floor(region.maxY + Epsilon));
+                const int z1 = static_cast<int>(std::floor(region.maxZ + Epsilon));
+
+                // z, y, x 的顺序与区块数组布局一致, 连续访问同一区块
+                for (int z = z0; z <= z1; ++z) {
+                    for (int y = y0; y <= y1; ++y) {
+                        for (int x = x0; x <= x1; ++x) {
+                            BlockShape shape = world.getBlockShape(x, y, z);
+                            for (uint32_t i = 0; i < shape.count; ++i) {
+                                AABB box = shape.boxes[i].move(x, y, z);
+                                if (box.intersects(region)) out.push_back(box);
+                            }
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief 沿单轴裁剪位移, 使 box 移动 delta 后不进入 other
+             */
+            static double clipAxis(const AABB& box, const AABB& other, int axis, double delta) noexcept {
+                const double boxMin[3]   = { box.minX, box.minY, box.minZ };
+                const double boxMax[3]   = { box.maxX, box.maxY, box.maxZ };
+                const double otherMin[3] = { other.minX, other.minY, other.minZ };
+                const double otherMax[3] = { other.maxX, other.maxY, other.maxZ };
+
+                // 其余两轴必须重叠
+                for (int i = 0; i < 3; ++i) {
+                    if (i == axis) continue;
+                    if (boxMax[i] <= otherMin[i] + Epsilon || boxMin[i] >= otherMax[i] - Epsilon) return delta;
+                }
+                if (delta > 0.0 && otherMin[axis] >= boxMax[axis] - Epsilon) {
+                    delta = std::min(delta, otherMin[axis] - boxMax[axis]);
+                } else if (delta < 0.0 && otherMax[axis] <= boxMin[axis] + Epsilon) {
+                    delta = std::max(delta, otherMax[axis] - boxMin[axis]);
+                }
+                return delta;
+            }
+
+            /**
+             * @brief 分轴扫掠: 先 Y 轴, 再按位移较大的水平轴优先
+             * @param boxes 可能碰撞的方块盒
+             * @return 碰撞后的实际位移
+             */
+            static glm::dvec3 collideWithBoxes(const AABB& box, const glm::dvec3& movement,
+                                               std::span<const AABB> boxes) noexcept {
+                glm::dvec3 result(0.0);
+                AABB current = box;
+
+                auto sweep = [&](int axis) {
+                    double delta = movement[axis];
+                    if (std::abs(delta) < Epsilon) return;
+                    for (const AABB& other : boxes) {
+                        delta = clipAxis(current, other, axis, delta);
+                        if (std::abs(delta) < Epsilon) {
+                            delta = 0.0;
+                            break;
+                        }
+                    }
+                    result[axis] = delta;
+                    glm::dvec3 offset(0.0);
+                    offset[axis] = delta;
+                    current = current.move(offset);
+                };
+
+                sweep(1);
+                if (std::abs(movement.x) < std::abs(movement.z)) {
+                    sweep(2);
+                    sweep(0);
+                } else {
+                    sweep(0);
+                    sweep(2);
+                }
+                return result;
+            }
+
+            /**
+             * @brief 移动单个实体, 包含台阶处理
+             * @param scratch 临时存放方块盒的容器, 调用之间可复用
+             */
+            template<VoxelCollisionWorld World, typename Container>
+            static void moveEntity(const World& world, EntityMotion& motion, Container& scratch) {
+                const glm::dvec3 wanted = motion.movement;
+                const AABB start = motion.box;
+
+                scratch.clear();
+                AABB region = start.unionAABB(start.move(wanted));
+                if (motion.stepHeight > 0.0) {
+                    region = region.expand(0.0, motion.stepHeight, 0.0);
+                }
+                collectBlockBoxes(world, region, scratch);
+
+                std::span<const AABB> boxes(scratch.data(), scratch.size());
+                glm::dvec3 moved = collideWithBoxes(start, wanted, boxes);
+
+                const bool blockedX = std::abs(moved.x - wanted.x) > Epsilon;
+                const bool blockedZ = std::abs(moved.z - wanted.z) > Epsilon;
+                const bool landing = wanted.y < 0.0 && std::abs(moved.y - wanted.y) > Epsilon;
+
+                // 台阶: 着地时水平受阻, 尝试先抬高再水平移动再落下, 取水平距离更远的结果
+                if (motion.stepHeight > 0.0 && (motion.onGround || landing) && (blockedX || blockedZ)) {
+                    glm::dvec3 up = collideWithBoxes(start, glm::dvec3(0.0, motion.stepHeight, 0.0), boxes);
+                    AABB raised = start.move(up);
+                    glm::dvec3 across = collideWithBoxes(raised, glm::dvec3(wanted.x, 0.0, wanted.z), boxes);
+                    AABB shifted = raised.move(across);
+                    glm::dvec3 down = collideWithBoxes(shifted, glm::dvec3(0.0, -up.y + std::min(wanted.y, 0.0), 0.0), boxes);
+                    glm::dvec3 stepped = up + across + down;
+
+                    double steppedDist = stepped.x * stepped.x + stepped.z * stepped.z;
+                    double movedDist   = moved.x * moved.x + moved.z * moved.z;
+                    if (steppedDist > movedDist + Epsilon) moved = stepped;
+                }
+
+                motion.box = start.move(moved);
+                motion.horizontalCollision = std::abs(moved.x - wanted.x) > Epsilon ||
+                                             std::abs(moved.z - wanted.z) > Epsilon;
+                motion.verticalCollision = std::abs(moved.y - wanted.y) > Epsilon;
+                motion.onGround = motion.verticalCollision && wanted.y < 0.0;
+                motion.movement = moved;
+            }
+
+            /**
+             * @brief 并行移动大量实体
+             *
+             * 实体之间互不阻挡 (实体间的推挤见 pushEntitiesApart), 因此各实体可独立求解。
+             * 按 batchSize 分批提交到 JobSystem, 每批复用一个临时 arena 上的方块盒缓冲区。
+             */
+            template<VoxelCollisionWorld World>
+            static void moveEntities(std::span<EntityMotion> entities, const World& world, size_t batchSize = 64) {
+                if (entities.empty()) return;
+                batchSize = std::max<size_t>(batchSize, 1);
+                const size_t batchCount = (entities.size() + batchSize - 1) / batchSize;
+
+                auto runBatch = [&](size_t batch) {
+                    World localWorld(world);
+                    Core::ScopedArena scope(Core::FrameMemory::GetScratchArena());
+                    std::pmr::vector<AABB> scratch(scope.Resource());
+                    scratch.reserve(64);
+
+                    const size_t begin = batch * batchSize;
+                    const size_t end = std::min(begin + batchSize, entities.size());
+                    for (size_t i = begin; i < end; ++i) {
+                        moveEntity(localWorld, entities[i], scratch);
+                    }
+                };
+
+                if (batchCount == 1) {
+                    runBatch(0);
+                } else {
+                    JobSystem::GetInstance().ParallelFor(batchCount, runBatch);
+                }
+            }
+
+            /**
+             * @brief 相互重叠的实体沿水平方向互相推开, 结果累加到 movement
+             * 对应 Minecraft: Entity.push。每个实体只写自己的位移, 可安全并行。
+             * broadphase 必须由 entities 的包围盒按相同顺序构建。
+             */
+            static void pushEntitiesApart(std::span<EntityMotion> entities, const UniformGridBroadphase& broadphase,
+                                          double strength = 0.05) {
+                if (entities.size() < 2) return;
+
+                JobSystem::GetInstance().ParallelFor(entities.size(), [&](size_t i) {
+                    const AABB& box = broadphase.getBox(static_cast<uint32_t>(i));
+                    const glm::dvec3 center = box.getCenter();
+                    glm::dvec3 push(0.0);
+
+                    broadphase.query(box, [&](uint32_t other) {
+                        if (other == i) return;
+                        glm::dvec3 delta = center - broadphase.getBox(other).getCenter();
+                        double distance = std::max(std::abs(delta.x), std::abs(delta.z));
+                        if (distance < 0.01) {
+                            // 完全重合时按索引决定方向, 保证两者向相反方向分开
+                            push.x += (i < other ? -1.0 : 1.0) * strength;
+                            return;
+                        }
+                        distance = std::sqrt(distance);
+                        double scale = std::min(1.0, 1.0 / distance) / distance * strength;
+                        push.x += delta.x * scale;
+                        push.z += delta.z * scale;
+                    });
+
+                    entities[i].movement += push;
+                });
+            }
+        };
+
+    } // namespace Physics
+} // namespace PrismaEngine
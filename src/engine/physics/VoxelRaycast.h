@@ -0,0 +1,279 @@
+#pragma once
+
+#include "CollisionSystem.h"
+#include "JobSystem.h"
+#include "VoxelCollision.h"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace PrismaEngine {
+    namespace Physics {
+
+        /**
+         * @brief 可按 16^3 区块整体判空的体素世界, 射线遍历会整块跳过空区块
+         */
+        template<typename T>
+        concept VoxelSectionWorld = VoxelCollisionWorld<T> && requires(const T& world, int x, int y, int z) {
+            { world.isSectionEmpty(x, y, z) } -> std::convertible_to<bool>;
+        };
+
+        /**
+         * @brief 体素射线检测结果
+         * 对应 Minecraft: net.minecraft.world.phys.BlockHitResult
+         */
+        struct VoxelRayHit {
+            bool isValid = false;
+            glm::ivec3 block{0};        // 命中的方块坐标
+            glm::dvec3 position{0.0};   // 命中点
+            glm::dvec3 normal{0.0};     // 命中面法线, 射线起点在方块内时为 0
+            double distance = 0.0;
+            RaycastHit::FaceDirection faceDirection = RaycastHit::FaceDirection::UP;
+        };
+
+        /**
+         * @brief 批量射线检测的输入
+         */
+        struct VoxelRay {
+            glm::dvec3 origin{0.0};
+            glm::dvec3 direction{0.0, 0.0, 1.0};
+            double maxDistance = 0.0;
+        };
+
+        /**
+         * @brief 体素射线遍历 (Amanatides–Woo)
+         *
+         * 逐格步进方块网格, 每步只比较三个轴的下一边界; 世界提供 isSectionEmpty 时, 空的 16^3 区块
+         * 一次跳过。完整方块直接以进入面作为命中, 只有非完整形状才做逐盒的精确检测。
+         * 代替 CollisionSystem::rayCastMultiple 用于方块拾取、视线和爆炸检测。
+         */
+        class VoxelRaycast {
+        public:
+            static constexpr int SectionSize = 16;
+
+            /**
+             * @brief 沿射线遍历所有非空方块
+             * @param visitor bool(const glm::ivec3& block, BlockShape shape, double tEnter, double tExit, int enterAxis),
+             *                返回 false 停止遍历; enterAxis 为进入该格时跨越的轴, 起点所在格为 -1
+             * @param direction 必须已归一化, t 即距离
+             */
+            template<VoxelCollisionWorld World, typename Visitor>
+            static void traverse(const World& world, const glm::dvec3& origin, const glm::dvec3& direction,
+                                 double maxDistance, Visitor&& visitor) {
+                constexpr double Inf = std::numeric_limits<double>::infinity();
+
+                glm::ivec3 cell(static_cast<int>(std::floor(origin.x)),
+                                static_cast<int>(std::floor(origin.y)),
+                                static_cast<int>(std::floor(origin.z)));
+                glm::ivec3 step(0);
+                glm::dvec3 tMax(Inf);
+                glm::dvec3 tDelta(Inf);
+
+                for (int axis = 0; axis < 3; ++axis) {
+                    if (direction[axis] > 0.0) {
+                        step[axis]   = 1;
+                        tDelta[axis] = 1.0 / direction[axis];
+                        tMax[axis]   = (cell[axis] + 1 - origin[axis]) * tDelta[axis];
+                    } else if (direction[axis] < 0.0) {
+                        step[axis]   = -1;
+                        tDelta[axis] = -1.0 / direction[axis];
+                        tMax[axis]   = (origin[axis] - cell[axis]) * tDelta[axis];
+                    }
+                }
+
+                double t = 0.0;
+                int enterAxis = -1;
+
+                while (t <= maxDistance) {
+                    if constexpr (VoxelSectionWorld<World>) {
+                        const int sx = cell.x >> 4, sy = cell.y >> 4, sz = cell.z >> 4;
+                        if (world.isSectionEmpty(sx, sy, sz)) {
+                            // 求射线离开整个区块的时刻, 在离开的轴上直接跨到相邻区块
+                            const glm::ivec3 section(sx, sy, sz);
+                            double exitT = Inf;
+                            int exitAxis = 0;
+                            for (int axis = 0; axis < 3; ++axis) {
+                                if (step[axis] == 0) continue;
+                                int boundary = step[axis] > 0 ? (section[axis] + 1) * SectionSize
+                                                              : section[axis] * SectionSize;
+                                double axisT = (boundary - origin[axis]) / direction[axis];
+                                if (axisT < exitT) {
+                                    exitT = axisT;
+                                    exitAxis = axis;
+                                }
+                            }
+                            if (exitT > maxDistance) return;
+
+                            for (int axis = 0; axis < 3; ++axis) {
+                                if (axis == exitAxis) {
+                                    cell[axis] = step[axis] > 0 ? (section[axis] + 1) * SectionSize
+                                                                : section[axis] * SectionSize - 1;
+                                } else {
+                                    // 浮点误差可能让其他轴落到区块外, 限制在当前区块范围内
+                                    int c = static_cast<int>(std::floor(origin[axis] + direction[axis] * exitT));
+                                    cell[axis] = std::clamp(c, section[axis] * SectionSize,
+                                                            section[axis] * SectionSize + SectionSize - 1);
+                                }
+                                if (step[axis] > 0) {
+                                    tMax[axis] = (cell[axis] + 1 - origin[axis]) * tDelta[axis];
+                                } else if (step[axis] < 0) {
+                                    tMax[axis] = (origin[axis] - cell[axis]) * tDelta[axis];
+                                }
+                            }
+                            t = exitT;
+                            enterAxis = exitAxis;
+                            continue;
+                        }
+                    }
+
+                    const int axis = tMax.x < tMax.y ? (tMax.x < tMax.z ? 0 : 2) : (tMax.y < tMax.z ? 1 : 2);
+                    const double cellExit = tMax[axis];
+
+                    BlockShape shape = world.getBlockShape(cell.x, cell.y, cell.z);
+                    if (!shape.isEmpty() && !visitor(cell, shape, t, std::min(cellExit, maxDistance), enterAxis)) {
+                        return;
+                    }
+
+                    t = cellExit;
+                    enterAxis = axis;
+                    cell[axis] += step[axis];
+                    tMax[axis] += tDelta[axis];
+                }
+            }
+
+            /**
+             * @brief 返回射线命中的第一个方块
+             */
+            template<VoxelCollisionWorld World>
+            static VoxelRayHit raycast(const World& world, const glm::dvec3& origin, const glm::dvec3& direction,
+                                       double maxDistance) {
+                VoxelRayHit result;
+                const double length = glm::length(direction);
+                if (length < 1e-12) return result;
+                const glm::dvec3 dir = direction / length;
+
+                traverse(world, origin, dir, maxDistance,
+                         [&](const glm::ivec3& block, BlockShape shape, double tEnter, double tExit, int enterAxis) {
+                    double hitT = 0.0;
+                    int hitAxis = enterAxis;
+                    if (isFullCube(shape)) {
+                        hitT = tEnter;
+                    } else if (!intersectShape(origin, dir, block, shape, tEnter, tExit, hitT, hitAxis)) {
+                        return true;
+                    }
+
+                    result.isValid  = true;
+                    result.block    = block;
+                    result.distance = hitT;
+                    result.position = origin + dir * hitT;
+                    if (hitAxis >= 0) {
+                        result.normal[hitAxis] = dir[hitAxis] > 0.0 ? -1.0 : 1.0;
+                        result.faceDirection = faceOf(hitAxis, dir[hitAxis] > 0.0);
+                    }
+                    return false;
+                });
+                return result;
+            }
+
+            /**
+             * @brief from 与 to 之间是否没有方块阻挡
+             * 对应 Minecraft: BlockGetter.isBlockInLine
+             */
+            template<VoxelCollisionWorld World>
+            static bool hasLineOfSight(const World& world, const glm::dvec3& from, const glm::dvec3& to) {
+                const glm::dvec3 delta = to - from;
+                const double distance = glm::length(delta);
+                if (distance < 1e-12) return true;
+                return !raycast(world, from, delta, distance).isValid;
+            }
+
+            /**
+             * @brief 并行检测大量射线 (AI 视线、爆炸等), hits[i] 对应 rays[i]
+             */
+            template<VoxelCollisionWorld World>
+            static void raycastBatch(const World& world, std::span<const VoxelRay> rays, std::span<VoxelRayHit> hits,
+                                     size_t batchSize = 64) {
+                const size_t count = std::min(rays.size(), hits.size());
+                if (count == 0) return;
+                batchSize = std::max<size_t>(batchSize, 1);
+                const size_t batchCount = (count + batchSize - 1) / batchSize;
+
+                auto runBatch = [&](size_t batch) {
+                    World localWorld(world);
+                    const size_t end = std::min((batch + 1) * batchSize, count);
+                    for (size_t i = batch * batchSize; i < end; ++i) {
+                        hits[i] = raycast(localWorld, rays[i].origin, rays[i].direction, rays[i].maxDistance);
+                    }
+                };
+
+                if (batchCount == 1) {
+                    runBatch(0);
+                } else {
+                    JobSystem::GetInstance().ParallelFor(batchCount, runBatch);
+                }
+            }
+
+        private:
+            static bool isFullCube(BlockShape shape) noexcept {
+                return shape.count == 1 && shape.boxes[0] == AABB(0.0, 0.0, 0.0, 1.0, 1.0, 1.0);
+            }
+
+            static RaycastHit::FaceDirection faceOf(int axis, bool positiveDirection) noexcept {
+                // 射线沿正方向前进时命中的是负方向的面
+                switch (axis) {
+                    case 0:  return positiveDirection ? RaycastHit::FaceDirection::WEST : RaycastHit::FaceDirection::EAST;
+                    case 1:  return positiveDirection ? RaycastHit::FaceDirection::DOWN : RaycastHit::FaceDirection::UP;
+                    default: return positiveDirection ? RaycastHit::FaceDirection::NORTH : RaycastHit::FaceDirection::SOUTH;
+                }
+            }
+
+            /**
+             * @brief 射线与非完整形状的精确检测, 只接受位于本格 [tEnter, tExit] 内的命中
+             */
+            static bool intersectShape(const glm::dvec3& origin, const glm::dvec3& dir, const glm::ivec3& block,
+                                       BlockShape shape, double tEnter, double tExit, double& hitT, int& hitAxis) {
+                bool found = false;
+                double best = tExit;
+                for (uint32_t i = 0; i < shape.count; ++i) {
+                    const AABB box = shape.boxes[i].move(block.x, block.y, block.z);
+                    const double boxMin[3] = { box.minX, box.minY, box.minZ };
+                    const double boxMax[3] = { box.maxX, box.maxY, box.maxZ };
+
+                    double near = -std::numeric_limits<double>::infinity();
+                    double far  = std::numeric_limits<double>::infinity();
+                    int nearAxis = -1;
+                    bool miss = false;
+                    for (int axis = 0; axis < 3 && !miss; ++axis) {
+                        if (std::abs(dir[axis]) < 1e-12) {
+                            miss = origin[axis] < boxMin[axis] || origin[axis] > boxMax[axis];
+                            continue;
+                        }
+                        double t1 = (boxMin[axis] - origin[axis]) / dir[axis];
+                        double t2 = (boxMax[axis] - origin[axis]) / dir[axis];
+                        if (t1 > t2) std::swap(t1, t2);
+                        if (t1 > near) {
+                            near = t1;
+                            nearAxis = axis;
+                        }
+                        far = std::min(far, t2);
+                        miss = near > far;
+                    }
+                    if (miss || far < 0.0) continue;
+
+                    // 起点在盒内时命中距离为 0
+                    double t = std::max(near, 0.0);
+                    if (t < tEnter - 1e-9 || t > best) continue;
+                    best = t;
+                    hitAxis = near >= 0.0 ? nearAxis : -1;
+                    found = true;
+                }
+                if (found) hitT = best;
+                return found;
+            }
+        };
+
+    } // namespace Physics
+} // namespace PrismaEngine
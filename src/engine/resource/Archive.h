@@ -4,7 +4,10 @@
 #include <filesystem>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <type_traits>
 #include "../Export.h"
+#include "BinaryBuffer.h"
 
 namespace PrismaEngine {
     namespace Serialization {
@@ -32,6 +35,23 @@ namespace PrismaEngine {
             // 基础类型特化由 cpp 提供，自定义类型通过此模板分发
             template<typename T>
             void SerializeValue(const std::string& key, const T& value);
+
+            /// <summary>
+            /// 写入数组; 二进制存档中平凡可复制的元素整块复制, 其他情况逐个调用 SerializeValue
+            /// </summary>
+            template<typename T>
+            void SerializeArray(const std::string& key, const T* data, uint32_t count);
+
+            template<typename T>
+            void SerializeArray(const std::string& key, const std::vector<T>& values) {
+                static_assert(!std::is_same_v<T, bool>, "std::vector<bool> is not supported");
+                SerializeArray(key, values.data(), static_cast<uint32_t>(values.size()));
+            }
+
+            /// <summary>
+            /// 二进制存档的输出缓冲区, 其他存档为空
+            /// </summary>
+            BinaryOutputBuffer* GetBinaryBuffer() const { return m_binaryBuffer; }
             
             virtual void WriteBool(bool value) = 0;
             virtual void WriteInt32(int32_t value) = 0;
@@ -49,6 +69,10 @@ namespace PrismaEngine {
             virtual void EndObject() = 0;
             virtual void EndArray() = 0;
             virtual void EnterField(const std::string& key) = 0;
+
+        protected:
+            // 非空时基础类型和数组直接写入缓冲区, 不经过虚函数
+            BinaryOutputBuffer* m_binaryBuffer = nullptr;
         };
 
         /// <summary>
@@ -66,6 +90,24 @@ namespace PrismaEngine {
             template<typename T>
             void DeserializeValue(const std::string& key, T& value);
 
+            /// <summary>
+            /// 读取 SerializeArray 写入的数组
+            /// </summary>
+            template<typename T>
+            void DeserializeArray(const std::string& key, std::vector<T>& values);
+
+            /// <summary>
+            /// 读取定长数组, 多余的元素被跳过
+            /// </summary>
+            /// <returns>实际读取的元素数</returns>
+            template<typename T>
+            uint32_t DeserializeArray(const std::string& key, T* data, uint32_t capacity);
+
+            /// <summary>
+            /// 二进制存档的输入游标, 其他存档为空
+            /// </summary>
+            BinaryReader* GetBinaryReader() const { return m_binaryReader; }
+
             virtual bool ReadBool() = 0;
             virtual int32_t ReadInt32() = 0;
             virtual uint32_t ReadUInt32() = 0;
@@ -84,24 +126,185 @@ namespace PrismaEngine {
             virtual bool HasNextField() = 0;
             virtual bool HasNextField(const std::string& expectedField) = 0;
             virtual void EnterField(const std::string& key) = 0;
+
+        protected:
+            // 非空时基础类型和数组直接从输入内存读取, 不经过虚函数
+            BinaryReader* m_binaryReader = nullptr;
         };
 
-        // 基础类型特化声明
-        template<> ENGINE_API void OutputArchive::SerializeValue<bool>(const std::string& key, const bool& value);
-        template<> ENGINE_API void OutputArchive::SerializeValue<int32_t>(const std::string& key, const int32_t& value);
-        template<> ENGINE_API void OutputArchive::SerializeValue<uint32_t>(const std::string& key, const uint32_t& value);
-        template<> ENGINE_API void OutputArchive::SerializeValue<float>(const std::string& key, const float& value);
-        template<> ENGINE_API void OutputArchive::SerializeValue<double>(const std::string& key, const double& value);
-        template<> ENGINE_API void OutputArchive::SerializeValue<std::string>(const std::string& key, const std::string& value);
-        template<> ENGINE_API void OutputArchive::SerializeValue<std::filesystem::path>(const std::string& key, const std::filesystem::path& value);
-
-        template<> ENGINE_API void InputArchive::DeserializeValue<bool>(const std::string& key, bool& value);
-        template<> ENGINE_API void InputArchive::DeserializeValue<int32_t>(const std::string& key, int32_t& value);
-        template<> ENGINE_API void InputArchive::DeserializeValue<uint32_t>(const std::string& key, uint32_t& value);
-        template<> ENGINE_API void InputArchive::DeserializeValue<float>(const std::string& key, float& value);
-        template<> ENGINE_API void InputArchive::DeserializeValue<double>(const std::string& key, double& value);
-        template<> ENGINE_API void InputArchive::DeserializeValue<std::string>(const std::string& key, std::string& value);
-        template<> ENGINE_API void InputArchive::DeserializeValue<std::filesystem::path>(const std::string& key, std::filesystem::path& value);
+        // ========================================================================
+        // 基础类型特化
+        // ========================================================================
+
+        template<>
+        inline void OutputArchive::SerializeValue<bool>(const std::string& key, const bool& value) {
+            if (m_binaryBuffer) { m_binaryBuffer->WriteValue(static_cast<uint8_t>(value ? 1 : 0)); return; }
+            SetCurrent(key);
+            WriteBool(value);
+        }
+
+        template<>
+        inline void OutputArchive::SerializeValue<int32_t>(const std::string& key, const int32_t& value) {
+            if (m_binaryBuffer) { m_binaryBuffer->WriteValue(value); return; }
+            SetCurrent(key);
+            WriteInt32(value);
+        }
+
+        template<>
+        inline void OutputArchive::SerializeValue<uint32_t>(const std::string& key, const uint32_t& value) {
+            if (m_binaryBuffer) { m_binaryBuffer->WriteValue(value); return; }
+            SetCurrent(key);
+            WriteUInt32(value);
+        }
+
+        template<>
+        inline void OutputArchive::SerializeValue<float>(const std::string& key, const float& value) {
+            if (m_binaryBuffer) { m_binaryBuffer->WriteValue(value); return; }
+            SetCurrent(key);
+            WriteFloat(value);
+        }
+
+        template<>
+        inline void OutputArchive::SerializeValue<double>(const std::string& key, const double& value) {
+            if (m_binaryBuffer) { m_binaryBuffer->WriteValue(value); return; }
+            SetCurrent(key);
+            WriteDouble(value);
+        }
+
+        template<>
+        inline void OutputArchive::SerializeValue<std::string>(const std::string& key, const std::string& value) {
+            if (m_binaryBuffer) {
+                m_binaryBuffer->WriteValue(static_cast<uint32_t>(value.size()));
+                m_binaryBuffer->Write(value.data(), value.size());
+                return;
+            }
+            SetCurrent(key);
+            WriteString(value);
+        }
+
+        template<>
+        inline void OutputArchive::SerializeValue<std::filesystem::path>(const std::string& key, const std::filesystem::path& value) {
+            SerializeValue(key, value.string());
+        }
+
+        template<>
+        inline void InputArchive::DeserializeValue<bool>(const std::string& key, bool& value) {
+            if (m_binaryReader) { value = m_binaryReader->ReadValue<uint8_t>() != 0; return; }
+            SetCurrent(key);
+            value = ReadBool();
+        }
+
+        template<>
+        inline void InputArchive::DeserializeValue<int32_t>(const std::string& key, int32_t& value) {
+            if (m_binaryReader) { value = m_binaryReader->ReadValue<int32_t>(); return; }
+            SetCurrent(key);
+            value = ReadInt32();
+        }
+
+        template<>
+        inline void InputArchive::DeserializeValue<uint32_t>(const std::string& key, uint32_t& value) {
+            if (m_binaryReader) { value = m_binaryReader->ReadValue<uint32_t>(); return; }
+            SetCurrent(key);
+            value = ReadUInt32();
+        }
+
+        template<>
+        inline void InputArchive::DeserializeValue<float>(const std::string& key, float& value) {
+            if (m_binaryReader) { value = m_binaryReader->ReadValue<float>(); return; }
+            SetCurrent(key);
+            value = ReadFloat();
+        }
+
+        template<>
+        inline void InputArchive::DeserializeValue<double>(const std::string& key, double& value) {
+            if (m_binaryReader) { value = m_binaryReader->ReadValue<double>(); return; }
+            SetCurrent(key);
+            value = ReadDouble();
+        }
+
+        template<>
+        inline void InputArchive::DeserializeValue<std::string>(const std::string& key, std::string& value) {
+            if (m_binaryReader) {
+                uint32_t size = m_binaryReader->ReadValue<uint32_t>();
+                value.assign(reinterpret_cast<const char*>(m_binaryReader->View(size)), size);
+                return;
+            }
+            SetCurrent(key);
+            value = ReadString();
+        }
+
+        template<>
+        inline void InputArchive::DeserializeValue<std::filesystem::path>(const std::string& key, std::filesystem::path& value) {
+            std::string str;
+            DeserializeValue(key, str);
+            value = std::filesystem::path(str);
+        }
+
+        // ========================================================================
+        // 数组
+        // ========================================================================
+
+        template<typename T>
+        inline void OutputArchive::SerializeArray(const std::string& key, const T* data, uint32_t count) {
+            if constexpr (std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>) {
+                if (m_binaryBuffer) {
+                    m_binaryBuffer->WriteValue(count);
+                    m_binaryBuffer->Write(data, static_cast<size_t>(count) * sizeof(T));
+                    return;
+                }
+            }
+
+            BeginArray(key, count);
+            for (uint32_t i = 0; i < count; ++i) {
+                SerializeValue(key, data[i]);
+            }
+            EndArray();
+        }
+
+        template<typename T>
+        inline void InputArchive::DeserializeArray(const std::string& key, std::vector<T>& values) {
+            static_assert(!std::is_same_v<T, bool>, "std::vector<bool> is not supported");
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (m_binaryReader) {
+                    uint32_t count = m_binaryReader->ReadValue<uint32_t>();
+                    // 先检查剩余数据, 损坏的数量不会触发巨大的分配
+                    const uint8_t* bytes = m_binaryReader->View(static_cast<size_t>(count) * sizeof(T));
+                    values.resize(count);
+                    if (count > 0) std::memcpy(values.data(), bytes, static_cast<size_t>(count) * sizeof(T));
+                    return;
+                }
+            }
+
+            uint32_t count = 0;
+            BeginArray(key, count);
+            values.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                DeserializeValue(key, values[i]);
+            }
+            EndArray();
+        }
+
+        template<typename T>
+        inline uint32_t InputArchive::DeserializeArray(const std::string& key, T* data, uint32_t capacity) {
+            if constexpr (std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>) {
+                if (m_binaryReader) {
+                    uint32_t count = m_binaryReader->ReadValue<uint32_t>();
+                    uint32_t read  = std::min(count, capacity);
+                    m_binaryReader->ReadBytes(data, static_cast<size_t>(read) * sizeof(T));
+                    m_binaryReader->Skip(static_cast<size_t>(count - read) * sizeof(T));
+                    return read;
+                }
+            }
+
+            uint32_t count = 0;
+            BeginArray(key, count);
+            uint32_t read = std::min(count, capacity);
+            for (uint32_t i = 0; i < read; ++i) {
+                DeserializeValue(key, data[i]);
+            }
+            EndArray();
+            return read;
+        }
 
     } // namespace Serialization
 } // namespace PrismaEngine
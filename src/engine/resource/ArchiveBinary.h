@@ -1,6 +1,7 @@
 #pragma once
 #include "SerializationVersion.h"
 #include "Archive.h"
+#include "BinaryBuffer.h"
 #include <vector>
 #include <fstream>
 
@@ -8,19 +9,36 @@ namespace PrismaEngine {
     namespace Serialization {
 
         // 二进制输出存档
+        // 写入 BinaryOutputBuffer; 基础类型和数组经由 OutputArchive 的快速路径直接写入, 不调用下面的虚函数
         class BinaryOutputArchive : public OutputArchive {
         public:
-            explicit BinaryOutputArchive(std::ostream& stream) : m_stream(stream) {}
+            explicit BinaryOutputArchive(BinaryOutputBuffer& buffer) : m_buffer(buffer) { m_binaryBuffer = &m_buffer; }
 
-            void WriteBool(bool value) override { m_stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
-            void WriteInt32(int32_t value) override { m_stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
-            void WriteUInt32(uint32_t value) override { m_stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
-            void WriteFloat(float value) override { m_stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
-            void WriteDouble(double value) override { m_stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+            // 流版本先写入内部缓冲区, 析构或 Flush 时一次性写入流
+            explicit BinaryOutputArchive(std::ostream& stream) : m_buffer(m_ownedBuffer), m_stream(&stream) {
+                m_binaryBuffer = &m_buffer;
+            }
+
+            ~BinaryOutputArchive() override { Flush(); }
+
+            BinaryOutputArchive(const BinaryOutputArchive&)            = delete;
+            BinaryOutputArchive& operator=(const BinaryOutputArchive&) = delete;
+
+            void Flush() {
+                if (!m_stream || m_buffer.Size() == 0) return;
+                m_stream->write(reinterpret_cast<const char*>(m_buffer.Data()), static_cast<std::streamsize>(m_buffer.Size()));
+                m_buffer.Clear();
+            }
+
+            void WriteBool(bool value) override { m_buffer.WriteValue(static_cast<uint8_t>(value ? 1 : 0)); }
+            void WriteInt32(int32_t value) override { m_buffer.WriteValue(value); }
+            void WriteUInt32(uint32_t value) override { m_buffer.WriteValue(value); }
+            void WriteFloat(float value) override { m_buffer.WriteValue(value); }
+            void WriteDouble(double value) override { m_buffer.WriteValue(value); }
             void WriteString(const std::string& value) override {
                 uint32_t size = static_cast<uint32_t>(value.size());
                 WriteUInt32(size);
-                m_stream.write(value.data(), size);
+                m_buffer.Write(value.data(), size);
             }
 
             // 带 Key 版本
@@ -37,24 +55,37 @@ namespace PrismaEngine {
             void EnterField(const std::string& /*key*/) override {}
 
         private:
-            std::ostream& m_stream;
+            BinaryOutputBuffer m_ownedBuffer;
+            BinaryOutputBuffer& m_buffer;
+            std::ostream* m_stream = nullptr;
         };
 
         // 二进制输入存档
+        // 直接读取内存映射文件或内存缓冲区, 数据在存档使用期间必须有效
         class BinaryInputArchive : public InputArchive {
         public:
-            explicit BinaryInputArchive(std::istream& stream) : m_stream(stream) {}
+            BinaryInputArchive(const uint8_t* data, size_t size) : m_reader(data, size) { m_binaryReader = &m_reader; }
+
+            // 流版本先读入全部剩余数据
+            explicit BinaryInputArchive(std::istream& stream)
+                : m_ownedData(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>())
+                , m_reader(m_ownedData.data(), m_ownedData.size()) {
+                m_binaryReader = &m_reader;
+            }
+
+            BinaryInputArchive(const BinaryInputArchive&)            = delete;
+            BinaryInputArchive& operator=(const BinaryInputArchive&) = delete;
+
+            BinaryReader& GetReader() { return m_reader; }
 
-            bool ReadBool() override { bool v; m_stream.read(reinterpret_cast<char*>(&v), sizeof(v)); return v; }
-            int32_t ReadInt32() override { int32_t v; m_stream.read(reinterpret_cast<char*>(&v), sizeof(v)); return v; }
-            uint32_t ReadUInt32() override { uint32_t v; m_stream.read(reinterpret_cast<char*>(&v), sizeof(v)); return v; }
-            float ReadFloat() override { float v; m_stream.read(reinterpret_cast<char*>(&v), sizeof(v)); return v; }
-            double ReadDouble() override { double v; m_stream.read(reinterpret_cast<char*>(&v), sizeof(v)); return v; }
+            bool ReadBool() override { return m_reader.ReadValue<uint8_t>() != 0; }
+            int32_t ReadInt32() override { return m_reader.ReadValue<int32_t>(); }
+            uint32_t ReadUInt32() override { return m_reader.ReadValue<uint32_t>(); }
+            float ReadFloat() override { return m_reader.ReadValue<float>(); }
+            double ReadDouble() override { return m_reader.ReadValue<double>(); }
             std::string ReadString() override {
                 uint32_t size = ReadUInt32();
-                std::string v(size, '\0');
-                m_stream.read(&v[0], size);
-                return v;
+                return std::string(reinterpret_cast<const char*>(m_reader.View(size)), size);
             }
 
             // 带 Key 版本
@@ -67,13 +98,14 @@ namespace PrismaEngine {
 
             void EndArray() override {}
             void EndObject() override {}
-            bool HasNextField() override { return !m_stream.eof(); }
+            bool HasNextField() override { return !m_reader.AtEnd(); }
             bool HasNextField(const std::string& /*expectedField*/) override { return HasNextField(); }
             void SetCurrent(const std::string& /*key*/) override {}
             void EnterField(const std::string& /*key*/) override {}
 
         private:
-            std::istream& m_stream;
+            std::vector<uint8_t> m_ownedData;
+            BinaryReader m_reader;
         };
     }
 }
@@ -11,6 +11,9 @@
 #include "ArchiveBinary.h"
 #include "ArchiveJson.h"
 #include "SerializationVersion.h"
+#include "core/MappedFile.h"
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 using json = nlohmann::json;
@@ -27,26 +30,15 @@ namespace PrismaEngine {
                                       SerializationFormat format = SerializationFormat::JSON,
                                       const SerializationVersion& version = SerializationVersion()) {
                 try {
+                    // 先序列化到内存, 文件只写入一次
+                    std::vector<uint8_t> data = SerializeToMemoryOrThrow(asset, format, version);
+
                     std::ofstream file(filePath, std::ios::binary);
                     if (!file) {
                         throw SerializationException("Failed to open file for writing: " + filePath.string());
                     }
-
-                    // 写入版本信息
-                    WriteVersionHeader(file, version, format);
-
-                    if (format == SerializationFormat::Binary) {
-                        BinaryOutputArchive archive(file);
-                        asset.Serialize(archive);
-                    } else {
-                        JsonOutputArchive archive;
-                        asset.Serialize(archive);
-                        
-                        // 将JSON写入文件
-                        file << archive.GetJson().dump(4);
-                    }
-
-                    return true;
+                    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                    return file.good();
                 } catch (const std::exception&) {
                     // 记录错误
                     return false;
@@ -57,35 +49,12 @@ namespace PrismaEngine {
             template<typename T>
             static std::unique_ptr<T> DeserializeFromFile(const std::filesystem::path& filePath,
                                                          SerializationFormat format = SerializationFormat::JSON) {
-                try {
-                    std::ifstream file(filePath, std::ios::binary);
-                    if (!file) {
-                        throw SerializationException("Failed to open file for reading: " + filePath.string());
-                    }
-
-                    // 读取版本信息
-                    auto version = ReadVersionHeader(file, format);
-
-                    auto asset = std::make_unique<T>();
-                    
-                    if (format == SerializationFormat::Binary) {
-                        BinaryInputArchive archive(file);
-                        asset->Deserialize(archive);
-                    } else {
-                        // 读取整个JSON文件
-                        std::string jsonStr((std::istreambuf_iterator<char>(file)),
-                                           std::istreambuf_iterator<char>());
-                        json jsonData = json::parse(jsonStr);
-                        
-                        JsonInputArchive archive(jsonData);
-                        asset->Deserialize(archive);
-                    }
-
-                    return asset;
-                } catch (const std::exception&) {
-                    // 记录错误
+                // 内存映射后直接从映射内存读取, 不经过流
+                Core::MappedFile file;
+                if (!file.Open(filePath, Core::MappedFile::AccessPattern::Sequential)) {
                     return nullptr;
                 }
+                return DeserializeFromMemory<T>(file.Data(), file.Size(), format);
             }
 
             // 序列化Asset到内存
@@ -93,56 +62,38 @@ namespace PrismaEngine {
             static std::vector<uint8_t> SerializeToMemory(const T& asset, 
                                                          SerializationFormat format = SerializationFormat::JSON,
                                                          const SerializationVersion& version = SerializationVersion()) {
-                std::vector<uint8_t> result;
-                
                 try {
-                    std::ostringstream stream;
-                    
-                    // 写入版本信息
-                    WriteVersionHeader(stream, version, format);
-
-                    if (format == SerializationFormat::Binary) {
-                        BinaryOutputArchive archive(stream);
-                        asset.Serialize(archive);
-                    } else {
-                        JsonOutputArchive archive;
-                        asset.Serialize(archive);
-                        
-                        // 将JSON写入流
-                        stream << archive.GetJson().dump();
-                    }
-
-                    std::string str = stream.str();
-                    result.assign(str.begin(), str.end());
-                } catch (const std::exception& e) {
+                    return SerializeToMemoryOrThrow(asset, format, version);
+                } catch (const std::exception&) {
                     // 记录错误
-                    result.clear();
+                    return {};
                 }
-                
-                return result;
             }
 
             // 从内存反序列化Asset
             template<typename T>
             static std::unique_ptr<T> DeserializeFromMemory(const std::vector<uint8_t>& data,
                                                           SerializationFormat format = SerializationFormat::JSON) {
-                try {
-                    std::istringstream stream(std::string(data.begin(), data.end()));
-                    
-                    // 读取版本信息
-                    auto version = ReadVersionHeader(stream, format);
+                return DeserializeFromMemory<T>(data.data(), data.size(), format);
+            }
 
+            // 从内存反序列化Asset, 数据只需在调用期间有效 (例如内存映射文件或归档中的条目)
+            template<typename T>
+            static std::unique_ptr<T> DeserializeFromMemory(const uint8_t* data, size_t size,
+                                                          SerializationFormat format = SerializationFormat::JSON) {
+                try {
                     auto asset = std::make_unique<T>();
-                    
+
                     if (format == SerializationFormat::Binary) {
-                        BinaryInputArchive archive(stream);
+                        BinaryInputArchive archive(data, size);
+                        ReadBinaryHeader(archive.GetReader());
                         asset->Deserialize(archive);
                     } else {
-                        // 读取整个JSON字符串
-                        std::string jsonStr((std::istreambuf_iterator<char>(stream)),
-                                           std::istreambuf_iterator<char>());
-                        json jsonData = json::parse(jsonStr);
-                        
+                        const char* begin = reinterpret_cast<const char*>(data);
+                        const char* end   = begin + size;
+                        const char* body  = ReadJsonHeader(begin, end);
+                        json jsonData = json::parse(body, end);
+
                         JsonInputArchive archive(jsonData);
                         asset->Deserialize(archive);
                     }
@@ -155,70 +106,73 @@ namespace PrismaEngine {
             }
 
         private:
-            // 写入版本头
-            static void WriteVersionHeader(std::ostream& stream, 
-                                         const SerializationVersion& version,
-                                         SerializationFormat format) {
+            // 二进制版本头: 魔数 + 格式 + 版本号
+            static constexpr char BinaryMagic[4] = { 'Y', 'A', 'G', 'E' };
+
+            template<typename T>
+            static std::vector<uint8_t> SerializeToMemoryOrThrow(const T& asset, SerializationFormat format,
+                                                                 const SerializationVersion& version) {
                 if (format == SerializationFormat::Binary) {
-                    // 二进制格式的版本头
-                    stream.write("YAGE", 4);  // 魔数
-                    uint8_t formatByte = static_cast<uint8_t>(format);
-                    stream.write(reinterpret_cast<const char*>(&formatByte), 1);
-                    stream.write(reinterpret_cast<const char*>(&version.major), sizeof(version.major));
-                    stream.write(reinterpret_cast<const char*>(&version.minor), sizeof(version.minor));
-                    stream.write(reinterpret_cast<const char*>(&version.patch), sizeof(version.patch));
-                } else {
-                    // JSON格式的版本信息作为元数据
-                    json header = {
-                        {"format", "json"},
-                        {"version", {
-                            {"major", version.major},
-                            {"minor", version.minor},
-                            {"patch", version.patch}
-                        }}
-                    };
-                    stream << header.dump() << "\n";
+                    BinaryOutputBuffer buffer;
+                    WriteBinaryHeader(buffer, version);
+                    BinaryOutputArchive archive(buffer);
+                    asset.Serialize(archive);
+                    return buffer.Release();
                 }
+
+                JsonOutputArchive archive;
+                asset.Serialize(archive);
+
+                std::string text = WriteJsonHeader(version);
+                text += archive.GetJson().dump();
+                return std::vector<uint8_t>(text.begin(), text.end());
             }
 
-            // 读取版本头
-            static SerializationVersion ReadVersionHeader(std::istream& stream, SerializationFormat format) {
-                SerializationVersion version;
-                
-                if (format == SerializationFormat::Binary) {
-                    // 读取二进制格式的版本头
-                    char magic[4];
-                    stream.read(magic, 4);
-                    if (std::string(magic, 4) != "YAGE") {
-                        throw SerializationException("Invalid file format");
-                    }
-                    
-                    uint8_t formatByte;
-                    stream.read(reinterpret_cast<char*>(&formatByte), 1);
-                    if (static_cast<SerializationFormat>(formatByte) != format) {
-                        throw SerializationException("Format mismatch");
-                    }
-                    
-                    stream.read(reinterpret_cast<char*>(&version.major), sizeof(version.major));
-                    stream.read(reinterpret_cast<char*>(&version.minor), sizeof(version.minor));
-                    stream.read(reinterpret_cast<char*>(&version.patch), sizeof(version.patch));
-                } else {
-                    // 读取JSON格式的版本信息
-                    std::string headerLine;
-                    std::getline(stream, headerLine);
-                    json header = json::parse(headerLine);
-                    
-                    if (header["format"] != "json") {
-                        throw SerializationException("Format mismatch");
-                    }
-                    
-                    version.major = header["version"]["major"];
-                    version.minor = header["version"]["minor"];
-                    version.patch = header["version"]["patch"];
+            static void WriteBinaryHeader(BinaryOutputBuffer& buffer, const SerializationVersion& version) {
+                buffer.Write(BinaryMagic, sizeof(BinaryMagic));
+                buffer.WriteValue(static_cast<uint8_t>(SerializationFormat::Binary));
+                buffer.WriteValue(version.major);
+                buffer.WriteValue(version.minor);
+                buffer.WriteValue(version.patch);
+            }
+
+            static SerializationVersion ReadBinaryHeader(BinaryReader& reader) {
+                if (std::memcmp(reader.View(sizeof(BinaryMagic)), BinaryMagic, sizeof(BinaryMagic)) != 0) {
+                    throw SerializationException("Invalid file format");
+                }
+                if (static_cast<SerializationFormat>(reader.ReadValue<uint8_t>()) != SerializationFormat::Binary) {
+                    throw SerializationException("Format mismatch");
                 }
-                
+
+                SerializationVersion version;
+                version.major = reader.ReadValue<uint32_t>();
+                version.minor = reader.ReadValue<uint32_t>();
+                version.patch = reader.ReadValue<uint32_t>();
                 return version;
             }
+
+            // JSON格式的版本信息作为首行元数据
+            static std::string WriteJsonHeader(const SerializationVersion& version) {
+                json header = {
+                    {"format", "json"},
+                    {"version", {
+                        {"major", version.major},
+                        {"minor", version.minor},
+                        {"patch", version.patch}
+                    }}
+                };
+                return header.dump() + "\n";
+            }
+
+            // 返回首行之后的正文
+            static const char* ReadJsonHeader(const char* begin, const char* end) {
+                const char* lineEnd = std::find(begin, end, '\n');
+                json header = json::parse(begin, lineEnd);
+                if (header["format"] != "json") {
+                    throw SerializationException("Format mismatch");
+                }
+                return lineEnd == end ? end : lineEnd + 1;
+            }
         };
 
     } // namespace Serialization
@@ -0,0 +1,108 @@
+#pragma once
+#include "SerializationVersion.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace PrismaEngine {
+    namespace Serialization {
+
+        /// <summary>
+        /// 二进制存档的输出缓冲区
+        /// 按倍数扩容的连续内存, 序列化完成后可直接转移为 std::vector, 无需再次复制
+        /// </summary>
+        class BinaryOutputBuffer {
+        public:
+            BinaryOutputBuffer() = default;
+            explicit BinaryOutputBuffer(size_t capacity) { m_data.resize(capacity); }
+
+            void Write(const void* data, size_t size) {
+                if (size == 0) return;
+                if (size > m_data.size() - m_size) Grow(size);
+                std::memcpy(m_data.data() + m_size, data, size);
+                m_size += size;
+            }
+
+            template<typename T>
+            void WriteValue(const T& value) {
+                static_assert(std::is_trivially_copyable_v<T>, "WriteValue requires a trivially copyable type");
+                Write(&value, sizeof(T));
+            }
+
+            void Reserve(size_t capacity) {
+                if (capacity > m_data.size()) m_data.resize(capacity);
+            }
+
+            const uint8_t* Data() const { return m_data.data(); }
+            size_t Size() const { return m_size; }
+            void Clear() { m_size = 0; }
+
+            /// <summary>
+            /// 取出已写入的数据, 缓冲区随后为空
+            /// </summary>
+            std::vector<uint8_t> Release() {
+                m_data.resize(m_size);
+                m_size = 0;
+                return std::move(m_data);
+            }
+
+        private:
+            void Grow(size_t size) {
+                constexpr size_t MinCapacity = 256;
+                m_data.resize(std::max({ m_data.size() * 2, m_size + size, MinCapacity }));
+            }
+
+            std::vector<uint8_t> m_data;  // size() 为容量, 有效数据为 [0, m_size)
+            size_t m_size = 0;
+        };
+
+        /// <summary>
+        /// 二进制存档的输入游标
+        /// 直接读取调用方持有的内存 (内存映射文件或内存缓冲区), 不复制整个输入; 越界时抛出 SerializationException
+        /// </summary>
+        class BinaryReader {
+        public:
+            BinaryReader() = default;
+            BinaryReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+            /// <summary>
+            /// 返回接下来 size 字节的指针并前进, 指针在输入内存释放前有效
+            /// </summary>
+            const uint8_t* View(size_t size) {
+                if (size > m_size - m_offset) {
+                    throw SerializationException("Unexpected end of binary data");
+                }
+                const uint8_t* data = m_data + m_offset;
+                m_offset += size;
+                return data;
+            }
+
+            void ReadBytes(void* dst, size_t size) {
+                if (size == 0) return;
+                std::memcpy(dst, View(size), size);
+            }
+
+            template<typename T>
+            T ReadValue() {
+                static_assert(std::is_trivially_copyable_v<T>, "ReadValue requires a trivially copyable type");
+                T value;
+                ReadBytes(&value, sizeof(T));
+                return value;
+            }
+
+            void Skip(size_t size) { View(size); }
+
+            size_t Offset() const { return m_offset; }
+            size_t Remaining() const { return m_size - m_offset; }
+            bool AtEnd() const { return m_offset >= m_size; }
+
+        private:
+            const uint8_t* m_data = nullptr;
+            size_t m_size   = 0;
+            size_t m_offset = 0;
+        };
+
+    } // namespace Serialization
+} // namespace PrismaEngine
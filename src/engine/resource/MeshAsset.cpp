@@ -1,15 +1,29 @@
 #include "MeshAsset.h"
 #include "AssetSerializer.h"
+#include "JobSystem.h"
 #include "Logger.h"
+#include "MeshOptimizer.h"
+#include "OBJParser.h"
 
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 namespace PrismaEngine {
 
 using namespace Serialization;
 
+namespace {
+
+static_assert(std::is_trivially_copyable_v<Vertex> && sizeof(Vertex) % sizeof(float) == 0,
+              "Vertex must be serializable as a float array");
+constexpr size_t VertexFloatCount = sizeof(Vertex) / sizeof(float);
+
+} // namespace
+
 bool MeshAsset::Load(const std::filesystem::path& path) {
     try {
         if (!std::filesystem::exists(path)) {
@@ -17,17 +31,23 @@ bool MeshAsset::Load(const std::filesystem::path& path) {
             return false;
         }
 
-        SubMesh triangle;
-        triangle.name          = "Triangle";
-        triangle.materialIndex = 0;
+        if (path.extension() == ".obj" || path.extension() == ".OBJ") {
+            if (!LoadOBJ(path)) {
+                return false;
+            }
+        } else {
+            SubMesh triangle;
+            triangle.name          = "Triangle";
+            triangle.materialIndex = 0;
 
-        triangle.vertices.resize(3);
-        triangle.vertices[0].position = {0.0f, 0.5f, 0.0f, 1.0f};
-        triangle.vertices[1].position = {-0.5f, -0.5f, 0.0f, 1.0f};
-        triangle.vertices[2].position = {0.5f, -0.5f, 0.0f, 1.0f};
+            triangle.vertices.resize(3);
+            triangle.vertices[0].position = {0.0f, 0.5f, 0.0f, 1.0f};
+            triangle.vertices[1].position = {-0.5f, -0.5f, 0.0f, 1.0f};
+            triangle.vertices[2].position = {0.5f, -0.5f, 0.0f, 1.0f};
 
-        triangle.indices = {0, 1, 2};
-        m_subMeshes.push_back(triangle);
+            triangle.indices = {0, 1, 2};
+            m_subMeshes.push_back(triangle);
+        }
 
         m_path                = path;
         m_name                = path.filename().string();
@@ -42,6 +62,94 @@ bool MeshAsset::Load(const std::filesystem::path& path) {
     }
 }
 
+bool MeshAsset::LoadFromMemory(const std::filesystem::path& path, const uint8_t* data, size_t size) {
+    if (path.extension() != ".obj" && path.extension() != ".OBJ") {
+        return false;
+    }
+    if (!LoadOBJ(path, data, size)) {
+        return false;
+    }
+
+    m_path                = path;
+    m_name                = path.filename().string();
+    m_metadata.sourcePath = path;
+    m_metadata.name       = m_name;
+
+    m_isLoaded = true;
+    return true;
+}
+
+bool MeshAsset::LoadOBJ(const std::filesystem::path& path, const uint8_t* data, size_t size) {
+    Resource::OBJMeshResult mesh =
+        data ? Resource::OBJParser::LoadMeshFromMemory(reinterpret_cast<const char*>(data), size, path.parent_path())
+             : Resource::OBJParser::LoadMesh(path.string());
+    if (!mesh.success) {
+        LOG_ERROR("Mesh", "Failed to load OBJ {0}: {1}", path.string(), mesh.error);
+        return false;
+    }
+
+    // OBJ 网格共享一个顶点数组, 拆分为各子网格自己的顶点
+    constexpr uint32_t Unmapped = 0xFFFFFFFF;
+    std::vector<uint32_t> remap(mesh.vertices.size(), Unmapped);
+    std::vector<uint32_t> remapOwner(mesh.vertices.size(), Unmapped);
+
+    PrismaMath::vec3 minBounds(std::numeric_limits<float>::max());
+    PrismaMath::vec3 maxBounds(std::numeric_limits<float>::lowest());
+
+    m_subMeshes.reserve(mesh.subMeshes.size());
+    for (uint32_t subIndex = 0; subIndex < mesh.subMeshes.size(); ++subIndex) {
+        const Resource::OBJSubMesh& source = mesh.subMeshes[subIndex];
+
+        SubMesh subMesh;
+        subMesh.name          = source.name;
+        subMesh.materialIndex = source.materialIndex;
+        subMesh.indices.reserve(source.indexCount);
+
+        for (uint32_t i = source.indexOffset; i < source.indexOffset + source.indexCount; ++i) {
+            const uint32_t index = mesh.indices[i];
+            if (remapOwner[index] != subIndex) {
+                remapOwner[index] = subIndex;
+                remap[index]      = static_cast<uint32_t>(subMesh.vertices.size());
+
+                const Resource::OBJVertex& v = mesh.vertices[index];
+                Vertex& vertex  = subMesh.vertices.emplace_back();
+                vertex.position = {v.position[0], v.position[1], v.position[2], 1.0f};
+                vertex.normal   = {v.normal[0], v.normal[1], v.normal[2], 0.0f};
+                vertex.uv       = {v.texCoord[0], v.texCoord[1], 0.0f, 0.0f};
+                vertex.texCoord = vertex.uv;
+
+                minBounds = PrismaMath::min(minBounds, PrismaMath::vec3(v.position[0], v.position[1], v.position[2]));
+                maxBounds = PrismaMath::max(maxBounds, PrismaMath::vec3(v.position[0], v.position[1], v.position[2]));
+            }
+            subMesh.indices.push_back(remap[index]);
+        }
+
+        m_subMeshes.push_back(std::move(subMesh));
+    }
+
+    if (!mesh.vertices.empty()) {
+        m_boundingBox.minBounds = minBounds;
+        m_boundingBox.maxBounds = maxBounds;
+    }
+
+    m_materialLibraries.assign(mesh.materialLibraries.begin(), mesh.materialLibraries.end());
+
+    // 导入优化: 各子网格互不相关, 并行处理
+    if (m_optimize) {
+        JobSystem::GetInstance().ParallelFor(m_subMeshes.size(), [&](size_t i) {
+            Graphic::MeshOptimizer::Optimize(m_subMeshes[i], m_optimizationSettings);
+        });
+    }
+
+    size_t vertexCount = 0;
+    for (const SubMesh& subMesh : m_subMeshes) {
+        vertexCount += subMesh.vertices.size();
+    }
+    LOG_INFO("Mesh", "Loaded OBJ {0}: {1} vertices ({2} after optimization), {3} triangles, {4} submeshes",
+             path.string(), mesh.vertices.size(), vertexCount, mesh.indices.size() / 3, m_subMeshes.size());
+    return true;
+}
+
 void MeshAsset::Unload() {
     m_subMeshes.clear();
     m_isLoaded    = false;
@@ -49,6 +157,7 @@ void MeshAsset::Unload() {
 
 void MeshAsset::Serialize(OutputArchive& archive) const {
     archive.BeginObject("MeshAsset");
+    archive("formatVersion", FormatVersion);
     archive("metadata", m_metadata);
     
     uint32_t count = static_cast<uint32_t>(m_subMeshes.size());
@@ -57,6 +166,22 @@ void MeshAsset::Serialize(OutputArchive& archive) const {
         archive.BeginObject("SubMesh");
         archive("name", subMesh.name);
         archive("materialIndex", subMesh.materialIndex);
+        // 顶点按 float 数组写入, 二进制存档整块复制
+        archive.SerializeArray("vertices", reinterpret_cast<const float*>(subMesh.vertices.data()),
+                               static_cast<uint32_t>(subMesh.vertices.size() * VertexFloatCount));
+        archive.SerializeArray("indices", subMesh.indices);
+
+        // LOD 索引区间按顺序连续存放, 只需写入各级别的索引数
+        std::vector<uint32_t> lodIndexCounts;
+        std::vector<float> lodErrors, lodScreenSizes;
+        for (const MeshLod& lod : subMesh.lods) {
+            lodIndexCounts.push_back(lod.indexCount);
+            lodErrors.push_back(lod.error);
+            lodScreenSizes.push_back(lod.screenSize);
+        }
+        archive.SerializeArray("lodIndexCounts", lodIndexCounts);
+        archive.SerializeArray("lodErrors", lodErrors);
+        archive.SerializeArray("lodScreenSizes", lodScreenSizes);
         archive.EndObject();
     }
     archive.EndArray();
@@ -65,6 +190,12 @@ void MeshAsset::Serialize(OutputArchive& archive) const {
 
 void MeshAsset::Deserialize(InputArchive& archive) {
     archive.BeginObject("MeshAsset");
+    // 旧布局的文件无法按当前格式解析, 直接拒绝而不是读出错误的顶点
+    uint32_t formatVersion = 0;
+    archive("formatVersion", formatVersion);
+    if (formatVersion != FormatVersion) {
+        throw SerializationException("Unsupported mesh format version " + std::to_string(formatVersion));
+    }
     archive("metadata", m_metadata);
 
     uint32_t count = 0;
@@ -74,6 +205,34 @@ void MeshAsset::Deserialize(InputArchive& archive) {
         archive.BeginObject("SubMesh");
         archive("name", m_subMeshes[i].name);
         archive("materialIndex", m_subMeshes[i].materialIndex);
+
+        std::vector<float> vertexData;
+        archive.DeserializeArray("vertices", vertexData);
+        m_subMeshes[i].vertices.resize(vertexData.size() / VertexFloatCount);
+        if (!m_subMeshes[i].vertices.empty()) {
+            std::memcpy(static_cast<void*>(m_subMeshes[i].vertices.data()), vertexData.data(), m_subMeshes[i].vertices.size() * sizeof(Vertex));
+        }
+        archive.DeserializeArray("indices", m_subMeshes[i].indices);
+
+        std::vector<uint32_t> lodIndexCounts;
+        std::vector<float> lodErrors, lodScreenSizes;
+        archive.DeserializeArray("lodIndexCounts", lodIndexCounts);
+        archive.DeserializeArray("lodErrors", lodErrors);
+        archive.DeserializeArray("lodScreenSizes", lodScreenSizes);
+
+        m_subMeshes[i].lods.clear();
+        uint32_t indexOffset = 0;
+        for (size_t lod = 0; lod < lodIndexCounts.size(); ++lod) {
+            MeshLod& range   = m_subMeshes[i].lods.emplace_back();
+            range.indexOffset = indexOffset;
+            range.indexCount  = lodIndexCounts[lod];
+            range.error       = lod < lodErrors.size() ? lodErrors[lod] : 0.0f;
+            range.screenSize  = lod < lodScreenSizes.size() ? lodScreenSizes[lod] : 0.0f;
+            indexOffset += range.indexCount;
+        }
+        if (indexOffset > m_subMeshes[i].indices.size()) {
+            throw SerializationException("Mesh LOD ranges exceed index count");
+        }
         archive.EndObject();
     }
     archive.EndArray();
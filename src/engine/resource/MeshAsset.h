@@ -2,6 +2,7 @@
 
 #include "Asset.h"
 #include "Mesh.h"
+#include "MeshOptimizer.h"
 #include <vector>
 
 namespace PrismaEngine {
@@ -14,9 +15,11 @@ public:
 
     // IResource接口实现
     bool Load(const std::filesystem::path& path) override;
+    bool LoadFromMemory(const std::filesystem::path& path, const uint8_t* data, size_t size) override;
     void Unload() override;
     bool IsLoaded() const override { return m_isLoaded; }
     AssetType GetType() const override { return AssetType::Mesh; }
+    std::vector<std::filesystem::path> GetFileDependencies() const override { return m_materialLibraries; }
 
     // Serializable接口实现
     void Serialize(Serialization::OutputArchive& archive) const override;
@@ -29,19 +32,32 @@ public:
 
     // Asset特定方法
     std::string GetAssetType() const override { return "Mesh"; }
-    std::string GetAssetVersion() const override { return "1.0.0"; }
+    std::string GetAssetVersion() const override { return "2.0.0"; }
 
     // 网格属性
     const std::vector<SubMesh>& GetSubMeshes() const { return m_subMeshes; }
     const BoundingBox& GetBoundingBox() const { return m_boundingBox; }
 
+    // 导入 OBJ 时的网格优化 (焊接、缓存/过度绘制优化、LOD 生成), 在 Load 之前设置
+    void SetOptimizationSettings(const Graphic::MeshOptimizationSettings& settings) { m_optimizationSettings = settings; }
+    void SetOptimizationEnabled(bool enable) { m_optimize = enable; }
+
     void AddSubMesh(const SubMesh& subMesh);
     void SetBoundingBox(const BoundingBox& boundingBox);
     void Clear();
 
 private:
+    // 序列化布局版本: 顶点按 float 数组整块存放并附带 LOD 区间; 布局变化时递增
+    static constexpr uint32_t FormatVersion = 2;
+
+    // 通过 OBJParser 加载 OBJ 文件; data 不为空时从内存解析
+    bool LoadOBJ(const std::filesystem::path& path, const uint8_t* data = nullptr, size_t size = 0);
+
     std::vector<SubMesh> m_subMeshes;
     BoundingBox m_boundingBox;
+    std::vector<std::filesystem::path> m_materialLibraries;  // OBJ 引用的 .mtl 文件
+    Graphic::MeshOptimizationSettings m_optimizationSettings;
+    bool m_optimize = true;
     bool m_isLoaded = false;
 };
 
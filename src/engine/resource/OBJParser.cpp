@@ -1,418 +1,788 @@
 #include "OBJParser.h"
 #include "../Logger.h"
-#include <format>
+#include "../JobSystem.h"
+#include "../core/MappedFile.h"
+#include "../core/VirtualFileSystem.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <fstream>
 #include <sstream>
-#include <filesystem>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 
 namespace PrismaEngine {
 namespace Resource {
 
-// 为了兼容旧代码，定义LOG_WARNING
-#ifndef LOG_WARNING
-#define LOG_WARNING(category, fmt, ...) ::Logger::GetInstance().LogFormat(::LogLevel::Warning, category, ::SourceLocation(__FILE__, __LINE__, __func__), fmt, ##__VA_ARGS__)
-#endif
+// ============================================================================
+// 内部数据结构
+// ============================================================================
 
-namespace PrismaEngine {
-namespace Resource {
+namespace {
 
-OBJParseResult OBJParser::Parse(const std::string& filePath) {
-    OBJParseResult result;
+// 面角点中缺省的纹理坐标/法线索引
+constexpr int32_t MissingIndex = -1;
 
-    // 检查文件是否存在
-    std::ifstream testFile(filePath);
-    if (!testFile.good()) {
-        result.error = "File does not exist: " + filePath;
-        return result;
-    }
-    testFile.close();
+// 每个解析块的最小字节数, 小文件不拆分
+constexpr size_t MinChunkBytes = 1u << 20;
 
-    // 打开文件
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        result.error = "Failed to open file: " + filePath;
-        return result;
-    }
+// 顶点去重的分片数 (固定值, 保证结果与线程数无关)
+constexpr uint32_t DedupShardBits = 6;
+constexpr uint32_t DedupShardCount = 1u << DedupShardBits;
 
-    std::string line;
-    uint32_t currentMaterialIndex = 0;
-    std::string currentGroupName = "default";
-
-    OBJGroup currentGroup;
-    currentGroup.name = currentGroupName;
-    currentGroup.materialIndex = 0;
-
-    try {
-        while (std::getline(file, line)) {
-            // 跳过空行和注释
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
+// 去重分片统计的角点块大小
+constexpr size_t DedupBlockSize = 1u << 16;
+
+constexpr uint32_t InvalidVertex = 0xFFFFFFFF;
+
+// 面角点 (合并后为从 0 开始的绝对索引)
+struct Corner {
+    int32_t v;
+    int32_t t;
+    int32_t n;
+};
+
+enum class StateEventType : uint8_t {
+    Group,
+    UseMaterial,
+    MaterialLib
+};
+
+// 组/材质切换, faceIndex 为事件之后第一个面在块内的序号
+struct StateEvent {
+    uint32_t faceIndex;
+    StateEventType type;
+    std::string_view name;
+};
+
+// 单个块的解析结果
+struct ChunkResult {
+    std::vector<float> positions;
+    std::vector<float> texCoords;
+    std::vector<float> normals;
+
+    std::vector<Corner> corners;
+    std::vector<uint32_t> faceEnds;         // 每个面最后一个角点之后的块内序号
+    std::vector<uint32_t> relativeFixups;   // 相对索引位置 (角点 * 3 + 分量), 合并时加上前面块的数量
+    std::vector<StateEvent> events;
+
+    const char* errorAt = nullptr;
+    const char* errorMessage = nullptr;
+};
+
+inline bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
 
-            std::istringstream iss(line);
-            std::string keyword;
-            iss >> keyword;
+inline const char* SkipSpaces(const char* p, const char* end) {
+    while (p < end && IsSpace(*p)) ++p;
+    return p;
+}
+
+inline std::string_view TrimmedRest(const char* p, const char* end) {
+    p = SkipSpaces(p, end);
+    while (end > p && IsSpace(end[-1])) --end;
+    return std::string_view(p, static_cast<size_t>(end - p));
+}
+
+inline bool ParseFloat(const char*& p, const char* end, float& out) {
+    p = SkipSpaces(p, end);
+    if (p < end && *p == '+') ++p;
+    auto [next, ec] = std::from_chars(p, end, out);
+    if (ec != std::errc()) return false;
+    p = next;
+    return true;
+}
 
-            // 根据关键字处理不同行类型
-            if (keyword == "v") {
-                // 顶点位置
+// 解析一个面索引: 正数为从 1 开始的绝对索引, 负数相对于当前已读取的元素数量
+inline bool ParseIndex(const char*& p, const char* end, int32_t count, int32_t& out, bool& relative) {
+    int32_t value = 0;
+    auto [next, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc() || value == 0) return false;
+    p = next;
+    relative = value < 0;
+    out = relative ? count + value : value - 1;
+    return true;
+}
+
+// 解析块 [begin, end), 块边界已对齐到行首
+void ParseChunk(const char* begin, const char* end, ChunkResult& out) {
+    // 按平均行长预估容量, 避免反复扩容
+    const size_t estimatedLines = static_cast<size_t>(end - begin) / 24 + 1;
+    out.positions.reserve(estimatedLines * 3 / 2);
+    out.corners.reserve(estimatedLines * 2);
+    out.faceEnds.reserve(estimatedLines / 2);
+
+    const char* p = begin;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!lineEnd) lineEnd = end;
+
+        const char* lineStart = p;
+        const char* s = SkipSpaces(p, lineEnd);
+        p = lineEnd + 1;
+
+        if (s == lineEnd || *s == '#') continue;
+
+        const char* keyword = s;
+        while (s < lineEnd && !IsSpace(*s)) ++s;
+        const size_t keywordLength = static_cast<size_t>(s - keyword);
+
+        auto fail = [&](const char* message) {
+            out.errorAt = lineStart;
+            out.errorMessage = message;
+        };
+
+        if (keyword[0] == 'v' && keywordLength <= 2) {
+            if (keywordLength == 1) {
+                // 顶点位置 (忽略可选的 w 和顶点颜色)
                 float x, y, z;
-                if (iss >> x >> y >> z) {
-                    result.positions.push_back(x);
-                    result.positions.push_back(y);
-                    result.positions.push_back(z);
+                if (!ParseFloat(s, lineEnd, x) || !ParseFloat(s, lineEnd, y) || !ParseFloat(s, lineEnd, z)) {
+                    fail("Malformed vertex position");
+                    return;
                 }
+                out.positions.insert(out.positions.end(), {x, y, z});
             }
-            else if (keyword == "vt") {
-                // 纹理坐标
-                float u, v;
-                if (iss >> u >> v) {
-                    result.texCoords.push_back(u);
-                    result.texCoords.push_back(v);
+            else if (keyword[1] == 't') {
+                // 纹理坐标 (v 可省略)
+                float u, v = 0.0f;
+                if (!ParseFloat(s, lineEnd, u)) {
+                    fail("Malformed texture coordinate");
+                    return;
                 }
+                const char* rest = s;
+                if (!ParseFloat(rest, lineEnd, v)) v = 0.0f;
+                out.texCoords.insert(out.texCoords.end(), {u, v});
             }
-            else if (keyword == "vn") {
-                // 法线
+            else if (keyword[1] == 'n') {
                 float nx, ny, nz;
-                if (iss >> nx >> ny >> nz) {
-                    result.normals.push_back(nx);
-                    result.normals.push_back(ny);
-                    result.normals.push_back(nz);
+                if (!ParseFloat(s, lineEnd, nx) || !ParseFloat(s, lineEnd, ny) || !ParseFloat(s, lineEnd, nz)) {
+                    fail("Malformed vertex normal");
+                    return;
                 }
+                out.normals.insert(out.normals.end(), {nx, ny, nz});
             }
-            else if (keyword == "f") {
-                // 面
-                OBJFace face;
-                std::string faceStr;
-                while (iss >> faceStr) {
-                    OBJFaceIndices indices;
-
-                    // 解析面索引格式: v, v/vt, v/vt/vn, v//vn
-                    size_t firstSlash = faceStr.find('/');
-                    size_t secondSlash = faceStr.rfind('/');
-
-                    if (firstSlash == std::string::npos) {
-                        // 只有顶点索引
-                        indices.vertexIndex = std::stoi(faceStr);
-                    }
-                    else if (firstSlash == secondSlash) {
-                        // v/vt 格式
-                        indices.vertexIndex = std::stoi(faceStr.substr(0, firstSlash));
-                        indices.texCoordIndex = std::stoi(faceStr.substr(firstSlash + 1));
+            // vp 等其他顶点语句忽略
+        }
+        else if (keyword[0] == 'f' && keywordLength == 1) {
+            // 面: v, v/vt, v/vt/vn, v//vn
+            const int32_t positionCount = static_cast<int32_t>(out.positions.size() / 3);
+            const int32_t texCoordCount = static_cast<int32_t>(out.texCoords.size() / 2);
+            const int32_t normalCount = static_cast<int32_t>(out.normals.size() / 3);
+            const size_t firstCorner = out.corners.size();
+
+            for (;;) {
+                s = SkipSpaces(s, lineEnd);
+                if (s == lineEnd) break;
+
+                Corner corner{0, MissingIndex, MissingIndex};
+                const uint32_t slot = static_cast<uint32_t>(out.corners.size()) * 3;
+                bool relative = false;
+
+                if (!ParseIndex(s, lineEnd, positionCount, corner.v, relative)) {
+                    fail("Malformed face statement");
+                    return;
+                }
+                if (relative) out.relativeFixups.push_back(slot);
+
+                if (s < lineEnd && *s == '/') {
+                    ++s;
+                    if (s < lineEnd && *s != '/') {
+                        if (!ParseIndex(s, lineEnd, texCoordCount, corner.t, relative)) {
+                            fail("Malformed face statement");
+                            return;
+                        }
+                        if (relative) out.relativeFixups.push_back(slot + 1);
                     }
-                    else {
-                        // v/vt/vn 或 v//vn 格式
-                        indices.vertexIndex = std::stoi(faceStr.substr(0, firstSlash));
-                        std::string middle = faceStr.substr(firstSlash + 1, secondSlash - firstSlash - 1);
-                        if (!middle.empty()) {
-                            indices.texCoordIndex = std::stoi(middle);
+                    if (s < lineEnd && *s == '/') {
+                        ++s;
+                        if (!ParseIndex(s, lineEnd, normalCount, corner.n, relative)) {
+                            fail("Malformed face statement");
+                            return;
                         }
-                        indices.normalIndex = std::stoi(faceStr.substr(secondSlash + 1));
+                        if (relative) out.relativeFixups.push_back(slot + 2);
                     }
+                }
 
-                    face.indices.push_back(indices);
+                if (s < lineEnd && !IsSpace(*s)) {
+                    fail("Malformed face statement");
+                    return;
                 }
+                out.corners.push_back(corner);
+            }
 
-                currentGroup.faces.push_back(face);
+            if (out.corners.size() - firstCorner < 3) {
+                fail("Face with fewer than 3 vertices");
+                return;
             }
-            else if (keyword == "g" || keyword == "o") {
-                // 保存当前组
-                if (!currentGroup.faces.empty()) {
-                    result.groups.push_back(currentGroup);
-                }
+            out.faceEnds.push_back(static_cast<uint32_t>(out.corners.size()));
+        }
+        else {
+            std::string_view word(keyword, keywordLength);
+            const uint32_t faceIndex = static_cast<uint32_t>(out.faceEnds.size());
 
-                // 开始新组
-                iss >> currentGroupName;
-                if (currentGroupName.empty()) {
-                    currentGroupName = "group_" + std::to_string(result.groups.size());
-                }
-                currentGroup.name = currentGroupName;
-                currentGroup.faces.clear();
+            if (word == "g" || word == "o") {
+                out.events.push_back({faceIndex, StateEventType::Group, TrimmedRest(s, lineEnd)});
             }
-            else if (keyword == "usemtl") {
-                // 使用材质
-                std::string materialName;
-                iss >> materialName;
-
-                // 查找材质索引
-                bool found = false;
-                for (size_t i = 0; i < result.materials.size(); ++i) {
-                    if (result.materials[i].name == materialName) {
-                        currentMaterialIndex = static_cast<uint32_t>(i);
-                        currentGroup.materialIndex = currentMaterialIndex;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    LOG_WARNING("OBJParser", "Material not found: {}", materialName);
-                }
+            else if (word == "usemtl") {
+                out.events.push_back({faceIndex, StateEventType::UseMaterial, TrimmedRest(s, lineEnd)});
             }
-            else if (keyword == "mtllib") {
-                // 材质库文件
-                std::string materialLib;
-                iss >> materialLib;
-
-                // 构建材质库文件路径
-                std::filesystem::path basePath = std::filesystem::path(filePath).parent_path();
-                std::filesystem::path materialPath = basePath / materialLib;
-
-                // 读取材质文件
-                if (!ReadMaterialFile(materialPath.string(), result.materials)) {
-                    LOG_WARNING("OBJParser", "Failed to load material file: {}", materialPath.string());
-                }
+            else if (word == "mtllib") {
+                out.events.push_back({faceIndex, StateEventType::MaterialLib, TrimmedRest(s, lineEnd)});
             }
+            // s, l, p 等语句忽略
         }
+    }
+}
 
-        // 保存最后一个组
-        if (!currentGroup.faces.empty()) {
-            result.groups.push_back(currentGroup);
-        }
+// 按行边界切分缓冲区
+std::vector<const char*> SplitIntoChunks(const char* data, size_t size) {
+    const size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t chunkCount = std::clamp<size_t>(size / MinChunkBytes, 1, threadCount * 4);
+    const size_t chunkBytes = size / chunkCount;
+
+    std::vector<const char*> bounds;
+    bounds.reserve(chunkCount + 1);
+    bounds.push_back(data);
+
+    const char* end = data + size;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        const char* p = std::max(data + i * chunkBytes, bounds.back());
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!newline) break;
+        bounds.push_back(newline + 1);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+inline uint32_t HashCorner(const Corner& c) {
+    uint32_t h = static_cast<uint32_t>(c.v) * 0x9E3779B1u;
+    h ^= static_cast<uint32_t>(c.t) * 0x85EBCA77u;
+    h ^= static_cast<uint32_t>(c.n) * 0xC2B2AE3Du;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+// 开放寻址 (线性探测) 的角点 -> 顶点表
+class CornerTable {
+public:
+    static constexpr uint32_t Empty = 0xFFFFFFFF;
+
+    explicit CornerTable(size_t expectedCount) {
+        size_t capacity = 16;
+        while (capacity < expectedCount * 2) capacity <<= 1;
+        m_slots.assign(capacity, Slot{{0, 0, 0}, Empty});
+        m_mask = capacity - 1;
+    }
 
-        // 检查是否至少有顶点和面
-        if (result.positions.empty()) {
-            result.error = "No vertices found in OBJ file";
-            return result;
+    // 返回角点对应的顶点序号, 不存在时以 newValue 插入
+    uint32_t FindOrInsert(const Corner& key, uint32_t hash, uint32_t newValue) {
+        if ((m_count + 1) * 2 > m_slots.size()) Grow();
+
+        size_t index = hash & m_mask;
+        for (;;) {
+            Slot& slot = m_slots[index];
+            if (slot.value == Empty) {
+                slot.key = key;
+                slot.value = newValue;
+                ++m_count;
+                return newValue;
+            }
+            if (slot.key.v == key.v && slot.key.t == key.t && slot.key.n == key.n) {
+                return slot.value;
+            }
+            index = (index + 1) & m_mask;
         }
+    }
 
-        if (result.groups.empty() && result.faces.empty()) {
-            result.error = "No faces found in OBJ file";
-            return result;
+private:
+    struct Slot {
+        Corner key;
+        uint32_t value;
+    };
+
+    void Grow() {
+        std::vector<Slot> old = std::move(m_slots);
+        m_slots.assign(old.size() * 2, Slot{{0, 0, 0}, Empty});
+        m_mask = m_slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.value == Empty) continue;
+            size_t index = HashCorner(slot.key) & m_mask;
+            while (m_slots[index].value != Empty) index = (index + 1) & m_mask;
+            m_slots[index] = slot;
         }
+    }
 
-        // 如果没有组，将所有面放入一个默认组
-        if (result.groups.empty()) {
-            OBJGroup defaultGroup;
-            defaultGroup.name = "default";
-            defaultGroup.materialIndex = 0;
-            // 添加所有面（之前已经添加到currentGroup了）
-            defaultGroup.faces = currentGroup.faces;
-            result.groups.push_back(defaultGroup);
+    std::vector<Slot> m_slots;
+    size_t m_mask = 0;
+    size_t m_count = 0;
+};
+
+} // namespace
+
+// ============================================================================
+// 合并后的解析结果
+// ============================================================================
+
+struct OBJParser::ParsedFile {
+    std::vector<float> positions;
+    std::vector<float> texCoords;
+    std::vector<float> normals;
+
+    std::vector<Corner> corners;
+    std::vector<uint32_t> faceOffsets;   // 面 i 的角点区间 [faceOffsets[i], faceOffsets[i + 1])
+
+    // 组名和材质不变的连续面区间
+    struct Run {
+        std::string name;
+        uint32_t materialIndex;
+        uint32_t firstFace;
+        uint32_t faceCount;
+    };
+    std::vector<Run> runs;
+
+    std::vector<OBJMaterial> materials;
+    std::vector<std::string> materialLibraries;
+
+    size_t FaceCount() const { return faceOffsets.empty() ? 0 : faceOffsets.size() - 1; }
+};
+
+bool OBJParser::ParseBuffer(const char* data, size_t size,
+                            const std::filesystem::path& baseDirectory,
+                            ParsedFile& out, std::string& error) {
+    auto& jobSystem = JobSystem::GetInstance();
+
+    // 1. 并行解析各块
+    std::vector<const char*> bounds = SplitIntoChunks(data, size);
+    const size_t chunkCount = bounds.size() - 1;
+    std::vector<ChunkResult> chunks(chunkCount);
+
+    jobSystem.ParallelFor(chunkCount, [&](size_t i) {
+        ParseChunk(bounds[i], bounds[i + 1], chunks[i]);
+    });
+
+    for (const ChunkResult& chunk : chunks) {
+        if (chunk.errorMessage) {
+            size_t line = 1 + static_cast<size_t>(std::count(data, chunk.errorAt, '\n'));
+            error = std::string(chunk.errorMessage) + " at line " + std::to_string(line);
+            return false;
         }
+    }
 
-        result.success = true;
+    // 2. 计算各块在合并数组中的偏移
+    struct ChunkOffsets {
+        size_t positions = 0;
+        size_t texCoords = 0;
+        size_t normals = 0;
+        size_t corners = 0;
+        size_t faces = 0;
+    };
+    std::vector<ChunkOffsets> offsets(chunkCount + 1);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        offsets[i + 1].positions = offsets[i].positions + chunks[i].positions.size();
+        offsets[i + 1].texCoords = offsets[i].texCoords + chunks[i].texCoords.size();
+        offsets[i + 1].normals = offsets[i].normals + chunks[i].normals.size();
+        offsets[i + 1].corners = offsets[i].corners + chunks[i].corners.size();
+        offsets[i + 1].faces = offsets[i].faces + chunks[i].faceEnds.size();
+    }
 
-    } catch (const std::exception& e) {
-        result.error = "Exception while parsing OBJ: " + std::string(e.what());
-        result.success = false;
+    const ChunkOffsets& totals = offsets[chunkCount];
+    if (totals.corners > static_cast<size_t>(UINT32_MAX) || totals.positions / 3 > static_cast<size_t>(INT32_MAX)) {
+        error = "OBJ file is too large";
+        return false;
     }
 
-    return result;
-}
+    out.positions.resize(totals.positions);
+    out.texCoords.resize(totals.texCoords);
+    out.normals.resize(totals.normals);
+    out.corners.resize(totals.corners);
+    out.faceOffsets.resize(totals.faces + 1);
+    out.faceOffsets[0] = 0;
+
+    // 3. 并行拷贝, 同时解析相对索引并检查越界
+    const int32_t positionCount = static_cast<int32_t>(totals.positions / 3);
+    const int32_t texCoordCount = static_cast<int32_t>(totals.texCoords / 2);
+    const int32_t normalCount = static_cast<int32_t>(totals.normals / 3);
+    std::vector<uint8_t> rangeErrors(chunkCount, 0);
+
+    jobSystem.ParallelFor(chunkCount, [&](size_t i) {
+        ChunkResult& chunk = chunks[i];
+        const ChunkOffsets& base = offsets[i];
+
+        std::copy(chunk.positions.begin(), chunk.positions.end(), out.positions.begin() + base.positions);
+        std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), out.texCoords.begin() + base.texCoords);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), out.normals.begin() + base.normals);
+
+        const int32_t bases[3] = {
+            static_cast<int32_t>(base.positions / 3),
+            static_cast<int32_t>(base.texCoords / 2),
+            static_cast<int32_t>(base.normals / 3)
+        };
+        for (uint32_t fixup : chunk.relativeFixups) {
+            int32_t* component = &chunk.corners[fixup / 3].v + fixup % 3;
+            *component += bases[fixup % 3];
+        }
 
-OBJParseResult OBJParser::ParseFromMemory(const char* data, size_t size) {
-    OBJParseResult result;
+        bool valid = true;
+        Corner* dst = out.corners.data() + base.corners;
+        for (const Corner& corner : chunk.corners) {
+            valid &= corner.v >= 0 && corner.v < positionCount;
+            valid &= corner.t == MissingIndex || (corner.t >= 0 && corner.t < texCoordCount);
+            valid &= corner.n == MissingIndex || (corner.n >= 0 && corner.n < normalCount);
+            *dst++ = corner;
+        }
+        rangeErrors[i] = valid ? 0 : 1;
 
-    if (!data || size == 0) {
-        result.error = "Invalid data or size";
-        return result;
-    }
+        const uint32_t cornerBase = static_cast<uint32_t>(base.corners);
+        uint32_t* faceDst = out.faceOffsets.data() + base.faces + 1;
+        for (uint32_t faceEnd : chunk.faceEnds) {
+            *faceDst++ = cornerBase + faceEnd;
+        }
 
-    std::istringstream iss(std::string(data, size));
-    std::string line;
-    uint32_t currentMaterialIndex = 0;
-    std::string currentGroupName = "default";
-
-    OBJGroup currentGroup;
-    currentGroup.name = currentGroupName;
-    currentGroup.materialIndex = 0;
-
-    try {
-        while (std::getline(iss, line)) {
-            // 跳过空行和注释
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
+        // 块数据已合并, 提前释放
+        chunk.positions = {};
+        chunk.texCoords = {};
+        chunk.normals = {};
+        chunk.corners = {};
+    });
 
-            std::istringstream lineStream(line);
-            std::string keyword;
-            lineStream >> keyword;
+    if (std::find(rangeErrors.begin(), rangeErrors.end(), 1) != rangeErrors.end()) {
+        error = "Face index out of range";
+        return false;
+    }
 
-            // 处理与Parse相同的逻辑
-            if (keyword == "v") {
-                float x, y, z;
-                if (lineStream >> x >> y >> z) {
-                    result.positions.push_back(x);
-                    result.positions.push_back(y);
-                    result.positions.push_back(z);
-                }
-            }
-            else if (keyword == "vt") {
-                float u, v;
-                if (lineStream >> u >> v) {
-                    result.texCoords.push_back(u);
-                    result.texCoords.push_back(v);
-                }
-            }
-            else if (keyword == "vn") {
-                float nx, ny, nz;
-                if (lineStream >> nx >> ny >> nz) {
-                    result.normals.push_back(nx);
-                    result.normals.push_back(ny);
-                    result.normals.push_back(nz);
-                }
+    // 4. 加载材质库 (可能出现在文件任意位置, 先于 usemtl 解析)
+    for (const ChunkResult& chunk : chunks) {
+        for (const StateEvent& event : chunk.events) {
+            if (event.type != StateEventType::MaterialLib || baseDirectory.empty()) continue;
+
+            std::filesystem::path materialPath = baseDirectory / std::filesystem::path(event.name);
+            out.materialLibraries.push_back(materialPath.generic_string());
+            if (!ReadMaterialFile(materialPath.generic_string(), out.materials)) {
+                LOG_WARNING("OBJParser", "Failed to load material file: {0}", materialPath.string());
             }
-            else if (keyword == "f") {
-                OBJFace face;
-                std::string faceStr;
-                while (lineStream >> faceStr) {
-                    OBJFaceIndices indices;
+        }
+    }
 
-                    size_t firstSlash = faceStr.find('/');
-                    size_t secondSlash = faceStr.rfind('/');
+    std::unordered_map<std::string_view, uint32_t> materialLookup;
+    for (size_t i = 0; i < out.materials.size(); ++i) {
+        materialLookup.emplace(out.materials[i].name, static_cast<uint32_t>(i));
+    }
 
-                    if (firstSlash == std::string::npos) {
-                        indices.vertexIndex = std::stoi(faceStr);
-                    }
-                    else if (firstSlash == secondSlash) {
-                        indices.vertexIndex = std::stoi(faceStr.substr(0, firstSlash));
-                        indices.texCoordIndex = std::stoi(faceStr.substr(firstSlash + 1));
-                    }
-                    else {
-                        indices.vertexIndex = std::stoi(faceStr.substr(0, firstSlash));
-                        std::string middle = faceStr.substr(firstSlash + 1, secondSlash - firstSlash - 1);
-                        if (!middle.empty()) {
-                            indices.texCoordIndex = std::stoi(middle);
-                        }
-                        indices.normalIndex = std::stoi(faceStr.substr(secondSlash + 1));
-                    }
+    // 5. 按文件顺序回放组/材质切换, 生成面区间
+    std::string currentName = "default";
+    uint32_t currentMaterial = 0;
+    uint32_t runStart = 0;
 
-                    face.indices.push_back(indices);
-                }
+    auto closeRun = [&](uint32_t faceIndex) {
+        if (faceIndex > runStart) {
+            out.runs.push_back({currentName, currentMaterial, runStart, faceIndex - runStart});
+        }
+        runStart = faceIndex;
+    };
 
-                currentGroup.faces.push_back(face);
-            }
-            else if (keyword == "g" || keyword == "o") {
-                if (!currentGroup.faces.empty()) {
-                    result.groups.push_back(currentGroup);
-                }
+    for (size_t i = 0; i < chunkCount; ++i) {
+        for (const StateEvent& event : chunks[i].events) {
+            const uint32_t faceIndex = static_cast<uint32_t>(offsets[i].faces) + event.faceIndex;
 
-                lineStream >> currentGroupName;
-                if (currentGroupName.empty()) {
-                    currentGroupName = "group_" + std::to_string(result.groups.size());
-                }
-                currentGroup.name = currentGroupName;
-                currentGroup.faces.clear();
+            if (event.type == StateEventType::Group) {
+                closeRun(faceIndex);
+                currentName = event.name.empty() ? "group_" + std::to_string(out.runs.size())
+                                                 : std::string(event.name);
             }
-            else if (keyword == "usemtl") {
-                std::string materialName;
-                lineStream >> materialName;
-
-                for (size_t i = 0; i < result.materials.size(); ++i) {
-                    if (result.materials[i].name == materialName) {
-                        currentMaterialIndex = static_cast<uint32_t>(i);
-                        currentGroup.materialIndex = currentMaterialIndex;
-                        break;
-                    }
+            else if (event.type == StateEventType::UseMaterial) {
+                auto it = materialLookup.find(event.name);
+                if (it == materialLookup.end()) {
+                    LOG_WARNING("OBJParser", "Material not found: {0}", std::string(event.name));
+                    continue;
+                }
+                if (it->second != currentMaterial) {
+                    closeRun(faceIndex);
+                    currentMaterial = it->second;
                 }
             }
         }
+    }
+    closeRun(static_cast<uint32_t>(out.FaceCount()));
 
-        if (!currentGroup.faces.empty()) {
-            result.groups.push_back(currentGroup);
-        }
+    if (out.positions.empty()) {
+        error = "No vertices found in OBJ file";
+        return false;
+    }
+    if (out.runs.empty()) {
+        error = "No faces found in OBJ file";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 公共接口
+// ============================================================================
 
-        result.success = true;
+OBJParseResult OBJParser::Parse(const std::string& filePath) {
+    OBJParseResult result;
 
-    } catch (const std::exception& e) {
-        result.error = "Exception while parsing OBJ from memory: " + std::string(e.what());
-        result.success = false;
+    Core::MappedFile file;
+    if (!file.Open(filePath, Core::MappedFile::AccessPattern::Sequential)) {
+        result.error = "Failed to open file: " + filePath;
+        return result;
     }
 
-    return result;
+    return ParseFromMemory(reinterpret_cast<const char*>(file.Data()), file.Size(),
+                           std::filesystem::path(filePath).parent_path());
 }
 
-bool OBJParser::ReadVertexLine(std::istringstream& line, std::vector<float>& positions) {
-    float x, y, z;
-    if (line >> x >> y >> z) {
-        positions.push_back(x);
-        positions.push_back(y);
-        positions.push_back(z);
-        return true;
+OBJParseResult OBJParser::ParseFromMemory(const char* data, size_t size,
+                                          const std::filesystem::path& baseDirectory) {
+    OBJParseResult result;
+
+    if (!data || size == 0) {
+        result.error = "Invalid data or size";
+        return result;
     }
-    return false;
-}
 
-bool OBJParser::ReadTexCoordLine(std::istringstream& line, std::vector<float>& texCoords) {
-    float u, v;
-    if (line >> u >> v) {
-        texCoords.push_back(u);
-        texCoords.push_back(v);
-        return true;
+    ParsedFile parsed;
+    if (!ParseBuffer(data, size, baseDirectory, parsed, result.error)) {
+        return result;
     }
-    return false;
+
+    result.positions = std::move(parsed.positions);
+    result.texCoords = std::move(parsed.texCoords);
+    result.normals = std::move(parsed.normals);
+    result.materials = std::move(parsed.materials);
+
+    // 转换为按面存储的旧结构 (索引从 1 开始, 0 表示缺省)
+    result.groups.resize(parsed.runs.size());
+    JobSystem::GetInstance().ParallelFor(parsed.runs.size(), [&](size_t runIndex) {
+        const ParsedFile::Run& run = parsed.runs[runIndex];
+        OBJGroup& group = result.groups[runIndex];
+        group.name = run.name;
+        group.materialIndex = run.materialIndex;
+        group.faces.resize(run.faceCount);
+
+        for (uint32_t f = 0; f < run.faceCount; ++f) {
+            const uint32_t face = run.firstFace + f;
+            auto& indices = group.faces[f].indices;
+            indices.reserve(parsed.faceOffsets[face + 1] - parsed.faceOffsets[face]);
+
+            for (uint32_t c = parsed.faceOffsets[face]; c < parsed.faceOffsets[face + 1]; ++c) {
+                const Corner& corner = parsed.corners[c];
+                indices.push_back({
+                    static_cast<uint32_t>(corner.v + 1),
+                    static_cast<uint32_t>(corner.t + 1),
+                    static_cast<uint32_t>(corner.n + 1)
+                });
+            }
+        }
+    });
+
+    result.success = true;
+    return result;
 }
 
-bool OBJParser::ReadNormalLine(std::istringstream& line, std::vector<float>& normals) {
-    float nx, ny, nz;
-    if (line >> nx >> ny >> nz) {
-        normals.push_back(nx);
-        normals.push_back(ny);
-        normals.push_back(nz);
-        return true;
+OBJMeshResult OBJParser::LoadMesh(const std::string& filePath) {
+    OBJMeshResult result;
+
+    Core::MappedFile file;
+    if (!file.Open(filePath, Core::MappedFile::AccessPattern::Sequential)) {
+        result.error = "Failed to open file: " + filePath;
+        return result;
     }
-    return false;
+
+    return LoadMeshFromMemory(reinterpret_cast<const char*>(file.Data()), file.Size(),
+                              std::filesystem::path(filePath).parent_path());
 }
 
-bool OBJParser::ReadFaceLine(std::istringstream& line, OBJFace& face) {
-    std::string faceStr;
-    while (line >> faceStr) {
-        OBJFaceIndices indices;
+OBJMeshResult OBJParser::LoadMeshFromMemory(const char* data, size_t size,
+                                            const std::filesystem::path& baseDirectory) {
+    OBJMeshResult result;
 
-        size_t firstSlash = faceStr.find('/');
-        size_t secondSlash = faceStr.rfind('/');
+    if (!data || size == 0) {
+        result.error = "Invalid data or size";
+        return result;
+    }
 
-        if (firstSlash == std::string::npos) {
-            indices.vertexIndex = std::stoi(faceStr);
-        }
-        else if (firstSlash == secondSlash) {
-            indices.vertexIndex = std::stoi(faceStr.substr(0, firstSlash));
-            indices.texCoordIndex = std::stoi(faceStr.substr(firstSlash + 1));
+    ParsedFile parsed;
+    if (!ParseBuffer(data, size, baseDirectory, parsed, result.error)) {
+        return result;
+    }
+
+    auto& jobSystem = JobSystem::GetInstance();
+    const size_t cornerCount = parsed.corners.size();
+    const size_t blockCount = (cornerCount + DedupBlockSize - 1) / DedupBlockSize;
+
+    // 1. 计算角点哈希, 按哈希高位分片并统计每块各分片的数量
+    std::vector<uint32_t> hashes(cornerCount);
+    std::vector<uint32_t> blockCounts(blockCount * DedupShardCount, 0);
+
+    jobSystem.ParallelFor(blockCount, [&](size_t block) {
+        const size_t begin = block * DedupBlockSize;
+        const size_t end = std::min(begin + DedupBlockSize, cornerCount);
+        uint32_t* counts = &blockCounts[block * DedupShardCount];
+        for (size_t c = begin; c < end; ++c) {
+            hashes[c] = HashCorner(parsed.corners[c]);
+            ++counts[hashes[c] >> (32 - DedupShardBits)];
         }
-        else {
-            indices.vertexIndex = std::stoi(faceStr.substr(0, firstSlash));
-            std::string middle = faceStr.substr(firstSlash + 1, secondSlash - firstSlash - 1);
-            if (!middle.empty()) {
-                indices.texCoordIndex = std::stoi(middle);
+    });
+
+    // 2. 按分片稳定排序角点 (分片内保持文件顺序)
+    std::vector<size_t> shardBegin(DedupShardCount + 1, 0);
+    std::vector<uint32_t> blockOffsets(blockCount * DedupShardCount);
+    {
+        size_t offset = 0;
+        for (uint32_t shard = 0; shard < DedupShardCount; ++shard) {
+            shardBegin[shard] = offset;
+            for (size_t block = 0; block < blockCount; ++block) {
+                blockOffsets[block * DedupShardCount + shard] = static_cast<uint32_t>(offset);
+                offset += blockCounts[block * DedupShardCount + shard];
             }
-            indices.normalIndex = std::stoi(faceStr.substr(secondSlash + 1));
         }
-
-        face.indices.push_back(indices);
+        shardBegin[DedupShardCount] = offset;
     }
-    return !face.indices.empty();
-}
 
-bool OBJParser::ReadMaterialLibLine(std::istringstream& line, std::vector<std::string>& materialLibs) {
-    std::string libName;
-    if (line >> libName) {
-        materialLibs.push_back(libName);
-        return true;
+    std::vector<Corner> sortedCorners(cornerCount);
+    std::vector<uint32_t> sortedHashes(cornerCount);
+    jobSystem.ParallelFor(blockCount, [&](size_t block) {
+        const size_t begin = block * DedupBlockSize;
+        const size_t end = std::min(begin + DedupBlockSize, cornerCount);
+        uint32_t* cursor = &blockOffsets[block * DedupShardCount];
+        for (size_t c = begin; c < end; ++c) {
+            const uint32_t dst = cursor[hashes[c] >> (32 - DedupShardBits)]++;
+            sortedCorners[dst] = parsed.corners[c];
+            sortedHashes[dst] = hashes[c];
+        }
+    });
+
+    // 3. 各分片独立去重, 得到分片内的顶点序号 (按分片排序后的顺序存放)
+    std::vector<uint32_t> localVertex(cornerCount);
+    std::vector<uint32_t> shardVertexCount(DedupShardCount, 0);
+
+    jobSystem.ParallelFor(DedupShardCount, [&](size_t shard) {
+        const size_t begin = shardBegin[shard];
+        const size_t end = shardBegin[shard + 1];
+        if (begin == end) return;
+
+        CornerTable table((end - begin) / 2);
+        uint32_t nextVertex = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t vertex = table.FindOrInsert(sortedCorners[i], sortedHashes[i], nextVertex);
+            if (vertex == nextVertex) ++nextVertex;
+            localVertex[i] = vertex;
+        }
+        shardVertexCount[shard] = nextVertex;
+    });
+
+    sortedCorners = {};
+    sortedHashes = {};
+
+    // 4. 按首次出现顺序重新编号, 使结果与串行去重一致
+    //    分片内保持文件顺序, 因此按文件顺序遍历时各分片的读取位置依次递增
+    std::vector<std::vector<uint32_t>> remap(DedupShardCount);
+    for (uint32_t shard = 0; shard < DedupShardCount; ++shard) {
+        remap[shard].assign(shardVertexCount[shard], InvalidVertex);
     }
-    return false;
-}
 
-bool OBJParser::ReadGroupLine(std::istringstream& line, std::string& groupName) {
-    if (line >> groupName) {
-        return true;
+    std::vector<size_t> shardCursor(shardBegin.begin(), shardBegin.end() - 1);
+    std::vector<uint32_t> cornerVertex(cornerCount);
+    std::vector<uint32_t> vertexSource;
+    vertexSource.reserve(cornerCount / 2);
+    for (size_t c = 0; c < cornerCount; ++c) {
+        const uint32_t shard = hashes[c] >> (32 - DedupShardBits);
+        uint32_t& global = remap[shard][localVertex[shardCursor[shard]++]];
+        if (global == InvalidVertex) {
+            global = static_cast<uint32_t>(vertexSource.size());
+            vertexSource.push_back(static_cast<uint32_t>(c));
+        }
+        cornerVertex[c] = global;
     }
-    return false;
-}
 
-bool OBJParser::ReadUseMaterialLine(std::istringstream& line, uint32_t& materialIndex) {
-    std::string materialName;
-    if (line >> materialName) {
-        // 注意：这个函数需要在调用者提供材质列表的上下文
-        materialIndex = 0;
-        return true;
+    hashes = {};
+    localVertex = {};
+    remap = {};
+
+    // 5. 生成顶点数据
+    result.vertices.resize(vertexSource.size());
+    const size_t vertexBlocks = (vertexSource.size() + DedupBlockSize - 1) / DedupBlockSize;
+    jobSystem.ParallelFor(vertexBlocks, [&](size_t block) {
+        const size_t begin = block * DedupBlockSize;
+        const size_t end = std::min(begin + DedupBlockSize, vertexSource.size());
+        for (size_t i = begin; i < end; ++i) {
+            const Corner& corner = parsed.corners[vertexSource[i]];
+            OBJVertex& vertex = result.vertices[i];
+
+            std::memcpy(vertex.position, &parsed.positions[static_cast<size_t>(corner.v) * 3], sizeof(vertex.position));
+
+            if (corner.t != MissingIndex) {
+                std::memcpy(vertex.texCoord, &parsed.texCoords[static_cast<size_t>(corner.t) * 2], sizeof(vertex.texCoord));
+            } else {
+                vertex.texCoord[0] = vertex.texCoord[1] = 0.0f;
+            }
+
+            if (corner.n != MissingIndex) {
+                std::memcpy(vertex.normal, &parsed.normals[static_cast<size_t>(corner.n) * 3], sizeof(vertex.normal));
+            } else {
+                vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+            }
+        }
+    });
+
+    result.hasTexCoords = !parsed.texCoords.empty();
+    result.hasNormals = !parsed.normals.empty();
+
+    // 6. 扇形三角化, 每个面区间对应一个子网格
+    size_t triangleCount = cornerCount - 2 * parsed.FaceCount();
+    result.indices.reserve(triangleCount * 3);
+
+    for (const ParsedFile::Run& run : parsed.runs) {
+        OBJSubMesh subMesh;
+        subMesh.name = run.name;
+        subMesh.materialIndex = run.materialIndex;
+        subMesh.indexOffset = static_cast<uint32_t>(result.indices.size());
+
+        for (uint32_t face = run.firstFace; face < run.firstFace + run.faceCount; ++face) {
+            const uint32_t first = parsed.faceOffsets[face];
+            const uint32_t last = parsed.faceOffsets[face + 1];
+            for (uint32_t c = first + 1; c + 1 < last; ++c) {
+                result.indices.push_back(cornerVertex[first]);
+                result.indices.push_back(cornerVertex[c]);
+                result.indices.push_back(cornerVertex[c + 1]);
+            }
+        }
+
+        subMesh.indexCount = static_cast<uint32_t>(result.indices.size()) - subMesh.indexOffset;
+        result.subMeshes.push_back(std::move(subMesh));
     }
-    return false;
+
+    result.materials = std::move(parsed.materials);
+    result.materialLibraries = std::move(parsed.materialLibraries);
+    result.success = true;
+    return result;
 }
 
+// ============================================================================
+// 材质文件
+// ============================================================================
+
 bool OBJParser::ReadMaterialFile(const std::string& filePath, std::vector<OBJMaterial>& materials) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        return false;
+    // 优先从已挂载的归档读取
+    std::istringstream file;
+    if (Core::VfsFile archived = Core::VirtualFileSystem::GetInstance().Open(filePath)) {
+        file.str(std::string(archived.Text()));
+    } else {
+        std::ifstream disk(filePath);
+        if (!disk.is_open()) {
+            return false;
+        }
+        std::ostringstream content;
+        content << disk.rdbuf();
+        file.str(content.str());
     }
 
     OBJMaterial currentMaterial;
@@ -488,18 +858,5 @@ bool OBJParser::ReadMaterialFile(const std::string& filePath, std::vector<OBJMat
     return !materials.empty();
 }
 
-std::string OBJParser::ReadWord(std::istringstream& line) {
-    std::string word;
-    line >> word;
-    return word;
-}
-
-bool OBJParser::SkipWhitespace(std::istringstream& line) {
-    while (line.peek() == ' ' || line.peek() == '\t') {
-        line.get();
-    }
-    return line.peek() != EOF && line.peek() != '\n' && line.peek() != '\r';
-}
-
 } // namespace Resource
 } // namespace PrismaEngine
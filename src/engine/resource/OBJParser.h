@@ -2,11 +2,8 @@
 
 #include <vector>
 #include <string>
-#include <fstream>
-#include <sstream>
-#include <map>
-#include <unordered_map>
 #include <cstdint>
+#include <filesystem>
 
 namespace PrismaEngine {
 namespace Resource {
@@ -20,11 +17,12 @@ struct OBJTexCoord {
 
 /**
  * @brief OBJ面索引数据结构
+ * 索引从 1 开始（与OBJ文件一致，负数相对索引已解析为绝对索引），0 表示缺省
  */
 struct OBJFaceIndices {
-    uint32_t vertexIndex;
-    uint32_t texCoordIndex;
-    uint32_t normalIndex;
+    uint32_t vertexIndex = 0;
+    uint32_t texCoordIndex = 0;
+    uint32_t normalIndex = 0;
 };
 
 /**
@@ -40,7 +38,7 @@ struct OBJFace {
 struct OBJGroup {
     std::string name;
     std::vector<OBJFace> faces;
-    uint32_t materialIndex;
+    uint32_t materialIndex = 0;
 };
 
 /**
@@ -80,8 +78,49 @@ struct OBJParseResult {
     OBJParseResult() : success(false) {}
 };
 
+/**
+ * @brief 去重后的OBJ顶点
+ */
+struct OBJVertex {
+    float position[3];
+    float texCoord[2];
+    float normal[3];
+};
+
+/**
+ * @brief OBJ子网格（索引缓冲区中的一段连续三角形）
+ */
+struct OBJSubMesh {
+    std::string name;
+    uint32_t materialIndex = 0;
+    uint32_t indexOffset = 0;
+    uint32_t indexCount = 0;
+};
+
+/**
+ * @brief 可直接上传GPU的OBJ网格
+ * 多边形已按扇形三角化，(v, vt, vn) 相同的角点共享同一个顶点
+ */
+struct OBJMeshResult {
+    bool success = false;
+    std::string error;
+
+    std::vector<OBJVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<OBJSubMesh> subMeshes;
+    std::vector<OBJMaterial> materials;
+    std::vector<std::string> materialLibraries;  // 引用的材质库路径 (含加载失败的), 用于热重载
+
+    bool hasTexCoords = false;
+    bool hasNormals = false;
+};
+
 /**
  * @brief OBJ文件解析器
+ *
+ * 文件通过内存映射读取，按行边界切分成若干块在工作线程上并行解析，
+ * 数值使用 std::from_chars 直接从映射区解析，不产生中间字符串。
+ * 各块结果按文件顺序合并，负数（相对）索引在合并时解析。
  */
 class OBJParser {
 public:
@@ -96,26 +135,35 @@ public:
      * @brief 从内存解析OBJ数据
      * @param data OBJ文件数据
      * @param size 数据大小
+     * @param baseDirectory mtllib 相对路径的基准目录，为空时不加载材质库
      * @return 解析结果
      */
-    static OBJParseResult ParseFromMemory(const char* data, size_t size);
+    static OBJParseResult ParseFromMemory(const char* data, size_t size,
+                                          const std::filesystem::path& baseDirectory = {});
+
+    /**
+     * @brief 加载OBJ文件为三角化、顶点去重后的网格
+     * @param filePath OBJ文件路径
+     * @return 网格数据
+     */
+    static OBJMeshResult LoadMesh(const std::string& filePath);
+
+    /**
+     * @brief 从内存加载OBJ网格
+     */
+    static OBJMeshResult LoadMeshFromMemory(const char* data, size_t size,
+                                            const std::filesystem::path& baseDirectory = {});
 
 private:
-    // 读取各种行类型
-    static bool ReadVertexLine(std::istringstream& line, std::vector<float>& positions);
-    static bool ReadTexCoordLine(std::istringstream& line, std::vector<float>& texCoords);
-    static bool ReadNormalLine(std::istringstream& line, std::vector<float>& normals);
-    static bool ReadFaceLine(std::istringstream& line, OBJFace& face);
-    static bool ReadMaterialLibLine(std::istringstream& line, std::vector<std::string>& materialLibs);
-    static bool ReadGroupLine(std::istringstream& line, std::string& groupName);
-    static bool ReadUseMaterialLine(std::istringstream& line, uint32_t& materialIndex);
+    struct ParsedFile;
+
+    // 并行解析整个缓冲区并合并各块结果
+    static bool ParseBuffer(const char* data, size_t size,
+                            const std::filesystem::path& baseDirectory,
+                            ParsedFile& out, std::string& error);
 
     // 读取材质文件
     static bool ReadMaterialFile(const std::string& filePath, std::vector<OBJMaterial>& materials);
-
-    // 辅助函数
-    static std::string ReadWord(std::istringstream& line);
-    static bool SkipWhitespace(std::istringstream& line);
 };
 
 } // namespace Resource
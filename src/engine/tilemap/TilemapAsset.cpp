@@ -1,11 +1,19 @@
 #include "TilemapAsset.h"
 #include "format/TmxParser.h"
 #include "format/TsxParser.h"
+#include "format/BakedTilemap.h"
+#include "format/TilemapBaker.h"
 #include "../resource/AssetSerializer.h"
 #include <filesystem>
 
 namespace PrismaEngine {
 
+TilemapAsset::TilemapAsset() = default;
+
+TilemapAsset::~TilemapAsset() {
+    Unload();
+}
+
 // ============================================================================
 // 加载
 // ============================================================================
@@ -17,6 +25,25 @@ bool TilemapAsset::Load(const std::filesystem::path& path) {
     m_path = path;
     m_name = path.filename().string();
 
+    // 优先使用烘焙文件: 显式的 .tmb, 或与 TMX 同名且不旧于它的 .tmb
+    std::filesystem::path bakedPath = path;
+    if (path.extension() != BakedTilemapFormat::Extension) {
+        bakedPath.replace_extension(BakedTilemapFormat::Extension);
+    }
+
+    std::error_code ec;
+    if (bakedPath == path ||
+        (std::filesystem::exists(bakedPath, ec) &&
+         std::filesystem::last_write_time(bakedPath, ec) >= std::filesystem::last_write_time(path, ec))) {
+        if (LoadBaked(bakedPath)) {
+            return true;
+        }
+        if (bakedPath == path) {
+            return false;
+        }
+        // 烘焙文件损坏或版本过旧时回退到 TMX
+    }
+
     // 解析 TMX 文件
     m_map = TmxParser::ParseFile(path);
 
@@ -37,15 +64,83 @@ bool TilemapAsset::Load(const std::filesystem::path& path) {
     return true;
 }
 
+bool TilemapAsset::LoadBaked(const std::filesystem::path& path) {
+    auto baked = std::make_unique<BakedTilemap>();
+    if (!baked->Open(path)) {
+        return false;
+    }
+
+    m_map = baked->CreateTileMap();
+    if (!m_map) {
+        return false;
+    }
+
+    if (m_map->name.empty()) {
+        m_map->name = path.stem().string();
+    }
+
+    m_baked = std::move(baked);
+    m_isLoaded = true;
+
+    SetMetadata(m_name, "Tilemap loaded from " + path.string());
+
+    return true;
+}
+
 // ============================================================================
 // 卸载
 // ============================================================================
 
 void TilemapAsset::Unload() {
+    // 先释放地图再解除映射, 瓦片层可能引用映射区
     m_map.reset();
+    m_baked.reset();
     m_isLoaded = false;
 }
 
+std::vector<std::filesystem::path> TilemapAsset::GetFileDependencies() const {
+    std::vector<std::filesystem::path> files;
+    if (!m_map) {
+        return files;
+    }
+
+    // 路径相对于 TMX 所在目录; 外部图块集中的图像相对于 TSX 所在目录
+    const std::filesystem::path baseDirectory = m_path.parent_path();
+    for (const auto& tileset : m_map->tilesets) {
+        std::filesystem::path imageDirectory = baseDirectory;
+        if (!tileset->source.empty()) {
+            const std::filesystem::path tsxPath = baseDirectory / tileset->source;
+            files.push_back(tsxPath);
+            imageDirectory = tsxPath.parent_path();
+        }
+        if (!tileset->imagePath.empty()) {
+            files.push_back(imageDirectory / tileset->imagePath);
+        }
+        for (const auto& image : tileset->images) {
+            if (!image.imagePath.empty()) {
+                files.push_back(imageDirectory / image.imagePath);
+            }
+        }
+    }
+    for (const ImageLayer* imageLayer : m_map->GetImageLayers()) {
+        if (!imageLayer->imagePath.empty()) {
+            files.push_back(baseDirectory / imageLayer->imagePath);
+        }
+    }
+    return files;
+}
+
+// ============================================================================
+// 烘焙
+// ============================================================================
+
+bool TilemapAsset::Bake(const std::filesystem::path& outPath) const {
+    if (!m_map) {
+        return false;
+    }
+    return TilemapBaker::BakeToFile(*m_map, outPath);
+}
+
 // ============================================================================
 // 序列化
 // ============================================================================
@@ -7,14 +7,16 @@
 
 namespace PrismaEngine {
 
+class BakedTilemap;
+
 // ============================================================================
 // 瓦片地图资源类
 // ============================================================================
 
 class TilemapAsset : public Asset {
 public:
-    TilemapAsset() = default;
-    ~TilemapAsset() override = default;
+    TilemapAsset();
+    ~TilemapAsset() override;
 
     // AssetBase 接口实现
     bool Load(const std::filesystem::path& path) override;
@@ -22,6 +24,9 @@ public:
     bool IsLoaded() const override { return m_isLoaded; }
     AssetType GetType() const override { return AssetType::Tilemap; }
 
+    // 外部 TSX 和图块集图像, 热重载时随之重新加载
+    std::vector<std::filesystem::path> GetFileDependencies() const override;
+
     // Serializable 接口实现
     void Serialize(OutputArchive& archive) const override;
     void Deserialize(InputArchive& archive) override;
@@ -30,6 +35,12 @@ public:
     std::string GetAssetType() const override { return "Tilemap"; }
     std::string GetAssetVersion() const override { return "1.0.0"; }
 
+    // 将当前地图烘焙为 .tmb 文件 (离线构建步骤)
+    bool Bake(const std::filesystem::path& outPath) const;
+
+    // 是否从烘焙文件加载 (瓦片层数据直接引用内存映射)
+    bool IsBaked() const { return m_baked != nullptr; }
+
     // 获取解析后的地图数据
     const TileMap* GetMap() const { return m_map.get(); }
     TileMap* GetMap() { return m_map.get(); }
@@ -98,6 +109,10 @@ public:
     T GetProperty(const std::string& name, const T& defaultValue) const;
 
 private:
+    bool LoadBaked(const std::filesystem::path& path);
+
+    // 烘焙文件映射必须比 m_map 存活更久
+    std::unique_ptr<BakedTilemap> m_baked;
     std::unique_ptr<TileMap> m_map;
     bool m_isLoaded = false;
 };
@@ -23,6 +23,10 @@ struct TileLayerData {
     int height = 0;
     std::vector<uint32_t> data;  // GID 数组
 
+    // 外部 GID 视图 (例如烘焙文件的内存映射区), 非空时优先于 data 且不拷贝
+    const uint32_t* mappedData = nullptr;
+    size_t mappedCount = 0;
+
     // 无限地图块数据
     struct Chunk {
         int x = 0;
@@ -30,6 +34,12 @@ struct TileLayerData {
         int width = 0;
         int height = 0;
         std::vector<uint32_t> data;
+
+        const uint32_t* mappedData = nullptr;
+        size_t mappedCount = 0;
+
+        const uint32_t* Gids() const { return mappedData ? mappedData : data.data(); }
+        size_t GidCount() const { return mappedData ? mappedCount : data.size(); }
     };
     std::vector<Chunk> chunks;
 
@@ -38,23 +48,47 @@ struct TileLayerData {
         return !chunks.empty();
     }
 
+    // 当前生效的 GID 数组
+    const uint32_t* Gids() const { return mappedData ? mappedData : data.data(); }
+    size_t GidCount() const { return mappedData ? mappedCount : data.size(); }
+
+    // 是否引用外部映射数据
+    bool IsMapped() const { return mappedData != nullptr; }
+
+    // 将外部映射数据拷贝为私有副本 (写入前调用)
+    void Detach() {
+        if (mappedData) {
+            data.assign(mappedData, mappedData + mappedCount);
+            mappedData = nullptr;
+            mappedCount = 0;
+        }
+        for (auto& chunk : chunks) {
+            if (chunk.mappedData) {
+                chunk.data.assign(chunk.mappedData, chunk.mappedData + chunk.mappedCount);
+                chunk.mappedData = nullptr;
+                chunk.mappedCount = 0;
+            }
+        }
+    }
+
     // 获取指定位置的 GID
     uint32_t GetGid(int x, int y) const {
         if (x < 0 || y < 0 || x >= width || y >= height) {
             return 0;
         }
         size_t index = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
-        if (index >= data.size()) {
+        if (index >= GidCount()) {
             return 0;
         }
-        return data[index];
+        return Gids()[index];
     }
 
     // 设置指定位置的 GID
     void SetGid(int x, int y, uint32_t gid) {
         if (x >= 0 && y >= 0 && x < width && y < height) {
             size_t index = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
-            if (index < data.size()) {
+            if (index < GidCount()) {
+                Detach();
                 data[index] = gid;
             }
         }
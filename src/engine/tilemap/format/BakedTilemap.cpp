@@ -0,0 +1,382 @@
+#include "BakedTilemap.h"
+#include <cstring>
+
+namespace PrismaEngine {
+
+using namespace BakedTilemapFormat;
+
+std::string BakedTilemap::s_lastError;
+
+// ============================================================================
+// 打开/关闭
+// ============================================================================
+
+bool BakedTilemap::Open(const std::filesystem::path& filePath) {
+    Close();
+
+    if (!m_file.Open(filePath, Core::MappedFile::AccessPattern::Sequential)) {
+        s_lastError = "Failed to map baked tilemap: " + filePath.string();
+        return false;
+    }
+
+    m_data = m_file.Data();
+    m_size = m_file.Size();
+
+    if (!Validate()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool BakedTilemap::OpenMemory(std::span<const uint8_t> data) {
+    Close();
+
+    m_data = data.data();
+    m_size = data.size();
+
+    if (!Validate()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void BakedTilemap::Close() {
+    m_header = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_file.Close();
+}
+
+// ============================================================================
+// 校验 - 只检查头和段表, 各区间在访问时按需检查
+// ============================================================================
+
+bool BakedTilemap::Validate() {
+    m_header = nullptr;
+
+    if (!m_data || m_size < sizeof(BakedHeader)) {
+        s_lastError = "Baked tilemap is truncated";
+        return false;
+    }
+
+    if (reinterpret_cast<uintptr_t>(m_data) % alignof(BakedHeader) != 0) {
+        s_lastError = "Baked tilemap buffer is misaligned";
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const BakedHeader*>(m_data);
+    if (header->magic != Magic) {
+        s_lastError = "Not a baked tilemap (bad magic)";
+        return false;
+    }
+    if (header->endianTag != EndianTag) {
+        s_lastError = "Baked tilemap has incompatible byte order";
+        return false;
+    }
+    if (header->version != Version) {
+        s_lastError = "Unsupported baked tilemap version: " + std::to_string(header->version);
+        return false;
+    }
+    if (header->fileSize != m_size) {
+        s_lastError = "Baked tilemap size mismatch";
+        return false;
+    }
+
+    for (uint32_t i = 0; i < SectionCount; ++i) {
+        const BakedSection& section = header->sections[i];
+        uint64_t elementSize = SectionElementSize(static_cast<SectionId>(i));
+        uint64_t end = static_cast<uint64_t>(section.offset) + elementSize * section.count;
+        if (section.count > 0 && (section.offset < sizeof(BakedHeader) || end > m_size)) {
+            s_lastError = "Baked tilemap section out of bounds: " + std::to_string(i);
+            return false;
+        }
+        if (section.offset % 4 != 0) {
+            s_lastError = "Baked tilemap section misaligned: " + std::to_string(i);
+            return false;
+        }
+    }
+
+    m_header = header;
+
+    // 组层必须出现在其子层之前, 重建层树时依赖这一顺序
+    auto layers = GetSection<BakedLayer>(SectionId::Layers);
+    for (size_t i = 0; i < layers.size(); ++i) {
+        uint32_t parent = layers[i].parent;
+        if (parent != InvalidIndex &&
+            (parent >= i || layers[parent].type != static_cast<uint32_t>(LayerType::GroupLayer))) {
+            s_lastError = "Baked tilemap layer hierarchy is invalid";
+            m_header = nullptr;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string_view BakedTilemap::GetString(const BakedString& str) const {
+    auto strings = GetSection<char>(SectionId::Strings);
+    if (str.offset > strings.size() || str.length > strings.size() - str.offset) {
+        return {};
+    }
+    return {strings.data() + str.offset, str.length};
+}
+
+// ============================================================================
+// 运行时地图重建
+// ============================================================================
+
+PropertyMap BakedTilemap::BuildProperties(const BakedRange& range) const {
+    PropertyMap properties;
+    for (const auto& baked : GetRange<BakedProperty>(SectionId::Properties, range)) {
+        Property prop;
+        prop.name = std::string(GetString(baked.name));
+        prop.value = std::string(GetString(baked.value));
+        prop.type = static_cast<PropertyType>(baked.type);
+        properties[prop.name] = std::move(prop);
+    }
+    return properties;
+}
+
+std::vector<std::pair<float, float>> BakedTilemap::BuildPoints(const BakedRange& range) const {
+    std::vector<std::pair<float, float>> points;
+    auto src = GetRange<BakedPoint>(SectionId::Points, range);
+    points.reserve(src.size());
+    for (const auto& point : src) {
+        points.emplace_back(point.x, point.y);
+    }
+    return points;
+}
+
+std::unique_ptr<Tileset> BakedTilemap::BuildTileset(const BakedTileset& baked) const {
+    auto tileset = std::make_unique<Tileset>();
+
+    tileset->name = std::string(GetString(baked.name));
+    tileset->imagePath = std::string(GetString(baked.imagePath));
+    tileset->source = std::string(GetString(baked.source));
+    tileset->firstGid = baked.firstGid;
+    tileset->tileWidth = baked.tileWidth;
+    tileset->tileHeight = baked.tileHeight;
+    tileset->spacing = baked.spacing;
+    tileset->margin = baked.margin;
+    tileset->tileCount = baked.tileCount;
+    tileset->columns = baked.columns;
+    tileset->objectAlignment = baked.objectAlignment;
+    tileset->imageWidth = baked.imageWidth;
+    tileset->imageHeight = baked.imageHeight;
+    tileset->tileOffset.x = baked.tileOffsetX;
+    tileset->tileOffset.y = baked.tileOffsetY;
+    tileset->transparentColor.r = baked.transparentR;
+    tileset->transparentColor.g = baked.transparentG;
+    tileset->transparentColor.b = baked.transparentB;
+    tileset->grid.orientation = static_cast<Orientation>(baked.gridOrientation);
+    tileset->grid.width = baked.gridWidth;
+    tileset->grid.height = baked.gridHeight;
+    tileset->properties = BuildProperties(baked.properties);
+
+    for (const auto& image : GetRange<BakedImageTile>(SectionId::ImageTiles, baked.imageTiles)) {
+        Tileset::ImageTile imgTile;
+        imgTile.id = image.id;
+        imgTile.imagePath = std::string(GetString(image.imagePath));
+        imgTile.imageWidth = image.imageWidth;
+        imgTile.imageHeight = image.imageHeight;
+        tileset->images.push_back(std::move(imgTile));
+    }
+
+    for (const auto& bakedTile : GetRange<BakedTile>(SectionId::Tiles, baked.tiles)) {
+        Tile tile;
+        tile.id = bakedTile.id;
+        tile.type = std::string(GetString(bakedTile.type));
+        tile.imagePath = std::string(GetString(bakedTile.imagePath));
+        tile.probability = bakedTile.probability;
+        tile.properties = BuildProperties(bakedTile.properties);
+
+        for (const auto& frame : GetRange<BakedFrame>(SectionId::Frames, bakedTile.frames)) {
+            tile.animation.push_back({frame.tileId, frame.duration});
+        }
+
+        for (const auto& shape : GetRange<BakedShape>(SectionId::Shapes, bakedTile.shapes)) {
+            CollisionShape collision;
+            collision.type = static_cast<CollisionShapeType>(shape.type);
+            collision.points = BuildPoints(shape.points);
+            tile.collisionShapes.push_back(std::move(collision));
+        }
+
+        tileset->tiles[tile.id] = std::move(tile);
+    }
+
+    return tileset;
+}
+
+std::unique_ptr<MapObject> BakedTilemap::BuildObject(const BakedObject& baked) const {
+    auto obj = std::make_unique<MapObject>();
+    obj->id = baked.id;
+    obj->name = std::string(GetString(baked.name));
+    obj->type = std::string(GetString(baked.type));
+    obj->x = baked.x;
+    obj->y = baked.y;
+    obj->width = baked.width;
+    obj->height = baked.height;
+    obj->rotation = baked.rotation;
+    obj->gid = baked.gid;
+    obj->visible = baked.visible != 0;
+    obj->objectType = static_cast<ObjectType>(baked.objectType);
+    obj->points = BuildPoints(baked.points);
+    obj->properties = BuildProperties(baked.properties);
+
+    auto texts = GetSection<BakedText>(SectionId::Texts);
+    if (baked.text != InvalidIndex && baked.text < texts.size()) {
+        const BakedText& bakedText = texts[baked.text];
+        auto* text = new TextObject();
+        text->text = std::string(GetString(bakedText.text));
+        text->fontFamily = std::string(GetString(bakedText.fontFamily));
+        text->color = std::string(GetString(bakedText.color));
+        text->pixelSize = bakedText.pixelSize;
+        text->kerning = bakedText.kerning;
+        text->wrap = (bakedText.flags & TextWrap) != 0;
+        text->bold = (bakedText.flags & TextBold) != 0;
+        text->italic = (bakedText.flags & TextItalic) != 0;
+        text->underline = (bakedText.flags & TextUnderline) != 0;
+        text->strikeout = (bakedText.flags & TextStrikeout) != 0;
+        text->hAlign = (bakedText.flags & TextHCenter) != 0;
+        text->vAlign = (bakedText.flags & TextVCenter) != 0;
+        obj->text = text;
+    }
+
+    return obj;
+}
+
+std::unique_ptr<Layer> BakedTilemap::BuildLayer(const BakedLayer& baked) const {
+    std::unique_ptr<Layer> layer;
+
+    auto fillCommon = [&](auto& data) {
+        data.id = baked.id;
+        data.name = std::string(GetString(baked.name));
+        data.tint = std::string(GetString(baked.tint));
+        data.visible = baked.visible != 0;
+        data.opacity = baked.opacity;
+        data.offsetX = baked.offsetX;
+        data.offsetY = baked.offsetY;
+        data.parallaxX = baked.parallaxX;
+        data.parallaxY = baked.parallaxY;
+        data.properties = BuildProperties(baked.properties);
+    };
+
+    switch (static_cast<LayerType>(baked.type)) {
+        case LayerType::TileLayer: {
+            auto impl = std::make_unique<TileLayerImpl>();
+            TileLayer* tileLayer = impl->AsTileLayer();
+            fillCommon(*tileLayer);
+
+            TileLayerData& tileData = tileLayer->tileData;
+            tileData.width = baked.width;
+            tileData.height = baked.height;
+
+            auto gids = GetLayerGids(baked);
+            tileData.mappedData = gids.empty() ? nullptr : gids.data();
+            tileData.mappedCount = gids.size();
+
+            for (const auto& bakedChunk : GetRange<BakedChunk>(SectionId::Chunks, baked.chunks)) {
+                TileLayerData::Chunk chunk;
+                chunk.x = bakedChunk.x;
+                chunk.y = bakedChunk.y;
+                chunk.width = bakedChunk.width;
+                chunk.height = bakedChunk.height;
+                auto chunkGids = GetRange<uint32_t>(SectionId::Gids, bakedChunk.gids);
+                chunk.mappedData = chunkGids.empty() ? nullptr : chunkGids.data();
+                chunk.mappedCount = chunkGids.size();
+                tileData.chunks.push_back(std::move(chunk));
+            }
+            layer = std::move(impl);
+            break;
+        }
+
+        case LayerType::ObjectLayer: {
+            auto impl = std::make_unique<ObjectLayerImpl>();
+            ObjectLayer* objectLayer = impl->AsObjectLayer();
+            fillCommon(*objectLayer);
+            objectLayer->drawOrder = static_cast<DrawOrder>(baked.drawOrder);
+            for (const auto& bakedObject : GetRange<BakedObject>(SectionId::Objects, baked.objects)) {
+                objectLayer->objects.push_back(BuildObject(bakedObject));
+            }
+            layer = std::move(impl);
+            break;
+        }
+
+        case LayerType::ImageLayer: {
+            auto impl = std::make_unique<ImageLayerImpl>();
+            ImageLayer* imageLayer = impl->AsImageLayer();
+            fillCommon(*imageLayer);
+            imageLayer->imagePath = std::string(GetString(baked.imagePath));
+            imageLayer->imageWidth = baked.imageWidth;
+            imageLayer->imageHeight = baked.imageHeight;
+            layer = std::move(impl);
+            break;
+        }
+
+        case LayerType::GroupLayer: {
+            auto impl = std::make_unique<GroupLayerImpl>();
+            fillCommon(*impl->AsGroupLayer());
+            layer = std::move(impl);
+            break;
+        }
+
+        default:
+            return nullptr;
+    }
+
+    // 同步基类字段, 便于按名称/ID 查找
+    fillCommon(*layer);
+    return layer;
+}
+
+std::unique_ptr<TileMap> BakedTilemap::CreateTileMap() const {
+    if (!IsOpen()) {
+        s_lastError = "Baked tilemap is not open";
+        return nullptr;
+    }
+
+    auto map = std::make_unique<TileMap>();
+
+    map->version = std::string(GetString(m_header->mapVersion));
+    map->name = std::string(GetString(m_header->name));
+    map->backgroundColor = std::string(GetString(m_header->backgroundColor));
+    map->width = m_header->width;
+    map->height = m_header->height;
+    map->tileWidth = m_header->tileWidth;
+    map->tileHeight = m_header->tileHeight;
+    map->hexSideLength = m_header->hexSideLength;
+    map->orientation = static_cast<Orientation>(m_header->orientation);
+    map->renderOrder = static_cast<RenderOrder>(m_header->renderOrder);
+    map->staggerAxis = static_cast<StaggerAxis>(m_header->staggerAxis);
+    map->staggerIndex = static_cast<StaggerIndex>(m_header->staggerIndex);
+    map->infinite = m_header->infinite != 0;
+    map->properties = BuildProperties(m_header->properties);
+
+    for (const auto& bakedTileset : GetSection<BakedTileset>(SectionId::Tilesets)) {
+        map->tilesets.push_back(BuildTileset(bakedTileset));
+    }
+
+    // 先序层表 -> 层树; Validate 已保证父层位于子层之前
+    auto bakedLayers = GetSection<BakedLayer>(SectionId::Layers);
+    std::vector<GroupLayer*> groups(bakedLayers.size(), nullptr);
+
+    for (size_t i = 0; i < bakedLayers.size(); ++i) {
+        const BakedLayer& baked = bakedLayers[i];
+        auto layer = BuildLayer(baked);
+        if (!layer) continue;
+
+        groups[i] = layer->AsGroupLayer();
+
+        if (baked.parent == InvalidIndex) {
+            map->layers.push_back(std::move(layer));
+        } else if (GroupLayer* parent = groups[baked.parent]) {
+            parent->layers.push_back(std::move(layer));
+        }
+    }
+
+    return map;
+}
+
+} // namespace PrismaEngine
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../core/Map.h"
+#include "../../core/MappedFile.h"
+#include "BakedTilemapFormat.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace PrismaEngine {
+
+// ============================================================================
+// 烘焙瓦片地图 - 内存映射 .tmb 文件并原地访问
+// ============================================================================
+
+class BakedTilemap {
+public:
+    BakedTilemap() = default;
+    ~BakedTilemap() = default;
+
+    BakedTilemap(const BakedTilemap&) = delete;
+    BakedTilemap& operator=(const BakedTilemap&) = delete;
+
+    // 映射并校验 .tmb 文件
+    bool Open(const std::filesystem::path& filePath);
+
+    // 使用外部内存 (调用方保证其生命周期长于本对象及其创建的 TileMap)
+    bool OpenMemory(std::span<const uint8_t> data);
+
+    // 关闭映射 (之前创建的 TileMap 将失效)
+    void Close();
+
+    bool IsOpen() const { return m_header != nullptr; }
+
+    // 文件头
+    const BakedTilemapFormat::BakedHeader& GetHeader() const { return *m_header; }
+
+    // 获取整段数据
+    template <typename T>
+    std::span<const T> GetSection(BakedTilemapFormat::SectionId id) const {
+        const auto& section = m_header->sections[static_cast<uint32_t>(id)];
+        return {reinterpret_cast<const T*>(m_data + section.offset), section.count};
+    }
+
+    // 获取段内的区间 (越界时返回空)
+    template <typename T>
+    std::span<const T> GetRange(BakedTilemapFormat::SectionId id, const BakedTilemapFormat::BakedRange& range) const {
+        auto section = GetSection<T>(id);
+        if (range.first > section.size() || range.count > section.size() - range.first) {
+            return {};
+        }
+        return section.subspan(range.first, range.count);
+    }
+
+    // 获取字符串 (越界时返回空)
+    std::string_view GetString(const BakedTilemapFormat::BakedString& str) const;
+
+    // 获取层的 GID 数组 (直接指向映射区)
+    std::span<const uint32_t> GetLayerGids(const BakedTilemapFormat::BakedLayer& layer) const {
+        return GetRange<uint32_t>(BakedTilemapFormat::SectionId::Gids, layer.gids);
+    }
+
+    // 创建运行时地图; 瓦片层的 GID 数组引用映射区而非拷贝
+    std::unique_ptr<TileMap> CreateTileMap() const;
+
+    // 获取最后错误信息
+    static const std::string& GetLastError() { return s_lastError; }
+
+private:
+    bool Validate();
+
+    PropertyMap BuildProperties(const BakedTilemapFormat::BakedRange& range) const;
+    std::vector<std::pair<float, float>> BuildPoints(const BakedTilemapFormat::BakedRange& range) const;
+    std::unique_ptr<Tileset> BuildTileset(const BakedTilemapFormat::BakedTileset& baked) const;
+    std::unique_ptr<Layer> BuildLayer(const BakedTilemapFormat::BakedLayer& baked) const;
+    std::unique_ptr<MapObject> BuildObject(const BakedTilemapFormat::BakedObject& baked) const;
+
+    static std::string s_lastError;
+
+    Core::MappedFile m_file;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    const BakedTilemapFormat::BakedHeader* m_header = nullptr;
+};
+
+} // namespace PrismaEngine
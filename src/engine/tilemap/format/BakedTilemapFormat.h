@@ -0,0 +1,256 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace PrismaEngine {
+
+// ============================================================================
+// 烘焙瓦片地图二进制格式 (.tmb)
+//
+// 文件布局:
+//   BakedHeader
+//   段 0..N (每段 16 字节对齐, 由 BakedHeader::sections 描述)
+//
+// 所有引用均为相对文件起始处的字节偏移或段内元素下标, 不包含指针,
+// 因此文件可以直接内存映射后原地使用。数值按小端序存储。
+// ============================================================================
+
+namespace BakedTilemapFormat {
+
+constexpr uint32_t Magic         = 0x424D5450;  // "PTMB"
+constexpr uint32_t Version       = 1;
+constexpr uint32_t EndianTag     = 0x01020304;
+constexpr uint32_t SectionAlign  = 16;
+constexpr uint32_t InvalidIndex  = 0xFFFFFFFF;
+constexpr const char* Extension  = ".tmb";
+
+// 段标识
+enum class SectionId : uint32_t {
+    Strings = 0,   // UTF-8 字符串池 (char)
+    Properties,    // BakedProperty
+    Tilesets,      // BakedTileset
+    Tiles,         // BakedTile (图块集中的特殊瓦片)
+    ImageTiles,    // BakedImageTile (Image Collection)
+    Frames,        // BakedFrame (动画帧)
+    Shapes,        // BakedShape (碰撞形状)
+    Points,        // BakedPoint (碰撞形状/对象的顶点)
+    Layers,        // BakedLayer (先序展开, 组层通过 parent 关联)
+    Chunks,        // BakedChunk (无限地图块)
+    Objects,       // BakedObject
+    Texts,         // BakedText
+    Gids,          // uint32_t GID 数组 (层和块的数据在此原地引用)
+    Count
+};
+
+constexpr uint32_t SectionCount = static_cast<uint32_t>(SectionId::Count);
+
+// 字符串引用 (位于 Strings 段)
+struct BakedString {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+// 区间引用 (位于某个段内的连续元素)
+struct BakedRange {
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+struct BakedSection {
+    uint32_t offset = 0;  // 相对文件起始
+    uint32_t count  = 0;  // 元素数量
+};
+
+struct BakedHeader {
+    uint32_t magic     = Magic;
+    uint32_t version   = Version;
+    uint32_t endianTag = EndianTag;
+    uint32_t fileSize  = 0;
+
+    // 地图属性
+    BakedString mapVersion;
+    BakedString name;
+    BakedString backgroundColor;
+    int32_t width         = 0;
+    int32_t height        = 0;
+    int32_t tileWidth     = 0;
+    int32_t tileHeight    = 0;
+    int32_t hexSideLength = 0;
+    uint8_t orientation   = 0;
+    uint8_t renderOrder   = 0;
+    uint8_t staggerAxis   = 0;
+    uint8_t staggerIndex  = 0;
+    uint32_t infinite     = 0;
+    BakedRange properties;
+
+    BakedSection sections[SectionCount];
+};
+
+struct BakedProperty {
+    BakedString name;
+    BakedString value;
+    uint32_t type = 0;  // PropertyType
+};
+
+struct BakedTileset {
+    BakedString name;
+    BakedString imagePath;
+    BakedString source;
+    int32_t firstGid        = 0;
+    int32_t tileWidth       = 0;
+    int32_t tileHeight      = 0;
+    int32_t spacing         = 0;
+    int32_t margin          = 0;
+    int32_t tileCount       = 0;
+    int32_t columns         = 0;
+    int32_t objectAlignment = 0;
+    int32_t imageWidth      = 0;
+    int32_t imageHeight     = 0;
+    int32_t tileOffsetX     = 0;
+    int32_t tileOffsetY     = 0;
+    int32_t transparentR    = 0;
+    int32_t transparentG    = 0;
+    int32_t transparentB    = 0;
+    uint32_t gridOrientation = 0;
+    int32_t gridWidth       = 0;
+    int32_t gridHeight      = 0;
+    BakedRange tiles;       // Tiles 段
+    BakedRange imageTiles;  // ImageTiles 段
+    BakedRange properties;  // Properties 段
+};
+
+struct BakedTile {
+    int32_t id = -1;
+    BakedString type;
+    BakedString imagePath;
+    float probability = 1.0f;
+    BakedRange frames;      // Frames 段
+    BakedRange shapes;      // Shapes 段
+    BakedRange properties;  // Properties 段
+};
+
+struct BakedImageTile {
+    int32_t id = -1;
+    BakedString imagePath;
+    int32_t imageWidth  = 0;
+    int32_t imageHeight = 0;
+};
+
+struct BakedFrame {
+    int32_t tileId   = 0;
+    int32_t duration = 0;
+};
+
+struct BakedShape {
+    uint32_t type = 0;  // CollisionShapeType
+    BakedRange points;  // Points 段
+};
+
+struct BakedPoint {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct BakedLayer {
+    uint32_t type   = 0;             // LayerType
+    uint32_t parent = InvalidIndex;  // 所属组层在 Layers 段中的下标
+    int32_t id      = 0;
+    BakedString name;
+    BakedString tint;
+    uint32_t visible = 1;
+    float opacity    = 1.0f;
+    int32_t offsetX  = 0;
+    int32_t offsetY  = 0;
+    float parallaxX  = 1.0f;
+    float parallaxY  = 1.0f;
+    BakedRange properties;
+
+    // 瓦片层
+    int32_t width  = 0;
+    int32_t height = 0;
+    BakedRange gids;    // Gids 段
+    BakedRange chunks;  // Chunks 段
+
+    // 对象层
+    uint32_t drawOrder = 0;
+    BakedRange objects;  // Objects 段
+
+    // 图像层
+    BakedString imagePath;
+    int32_t imageWidth  = 0;
+    int32_t imageHeight = 0;
+};
+
+struct BakedChunk {
+    int32_t x      = 0;
+    int32_t y      = 0;
+    int32_t width  = 0;
+    int32_t height = 0;
+    BakedRange gids;  // Gids 段
+};
+
+struct BakedObject {
+    int32_t id = 0;
+    BakedString name;
+    BakedString type;
+    float x          = 0.0f;
+    float y          = 0.0f;
+    float width      = 0.0f;
+    float height     = 0.0f;
+    float rotation   = 0.0f;
+    uint32_t gid     = 0;
+    uint32_t visible = 1;
+    uint32_t objectType = 0;  // ObjectType
+    uint32_t text       = InvalidIndex;  // Texts 段下标
+    BakedRange points;
+    BakedRange properties;
+};
+
+struct BakedText {
+    BakedString text;
+    BakedString fontFamily;
+    BakedString color;
+    int32_t pixelSize = 16;
+    int32_t kerning   = 0;
+    uint32_t flags    = 0;  // TextFlag
+};
+
+enum TextFlag : uint32_t {
+    TextWrap      = 1u << 0,
+    TextBold      = 1u << 1,
+    TextItalic    = 1u << 2,
+    TextUnderline = 1u << 3,
+    TextStrikeout = 1u << 4,
+    TextHCenter   = 1u << 5,
+    TextVCenter   = 1u << 6
+};
+
+// 段元素大小, 供加载时校验使用
+constexpr uint32_t SectionElementSize(SectionId id) {
+    switch (id) {
+        case SectionId::Strings: return 1;
+        case SectionId::Properties: return sizeof(BakedProperty);
+        case SectionId::Tilesets: return sizeof(BakedTileset);
+        case SectionId::Tiles: return sizeof(BakedTile);
+        case SectionId::ImageTiles: return sizeof(BakedImageTile);
+        case SectionId::Frames: return sizeof(BakedFrame);
+        case SectionId::Shapes: return sizeof(BakedShape);
+        case SectionId::Points: return sizeof(BakedPoint);
+        case SectionId::Layers: return sizeof(BakedLayer);
+        case SectionId::Chunks: return sizeof(BakedChunk);
+        case SectionId::Objects: return sizeof(BakedObject);
+        case SectionId::Texts: return sizeof(BakedText);
+        case SectionId::Gids: return sizeof(uint32_t);
+        default: return 0;
+    }
+}
+
+static_assert(std::is_trivially_copyable_v<BakedHeader>, "BakedHeader 必须可直接映射");
+static_assert(std::is_trivially_copyable_v<BakedLayer>, "BakedLayer 必须可直接映射");
+static_assert(std::is_trivially_copyable_v<BakedTileset>, "BakedTileset 必须可直接映射");
+static_assert(sizeof(BakedHeader) % 4 == 0, "BakedHeader 必须 4 字节对齐");
+
+} // namespace BakedTilemapFormat
+
+} // namespace PrismaEngine
@@ -0,0 +1,387 @@
+#include "TilemapBaker.h"
+#include "BakedTilemapFormat.h"
+#include "TmxParser.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+
+namespace PrismaEngine {
+
+using namespace BakedTilemapFormat;
+
+std::string TilemapBaker::s_lastError;
+
+namespace {
+
+// ============================================================================
+// 烘焙上下文 - 按段收集数据, 最后统一布局
+// ============================================================================
+
+class BakeContext {
+public:
+    std::vector<char> strings;
+    std::vector<BakedProperty> properties;
+    std::vector<BakedTileset> tilesets;
+    std::vector<BakedTile> tiles;
+    std::vector<BakedImageTile> imageTiles;
+    std::vector<BakedFrame> frames;
+    std::vector<BakedShape> shapes;
+    std::vector<BakedPoint> points;
+    std::vector<BakedLayer> layers;
+    std::vector<BakedChunk> chunks;
+    std::vector<BakedObject> objects;
+    std::vector<BakedText> texts;
+    std::vector<uint32_t> gids;
+
+    BakedString AddString(std::string_view str) {
+        if (str.empty()) {
+            return {};
+        }
+        auto it = m_stringLookup.find(std::string(str));
+        if (it != m_stringLookup.end()) {
+            return it->second;
+        }
+        BakedString ref;
+        ref.offset = static_cast<uint32_t>(strings.size());
+        ref.length = static_cast<uint32_t>(str.size());
+        strings.insert(strings.end(), str.begin(), str.end());
+        m_stringLookup.emplace(std::string(str), ref);
+        return ref;
+    }
+
+    BakedRange AddProperties(const PropertyMap& props) {
+        BakedRange range{static_cast<uint32_t>(properties.size()), static_cast<uint32_t>(props.size())};
+        for (const auto& [name, prop] : props) {
+            BakedProperty baked;
+            baked.name  = AddString(prop.name.empty() ? name : prop.name);
+            baked.value = AddString(prop.value);
+            baked.type  = static_cast<uint32_t>(prop.type);
+            properties.push_back(baked);
+        }
+        return range;
+    }
+
+    BakedRange AddPoints(const std::vector<std::pair<float, float>>& src) {
+        BakedRange range{static_cast<uint32_t>(points.size()), static_cast<uint32_t>(src.size())};
+        for (const auto& [x, y] : src) {
+            points.push_back({x, y});
+        }
+        return range;
+    }
+
+    BakedRange AddGids(const uint32_t* src, size_t count) {
+        BakedRange range{static_cast<uint32_t>(gids.size()), static_cast<uint32_t>(count)};
+        gids.insert(gids.end(), src, src + count);
+        return range;
+    }
+
+    void AddTileset(const Tileset& tileset) {
+        BakedTileset baked;
+        baked.name            = AddString(tileset.name);
+        baked.imagePath       = AddString(tileset.imagePath);
+        baked.source          = AddString(tileset.source);
+        baked.firstGid        = tileset.firstGid;
+        baked.tileWidth       = tileset.tileWidth;
+        baked.tileHeight      = tileset.tileHeight;
+        baked.spacing         = tileset.spacing;
+        baked.margin          = tileset.margin;
+        baked.tileCount       = tileset.tileCount;
+        baked.columns         = tileset.columns;
+        baked.objectAlignment = tileset.objectAlignment;
+        baked.imageWidth      = tileset.imageWidth;
+        baked.imageHeight     = tileset.imageHeight;
+        baked.tileOffsetX     = tileset.tileOffset.x;
+        baked.tileOffsetY     = tileset.tileOffset.y;
+        baked.transparentR    = tileset.transparentColor.r;
+        baked.transparentG    = tileset.transparentColor.g;
+        baked.transparentB    = tileset.transparentColor.b;
+        baked.gridOrientation = static_cast<uint32_t>(tileset.grid.orientation);
+        baked.gridWidth       = tileset.grid.width;
+        baked.gridHeight      = tileset.grid.height;
+        baked.properties      = AddProperties(tileset.properties);
+
+        baked.imageTiles.first = static_cast<uint32_t>(imageTiles.size());
+        for (const auto& image : tileset.images) {
+            BakedImageTile bakedImage;
+            bakedImage.id          = image.id;
+            bakedImage.imagePath   = AddString(image.imagePath);
+            bakedImage.imageWidth  = image.imageWidth;
+            bakedImage.imageHeight = image.imageHeight;
+            imageTiles.push_back(bakedImage);
+        }
+        baked.imageTiles.count = static_cast<uint32_t>(imageTiles.size()) - baked.imageTiles.first;
+
+        // 特殊瓦片需要连续存放, 先收集再写入, 避免嵌套段交错
+        std::vector<BakedTile> tilesetTiles;
+        tilesetTiles.reserve(tileset.tiles.size());
+        for (const auto& [id, tile] : tileset.tiles) {
+            BakedTile bakedTile;
+            bakedTile.id          = tile.id >= 0 ? tile.id : id;
+            bakedTile.type        = AddString(tile.type);
+            bakedTile.imagePath   = AddString(tile.imagePath);
+            bakedTile.probability = tile.probability;
+            bakedTile.properties  = AddProperties(tile.properties);
+
+            const auto& animFrames = tile.animation.empty() ? tile.frames : tile.animation;
+            bakedTile.frames.first = static_cast<uint32_t>(frames.size());
+            bakedTile.frames.count = static_cast<uint32_t>(animFrames.size());
+            for (const auto& frame : animFrames) {
+                frames.push_back({frame.tileId, frame.duration});
+            }
+
+            bakedTile.shapes.first = static_cast<uint32_t>(shapes.size());
+            bakedTile.shapes.count = static_cast<uint32_t>(tile.collisionShapes.size());
+            for (const auto& shape : tile.collisionShapes) {
+                BakedShape bakedShape;
+                bakedShape.type   = static_cast<uint32_t>(shape.type);
+                bakedShape.points = AddPoints(shape.points);
+                shapes.push_back(bakedShape);
+            }
+
+            tilesetTiles.push_back(bakedTile);
+        }
+        baked.tiles.first = static_cast<uint32_t>(tiles.size());
+        baked.tiles.count = static_cast<uint32_t>(tilesetTiles.size());
+        tiles.insert(tiles.end(), tilesetTiles.begin(), tilesetTiles.end());
+
+        tilesets.push_back(baked);
+    }
+
+    uint32_t AddText(const TextObject& text) {
+        BakedText baked;
+        baked.text       = AddString(text.text);
+        baked.fontFamily = AddString(text.fontFamily);
+        baked.color      = AddString(text.color);
+        baked.pixelSize  = text.pixelSize;
+        baked.kerning    = text.kerning;
+        baked.flags      = (text.wrap ? TextWrap : 0u) | (text.bold ? TextBold : 0u) |
+                      (text.italic ? TextItalic : 0u) | (text.underline ? TextUnderline : 0u) |
+                      (text.strikeout ? TextStrikeout : 0u) | (text.hAlign ? TextHCenter : 0u) |
+                      (text.vAlign ? TextVCenter : 0u);
+        texts.push_back(baked);
+        return static_cast<uint32_t>(texts.size() - 1);
+    }
+
+    BakedObject MakeObject(const MapObject& obj) {
+        BakedObject baked;
+        baked.id         = obj.id;
+        baked.name       = AddString(obj.name);
+        baked.type       = AddString(obj.type);
+        baked.x          = obj.x;
+        baked.y          = obj.y;
+        baked.width      = obj.width;
+        baked.height     = obj.height;
+        baked.rotation   = obj.rotation;
+        baked.gid        = obj.gid;
+        baked.visible    = obj.visible ? 1u : 0u;
+        baked.objectType = static_cast<uint32_t>(obj.objectType);
+        baked.points     = AddPoints(obj.points);
+        baked.properties = AddProperties(obj.properties);
+        if (obj.text) {
+            baked.text = AddText(*obj.text);
+        }
+        return baked;
+    }
+
+    // 先序展开层树; 组层的子层紧随其后并通过 parent 指回组层
+    void AddLayers(const std::vector<std::unique_ptr<Layer>>& src, uint32_t parent) {
+        for (const auto& layer : src) {
+            if (!layer) continue;
+            AddLayer(*layer, parent);
+        }
+    }
+
+    void AddLayer(Layer& layer, uint32_t parent) {
+        BakedLayer baked;
+        baked.type   = static_cast<uint32_t>(layer.GetType());
+        baked.parent = parent;
+
+        // 解析器把层属性写在具体层数据上, 基类字段仅作回退
+        auto fillCommon = [&](const auto& data) {
+            baked.id         = data.id;
+            baked.name       = AddString(data.name);
+            baked.tint       = AddString(data.tint);
+            baked.visible    = data.visible ? 1u : 0u;
+            baked.opacity    = data.opacity;
+            baked.offsetX    = data.offsetX;
+            baked.offsetY    = data.offsetY;
+            baked.parallaxX  = data.parallaxX;
+            baked.parallaxY  = data.parallaxY;
+            baked.properties = AddProperties(data.properties);
+        };
+
+        if (TileLayer* tileLayer = layer.AsTileLayer()) {
+            fillCommon(*tileLayer);
+            const TileLayerData& tileData = tileLayer->tileData;
+            baked.width  = tileData.width;
+            baked.height = tileData.height;
+            baked.gids   = AddGids(tileData.Gids(), tileData.GidCount());
+
+            baked.chunks.first = static_cast<uint32_t>(chunks.size());
+            baked.chunks.count = static_cast<uint32_t>(tileData.chunks.size());
+            for (const auto& chunk : tileData.chunks) {
+                BakedChunk bakedChunk;
+                bakedChunk.x      = chunk.x;
+                bakedChunk.y      = chunk.y;
+                bakedChunk.width  = chunk.width;
+                bakedChunk.height = chunk.height;
+                bakedChunk.gids   = AddGids(chunk.Gids(), chunk.GidCount());
+                chunks.push_back(bakedChunk);
+            }
+            layers.push_back(baked);
+        } else if (ObjectLayer* objectLayer = layer.AsObjectLayer()) {
+            fillCommon(*objectLayer);
+            baked.drawOrder = static_cast<uint32_t>(objectLayer->drawOrder);
+
+            std::vector<BakedObject> layerObjects;
+            layerObjects.reserve(objectLayer->objects.size());
+            for (const auto& obj : objectLayer->objects) {
+                if (obj) {
+                    layerObjects.push_back(MakeObject(*obj));
+                }
+            }
+            baked.objects.first = static_cast<uint32_t>(objects.size());
+            baked.objects.count = static_cast<uint32_t>(layerObjects.size());
+            objects.insert(objects.end(), layerObjects.begin(), layerObjects.end());
+            layers.push_back(baked);
+        } else if (ImageLayer* imageLayer = layer.AsImageLayer()) {
+            fillCommon(*imageLayer);
+            baked.imagePath   = AddString(imageLayer->imagePath);
+            baked.imageWidth  = imageLayer->imageWidth;
+            baked.imageHeight = imageLayer->imageHeight;
+            layers.push_back(baked);
+        } else if (GroupLayer* groupLayer = layer.AsGroupLayer()) {
+            fillCommon(*groupLayer);
+            layers.push_back(baked);
+            AddLayers(groupLayer->layers, static_cast<uint32_t>(layers.size() - 1));
+        }
+    }
+
+private:
+    std::unordered_map<std::string, BakedString> m_stringLookup;
+};
+
+uint32_t AlignUp(size_t value) {
+    return static_cast<uint32_t>((value + SectionAlign - 1) & ~static_cast<size_t>(SectionAlign - 1));
+}
+
+template <typename T>
+void WriteSection(std::vector<uint8_t>& out, BakedHeader& header, SectionId id, const std::vector<T>& items) {
+    out.resize(AlignUp(out.size()), 0);
+    auto& section  = header.sections[static_cast<uint32_t>(id)];
+    section.offset = static_cast<uint32_t>(out.size());
+    section.count  = static_cast<uint32_t>(items.size());
+    if (!items.empty()) {
+        size_t bytes = items.size() * sizeof(T);
+        size_t start = out.size();
+        out.resize(start + bytes);
+        std::memcpy(out.data() + start, items.data(), bytes);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// 烘焙
+// ============================================================================
+
+bool TilemapBaker::Bake(const TileMap& map, std::vector<uint8_t>& outData) {
+    BakeContext ctx;
+
+    BakedHeader header;
+    header.mapVersion      = ctx.AddString(map.version);
+    header.name            = ctx.AddString(map.name);
+    header.backgroundColor = ctx.AddString(map.backgroundColor);
+    header.width           = map.width;
+    header.height          = map.height;
+    header.tileWidth       = map.tileWidth;
+    header.tileHeight      = map.tileHeight;
+    header.hexSideLength   = map.hexSideLength;
+    header.orientation     = static_cast<uint8_t>(map.orientation);
+    header.renderOrder     = static_cast<uint8_t>(map.renderOrder);
+    header.staggerAxis     = static_cast<uint8_t>(map.staggerAxis);
+    header.staggerIndex    = static_cast<uint8_t>(map.staggerIndex);
+    header.infinite        = map.infinite ? 1u : 0u;
+    header.properties      = ctx.AddProperties(map.properties);
+
+    for (const auto& tileset : map.tilesets) {
+        if (tileset) {
+            ctx.AddTileset(*tileset);
+        }
+    }
+
+    ctx.AddLayers(map.layers, InvalidIndex);
+
+    outData.clear();
+    outData.resize(sizeof(BakedHeader), 0);
+
+    // GID 数组放在最前, 保证大块数据起始处对齐
+    WriteSection(outData, header, SectionId::Gids, ctx.gids);
+    WriteSection(outData, header, SectionId::Layers, ctx.layers);
+    WriteSection(outData, header, SectionId::Chunks, ctx.chunks);
+    WriteSection(outData, header, SectionId::Tilesets, ctx.tilesets);
+    WriteSection(outData, header, SectionId::Tiles, ctx.tiles);
+    WriteSection(outData, header, SectionId::ImageTiles, ctx.imageTiles);
+    WriteSection(outData, header, SectionId::Frames, ctx.frames);
+    WriteSection(outData, header, SectionId::Shapes, ctx.shapes);
+    WriteSection(outData, header, SectionId::Points, ctx.points);
+    WriteSection(outData, header, SectionId::Objects, ctx.objects);
+    WriteSection(outData, header, SectionId::Texts, ctx.texts);
+    WriteSection(outData, header, SectionId::Properties, ctx.properties);
+    WriteSection(outData, header, SectionId::Strings, ctx.strings);
+
+    if (outData.size() > std::numeric_limits<uint32_t>::max()) {
+        s_lastError = "Baked tilemap exceeds 4 GiB";
+        outData.clear();
+        return false;
+    }
+
+    header.fileSize = static_cast<uint32_t>(outData.size());
+    std::memcpy(outData.data(), &header, sizeof(BakedHeader));
+    return true;
+}
+
+bool TilemapBaker::BakeToFile(const TileMap& map, const std::filesystem::path& outPath) {
+    std::vector<uint8_t> data;
+    if (!Bake(map, data)) {
+        return false;
+    }
+
+    // 先写临时文件再替换, 避免运行时映射到写了一半的文件
+    std::filesystem::path tempPath = outPath;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            s_lastError = "Failed to open output file: " + tempPath.string();
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            s_lastError = "Failed to write output file: " + tempPath.string();
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, outPath, ec);
+    if (ec) {
+        s_lastError = "Failed to replace output file: " + outPath.string();
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool TilemapBaker::BakeTmxFile(const std::filesystem::path& tmxPath, const std::filesystem::path& outPath) {
+    auto map = TmxParser::ParseFile(tmxPath);
+    if (!map) {
+        s_lastError = TmxParser::GetLastError();
+        return false;
+    }
+    return BakeToFile(*map, outPath);
+}
+
+} // namespace PrismaEngine
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../core/Map.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace PrismaEngine {
+
+// ============================================================================
+// 瓦片地图烘焙器 - 将 TileMap 转换为可内存映射的二进制格式 (.tmb)
+// ============================================================================
+
+class TilemapBaker {
+public:
+    // 将地图烘焙到内存
+    static bool Bake(const TileMap& map, std::vector<uint8_t>& outData);
+
+    // 将地图烘焙到文件
+    static bool BakeToFile(const TileMap& map, const std::filesystem::path& outPath);
+
+    // 解析 TMX 并烘焙 (离线构建步骤)
+    static bool BakeTmxFile(const std::filesystem::path& tmxPath, const std::filesystem::path& outPath);
+
+    // 获取最后错误信息
+    static const std::string& GetLastError() { return s_lastError; }
+
+private:
+    static std::string s_lastError;
+};
+
+} // namespace PrismaEngine
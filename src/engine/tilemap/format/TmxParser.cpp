@@ -1,9 +1,12 @@
 #include "TmxParser.h"
 #include "TileDataDecoder.h"
+#include "TsxParser.h"
+#include "../../JobSystem.h"
 #include <tinyxml2.h>
 #include <filesystem>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
 
 namespace PrismaEngine {
 
@@ -346,83 +349,127 @@ std::unique_ptr<MapObject> TmxParser::ParseObject(void* objectElement) {
 // 瓦片层数据解析
 // ============================================================================
 
+bool TmxParser::ParseEncoding(const char* encoding, const char* compression, TileDataEncoding& outEncoding) {
+    if (!encoding || strcmp(encoding, "csv") == 0) {
+        outEncoding = TileDataEncoding::CSV;
+        return true;
+    }
+
+    if (strcmp(encoding, "base64") != 0) {
+        s_lastError = "Unknown encoding format: " + std::string(encoding);
+        return false;
+    }
+
+    if (!compression || compression[0] == '\0') {
+        outEncoding = TileDataEncoding::Base64;
+    } else if (strcmp(compression, "zlib") == 0) {
+        outEncoding = TileDataEncoding::Base64_Zlib;
+    } else if (strcmp(compression, "zstd") == 0) {
+        outEncoding = TileDataEncoding::Base64_Zstd;
+    } else if (strcmp(compression, "gzip") == 0) {
+        outEncoding = TileDataEncoding::Base64_Gzip;
+    } else {
+        s_lastError = "Unknown compression format: " + std::string(compression);
+        return false;
+    }
+    return true;
+}
+
 bool TmxParser::ParseTileData(
     void* dataElement,
     TileLayerData& outData,
     int width,
-    int height
+    int height,
+    ParseContext& context
 ) {
     tinyxml2::XMLElement* dataElem = static_cast<tinyxml2::XMLElement*>(dataElement);
 
     if (!dataElem) return false;
 
+    outData.width = width;
+    outData.height = height;
+
     // 检查编码方式
     const char* encoding = dataElem->Attribute("encoding");
     const char* compression = dataElem->Attribute("compression");
 
+    if (!encoding && dataElem->FirstChildElement("tile")) {
+        // XML 格式 - 每个瓦片是一个元素, 需要遍历 DOM, 直接在当前线程解析
+        std::vector<uint32_t> gids;
+        for (tinyxml2::XMLElement* tileElem = dataElem->FirstChildElement("tile");
+             tileElem != nullptr;
+             tileElem = tileElem->NextSiblingElement("tile")) {
+            uint32_t gid = static_cast<uint32_t>(tileElem->IntAttribute("gid", 0));
+            gids.push_back(gid);
+        }
+        outData.data = std::move(gids);
+        return true;
+    }
+
     TileDataEncoding dataEncoding = TileDataEncoding::CSV;
+    if (!ParseEncoding(encoding, compression, dataEncoding)) {
+        return false;
+    }
 
-    if (!encoding) {
-        // 默认 CSV (无 encoding 属性时，可能是 XML 格式的瓦片)
-        // 检查是否有 tile 子元素
-        if (dataElem->FirstChildElement("tile")) {
-            // XML 格式 - 每个瓦片是一个元素
-            std::vector<uint32_t> gids;
-            for (tinyxml2::XMLElement* tileElem = dataElem->FirstChildElement("tile");
-                 tileElem != nullptr;
-                 tileElem = tileElem->NextSiblingElement("tile")) {
-                uint32_t gid = static_cast<uint32_t>(tileElem->IntAttribute("gid", 0));
-                gids.push_back(gid);
-            }
-            outData.data = gids;
-            outData.width = width;
-            outData.height = height;
-            return true;
+    // 解析块数据 (无限地图)
+    for (tinyxml2::XMLElement* chunkElem = dataElem->FirstChildElement("chunk");
+         chunkElem != nullptr;
+         chunkElem = chunkElem->NextSiblingElement("chunk")) {
+
+        TileLayerData::Chunk chunk;
+        chunk.x = chunkElem->IntAttribute("x", 0);
+        chunk.y = chunkElem->IntAttribute("y", 0);
+        chunk.width = chunkElem->IntAttribute("width", 0);
+        chunk.height = chunkElem->IntAttribute("height", 0);
+
+        // GetText 会原地规范化 DOM 文本, 必须在收集阶段完成
+        if (const char* text = chunkElem->GetText()) {
+            ParseContext::TileDataJob job;
+            job.text = text;
+            job.encoding = dataEncoding;
+            job.expectedSize = chunk.width * chunk.height;
+            job.target = &outData;
+            job.chunkIndex = outData.chunks.size();
+            context.tileDataJobs.push_back(job);
         }
-    } else if (strcmp(encoding, "csv") == 0) {
-        dataEncoding = TileDataEncoding::CSV;
-    } else if (strcmp(encoding, "base64") == 0) {
-        if (!compression) {
-            dataEncoding = TileDataEncoding::Base64;
-        } else if (strcmp(compression, "zlib") == 0) {
-            dataEncoding = TileDataEncoding::Base64_Zlib;
-        } else if (strcmp(compression, "zstd") == 0) {
-            dataEncoding = TileDataEncoding::Base64_Zstd;
-        } else if (strcmp(compression, "gzip") == 0) {
-            dataEncoding = TileDataEncoding::Base64_Gzip;
-        } else {
-            s_lastError = "Unknown compression format: " + std::string(compression);
-            return false;
-        }
-    } else {
-        s_lastError = "Unknown encoding format: " + std::string(encoding);
-        return false;
+
+        outData.chunks.push_back(std::move(chunk));
     }
 
     // 获取数据内容
-    const char* text = dataElem->GetText();
-    if (!text) {
-        outData.width = width;
-        outData.height = height;
+    if (outData.chunks.empty()) {
         outData.data.clear();
-        return true;
-    }
 
-    // 解码数据
-    outData.data = TileDataDecoder::Decode(text, dataEncoding, width * height);
-    outData.width = width;
-    outData.height = height;
+        if (const char* text = dataElem->GetText()) {
+            ParseContext::TileDataJob job;
+            job.text = text;
+            job.encoding = dataEncoding;
+            job.expectedSize = width * height;
+            job.target = &outData;
+            context.tileDataJobs.push_back(job);
+        }
+    }
 
     return true;
 }
 
+void TmxParser::DecodeTileData(ParseContext::TileDataJob& job) {
+    std::vector<uint32_t> gids = TileDataDecoder::Decode(job.text, job.encoding, job.expectedSize);
+
+    if (job.chunkIndex == ParseContext::TileDataJob::LayerData) {
+        job.target->data = std::move(gids);
+    } else {
+        job.target->chunks[job.chunkIndex].data = std::move(gids);
+    }
+}
+
 // ============================================================================
 // 图块集解析
 // ============================================================================
 
 std::unique_ptr<Tileset> TmxParser::ParseTileset(
     void* tilesetElement,
-    const std::filesystem::path& basePath
+    ParseContext& context
 ) {
     tinyxml2::XMLElement* tsElem = static_cast<tinyxml2::XMLElement*>(tilesetElement);
 
@@ -438,8 +485,11 @@ std::unique_ptr<Tileset> TmxParser::ParseTileset(
         // 外部 TSX 文件
         tileset->source = source;
 
-        // TODO: 加载外部 TSX 文件
-        // 目前跳过，需要在完整实现中处理
+        // 外部 TSX 文件在解码阶段并行加载
+        ParseContext::TilesetJob job;
+        job.target = tileset.get();
+        job.path = context.basePath / source;
+        context.tilesetJobs.push_back(std::move(job));
         return tileset;
     }
 
@@ -581,8 +631,7 @@ std::unique_ptr<Tileset> TmxParser::ParseTileset(
 
 std::unique_ptr<Layer> TmxParser::ParseLayer(
     void* layerElement,
-    const std::filesystem::path& basePath,
-    TileMap& map
+    ParseContext& context
 ) {
     tinyxml2::XMLElement* layerElem = static_cast<tinyxml2::XMLElement*>(layerElement);
 
@@ -621,45 +670,10 @@ std::unique_ptr<Layer> TmxParser::ParseLayer(
             int width = layerElem->IntAttribute("width", 0);
             int height = layerElem->IntAttribute("height", 0);
 
+            // 收集瓦片数据 (解码在所有层收集完成后并行进行)
             tinyxml2::XMLElement* dataElem = layerElem->FirstChildElement("data");
             if (dataElem) {
-                ParseTileData(dataElem, tileLayer->tileData, width, height);
-            }
-
-            // 解析块数据 (无限地图)
-            for (tinyxml2::XMLElement* chunkElem = dataElem ? dataElem->FirstChildElement("chunk") : nullptr;
-                 chunkElem != nullptr;
-                 chunkElem = chunkElem->NextSiblingElement("chunk")) {
-
-                TileLayerData::Chunk chunk;
-                chunk.x = chunkElem->IntAttribute("x", 0);
-                chunk.y = chunkElem->IntAttribute("y", 0);
-                chunk.width = chunkElem->IntAttribute("width", 0);
-                chunk.height = chunkElem->IntAttribute("height", 0);
-
-                // 解析块数据
-                const char* encoding = chunkElem->Attribute("encoding");
-                const char* compression = chunkElem->Attribute("compression");
-
-                TileDataEncoding dataEncoding = TileDataEncoding::CSV;
-                if (encoding && strcmp(encoding, "base64") == 0) {
-                    if (!compression || strcmp(compression, "zlib") == 0) {
-                        dataEncoding = TileDataEncoding::Base64_Zlib;
-                    } else if (strcmp(compression, "zstd") == 0) {
-                        dataEncoding = TileDataEncoding::Base64_Zstd;
-                    } else if (strcmp(compression, "gzip") == 0) {
-                        dataEncoding = TileDataEncoding::Base64_Gzip;
-                    } else {
-                        dataEncoding = TileDataEncoding::Base64;
-                    }
-                }
-
-                const char* text = chunkElem->GetText();
-                if (text) {
-                    chunk.data = TileDataDecoder::Decode(text, dataEncoding, chunk.width * chunk.height);
-                }
-
-                tileLayer->tileData.chunks.push_back(chunk);
+                ParseTileData(dataElem, tileLayer->tileData, width, height, context);
             }
 
             // 属性
@@ -764,7 +778,7 @@ std::unique_ptr<Layer> TmxParser::ParseLayer(
                 std::string elemName = subLayerElem->Name();
                 if (elemName == "properties") continue;
 
-                auto subLayer = ParseLayer(subLayerElem, basePath, map);
+                auto subLayer = ParseLayer(subLayerElem, context);
                 if (subLayer) {
                     groupLayer->layers.push_back(std::move(subLayer));
                 }
@@ -836,39 +850,77 @@ bool TmxParser::ParseMapAttributes(void* mapElement, TileMap& outMap) {
 }
 
 // ============================================================================
-// 主解析方法
+// 并行解码
 // ============================================================================
 
-std::unique_ptr<TileMap> TmxParser::ParseFile(const std::filesystem::path& filePath) {
-    tinyxml2::XMLDocument doc;
-    tinyxml2::XMLError result = doc.LoadFile(filePath.string().c_str());
+void TmxParser::DecodeParallel(ParseContext& context) {
+    const size_t tilesetCount = context.tilesetJobs.size();
+    const size_t totalCount = tilesetCount + context.tileDataJobs.size();
+    if (totalCount == 0) return;
+
+    // 外部图块集涉及文件 I/O, 优先调度; 瓦片数据按文本长度降序, 使大层尽早开始
+    std::vector<size_t> tileDataOrder(context.tileDataJobs.size());
+    for (size_t i = 0; i < tileDataOrder.size(); ++i) {
+        tileDataOrder[i] = i;
+        context.tileDataJobs[i].textLength = strlen(context.tileDataJobs[i].text);
+    }
+    std::stable_sort(tileDataOrder.begin(), tileDataOrder.end(), [&context](size_t a, size_t b) {
+        return context.tileDataJobs[a].textLength > context.tileDataJobs[b].textLength;
+    });
+
+    // 每个作业只写入各自的目标, 结果与执行顺序无关
+    JobSystem::GetInstance().ParallelFor(totalCount, [&](size_t index) {
+        if (index < tilesetCount) {
+            auto& job = context.tilesetJobs[index];
+            job.result = TsxParser::ParseFile(job.path);
+            if (!job.result) {
+                job.error = TsxParser::GetLastError();
+            }
+        } else {
+            DecodeTileData(context.tileDataJobs[tileDataOrder[index - tilesetCount]]);
+        }
+    });
 
-    if (result != tinyxml2::XML_SUCCESS) {
-        s_lastError = "Failed to load TMX file: " + filePath.string();
-        return nullptr;
+    // 按文档顺序合并外部图块集
+    for (auto& job : context.tilesetJobs) {
+        if (!job.result) {
+            if (s_lastError.empty()) {
+                s_lastError = job.error;
+            }
+            continue;
+        }
+
+        int firstGid = job.target->firstGid;
+        std::string source = std::move(job.target->source);
+        *job.target = std::move(*job.result);
+        job.target->firstGid = firstGid;
+        job.target->source = std::move(source);
     }
+}
 
-    std::filesystem::path basePath = filePath.parent_path();
+// ============================================================================
+// 主解析方法
+// ============================================================================
 
-    tinyxml2::XMLElement* mapElem = doc.FirstChildElement("map");
-    if (!mapElem) {
-        s_lastError = "No map element found in TMX file";
-        return nullptr;
-    }
+std::unique_ptr<TileMap> TmxParser::ParseDocument(void* mapElement, const std::filesystem::path& basePath) {
+    tinyxml2::XMLElement* mapElem = static_cast<tinyxml2::XMLElement*>(mapElement);
 
     auto map = std::make_unique<TileMap>();
-    map->name = filePath.stem().string();
 
     if (!ParseMapAttributes(mapElem, *map)) {
         return nullptr;
     }
 
+    // 第一阶段: 遍历 XML, 构建地图结构并收集解码作业
+    ParseContext context;
+    context.basePath = basePath;
+
     // 解析图块集
     for (tinyxml2::XMLElement* tsElem = mapElem->FirstChildElement("tileset");
          tsElem != nullptr;
          tsElem = tsElem->NextSiblingElement("tileset")) {
 
-        auto tileset = ParseTileset(tsElem, basePath);
+        auto tileset = ParseTileset(tsElem, context);
         if (tileset) {
             map->tilesets.push_back(std::move(tileset));
         }
@@ -882,12 +934,39 @@ std::unique_ptr<TileMap> TmxParser::ParseFile(const std::filesystem::path& fileP
         std::string elemName = layerElem->Name();
         if (elemName == "properties" || elemName == "tileset") continue;
 
-        auto layer = ParseLayer(layerElem, basePath, *map);
+        auto layer = ParseLayer(layerElem, context);
         if (layer) {
             map->layers.push_back(std::move(layer));
         }
     }
 
+    // 第二阶段: 在线程池上并行解码瓦片数据和外部图块集
+    DecodeParallel(context);
+
+    return map;
+}
+
+std::unique_ptr<TileMap> TmxParser::ParseFile(const std::filesystem::path& filePath) {
+    s_lastError.clear();
+
+    tinyxml2::XMLDocument doc;
+    tinyxml2::XMLError result = doc.LoadFile(filePath.string().c_str());
+
+    if (result != tinyxml2::XML_SUCCESS) {
+        s_lastError = "Failed to load TMX file: " + filePath.string();
+        return nullptr;
+    }
+
+    tinyxml2::XMLElement* mapElem = doc.FirstChildElement("map");
+    if (!mapElem) {
+        s_lastError = "No map element found in TMX file";
+        return nullptr;
+    }
+
+    auto map = ParseDocument(mapElem, filePath.parent_path());
+    if (map) {
+        map->name = filePath.stem().string();
+    }
     return map;
 }
 
@@ -899,6 +978,8 @@ std::unique_ptr<TileMap> TmxParser::ParseString(
     const std::string& tmxContent,
     const std::filesystem::path& basePath
 ) {
+    s_lastError.clear();
+
     tinyxml2::XMLDocument doc;
     tinyxml2::XMLError result = doc.Parse(tmxContent.c_str());
 
@@ -913,38 +994,7 @@ std::unique_ptr<TileMap> TmxParser::ParseString(
         return nullptr;
     }
 
-    auto map = std::make_unique<TileMap>();
-
-    if (!ParseMapAttributes(mapElem, *map)) {
-        return nullptr;
-    }
-
-    // 解析图块集
-    for (tinyxml2::XMLElement* tsElem = mapElem->FirstChildElement("tileset");
-         tsElem != nullptr;
-         tsElem = tsElem->NextSiblingElement("tileset")) {
-
-        auto tileset = ParseTileset(tsElem, basePath);
-        if (tileset) {
-            map->tilesets.push_back(std::move(tileset));
-        }
-    }
-
-    // 解析层
-    for (tinyxml2::XMLElement* layerElem = mapElem->FirstChildElement();
-         layerElem != nullptr;
-         layerElem = layerElem->NextSiblingElement()) {
-
-        std::string elemName = layerElem->Name();
-        if (elemName == "properties" || elemName == "tileset") continue;
-
-        auto layer = ParseLayer(layerElem, basePath, *map);
-        if (layer) {
-            map->layers.push_back(std::move(layer));
-        }
-    }
-
-    return map;
+    return ParseDocument(mapElem, basePath);
 }
 
 } // namespace PrismaEngine
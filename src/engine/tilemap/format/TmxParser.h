@@ -4,6 +4,7 @@
 #include <string>
 #include <memory>
 #include <filesystem>
+#include <vector>
 
 namespace PrismaEngine {
 
@@ -31,30 +32,69 @@ public:
 private:
     static std::string s_lastError;
 
+    // 解析上下文: 第一阶段遍历 XML 时收集的解码作业, 第二阶段在线程池上并行执行
+    struct ParseContext {
+        // 瓦片数据解码作业 (层数据或无限地图块)
+        struct TileDataJob {
+            static constexpr size_t LayerData = static_cast<size_t>(-1);
+
+            const char* text = nullptr;       // 指向 XML 文档内的文本, 文档在解码期间保持有效
+            size_t textLength = 0;
+            TileDataEncoding encoding = TileDataEncoding::CSV;
+            int expectedSize = -1;
+            TileLayerData* target = nullptr;
+            size_t chunkIndex = LayerData;    // LayerData 表示写入 target->data
+        };
+
+        // 外部图块集 (TSX) 加载作业
+        struct TilesetJob {
+            Tileset* target = nullptr;
+            std::filesystem::path path;
+            std::unique_ptr<Tileset> result;
+            std::string error;
+        };
+
+        std::filesystem::path basePath;
+        std::vector<TileDataJob> tileDataJobs;
+        std::vector<TilesetJob> tilesetJobs;
+    };
+
+    // 解析 <map> 元素
+    static std::unique_ptr<TileMap> ParseDocument(void* mapElement, const std::filesystem::path& basePath);
+
+    // 并行执行收集到的解码作业, 并按文档顺序合并结果
+    static void DecodeParallel(ParseContext& context);
+
     // 解析地图属性
     static bool ParseMapAttributes(void* mapElement, TileMap& outMap);
 
-    // 解析图块集
+    // 解析图块集 (外部 TSX 仅登记作业)
     static std::unique_ptr<Tileset> ParseTileset(
         void* tilesetElement,
-        const std::filesystem::path& basePath
+        ParseContext& context
     );
 
     // 解析层
     static std::unique_ptr<Layer> ParseLayer(
         void* layerElement,
-        const std::filesystem::path& basePath,
-        TileMap& map
+        ParseContext& context
     );
 
-    // 解析瓦片层数据
+    // 解析瓦片层数据 (编码数据仅登记作业, 不在此处解码)
     static bool ParseTileData(
         void* dataElement,
         TileLayerData& outData,
         int width,
-        int height
+        int height,
+        ParseContext& context
     );
 
+    // 解码单个瓦片数据作业
+    static void DecodeTileData(ParseContext::TileDataJob& job);
+
+    // 解析编码/压缩属性
+    static bool ParseEncoding(const char* encoding, const char* compression, TileDataEncoding& outEncoding);
+
     // 解析对象
     static std::unique_ptr<MapObject> ParseObject(void* objectElement);
 
@@ -4,7 +4,7 @@
 
 namespace PrismaEngine {
 
-std::string TsxParser::s_lastError;
+thread_local std::string TsxParser::s_lastError;
 
 // ============================================================================
 // 属性解析
@@ -19,11 +19,11 @@ public:
     // 解析 TSX 内容字符串
     static std::unique_ptr<Tileset> ParseString(const std::string& tsxContent);
 
-    // 获取最后错误信息
+    // 获取当前线程的最后错误信息 (TMX 解析时会在作业线程上并行加载)
     static const std::string& GetLastError() { return s_lastError; }
 
 private:
-    static std::string s_lastError;
+    static thread_local std::string s_lastError;
 
     // 解析碰撞形状
     static std::vector<CollisionShape> ParseCollisionShapes(void* tileElement);
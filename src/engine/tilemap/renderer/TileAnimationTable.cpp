@@ -0,0 +1,122 @@
+#include "TileAnimationTable.h"
+#include "../../graphic/interfaces/IRenderDevice.h"
+#include "../../graphic/interfaces/IResourceFactory.h"
+#include "../../graphic/interfaces/ITexture.h"
+#include <algorithm>
+#include <numeric>
+
+namespace PrismaEngine {
+
+void TileAnimationTable::Clear() {
+    m_lookup.clear();
+    m_texels.clear();
+    m_animationCount = 0;
+    m_loopPeriod = 1;
+}
+
+void TileAnimationTable::Build(const TileMap& map) {
+    Clear();
+
+    struct Entry {
+        const Tileset* tileset;
+        int localId;
+        const std::vector<Frame>* frames;
+    };
+
+    // 按图块集顺序和瓦片 ID 排序, 保证表布局稳定
+    std::vector<Entry> entries;
+    for (const auto& tileset : map.tilesets) {
+        if (!tileset) continue;
+
+        size_t first = entries.size();
+        for (const auto& [id, tile] : tileset->tiles) {
+            const auto& frames = tile.animation.empty() ? tile.frames : tile.animation;
+            if (frames.empty() || tile.GetAnimationDuration() <= 0) continue;
+            entries.push_back({tileset.get(), id, &frames});
+        }
+        std::sort(entries.begin() + static_cast<std::ptrdiff_t>(first), entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.localId < b.localId; });
+    }
+
+    if (entries.empty()) return;
+
+    m_animationCount = static_cast<uint32_t>(entries.size());
+
+    size_t frameCount = 0;
+    for (const auto& entry : entries) {
+        frameCount += entry.frames->size();
+    }
+
+    size_t texelCount = entries.size() + frameCount;
+    size_t rows = (texelCount + TableWidth - 1) / TableWidth;
+    m_texels.assign(rows * TableWidth * 4, 0.0f);
+
+    uint64_t loopPeriod = 1;
+    uint32_t frameTexel = m_animationCount;
+
+    for (uint32_t animIndex = 0; animIndex < m_animationCount; ++animIndex) {
+        const Entry& entry = entries[animIndex];
+        const Tileset& tileset = *entry.tileset;
+
+        float baseU0, baseV0, baseU1, baseV1;
+        tileset.GetTileUV(entry.localId, baseU0, baseV0, baseU1, baseV1);
+
+        uint32_t endTime = 0;
+        for (size_t i = 0; i < entry.frames->size(); ++i) {
+            const Frame& frame = (*entry.frames)[i];
+            endTime += static_cast<uint32_t>(std::max(frame.duration, 0));
+
+            float u0, v0, u1, v1;
+            tileset.GetTileUV(frame.tileId, u0, v0, u1, v1);
+
+            float* texel = &m_texels[(static_cast<size_t>(frameTexel) + i) * 4];
+            texel[0] = u0 - baseU0;
+            texel[1] = v0 - baseV0;
+            texel[2] = static_cast<float>(endTime);
+        }
+
+        float* header = &m_texels[static_cast<size_t>(animIndex) * 4];
+        header[0] = static_cast<float>(frameTexel);
+        header[1] = static_cast<float>(entry.frames->size());
+        header[2] = static_cast<float>(endTime);
+
+        m_lookup[entry.tileset][entry.localId] = animIndex;
+        frameTexel += static_cast<uint32_t>(entry.frames->size());
+
+        // 公共周期超出精度范围时退化为固定上限
+        if (loopPeriod <= MaxLoopPeriod) {
+            loopPeriod = std::lcm(loopPeriod, static_cast<uint64_t>(endTime));
+        }
+    }
+
+    m_loopPeriod = loopPeriod <= MaxLoopPeriod ? static_cast<uint32_t>(loopPeriod) : MaxLoopPeriod;
+}
+
+uint32_t TileAnimationTable::Find(const Tileset* tileset, int localId) const {
+    auto tilesetIt = m_lookup.find(tileset);
+    if (tilesetIt == m_lookup.end()) {
+        return NotAnimated;
+    }
+
+    auto it = tilesetIt->second.find(localId);
+    return it != tilesetIt->second.end() ? it->second : NotAnimated;
+}
+
+std::shared_ptr<Graphic::ITexture> TileAnimationTable::CreateTexture(Graphic::IRenderDevice* device) const {
+    if (!device || !device->GetResourceFactory() || m_texels.empty()) {
+        return nullptr;
+    }
+
+    Graphic::TextureDesc desc;
+    desc.name = "TileAnimationTable";
+    desc.type = Graphic::TextureType::Texture2D;
+    desc.format = Graphic::TextureFormat::RGBA32_Float;
+    desc.width = GetWidth();
+    desc.height = GetHeight();
+    desc.initialData = m_texels.data();
+    desc.dataSize = m_texels.size() * sizeof(float);
+
+    return std::shared_ptr<Graphic::ITexture>(device->GetResourceFactory()->CreateTextureImpl(desc));
+}
+
+} // namespace PrismaEngine
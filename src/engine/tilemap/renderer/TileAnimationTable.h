@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../core/Map.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace PrismaEngine {
+
+namespace Graphic {
+class IRenderDevice;
+class ITexture;
+}
+
+// ============================================================================
+// 瓦片动画查找表 - 供着色器根据全局时间选择动画帧
+//
+// 表以 RGBA32F 纹理存储, 每行 TableWidth 个纹素:
+//   [0, 动画数)      头纹素: (首帧纹素下标, 帧数, 总时长(毫秒), 0)
+//   [动画数, ...)    帧纹素: (U 偏移, V 偏移, 帧结束时间(毫秒), 0)
+// U/V 偏移相对于动画瓦片自身的 UV 原点, 因此翻转后的 UV 同样适用。
+// 顶点的 animIndex 为头纹素下标, 非动画瓦片为 -1。
+// ============================================================================
+
+class TileAnimationTable {
+public:
+    static constexpr uint32_t TableWidth = 256;
+    static constexpr uint32_t NotAnimated = 0xFFFFFFFF;
+
+    // 时间循环周期上限 (毫秒), float 在此范围内保持毫秒精度
+    static constexpr uint32_t MaxLoopPeriod = 1u << 24;
+
+    // 从地图的图块集构建查找表
+    void Build(const TileMap& map);
+
+    // 清空
+    void Clear();
+
+    // 查找动画索引, 非动画瓦片返回 NotAnimated
+    uint32_t Find(const Tileset* tileset, int localId) const;
+
+    bool IsEmpty() const { return m_animationCount == 0; }
+    uint32_t GetAnimationCount() const { return m_animationCount; }
+
+    // 纹理数据 (RGBA32F, 行优先)
+    const std::vector<float>& GetTexels() const { return m_texels; }
+    uint32_t GetWidth() const { return TableWidth; }
+    uint32_t GetHeight() const { return static_cast<uint32_t>(m_texels.size() / 4 / TableWidth); }
+
+    // 所有动画共同的循环周期 (毫秒); 时间在此周期内回绕不会产生跳帧
+    uint32_t GetLoopPeriod() const { return m_loopPeriod; }
+
+    // 创建 GPU 查找纹理
+    std::shared_ptr<Graphic::ITexture> CreateTexture(Graphic::IRenderDevice* device) const;
+
+private:
+    std::unordered_map<const Tileset*, std::unordered_map<int, uint32_t>> m_lookup;
+    std::vector<float> m_texels;
+    uint32_t m_animationCount = 0;
+    uint32_t m_loopPeriod = 1;
+};
+
+} // namespace PrismaEngine
@@ -0,0 +1,507 @@
+#include "TileChunk.h"
+#include "../../JobSystem.h"
+#include "../../graphic/interfaces/IBuffer.h"
+#include "../../graphic/interfaces/IRenderDevice.h"
+#include "../../graphic/interfaces/IResourceFactory.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PrismaEngine {
+
+namespace {
+
+// 缓冲区扩容时预留的槽位, 避免编辑时频繁重建 GPU 缓冲区
+uint32_t GrowQuadCapacity(uint32_t required) {
+    return std::max<uint32_t>(64, required + required / 4);
+}
+
+} // namespace
+
+// ============================================================================
+// 构造/析构
+// ============================================================================
+
+TileChunk::~TileChunk() {
+    // 后台任务持有自身状态的引用, 但等待完成可以避免在关闭时遗留工作
+    if (m_pendingFuture.valid()) {
+        m_pendingFuture.wait();
+    }
+}
+
+void TileChunk::Initialize(
+    int chunkX, int chunkY,
+    int chunkSize,
+    int tileWidth, int tileHeight
+) {
+    m_chunkX = chunkX;
+    m_chunkY = chunkY;
+    m_chunkSize = chunkSize;
+    m_tileWidth = tileWidth;
+    m_tileHeight = tileHeight;
+    m_geometry = Geometry();
+    m_dirty = true;
+}
+
+// ============================================================================
+// 四边形构建
+// ============================================================================
+
+bool TileChunk::BuildTileQuad(
+    const TileChunkBuildContext& context,
+    size_t layerIndex,
+    uint32_t gid,
+    int tileX, int tileY,
+    TileVertex outQuad[4]
+) {
+    uint32_t pureGid = GIDHelper::GetPureGid(gid);
+    if (pureGid == 0 || !context.map) return false;
+
+    const Tileset* tileset = context.map->FindTilesetByGid(gid);
+    if (!tileset) return false;
+
+    auto texIt = context.textureIndices.find(tileset);
+    if (texIt == context.textureIndices.end()) return false;
+
+    float opacity = layerIndex < context.opacities.size() ? context.opacities[layerIndex] : 1.0f;
+    if (opacity <= 0.0f) return false;
+
+    int localId = static_cast<int>(pureGid) - tileset->firstGid;
+
+    float u0, texV0, u1, texV1;
+    tileset->GetTileUV(localId, u0, texV0, u1, texV1);
+
+    const TileMap& map = *context.map;
+    float tileWidth = static_cast<float>(map.tileWidth);
+    float tileHeight = static_cast<float>(map.tileHeight);
+
+    float worldX, worldY;
+    if (map.orientation == Orientation::Isometric) {
+        worldX = static_cast<float>((tileX - tileY) * map.tileWidth / 2);
+        worldY = static_cast<float>((tileX + tileY) * map.tileHeight / 2);
+    } else {
+        worldX = static_cast<float>(tileX * map.tileWidth);
+        worldY = static_cast<float>(tileY * map.tileHeight);
+    }
+
+    bool flipH = GIDHelper::IsHorizontallyFlipped(gid);
+    bool flipV = GIDHelper::IsVerticallyFlipped(gid);
+    float texIndex = static_cast<float>(texIt->second);
+
+    float animIndex = -1.0f;
+    if (context.animations) {
+        uint32_t index = context.animations->Find(tileset, localId);
+        if (index != TileAnimationTable::NotAnimated) {
+            animIndex = static_cast<float>(index);
+        }
+    }
+
+    outQuad[0] = TileVertex(worldX, worldY, flipH ? u1 : u0, flipV ? texV1 : texV0, texIndex, 1.0f, 1.0f, 1.0f, opacity, animIndex);
+    outQuad[1] = TileVertex(worldX, worldY + tileHeight, flipH ? u1 : u0, flipV ? texV0 : texV1, texIndex, 1.0f, 1.0f, 1.0f, opacity, animIndex);
+    outQuad[2] = TileVertex(worldX + tileWidth, worldY + tileHeight, flipH ? u0 : u1, flipV ? texV0 : texV1, texIndex, 1.0f, 1.0f, 1.0f, opacity, animIndex);
+    outQuad[3] = TileVertex(worldX + tileWidth, worldY, flipH ? u0 : u1, flipV ? texV1 : texV0, texIndex, 1.0f, 1.0f, 1.0f, opacity, animIndex);
+    return true;
+}
+
+// ============================================================================
+// 整块构建
+// ============================================================================
+
+void TileChunk::GatherGids(const TileChunkBuildContext& context, std::vector<uint32_t>& outGids) const {
+    size_t tilesPerLayer = static_cast<size_t>(m_chunkSize) * static_cast<size_t>(m_chunkSize);
+    outGids.assign(context.layers.size() * tilesPerLayer, 0);
+
+    int startX = m_chunkX * m_chunkSize;
+    int startY = m_chunkY * m_chunkSize;
+
+    for (size_t layerIndex = 0; layerIndex < context.layers.size(); ++layerIndex) {
+        const TileLayer* layer = context.layers[layerIndex];
+        if (!layer) continue;
+
+        const TileLayerData& data = layer->tileData;
+        int endX = std::min(startX + m_chunkSize, data.width);
+        int endY = std::min(startY + m_chunkSize, data.height);
+
+        for (int y = startY; y < endY; ++y) {
+            for (int x = startX; x < endX; ++x) {
+                outGids[TileSlot(layerIndex, x - startX, y - startY)] = data.GetGid(x, y);
+            }
+        }
+    }
+}
+
+void TileChunk::BuildFromGids(
+    const TileChunkBuildContext& context,
+    const std::vector<uint32_t>& gids,
+    int chunkX, int chunkY, int chunkSize,
+    Geometry& out
+) {
+    // 保留 out 已有的容量, 后台缓冲在多次重建间复用
+    out.vertices.clear();
+    out.freeQuads.clear();
+    out.liveQuads = 0;
+    out.quadOfTile.assign(gids.size(), InvalidQuad);
+
+    int startX = chunkX * chunkSize;
+    int startY = chunkY * chunkSize;
+
+    // 槽位顺序与 TileSlot 一致: 层 -> 行 -> 列
+    TileVertex quad[4];
+    size_t slot = 0;
+    for (size_t layerIndex = 0; layerIndex < context.layers.size(); ++layerIndex) {
+        for (int localY = 0; localY < chunkSize; ++localY) {
+            for (int localX = 0; localX < chunkSize; ++localX, ++slot) {
+                if (!BuildTileQuad(context, layerIndex, gids[slot], startX + localX, startY + localY, quad)) {
+                    continue;
+                }
+
+                out.quadOfTile[slot] = out.QuadCount();
+                out.vertices.insert(out.vertices.end(), quad, quad + 4);
+                ++out.liveQuads;
+            }
+        }
+    }
+}
+
+void TileChunk::BuildGeometry(const TileChunkBuildContext& context) {
+    // 同步构建会取代正在进行的后台构建
+    if (m_pendingFuture.valid()) {
+        m_pendingFuture.wait();
+        m_pendingFuture = {};
+        m_backGeometry = std::move(m_pendingBuild->geometry);
+    }
+    m_pendingBuild.reset();
+    m_editsDuringBuild.clear();
+
+    std::vector<uint32_t> gids;
+    GatherGids(context, gids);
+    BuildFromGids(context, gids, m_chunkX, m_chunkY, m_chunkSize, m_geometry);
+
+    EnsureIndexPattern(m_geometry.QuadCount());
+    m_fullUploadPending = true;
+    m_dirtyQuadBegin = m_dirtyQuadEnd = 0;
+    m_dirty = false;
+}
+
+void TileChunk::BuildGeometryAsync(std::shared_ptr<const TileChunkBuildContext> context) {
+    if (!context) return;
+
+    // 已有构建在进行时, 先丢弃其结果 (它基于旧数据)
+    if (m_pendingFuture.valid()) {
+        m_pendingFuture.wait();
+        m_pendingFuture = {};
+        m_backGeometry = std::move(m_pendingBuild->geometry);
+    }
+
+    // GID 快照在主线程采集, 工作线程不访问可被修改的层数据
+    auto job = std::make_shared<BuildJob>();
+    GatherGids(*context, job->gids);
+    job->geometry = std::move(m_backGeometry);
+    m_pendingFuture = job->done.get_future();
+    m_pendingBuild = job;
+    m_editsDuringBuild.clear();
+    m_dirty = false;
+
+    int chunkX = m_chunkX, chunkY = m_chunkY, chunkSize = m_chunkSize;
+    JobSystem::GetInstance().SubmitJob([job, context, chunkX, chunkY, chunkSize]() {
+        BuildFromGids(*context, job->gids, chunkX, chunkY, chunkSize, job->geometry);
+        job->done.set_value();
+    });
+}
+
+bool TileChunk::ResolveAsyncBuild(const TileChunkBuildContext& context, bool wait) {
+    if (!m_pendingBuild) return false;
+
+    if (!wait && m_pendingFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    m_pendingFuture.get();
+
+    // 交换前后台几何体, 旧的前台几何体留作下一次构建的后台缓冲
+    std::swap(m_geometry, m_pendingBuild->geometry);
+    m_backGeometry = std::move(m_pendingBuild->geometry);
+    m_pendingBuild.reset();
+    EnsureIndexPattern(m_geometry.QuadCount());
+    m_fullUploadPending = true;
+    m_dirtyQuadBegin = m_dirtyQuadEnd = 0;
+
+    // 重放构建期间发生的修改
+    size_t tilesPerLayer = static_cast<size_t>(m_chunkSize) * static_cast<size_t>(m_chunkSize);
+    for (uint64_t edit : m_editsDuringBuild) {
+        size_t layerIndex = static_cast<size_t>(edit >> 32);
+        size_t tile = static_cast<size_t>(edit & 0xFFFFFFFFu) % tilesPerLayer;
+        PatchTile(context, layerIndex, static_cast<int>(tile % m_chunkSize), static_cast<int>(tile / m_chunkSize));
+    }
+    m_editsDuringBuild.clear();
+    return true;
+}
+
+// ============================================================================
+// 增量更新
+// ============================================================================
+
+void TileChunk::UpdateTile(const TileChunkBuildContext& context, size_t layerIndex, int tileX, int tileY) {
+    int localX = tileX - m_chunkX * m_chunkSize;
+    int localY = tileY - m_chunkY * m_chunkSize;
+    if (localX < 0 || localY < 0 || localX >= m_chunkSize || localY >= m_chunkSize) return;
+    if (layerIndex >= context.layers.size()) return;
+
+    if (m_pendingBuild) {
+        m_editsDuringBuild.push_back((static_cast<uint64_t>(layerIndex) << 32) |
+                                     static_cast<uint32_t>(localY * m_chunkSize + localX));
+    }
+
+    PatchTile(context, layerIndex, localX, localY);
+}
+
+void TileChunk::PatchTile(const TileChunkBuildContext& context, size_t layerIndex, int localX, int localY) {
+    size_t slot = TileSlot(layerIndex, localX, localY);
+    if (slot >= m_geometry.quadOfTile.size()) {
+        // 层数变化后需要整块重建
+        m_dirty = true;
+        return;
+    }
+
+    int tileX = m_chunkX * m_chunkSize + localX;
+    int tileY = m_chunkY * m_chunkSize + localY;
+
+    const TileLayer* layer = context.layers[layerIndex];
+    uint32_t gid = layer ? layer->tileData.GetGid(tileX, tileY) : 0;
+
+    TileVertex quad[4];
+    bool hasQuad = BuildTileQuad(context, layerIndex, gid, tileX, tileY, quad);
+    uint32_t& quadIndex = m_geometry.quadOfTile[slot];
+
+    if (!hasQuad) {
+        if (quadIndex == InvalidQuad) return;
+
+        // 退化为零面积四边形并回收槽位
+        std::fill_n(m_geometry.vertices.begin() + static_cast<size_t>(quadIndex) * 4, 4, TileVertex(0, 0, 0, 0, 0, 0, 0, 0, 0));
+        m_geometry.freeQuads.push_back(quadIndex);
+        MarkQuadDirty(quadIndex);
+        quadIndex = InvalidQuad;
+        --m_geometry.liveQuads;
+        return;
+    }
+
+    if (quadIndex == InvalidQuad) {
+        if (!m_geometry.freeQuads.empty()) {
+            quadIndex = m_geometry.freeQuads.back();
+            m_geometry.freeQuads.pop_back();
+        } else {
+            quadIndex = m_geometry.QuadCount();
+            m_geometry.vertices.resize(m_geometry.vertices.size() + 4);
+            EnsureIndexPattern(m_geometry.QuadCount());
+        }
+        ++m_geometry.liveQuads;
+    }
+
+    std::copy(quad, quad + 4, m_geometry.vertices.begin() + static_cast<size_t>(quadIndex) * 4);
+    MarkQuadDirty(quadIndex);
+}
+
+void TileChunk::MarkQuadDirty(uint32_t quad) {
+    if (m_dirtyQuadBegin >= m_dirtyQuadEnd) {
+        m_dirtyQuadBegin = quad;
+        m_dirtyQuadEnd = quad + 1;
+    } else {
+        m_dirtyQuadBegin = std::min(m_dirtyQuadBegin, quad);
+        m_dirtyQuadEnd = std::max(m_dirtyQuadEnd, quad + 1);
+    }
+}
+
+void TileChunk::EnsureIndexPattern(uint32_t quadCount) {
+    uint32_t current = static_cast<uint32_t>(m_indices.size() / 6);
+    if (quadCount <= current) return;
+
+    m_indices.reserve(static_cast<size_t>(quadCount) * 6);
+    for (uint32_t quad = current; quad < quadCount; ++quad) {
+        uint32_t base = quad * 4;
+        m_indices.insert(m_indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+}
+
+// ============================================================================
+// GPU 上传
+// ============================================================================
+
+void TileChunk::UploadGeometry(Graphic::IRenderDevice* device) {
+    if (!NeedsUpload()) return;
+    if (!device || !device->GetResourceFactory()) return;
+
+    uint32_t quadCount = m_geometry.QuadCount();
+    if (quadCount == 0) {
+        m_fullUploadPending = false;
+        m_dirtyQuadBegin = m_dirtyQuadEnd = 0;
+        return;
+    }
+
+    auto* factory = device->GetResourceFactory();
+
+    // 容量不足时重建缓冲区并整块上传
+    if (!m_vertexBuffer || quadCount > m_vertexCapacityQuads) {
+        m_vertexCapacityQuads = GrowQuadCapacity(quadCount);
+
+        Graphic::BufferDesc desc;
+        desc.name = "TileChunkVertices";
+        desc.type = Graphic::BufferType::Vertex;
+        desc.usage = Graphic::BufferUsage::Dynamic;
+        desc.size = static_cast<uint64_t>(m_vertexCapacityQuads) * 4 * sizeof(TileVertex);
+        desc.stride = sizeof(TileVertex);
+        m_vertexBuffer = std::shared_ptr<Graphic::IBuffer>(factory->CreateBufferImpl(desc));
+        m_fullUploadPending = true;
+    }
+
+    if (!m_indexBuffer || quadCount > m_indexCapacityQuads) {
+        m_indexCapacityQuads = m_vertexCapacityQuads;
+        EnsureIndexPattern(m_indexCapacityQuads);
+
+        Graphic::BufferDesc desc;
+        desc.name = "TileChunkIndices";
+        desc.type = Graphic::BufferType::Index;
+        desc.usage = Graphic::BufferUsage::Immutable;
+        desc.size = static_cast<uint64_t>(m_indexCapacityQuads) * 6 * sizeof(uint32_t);
+        desc.initialData = m_indices.data();
+        desc.stride = sizeof(uint32_t);
+        m_indexBuffer = std::shared_ptr<Graphic::IBuffer>(factory->CreateBufferImpl(desc));
+    }
+
+    if (!m_vertexBuffer) return;
+
+    if (m_fullUploadPending) {
+        m_vertexBuffer->UpdateData(m_geometry.vertices.data(), m_geometry.vertices.size() * sizeof(TileVertex), 0);
+    } else {
+        // 只上传被修改的槽位区间
+        uint64_t offset = static_cast<uint64_t>(m_dirtyQuadBegin) * 4 * sizeof(TileVertex);
+        uint64_t size = static_cast<uint64_t>(m_dirtyQuadEnd - m_dirtyQuadBegin) * 4 * sizeof(TileVertex);
+        m_vertexBuffer->UpdateData(m_geometry.vertices.data() + static_cast<size_t>(m_dirtyQuadBegin) * 4, size, offset);
+    }
+
+    m_fullUploadPending = false;
+    m_dirtyQuadBegin = m_dirtyQuadEnd = 0;
+}
+
+// ============================================================================
+// 可见性
+// ============================================================================
+
+void TileChunk::GetBounds(float& minX, float& minY, float& maxX, float& maxY) const {
+    minX = static_cast<float>(m_chunkX * m_chunkSize * m_tileWidth);
+    minY = static_cast<float>(m_chunkY * m_chunkSize * m_tileHeight);
+    maxX = minX + static_cast<float>(m_chunkSize * m_tileWidth);
+    maxY = minY + static_cast<float>(m_chunkSize * m_tileHeight);
+}
+
+bool TileChunk::IsVisible(
+    float viewMinX, float viewMinY,
+    float viewMaxX, float viewMaxY
+) const {
+    float minX, minY, maxX, maxY;
+    GetBounds(minX, minY, maxX, maxY);
+    return maxX >= viewMinX && minX <= viewMaxX && maxY >= viewMinY && minY <= viewMaxY;
+}
+
+// ============================================================================
+// 块管理器
+// ============================================================================
+
+TileChunkManager::TileChunkManager() = default;
+
+TileChunkManager::~TileChunkManager() {
+    WaitForBuilds();
+}
+
+void TileChunkManager::Initialize(const TileMap& map, int chunkSize) {
+    WaitForBuilds();
+
+    m_chunkSize = std::max(1, chunkSize);
+    m_tileWidth = map.tileWidth;
+    m_tileHeight = map.tileHeight;
+    m_chunksX = (map.width + m_chunkSize - 1) / m_chunkSize;
+    m_chunksY = (map.height + m_chunkSize - 1) / m_chunkSize;
+    m_totalChunks = m_chunksX * m_chunksY;
+
+    m_chunks.clear();
+    m_chunks.resize(static_cast<size_t>(m_totalChunks));
+    for (int chunkY = 0; chunkY < m_chunksY; ++chunkY) {
+        for (int chunkX = 0; chunkX < m_chunksX; ++chunkX) {
+            m_chunks[static_cast<size_t>(chunkY * m_chunksX + chunkX)].Initialize(
+                chunkX, chunkY, m_chunkSize, m_tileWidth, m_tileHeight);
+        }
+    }
+}
+
+void TileChunkManager::SetBuildContext(std::shared_ptr<const TileChunkBuildContext> context) {
+    m_context = std::move(context);
+}
+
+void TileChunkManager::RebuildAll(bool async) {
+    if (!m_context) return;
+
+    for (auto& chunk : m_chunks) {
+        if (async) {
+            chunk.BuildGeometryAsync(m_context);
+        } else {
+            chunk.BuildGeometry(*m_context);
+        }
+    }
+}
+
+void TileChunkManager::OnTileChanged(size_t layerIndex, int tileX, int tileY) {
+    if (!m_context || tileX < 0 || tileY < 0) return;
+
+    TileChunk* chunk = GetChunk(tileX / m_chunkSize, tileY / m_chunkSize);
+    if (chunk) {
+        chunk->UpdateTile(*m_context, layerIndex, tileX, tileY);
+    }
+}
+
+void TileChunkManager::WaitForBuilds() {
+    for (auto& chunk : m_chunks) {
+        if (chunk.IsBuilding() && m_context) {
+            chunk.ResolveAsyncBuild(*m_context, true);
+        }
+    }
+}
+
+TileChunk* TileChunkManager::GetChunk(int chunkX, int chunkY) {
+    if (chunkX < 0 || chunkY < 0 || chunkX >= m_chunksX || chunkY >= m_chunksY) {
+        return nullptr;
+    }
+    return &m_chunks[static_cast<size_t>(chunkY * m_chunksX + chunkX)];
+}
+
+void TileChunkManager::GetChunkCoord(float worldX, float worldY, int& chunkX, int& chunkY) const {
+    float chunkWidth = static_cast<float>(m_chunkSize * m_tileWidth);
+    float chunkHeight = static_cast<float>(m_chunkSize * m_tileHeight);
+    chunkX = chunkWidth > 0.0f ? static_cast<int>(std::floor(worldX / chunkWidth)) : 0;
+    chunkY = chunkHeight > 0.0f ? static_cast<int>(std::floor(worldY / chunkHeight)) : 0;
+}
+
+std::vector<TileChunk*> TileChunkManager::GetVisibleChunks(
+    float viewMinX, float viewMinY,
+    float viewMaxX, float viewMaxY
+) {
+    std::vector<TileChunk*> result;
+    for (auto& chunk : m_chunks) {
+        if (chunk.HasData() && chunk.IsVisible(viewMinX, viewMinY, viewMaxX, viewMaxY)) {
+            result.push_back(&chunk);
+        }
+    }
+    return result;
+}
+
+void TileChunkManager::UpdateDirtyChunks(Graphic::IRenderDevice* device) {
+    if (!m_context) return;
+
+    for (auto& chunk : m_chunks) {
+        if (chunk.IsBuilding()) {
+            chunk.ResolveAsyncBuild(*m_context);
+        } else if (chunk.IsDirty()) {
+            chunk.BuildGeometryAsync(m_context);
+        }
+
+        chunk.UploadGeometry(device);
+    }
+}
+
+} // namespace PrismaEngine
@@ -2,23 +2,58 @@
 
 #include "../core/Map.h"
 #include "TilemapRenderer.h"
+#include "TileAnimationTable.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 namespace PrismaEngine {
 
 namespace Graphic {
 class IBuffer;
+class IRenderDevice;
 }
 
+// ============================================================================
+// 块构建上下文 - 构建几何体所需的只读数据 (可被后台构建任务共享)
+// ============================================================================
+
+struct TileChunkBuildContext {
+    const TileMap* map = nullptr;
+
+    // 参与渲染的图块层 (与 TileMap::GetTileLayers 顺序一致, 隐藏层为 nullptr)
+    std::vector<const TileLayer*> layers;
+    std::vector<float> opacities;
+
+    // 图块集 -> 纹理数组索引
+    std::unordered_map<const Tileset*, int> textureIndices;
+
+    // GPU 动画查找表 (为空时不写入动画索引)
+    std::shared_ptr<const TileAnimationTable> animations;
+};
+
 // ============================================================================
 // 瓦块 - 用于分块渲染优化
+//
+// 每个非空瓦片占用一个四边形槽位 (4 个顶点), 单个瓦片修改只改写对应槽位,
+// 并以子区间更新 GPU 缓冲区。整块重建在工作线程上进行, 构建结果写入后备
+// 缓冲, 完成后在主线程交换。
 // ============================================================================
 
 class TileChunk {
 public:
+    static constexpr uint32_t InvalidQuad = 0xFFFFFFFF;
+
     TileChunk() = default;
-    ~TileChunk() = default;
+    ~TileChunk();
+
+    TileChunk(const TileChunk&) = delete;
+    TileChunk& operator=(const TileChunk&) = delete;
+    TileChunk(TileChunk&&) = default;
+    TileChunk& operator=(TileChunk&&) = default;
 
     // 初始化块
     void Initialize(
@@ -27,21 +62,37 @@ public:
         int tileWidth, int tileHeight
     );
 
-    // 构建几何体
-    void BuildGeometry(
-        const TileMap& map,
-        const std::vector<TileLayer*>& layers
-    );
+    // 构建几何体 (同步, 在调用线程上)
+    void BuildGeometry(const TileChunkBuildContext& context);
+
+    // 在工作线程上构建几何体, 完成前当前几何体保持可用
+    void BuildGeometryAsync(std::shared_ptr<const TileChunkBuildContext> context);
+
+    // 应用已完成的后台构建结果; wait 为 true 时阻塞等待
+    // 返回是否有新的几何体被应用
+    bool ResolveAsyncBuild(const TileChunkBuildContext& context, bool wait = false);
+
+    // 是否有后台构建正在进行
+    bool IsBuilding() const { return m_pendingBuild != nullptr; }
+
+    // 更新单个瓦片 (世界瓦片坐标), 只改写对应槽位
+    void UpdateTile(const TileChunkBuildContext& context, size_t layerIndex, int tileX, int tileY);
 
     // 重建几何体 (标记为脏)
     void MarkDirty() { m_dirty = true; }
     bool IsDirty() const { return m_dirty; }
 
+    // 上传几何体到 GPU (整块或脏区间)
+    void UploadGeometry(Graphic::IRenderDevice* device);
+
+    // 是否有尚未上传的几何体修改
+    bool NeedsUpload() const { return m_fullUploadPending || m_dirtyQuadBegin < m_dirtyQuadEnd; }
+
     // 获取渲染数据
-    const std::vector<float>& GetVertices() const { return m_vertices; }
+    const std::vector<TileVertex>& GetVertices() const { return m_geometry.vertices; }
     const std::vector<uint32_t>& GetIndices() const { return m_indices; }
-    size_t GetVertexCount() const { return m_vertexCount; }
-    size_t GetIndexCount() const { return m_indexCount; }
+    size_t GetVertexCount() const { return m_geometry.vertices.size(); }
+    size_t GetIndexCount() const { return m_geometry.QuadCount() * 6; }
 
     // GPU 缓冲区
     void SetVertexBuffer(std::shared_ptr<Graphic::IBuffer> buffer) { m_vertexBuffer = buffer; }
@@ -51,7 +102,7 @@ public:
     std::shared_ptr<Graphic::IBuffer> GetIndexBuffer() const { return m_indexBuffer; }
 
     // 检查是否有数据
-    bool HasData() const { return m_hasData; }
+    bool HasData() const { return m_geometry.liveQuads > 0; }
 
     // 获取块的世界边界
     void GetBounds(float& minX, float& minY, float& maxX, float& maxY) const;
@@ -62,7 +113,55 @@ public:
         float viewMaxX, float viewMaxY
     ) const;
 
+    // 计算单个瓦片的四边形, 空瓦片返回 false
+    static bool BuildTileQuad(
+        const TileChunkBuildContext& context,
+        size_t layerIndex,
+        uint32_t gid,
+        int tileX, int tileY,
+        TileVertex outQuad[4]
+    );
+
 private:
+    // 块的几何体 (前台/后台各一份)
+    struct Geometry {
+        std::vector<TileVertex> vertices;      // 每槽位 4 个顶点
+        std::vector<uint32_t> quadOfTile;      // [层][块内瓦片] -> 槽位
+        std::vector<uint32_t> freeQuads;       // 可复用的空槽位
+        uint32_t liveQuads = 0;
+
+        uint32_t QuadCount() const { return static_cast<uint32_t>(vertices.size() / 4); }
+    };
+
+    // 后台构建任务
+    struct BuildJob {
+        std::vector<uint32_t> gids;            // 发起时的 GID 快照
+        Geometry geometry;
+        std::promise<void> done;
+    };
+
+    size_t TileSlot(size_t layerIndex, int localX, int localY) const {
+        return layerIndex * static_cast<size_t>(m_chunkSize) * static_cast<size_t>(m_chunkSize) +
+               static_cast<size_t>(localY) * static_cast<size_t>(m_chunkSize) + static_cast<size_t>(localX);
+    }
+
+    // 从 GID 快照构建整块几何体 (不访问块成员, 可在工作线程上调用)
+    static void BuildFromGids(
+        const TileChunkBuildContext& context,
+        const std::vector<uint32_t>& gids,
+        int chunkX, int chunkY, int chunkSize,
+        Geometry& out
+    );
+
+    // 采集块内所有层的 GID
+    void GatherGids(const TileChunkBuildContext& context, std::vector<uint32_t>& outGids) const;
+
+    // 将瓦片写入槽位
+    void PatchTile(const TileChunkBuildContext& context, size_t layerIndex, int localX, int localY);
+
+    void MarkQuadDirty(uint32_t quad);
+    void EnsureIndexPattern(uint32_t quadCount);
+
     // 块位置
     int m_chunkX = 0;
     int m_chunkY = 0;
@@ -70,19 +169,29 @@ private:
     int m_tileWidth = 0;
     int m_tileHeight = 0;
 
-    // 几何体数据
-    std::vector<float> m_vertices;
-    std::vector<uint32_t> m_indices;
-    size_t m_vertexCount = 0;
-    size_t m_indexCount = 0;
+    // 前台几何体
+    Geometry m_geometry;
+    std::vector<uint32_t> m_indices;           // 固定的四边形索引模式
+
+    // 后台构建
+    Geometry m_backGeometry;                   // 后台几何体 (构建期间移交给任务)
+    std::shared_ptr<BuildJob> m_pendingBuild;
+    std::future<void> m_pendingFuture;
+    std::vector<uint64_t> m_editsDuringBuild;  // 构建期间的修改 (层 << 32 | 块内瓦片)
+
+    // 待上传区间 (槽位)
+    uint32_t m_dirtyQuadBegin = 0;
+    uint32_t m_dirtyQuadEnd = 0;
+    bool m_fullUploadPending = false;
 
     // GPU 缓冲区
     std::shared_ptr<Graphic::IBuffer> m_vertexBuffer;
     std::shared_ptr<Graphic::IBuffer> m_indexBuffer;
+    uint32_t m_vertexCapacityQuads = 0;
+    uint32_t m_indexCapacityQuads = 0;
 
     // 状态
     bool m_dirty = true;
-    bool m_hasData = false;
 };
 
 // ============================================================================
@@ -100,8 +209,17 @@ public:
         int chunkSize = 32
     );
 
-    // 重建所有块
-    void RebuildAll(const TileMap& map);
+    // 设置构建上下文 (层列表、透明度或纹理变化后调用)
+    void SetBuildContext(std::shared_ptr<const TileChunkBuildContext> context);
+
+    // 重建所有块; async 为 true 时在工作线程上构建, 旧几何体在完成前继续使用
+    void RebuildAll(bool async = true);
+
+    // 瓦片修改后调用, 只更新对应槽位
+    void OnTileChanged(size_t layerIndex, int tileX, int tileY);
+
+    // 等待所有后台构建完成
+    void WaitForBuilds();
 
     // 获取指定位置的块
     TileChunk* GetChunk(int chunkX, int chunkY);
@@ -118,23 +236,24 @@ public:
         float viewMaxX, float viewMaxY
     );
 
-    // 更新脏块
-    void UpdateDirtyChunks(
-        const TileMap& map,
-        Graphic::IRenderDevice* device
-    );
+    // 更新脏块: 应用已完成的后台构建, 并上传修改过的区间
+    void UpdateDirtyChunks(Graphic::IRenderDevice* device);
 
     // 获取块数量
     int GetChunkCountX() const { return m_chunksX; }
     int GetChunkCountY() const { return m_chunksY; }
     int GetTotalChunkCount() const { return m_totalChunks; }
+    int GetChunkSize() const { return m_chunkSize; }
 
 private:
     std::vector<TileChunk> m_chunks;
+    std::shared_ptr<const TileChunkBuildContext> m_context;
     int m_chunksX = 0;
     int m_chunksY = 0;
     int m_totalChunks = 0;
     int m_chunkSize = 32;
+    int m_tileWidth = 0;
+    int m_tileHeight = 0;
 };
 
 } // namespace PrismaEngine
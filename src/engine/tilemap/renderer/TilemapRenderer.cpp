@@ -1,4 +1,6 @@
 #include "TilemapRenderer.h"
+#include "TileChunk.h"
+#include "TileAnimationTable.h"
 #include "../../graphic/interfaces/IResourceManager.h"
 #include "../../graphic/Material.h"
 #include "../../graphic/RenderCommandContext.h"
@@ -34,13 +36,26 @@ void TilemapRenderer::Update(float deltaTime) {
 
     // 更新动画瓦片
     if (m_animatedTilesEnabled) {
-        UpdateAnimatedTiles(deltaTime);
+        if (m_animationMode == TilemapAnimationMode::GPU) {
+            // 只推进时间, 帧选择由着色器完成
+            if (m_animationTable && !m_animationTable->IsEmpty()) {
+                m_animationTimeMs = std::fmod(m_animationTimeMs + deltaTime * 1000.0,
+                                              static_cast<double>(m_animationTable->GetLoopPeriod()));
+            }
+        } else {
+            UpdateAnimatedTiles(deltaTime);
+        }
     }
 
     // 如果几何体脏，重建
     if (m_geometryDirty) {
         BuildGeometry();
     }
+
+    // 应用完成的后台构建并上传修改过的区间
+    if (m_renderMode == TilemapRenderMode::Chunked && m_chunkManager) {
+        m_chunkManager->UpdateDirtyChunks(m_device);
+    }
 }
 
 void TilemapRenderer::Shutdown() {
@@ -50,7 +65,11 @@ void TilemapRenderer::Shutdown() {
     m_tilesetToTextureIndex.clear();
     m_vertexBuffer.reset();
     m_indexBuffer.reset();
+    m_chunkManager.reset();
+    m_tileLayers.clear();
     m_animatedTiles.clear();
+    m_animationTable.reset();
+    m_animationTexture.reset();
 }
 
 // ============================================================================
@@ -58,26 +77,33 @@ void TilemapRenderer::Shutdown() {
 // ============================================================================
 
 void TilemapRenderer::SetTilemap(TilemapAsset* tilemap) {
+    // 旧地图的后台构建任务引用其层数据, 需先结束
+    m_chunkManager.reset();
+    m_tileLayers.clear();
+
     m_tilemap = tilemap;
 
     if (m_tilemap && m_tilemap->IsLoaded()) {
+        m_tileLayers = m_tilemap->GetTileLayers();
+
         // 加载图块集纹理
         LoadTilesetTextures();
 
         // 注册动画瓦片
+        m_animatedTiles.clear();
+        m_animationTable.reset();
+        m_animationTexture.reset();
         if (m_animatedTilesEnabled) {
-            RegisterAnimatedTiles();
-        }
-
-        // 计算块数量
-        if (m_tilemap->GetWidth() > 0 && m_tilemap->GetHeight() > 0) {
-            m_chunksX = (m_tilemap->GetWidth() + m_chunkSize - 1) / m_chunkSize;
-            m_chunksY = (m_tilemap->GetHeight() + m_chunkSize - 1) / m_chunkSize;
+            if (m_animationMode == TilemapAnimationMode::GPU) {
+                BuildAnimationTable();
+            } else {
+                RegisterAnimatedTiles();
+            }
         }
 
         // 初始化层状态
         m_layerStates.clear();
-        // TODO: 从地图获取层数
+        m_layerStates.resize(m_tileLayers.size());
     }
 
     m_geometryDirty = true;
@@ -122,35 +148,51 @@ float TilemapRenderer::GetLayerOpacity(size_t layerIndex) const {
 // ============================================================================
 
 void TilemapRenderer::SetTile(int x, int y, uint32_t gid) {
+    SetTile(0, x, y, gid);
+}
+
+uint32_t TilemapRenderer::GetTile(int x, int y) const {
+    return GetTile(0, x, y);
+}
+
+void TilemapRenderer::SetTile(size_t layerIndex, int x, int y, uint32_t gid) {
     if (!m_tilemap || !m_tilemap->IsLoaded()) {
         return;
     }
 
-    const TileMap* map = m_tilemap->GetMap();
-    if (!map) return;
+    if (layerIndex >= m_tileLayers.size() || !m_tileLayers[layerIndex]) {
+        return;
+    }
 
-    // TODO: 更新地图数据
-    // map->SetTile(x, y, gid);
+    TileLayerData& tileData = m_tileLayers[layerIndex]->tileData;
+    if (tileData.GetGid(x, y) == gid) {
+        return;
+    }
+    tileData.SetGid(x, y, gid);
 
-    m_geometryDirty = true;
+    // 分块模式下只改写对应的四边形槽位, 其余模式整体重建
+    if (m_renderMode == TilemapRenderMode::Chunked && m_chunkManager && !m_geometryDirty) {
+        m_chunkManager->OnTileChanged(layerIndex, x, y);
+    } else {
+        m_geometryDirty = true;
+    }
 }
 
-uint32_t TilemapRenderer::GetTile(int x, int y) const {
+uint32_t TilemapRenderer::GetTile(size_t layerIndex, int x, int y) const {
     if (!m_tilemap || !m_tilemap->IsLoaded()) {
         return 0;
     }
 
-    const TileMap* map = m_tilemap->GetMap();
-    if (!map) return 0;
+    if (layerIndex >= m_tileLayers.size() || !m_tileLayers[layerIndex]) {
+        return 0;
+    }
 
-    // TODO: 从地图获取瓦片
-    // return map->GetTile(x, y);
-    return 0;
+    return m_tileLayers[layerIndex]->tileData.GetGid(x, y);
 }
 
 void TilemapRenderer::SetTiles(const std::vector<TileChange>& changes) {
     for (const auto& change : changes) {
-        SetTile(change.x, change.y, change.newGid);
+        SetTile(change.layer, change.x, change.y, change.newGid);
     }
 }
 
@@ -200,11 +242,48 @@ void TilemapRenderer::UpdateAnimatedTiles(float deltaTime) {
 
             // 更新瓦片
             uint32_t newGid = animTile.baseGid + animTile.tile->animation[animTile.currentFrame].tileId;
-            SetTile(animTile.x, animTile.y, newGid);
+            SetTile(animTile.layer, animTile.x, animTile.y, newGid);
         }
     }
 }
 
+void TilemapRenderer::SetAnimationMode(TilemapAnimationMode mode) {
+    if (m_animationMode == mode) {
+        return;
+    }
+    m_animationMode = mode;
+
+    m_animatedTiles.clear();
+    m_animationTable.reset();
+    m_animationTexture.reset();
+    m_animationTimeMs = 0.0;
+
+    if (m_tilemap && m_tilemap->IsLoaded() && m_animatedTilesEnabled) {
+        if (m_animationMode == TilemapAnimationMode::GPU) {
+            BuildAnimationTable();
+        } else {
+            RegisterAnimatedTiles();
+        }
+    }
+
+    // 顶点中的动画索引需要重新生成
+    m_geometryDirty = true;
+}
+
+void TilemapRenderer::BuildAnimationTable() {
+    const TileMap* map = m_tilemap ? m_tilemap->GetMap() : nullptr;
+    if (!map) return;
+
+    auto table = std::make_shared<TileAnimationTable>();
+    table->Build(*map);
+    if (table->IsEmpty()) {
+        return;
+    }
+
+    m_animationTable = table;
+    m_animationTexture = m_animationTable->CreateTexture(m_device);
+}
+
 // ============================================================================
 // 几何构建
 // ============================================================================
@@ -289,6 +368,15 @@ void TilemapRenderer::BuildLayerGeometry(
 
             int localId = static_cast<int>(pureGid) - tileset->firstGid;
 
+            // GPU 动画模式下记录动画索引, 由着色器选择帧
+            float animIndex = -1.0f;
+            if (m_animationTable && m_animationMode == TilemapAnimationMode::GPU) {
+                uint32_t index = m_animationTable->Find(tileset, localId);
+                if (index != TileAnimationTable::NotAnimated) {
+                    animIndex = static_cast<float>(index);
+                }
+            }
+
             // 获取 UV 坐标
             float u0, texV0, u1, texV1;
             GetTileUV(tileset, localId, u0, texV0, u1, texV1);
@@ -310,15 +398,15 @@ void TilemapRenderer::BuildLayerGeometry(
 
             if (flipD) {
                 // 对角翻转 (旋转)
-                v0 = TileVertex(worldX, worldY, flipH ? u1 : u0, flipV ? texV1 : texV0, textureIndex, r, g, b, a);
-                v1 = TileVertex(worldX, worldY + tileHeight, flipH ? u1 : u0, flipV ? texV0 : texV1, textureIndex, r, g, b, a);
-                v2 = TileVertex(worldX + tileWidth, worldY + tileHeight, flipH ? u0 : u1, flipV ? texV0 : texV1, textureIndex, r, g, b, a);
-                v3 = TileVertex(worldX + tileWidth, worldY, flipH ? u0 : u1, flipV ? texV1 : texV0, textureIndex, r, g, b, a);
+                v0 = TileVertex(worldX, worldY, flipH ? u1 : u0, flipV ? texV1 : texV0, textureIndex, r, g, b, a, animIndex);
+                v1 = TileVertex(worldX, worldY + tileHeight, flipH ? u1 : u0, flipV ? texV0 : texV1, textureIndex, r, g, b, a, animIndex);
+                v2 = TileVertex(worldX + tileWidth, worldY + tileHeight, flipH ? u0 : u1, flipV ? texV0 : texV1, textureIndex, r, g, b, a, animIndex);
+                v3 = TileVertex(worldX + tileWidth, worldY, flipH ? u0 : u1, flipV ? texV1 : texV0, textureIndex, r, g, b, a, animIndex);
             } else {
-                v0 = TileVertex(worldX, worldY, flipH ? u1 : u0, flipV ? texV1 : texV0, textureIndex, r, g, b, a);
-                v1 = TileVertex(worldX, worldY + tileHeight, flipH ? u1 : u0, flipV ? texV0 : texV1, textureIndex, r, g, b, a);
-                v2 = TileVertex(worldX + tileWidth, worldY + tileHeight, flipH ? u0 : u1, flipV ? texV0 : texV1, textureIndex, r, g, b, a);
-                v3 = TileVertex(worldX + tileWidth, worldY, flipH ? u0 : u1, flipV ? texV1 : texV0, textureIndex, r, g, b, a);
+                v0 = TileVertex(worldX, worldY, flipH ? u1 : u0, flipV ? texV1 : texV0, textureIndex, r, g, b, a, animIndex);
+                v1 = TileVertex(worldX, worldY + tileHeight, flipH ? u1 : u0, flipV ? texV0 : texV1, textureIndex, r, g, b, a, animIndex);
+                v2 = TileVertex(worldX + tileWidth, worldY + tileHeight, flipH ? u0 : u1, flipV ? texV0 : texV1, textureIndex, r, g, b, a, animIndex);
+                v3 = TileVertex(worldX + tileWidth, worldY, flipH ? u0 : u1, flipV ? texV1 : texV0, textureIndex, r, g, b, a, animIndex);
             }
 
             vertices.insert(vertices.end(), {v0, v1, v2, v3});
@@ -344,109 +432,34 @@ void TilemapRenderer::BuildChunkGeometry() {
     const TileMap* map = m_tilemap->GetMap();
     if (!map) return;
 
-    int mapWidth = map->width;
-    int mapHeight = map->height;
-
-    m_chunksX = (mapWidth + m_chunkSize - 1) / m_chunkSize;
-    m_chunksY = (mapHeight + m_chunkSize - 1) / m_chunkSize;
-
-    for (int chunkY = 0; chunkY < m_chunksY; ++chunkY) {
-        for (int chunkX = 0; chunkX < m_chunksX; ++chunkX) {
-            BuildChunkGeometry(chunkX, chunkY);
-        }
+    if (!m_chunkManager || m_chunkManager->GetChunkSize() != m_chunkSize) {
+        m_chunkManager = std::make_unique<TileChunkManager>();
+        m_chunkManager->Initialize(*map, m_chunkSize);
     }
-}
-
-void TilemapRenderer::BuildChunkGeometry(int chunkX, int chunkY) {
-    int chunkIndex = chunkY * m_chunksX + chunkX;
-    if (chunkIndex >= MAX_CHUNKS) return;
 
-    Chunk& chunk = m_chunks[chunkIndex];
-    chunk.vertices.clear();
-    chunk.indices.clear();
-    chunk.dirty = false;
-    chunk.hasData = false;
+    // 整块重建在工作线程上进行, 完成前继续使用旧几何体
+    m_chunkManager->SetBuildContext(CreateChunkBuildContext());
+    m_chunkManager->RebuildAll(true);
+}
 
-    if (!m_tilemap || !m_tilemap->IsLoaded()) {
-        return;
+std::shared_ptr<TileChunkBuildContext> TilemapRenderer::CreateChunkBuildContext() const {
+    auto context = std::make_shared<TileChunkBuildContext>();
+    context->map = m_tilemap ? m_tilemap->GetMap() : nullptr;
+    context->textureIndices = m_tilesetToTextureIndex;
+    if (m_animationMode == TilemapAnimationMode::GPU && m_animatedTilesEnabled) {
+        context->animations = m_animationTable;
     }
 
-    const TileMap* map = m_tilemap->GetMap();
-    if (!map) return;
-
-    int startX = chunkX * m_chunkSize;
-    int startY = chunkY * m_chunkSize;
-    int endX = std::min(startX + m_chunkSize, map->width);
-    int endY = std::min(startY + m_chunkSize, map->height);
-
-    int tileWidth = map->tileWidth;
-    int tileHeight = map->tileHeight;
-
-    uint32_t vertexOffset = 0;
-
-    for (auto* layer : m_tilemap->GetTileLayers()) {
-        if (!layer || !layer->visible) continue;
-
-        for (int y = startY; y < endY; ++y) {
-            for (int x = startX; x < endX; ++x) {
-                uint32_t gid = layer->tileData.GetGid(x, y);
-                uint32_t pureGid = GIDHelper::GetPureGid(gid);
-
-                if (pureGid == 0) continue;
-
-                const Tileset* tileset = map->FindTilesetByGid(gid);
-                if (!tileset) continue;
-
-                int textureIndex = GetTilesetTextureIndex(tileset);
-                if (textureIndex < 0) continue;
-
-                int localId = static_cast<int>(pureGid) - tileset->firstGid;
-
-                float u0, texV0, u1, texV1;
-                GetTileUV(tileset, localId, u0, texV0, u1, texV1);
-
-                float worldX = static_cast<float>(x * tileWidth);
-                float worldY = static_cast<float>(y * tileHeight);
-
-                float opacity = layer->opacity;
-                float r = 1.0f, g = 1.0f, b = 1.0f, a = opacity;
-
-                bool flipH = GIDHelper::IsHorizontallyFlipped(gid);
-                bool flipV = GIDHelper::IsVerticallyFlipped(gid);
-                bool flipD = GIDHelper::IsDiagonallyFlipped(gid);
-
-                // 添加 4 个顶点 (两个三角形)
-                TileVertex v0, v1, v2, v3;
-
-                if (flipD) {
-                    v0 = TileVertex(worldX, worldY, flipH ? u1 : u0, flipV ? texV1 : texV0, static_cast<float>(textureIndex), r, g, b, a);
-                    v1 = TileVertex(worldX, worldY + tileHeight, flipH ? u1 : u0, flipV ? texV0 : texV1, static_cast<float>(textureIndex), r, g, b, a);
-                    v2 = TileVertex(worldX + tileWidth, worldY + tileHeight, flipH ? u0 : u1, flipV ? texV0 : texV1, static_cast<float>(textureIndex), r, g, b, a);
-                    v3 = TileVertex(worldX + tileWidth, worldY, flipH ? u0 : u1, flipV ? texV1 : texV0, static_cast<float>(textureIndex), r, g, b, a);
-                } else {
-                    v0 = TileVertex(worldX, worldY, flipH ? u1 : u0, flipV ? texV1 : texV0, static_cast<float>(textureIndex), r, g, b, a);
-                    v1 = TileVertex(worldX, worldY + tileHeight, flipH ? u1 : u0, flipV ? texV0 : texV1, static_cast<float>(textureIndex), r, g, b, a);
-                    v2 = TileVertex(worldX + tileWidth, worldY + tileHeight, flipH ? u0 : u1, flipV ? texV0 : texV1, static_cast<float>(textureIndex), r, g, b, a);
-                    v3 = TileVertex(worldX + tileWidth, worldY, flipH ? u0 : u1, flipV ? texV1 : texV0, static_cast<float>(textureIndex), r, g, b, a);
-                }
-
-                chunk.vertices.insert(chunk.vertices.end(), {v0, v1, v2, v3});
-
-                uint32_t i0 = vertexOffset + 0;
-                uint32_t i1 = vertexOffset + 1;
-                uint32_t i2 = vertexOffset + 2;
-                uint32_t i3 = vertexOffset + 3;
-
-                chunk.indices.insert(chunk.indices.end(), {i0, i1, i2, i0, i2, i3});
-
-                vertexOffset += 4;
-                chunk.hasData = true;
-            }
-        }
+    context->layers.reserve(m_tileLayers.size());
+    context->opacities.reserve(m_tileLayers.size());
+    for (size_t i = 0; i < m_tileLayers.size(); ++i) {
+        const TileLayer* layer = m_tileLayers[i];
+        bool visible = layer && layer->visible && GetLayerVisibility(i);
+        context->layers.push_back(visible ? layer : nullptr);
+        context->opacities.push_back(layer ? layer->opacity * GetLayerOpacity(i) : 0.0f);
     }
 
-    chunk.vertexCount = vertexOffset;
-    chunk.indexCount = static_cast<uint32_t>(chunk.indices.size());
+    return context;
 }
 
 // ============================================================================
@@ -511,7 +524,8 @@ void TilemapRenderer::RegisterAnimatedTiles() {
             if (tile.HasAnimation()) {
                 // 查找使用此瓦片的位置
                 // TODO: 遍历所有层，找到使用此瓦片的位置
-                for (auto* layer : m_tilemap->GetTileLayers()) {
+                for (size_t layerIndex = 0; layerIndex < m_tileLayers.size(); ++layerIndex) {
+                    const TileLayer* layer = m_tileLayers[layerIndex];
                     if (!layer) continue;
 
                     for (int y = 0; y < layer->tileData.height; ++y) {
@@ -521,6 +535,7 @@ void TilemapRenderer::RegisterAnimatedTiles() {
 
                             if (pureGid == static_cast<uint32_t>(tileset->firstGid + id)) {
                                 AnimatedTileInfo info;
+                                info.layer = layerIndex;
                                 info.x = x;
                                 info.y = y;
                                 info.tile = &tile;
@@ -20,6 +20,10 @@ class IMaterial;
 class ICamera;
 }
 
+class TileChunkManager;
+class TileAnimationTable;
+struct TileChunkBuildContext;
+
 // ============================================================================
 // 瓦片顶点
 // ============================================================================
@@ -29,11 +33,12 @@ struct TileVertex {
     float u, v;          // 纹理坐标
     float texIndex;      // 纹理数组索引
     float r, g, b, a;    // 颜色 (用于淡入淡出)
+    float animIndex;     // 动画查找表索引 (GPU 动画模式), -1 表示静态瓦片
 
     TileVertex() = default;
 
-    TileVertex(float px, float py, float pu, float pv, float ti, float tr, float tg, float tb, float ta)
-        : x(px), y(py), u(pu), v(pv), texIndex(ti), r(tr), g(tg), b(tb), a(ta) {}
+    TileVertex(float px, float py, float pu, float pv, float ti, float tr, float tg, float tb, float ta, float ai = -1.0f)
+        : x(px), y(py), u(pu), v(pv), texIndex(ti), r(tr), g(tg), b(tb), a(ta), animIndex(ai) {}
 };
 
 // ============================================================================
@@ -43,6 +48,7 @@ struct TileVertex {
 struct TileChange {
     int x, y;
     uint32_t newGid;
+    size_t layer = 0;    // 图块层索引 (TileMap::GetTileLayers 顺序)
 };
 
 // ============================================================================
@@ -55,6 +61,15 @@ enum class TilemapRenderMode {
     Chunked      // 分块模式 - 分块渲染 (推荐用于大地图)
 };
 
+// ============================================================================
+// 动画模式
+// ============================================================================
+
+enum class TilemapAnimationMode {
+    CPU,         // CPU 模式 - 每帧推进动画并改写顶点
+    GPU          // GPU 模式 - 帧表存于查找纹理, 着色器根据时间选择帧
+};
+
 // ============================================================================
 // 瓦片地图渲染器
 // ============================================================================
@@ -108,10 +123,14 @@ public:
     // 动态更新
     // =====================================================================
 
-    // 设置指定位置的瓦片
+    // 设置指定位置的瓦片 (第一个图块层)
     void SetTile(int x, int y, uint32_t gid);
     uint32_t GetTile(int x, int y) const;
 
+    // 设置指定图块层上的瓦片; 分块模式下只更新对应的四边形槽位
+    void SetTile(size_t layerIndex, int x, int y, uint32_t gid);
+    uint32_t GetTile(size_t layerIndex, int x, int y) const;
+
     // 批量更新瓦片
     void SetTiles(const std::vector<TileChange>& changes);
 
@@ -136,6 +155,16 @@ public:
     // 更新动画瓦片 (在 Update 中自动调用)
     void UpdateAnimatedTiles(float deltaTime);
 
+    // 设置动画模式 (GPU 模式下动画不占用每帧 CPU 时间)
+    void SetAnimationMode(TilemapAnimationMode mode);
+    TilemapAnimationMode GetAnimationMode() const { return m_animationMode; }
+
+    // 着色器动画时间 (毫秒, 已按动画公共周期回绕), 对应 TilemapUBO::u_TimeMs
+    float GetAnimationTime() const { return static_cast<float>(m_animationTimeMs); }
+
+    // 动画查找纹理 (GPU 模式), 绑定到 u_AnimationTable
+    std::shared_ptr<Graphic::ITexture> GetAnimationTexture() const { return m_animationTexture; }
+
 private:
     // =====================================================================
     // 几何构建
@@ -147,11 +176,11 @@ private:
     // 构建指定层的几何体
     void BuildLayerGeometry(TileLayer* layer, std::vector<TileVertex>& vertices, std::vector<uint32_t>& indices);
 
-    // 构建分块几何体
+    // 构建分块几何体 (在工作线程上进行)
     void BuildChunkGeometry();
 
-    // 构建指定块的几何体
-    void BuildChunkGeometry(int chunkX, int chunkY);
+    // 创建分块构建上下文 (层可见性/透明度/纹理索引的快照)
+    std::shared_ptr<TileChunkBuildContext> CreateChunkBuildContext() const;
 
     // =====================================================================
     // 纹理管理
@@ -173,6 +202,9 @@ private:
     // 更新动画帧
     void UpdateAnimationFrame(int x, int y, const Tile* tile, uint32_t& currentGid);
 
+    // 构建 GPU 动画查找表
+    void BuildAnimationTable();
+
     // =====================================================================
     // 辅助方法
     // =====================================================================
@@ -210,20 +242,10 @@ private:
     uint32_t m_indexCount = 0;
 
     // 分块渲染数据
-    static constexpr int MAX_CHUNKS = 256;
-    struct Chunk {
-        std::vector<TileVertex> vertices;
-        std::vector<uint32_t> indices;
-        std::shared_ptr<Graphic::IBuffer> vertexBuffer;
-        std::shared_ptr<Graphic::IBuffer> indexBuffer;
-        uint32_t vertexCount = 0;
-        uint32_t indexCount = 0;
-        bool dirty = true;
-        bool hasData = false;
-    };
-    Chunk m_chunks[MAX_CHUNKS];
-    int m_chunksX = 0;
-    int m_chunksY = 0;
+    std::unique_ptr<TileChunkManager> m_chunkManager;
+
+    // 图块层 (TileMap::GetTileLayers 的缓存, 供逐瓦片修改使用)
+    std::vector<TileLayer*> m_tileLayers;
 
     // 层状态
     struct LayerState {
@@ -243,6 +265,7 @@ private:
     // 动画瓦片
     bool m_animatedTilesEnabled = true;
     struct AnimatedTileInfo {
+        size_t layer;
         int x, y;
         const Tile* tile;
         float frameTimer;
@@ -250,6 +273,12 @@ private:
         uint32_t baseGid;
     };
     std::vector<AnimatedTileInfo> m_animatedTiles;
+
+    // GPU 动画
+    TilemapAnimationMode m_animationMode = TilemapAnimationMode::CPU;
+    std::shared_ptr<TileAnimationTable> m_animationTable;
+    std::shared_ptr<Graphic::ITexture> m_animationTexture;
+    double m_animationTimeMs = 0.0;
 };
 
 } // namespace PrismaEngine
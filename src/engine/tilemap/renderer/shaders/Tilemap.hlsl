@@ -7,16 +7,31 @@ cbuffer CameraBuffer : register(b0) {
     matrix u_Projection;
 };
 
+// Tile animation parameters
+cbuffer TilemapBuffer : register(b1) {
+    float u_TimeMs;                 // Animation time in ms, wrapped to the common loop period
+    float u_AnimationTableWidth;    // Texels per row of the lookup table
+    float2 u_Padding;
+};
+
 // Texture arrays (using texture2d arrays)
 Texture2D u_TilesetTextures[16] : register(t1);
 SamplerState u_SamplerState : register(s0);
 
+// Animation lookup table (RGBA32F)
+//   header texel: (first frame texel, frame count, total duration, 0)
+//   frame texel:  (U offset, V offset, frame end time, 0)
+Texture2D<float4> u_AnimationTable : register(t17);
+
+#define MAX_ANIMATION_FRAMES 64
+
 // Input vertex structure
 struct VertexInput {
     float2 a_Position : POSITION;
     float2 a_TexCoord : TEXCOORD0;
     float a_TexIndex : TEXCOORD1;
     float4 a_Color : COLOR;
+    float a_AnimIndex : TEXCOORD2;  // -1 for static tiles
 };
 
 // Output to pixel shader
@@ -27,12 +42,37 @@ struct PixelInput {
     float4 Color : COLOR;
 };
 
+float4 FetchAnimationTexel(int index) {
+    int width = (int)u_AnimationTableWidth;
+    return u_AnimationTable.Load(int3(index % width, index / width, 0));
+}
+
+float2 GetAnimationOffset(int animIndex) {
+    float4 header = FetchAnimationTexel(animIndex);
+    int firstFrame = (int)header.x;
+    int frameCount = (int)header.y;
+    float time = fmod(u_TimeMs, header.z);
+
+    float2 offset = float2(0.0, 0.0);
+    for (int i = 0; i < MAX_ANIMATION_FRAMES && i < frameCount; ++i) {
+        float4 frame = FetchAnimationTexel(firstFrame + i);
+        offset = frame.xy;
+        if (time < frame.z) {
+            break;
+        }
+    }
+    return offset;
+}
+
 // Vertex Shader
 PixelInput VSMain(VertexInput input) {
     PixelInput output;
     float4 worldPos = float4(input.a_Position, 0.0, 1.0);
     output.Position = mul(u_ViewProjection, worldPos);
     output.TexCoord = input.a_TexCoord;
+    if (input.a_AnimIndex >= 0.0) {
+        output.TexCoord += GetAnimationOffset((int)input.a_AnimIndex);
+    }
     output.TexIndex = input.a_TexIndex;
     output.Color = input.a_Color;
     return output;
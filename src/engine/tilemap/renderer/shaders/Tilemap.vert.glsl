@@ -5,6 +5,7 @@ layout(location = 0) in vec2 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
 layout(location = 2) in float a_TexIndex;
 layout(location = 3) in vec4 a_Color;
+layout(location = 4) in float a_AnimIndex;  // 动画查找表索引, -1 表示静态瓦片
 
 // Uniform 缓冲区
 layout(binding = 0) uniform CameraUBO {
@@ -13,16 +14,57 @@ layout(binding = 0) uniform CameraUBO {
     mat4 u_Projection;
 };
 
+// 瓦片动画参数
+layout(binding = 2) uniform TilemapUBO {
+    float u_TimeMs;                 // 动画时间 (毫秒, 已按公共周期回绕)
+    float u_AnimationTableWidth;    // 查找表每行纹素数
+    vec2 u_Padding;
+};
+
+// 动画查找表 (RGBA32F)
+//   头纹素: (首帧纹素下标, 帧数, 总时长, 0)
+//   帧纹素: (U 偏移, V 偏移, 帧结束时间, 0)
+layout(binding = 3) uniform sampler2D u_AnimationTable;
+
+// 单个动画的最大帧数
+const int MAX_ANIMATION_FRAMES = 64;
+
 // 输出到片段着色器
 layout(location = 0) out vec2 v_TexCoord;
 layout(location = 1) out float v_TexIndex;
 layout(location = 2) out vec4 v_Color;
 
+vec4 FetchAnimationTexel(int index) {
+    int width = int(u_AnimationTableWidth);
+    return texelFetch(u_AnimationTable, ivec2(index % width, index / width), 0);
+}
+
+vec2 GetAnimationOffset(int animIndex) {
+    vec4 header = FetchAnimationTexel(animIndex);
+    int firstFrame = int(header.x);
+    int frameCount = int(header.y);
+    float time = mod(u_TimeMs, header.z);
+
+    vec2 offset = vec2(0.0);
+    for (int i = 0; i < MAX_ANIMATION_FRAMES && i < frameCount; ++i) {
+        vec4 frame = FetchAnimationTexel(firstFrame + i);
+        offset = frame.xy;
+        if (time < frame.z) {
+            break;
+        }
+    }
+    return offset;
+}
+
 void main() {
     vec4 worldPos = vec4(a_Position, 0.0, 1.0);
     gl_Position = u_ViewProjection * worldPos;
 
     v_TexCoord = a_TexCoord;
+    if (a_AnimIndex >= 0.0) {
+        v_TexCoord += GetAnimationOffset(int(a_AnimIndex));
+    }
+
     v_TexIndex = a_TexIndex;
     v_Color = a_Color;
 }